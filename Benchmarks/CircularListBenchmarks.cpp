@@ -0,0 +1,91 @@
+#include <GameLib/CircularList.h>
+#include <GameLib/GameParameters.h>
+#include <GameLib/GameTypes.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+/*
+ * Measures pinning points one after the other, as when a ship's points get pinned
+ * with the oldest pins getting purged, against the number of pinned points.
+ */
+static void CircularList_Emplace(benchmark::State & state)
+{
+    size_t const pointCount = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        CircularList<ElementIndex, GameParameters::MaxPinnedPoints> pinnedPoints;
+        size_t purgedCount = 0;
+
+        for (size_t p = 0; p < pointCount; ++p)
+        {
+            pinnedPoints.emplace(
+                [&purgedCount](ElementIndex /*pointIndex*/)
+                {
+                    ++purgedCount;
+                },
+                static_cast<ElementIndex>(p));
+        }
+
+        benchmark::DoNotOptimize(purgedCount);
+    }
+
+    state.counters["Points"] = static_cast<double>(pointCount);
+    state.SetComplexityN(static_cast<int64_t>(pointCount));
+}
+
+BENCHMARK(CircularList_Emplace)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 20)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
+
+/*
+ * Measures looking up points in a full list of pinned points, as when toggling pins,
+ * against the number of points looked up.
+ */
+static void CircularList_Visit(benchmark::State & state)
+{
+    size_t const pointCount = static_cast<size_t>(state.range(0));
+
+    CircularList<ElementIndex, GameParameters::MaxPinnedPoints> pinnedPoints;
+    for (size_t p = 0; p < GameParameters::MaxPinnedPoints; ++p)
+    {
+        pinnedPoints.emplace(
+            [](ElementIndex /*pointIndex*/)
+            {
+            },
+            static_cast<ElementIndex>(p * 2));
+    }
+
+    for (auto _ : state)
+    {
+        size_t pinnedCount = 0;
+
+        for (size_t p = 0; p < pointCount; ++p)
+        {
+            ElementIndex const pointIndex = static_cast<ElementIndex>(p % (GameParameters::MaxPinnedPoints * 2));
+            for (auto const pinnedPointIndex : pinnedPoints)
+            {
+                if (pinnedPointIndex == pointIndex)
+                {
+                    ++pinnedCount;
+                    break;
+                }
+            }
+        }
+
+        benchmark::DoNotOptimize(pinnedCount);
+    }
+
+    state.counters["Points"] = static_cast<double>(pointCount);
+    state.SetComplexityN(static_cast<int64_t>(pointCount));
+}
+
+BENCHMARK(CircularList_Visit)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 20)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
@@ -0,0 +1,56 @@
+#include <GameLib/FixedSizeVector.h>
+#include <GameLib/GameTypes.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+
+/*
+ * Measures connecting springs to points and disconnecting them, as when building and
+ * breaking a ship, against the number of points.
+ */
+static void FixedSizeVector_ConnectedSprings(benchmark::State & state)
+{
+    size_t const pointCount = static_cast<size_t>(state.range(0));
+
+    // As in Points
+    std::unique_ptr<FixedSizeVector<ElementIndex, 8U + 1U>[]> connectedSprings(
+        new FixedSizeVector<ElementIndex, 8U + 1U>[pointCount]);
+
+    for (auto _ : state)
+    {
+        for (size_t p = 0; p < pointCount; ++p)
+        {
+            auto & pointConnectedSprings = connectedSprings[p];
+
+            pointConnectedSprings.clear();
+            for (ElementIndex s = 0; s < 8; ++s)
+            {
+                pointConnectedSprings.push_back(static_cast<ElementIndex>(p * 8) + s);
+            }
+
+            pointConnectedSprings.erase_first(static_cast<ElementIndex>(p * 8) + static_cast<ElementIndex>(p % 8));
+        }
+
+        size_t connectedSpringCount = 0;
+        for (size_t p = 0; p < pointCount; ++p)
+        {
+            for (auto const springIndex : connectedSprings[p])
+            {
+                connectedSpringCount += springIndex & 1;
+            }
+        }
+
+        benchmark::DoNotOptimize(connectedSpringCount);
+    }
+
+    state.counters["Points"] = static_cast<double>(pointCount);
+    state.SetComplexityN(static_cast<int64_t>(pointCount));
+}
+
+BENCHMARK(FixedSizeVector_ConnectedSprings)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 20)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
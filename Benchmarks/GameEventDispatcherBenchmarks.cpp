@@ -0,0 +1,54 @@
+#include "Utils.h"
+
+#include <GameLib/GameEventDispatcher.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+namespace
+{
+    class NullGameEventHandler : public IGameEventHandler
+    {
+    };
+}
+
+/*
+ * Measures firing one stress event per point and publishing them, as when a whole ship
+ * gets stressed in a step, against the number of points.
+ */
+static void GameEventDispatcher_StressAndFlush(benchmark::State & state)
+{
+    size_t const pointCount = static_cast<size_t>(state.range(0));
+
+    MaterialDatabase materials = MakeSyntheticMaterialDatabase();
+    Material const * const materialsByKind[] = {
+        materials.Get(SyntheticShipStructuralColour),
+        materials.Get(SyntheticShipLampColour) };
+
+    NullGameEventHandler sink;
+    GameEventDispatcher gameEventDispatcher;
+    gameEventDispatcher.RegisterSink(&sink);
+
+    for (auto _ : state)
+    {
+        for (size_t p = 0; p < pointCount; ++p)
+        {
+            gameEventDispatcher.OnStress(
+                materialsByKind[p % 2],
+                (p % 3) == 0,
+                1);
+        }
+
+        gameEventDispatcher.Flush();
+    }
+
+    state.counters["Points"] = static_cast<double>(pointCount);
+    state.SetComplexityN(static_cast<int64_t>(pointCount));
+}
+
+BENCHMARK(GameEventDispatcher_StressAndFlush)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 20)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
@@ -0,0 +1,46 @@
+#include "Utils.h"
+
+#include <GameLib/GameEventDispatcher.h>
+#include <GameLib/GameParameters.h>
+#include <GameLib/NullRenderBackend.h>
+#include <GameLib/Physics.h>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+/*
+ * Measures the CPU-side cost of preparing a frame of a ship that is being simulated,
+ * against the number of springs in the ship.
+ */
+static void World_Render(benchmark::State & state)
+{
+    int const size = static_cast<int>(state.range(0));
+
+    auto gameEventDispatcher = std::make_shared<GameEventDispatcher>();
+    GameParameters gameParameters;
+    MaterialDatabase materials = MakeSyntheticMaterialDatabase();
+
+    Physics::World world(gameEventDispatcher, gameParameters);
+    world.AddShip(MakeSyntheticShipDefinition(size, size), materials, gameParameters);
+
+    NullRenderBackend renderBackend;
+
+    // Upload the elements once, as the game does at the first frame
+    world.Render(gameParameters, renderBackend);
+
+    for (auto _ : state)
+    {
+        world.Render(gameParameters, renderBackend);
+    }
+
+    size_t const springCount = CalculateSyntheticShipSpringCount(size, size);
+    state.counters["Springs"] = static_cast<double>(springCount);
+    state.SetComplexityN(static_cast<int64_t>(springCount));
+}
+
+BENCHMARK(World_Render)
+    ->RangeMultiplier(2)
+    ->Range(32, 512)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
@@ -0,0 +1,245 @@
+#include "Utils.h"
+
+#include <GameLib/GameEventDispatcher.h>
+#include <GameLib/GameParameters.h>
+#include <GameLib/Physics.h>
+#include <GameLib/ShipBuilder.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace
+{
+    /*
+     * A synthetic ship with a side of the length requested by the benchmark, together
+     * with all it needs to live.
+     *
+     * Ships are compiled once per size, as the benchmark functions are run more than once
+     * and compiling the largest ships takes seconds.
+     */
+    class SyntheticShip
+    {
+    public:
+
+        explicit SyntheticShip(
+            benchmark::State const & state,
+            size_t lampCount = 0)
+            : mSize(static_cast<int>(state.range(0)))
+            , mGameEventDispatcher(std::make_shared<GameEventDispatcher>())
+            , mGameParameters()
+            , mWorld(mGameEventDispatcher, mGameParameters)
+            , mShip()
+            , mCurrentStepSequenceNumber(mWorld.GetCurrentStepSequenceNumber())
+        {
+            mShip = ShipBuilder::Create(
+                mWorld.GetNextShipId(),
+                mWorld,
+                mGameEventDispatcher,
+                GetCompiledShip(mSize, lampCount),
+                mGameParameters,
+                mCurrentStepSequenceNumber);
+        }
+
+        Physics::Ship & GetShip()
+        {
+            return *mShip;
+        }
+
+        GameParameters const & GetGameParameters() const
+        {
+            return mGameParameters;
+        }
+
+        uint64_t GetNextStepSequenceNumber()
+        {
+            return ++mCurrentStepSequenceNumber;
+        }
+
+        /*
+         * Gives the ship's points some water, so that water moves around.
+         */
+        void Flood()
+        {
+            auto & points = mShip->GetPoints();
+            for (auto pointIndex : points)
+            {
+                points.GetWater(pointIndex) = (pointIndex % 2 == 0) ? 0.5f : 1.5f;
+            }
+        }
+
+        void SetCounters(benchmark::State & state) const
+        {
+            size_t const pointCount = static_cast<size_t>(mSize) * static_cast<size_t>(mSize);
+            state.counters["Points"] = static_cast<double>(pointCount);
+            state.counters["Springs"] = static_cast<double>(CalculateSyntheticShipSpringCount(mSize, mSize));
+            state.SetComplexityN(static_cast<int64_t>(pointCount));
+        }
+
+    private:
+
+        static ShipBuilder::CompiledShip const & GetCompiledShip(
+            int size,
+            size_t lampCount)
+        {
+            // The compiled ships point to the materials
+            static MaterialDatabase const Materials = MakeSyntheticMaterialDatabase();
+            static std::map<std::pair<int, size_t>, ShipBuilder::CompiledShip> CompiledShips;
+
+            auto const key = std::make_pair(size, lampCount);
+            auto it = CompiledShips.find(key);
+            if (it == CompiledShips.end())
+            {
+                it = CompiledShips.emplace(
+                    key,
+                    ShipBuilder::Compile(
+                        MakeSyntheticShipDefinition(size, size, lampCount),
+                        Materials,
+                        [](float, std::string const &) {})).first;
+            }
+
+            return it->second;
+        }
+
+    private:
+
+        int const mSize;
+        std::shared_ptr<GameEventDispatcher> mGameEventDispatcher;
+        GameParameters mGameParameters;
+        Physics::World mWorld;
+        std::unique_ptr<Physics::Ship> mShip;
+        uint64_t mCurrentStepSequenceNumber;
+    };
+}
+
+// The synthetic ships go from 32x32 (1K points) to 1024x1024 (1M points)
+#define SHIP_BENCHMARK(name)                \
+    BENCHMARK(name)                         \
+        ->RangeMultiplier(2)                \
+        ->Range(32, 1024)                   \
+        ->Unit(benchmark::kMicrosecond)     \
+        ->Complexity()
+
+static void Ship_Integrate(benchmark::State & state)
+{
+    SyntheticShip ship(state);
+
+    for (auto _ : state)
+    {
+        ship.GetShip().Integrate();
+    }
+
+    ship.SetCounters(state);
+}
+
+SHIP_BENCHMARK(Ship_Integrate);
+
+static void Ship_UpdatePointForces(benchmark::State & state)
+{
+    SyntheticShip ship(state);
+
+    for (auto _ : state)
+    {
+        ship.GetShip().UpdatePointForces(ship.GetGameParameters());
+    }
+
+    ship.SetCounters(state);
+}
+
+SHIP_BENCHMARK(Ship_UpdatePointForces);
+
+static void Ship_UpdateSpringForces(benchmark::State & state)
+{
+    SyntheticShip ship(state);
+
+    for (auto _ : state)
+    {
+        ship.GetShip().UpdateSpringForces(ship.GetGameParameters());
+    }
+
+    ship.SetCounters(state);
+}
+
+SHIP_BENCHMARK(Ship_UpdateSpringForces);
+
+static void Ship_GravitateWater(benchmark::State & state)
+{
+    SyntheticShip ship(state);
+    ship.Flood();
+
+    for (auto _ : state)
+    {
+        ship.GetShip().GravitateWater(ship.GetGameParameters());
+    }
+
+    ship.SetCounters(state);
+}
+
+SHIP_BENCHMARK(Ship_GravitateWater);
+
+static void Ship_BalancePressure(benchmark::State & state)
+{
+    SyntheticShip ship(state);
+    ship.Flood();
+
+    for (auto _ : state)
+    {
+        ship.GetShip().BalancePressure(ship.GetGameParameters());
+    }
+
+    ship.SetCounters(state);
+}
+
+SHIP_BENCHMARK(Ship_BalancePressure);
+
+static void Ship_DiffuseLight(benchmark::State & state)
+{
+    // Light costs as much as the points times the lamps
+    SyntheticShip ship(state, 8);
+
+    for (auto _ : state)
+    {
+        ship.GetShip().DiffuseLight(ship.GetGameParameters());
+    }
+
+    ship.SetCounters(state);
+}
+
+SHIP_BENCHMARK(Ship_DiffuseLight);
+
+static void Ship_DetectConnectedComponents(benchmark::State & state)
+{
+    SyntheticShip ship(state);
+
+    for (auto _ : state)
+    {
+        ship.GetShip().DetectConnectedComponents(ship.GetNextStepSequenceNumber());
+    }
+
+    ship.SetCounters(state);
+}
+
+SHIP_BENCHMARK(Ship_DetectConnectedComponents);
+
+static void Springs_UpdateStrains(benchmark::State & state)
+{
+    // The ship stays at rest, hence no spring ever breaks
+    SyntheticShip ship(state);
+
+    for (auto _ : state)
+    {
+        bool const isBroken = ship.GetShip().GetSprings().UpdateStrains(
+            ship.GetGameParameters(),
+            ship.GetShip().GetPoints());
+
+        benchmark::DoNotOptimize(isBroken);
+    }
+
+    ship.SetCounters(state);
+}
+
+SHIP_BENCHMARK(Springs_UpdateStrains);
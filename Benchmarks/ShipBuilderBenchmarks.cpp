@@ -0,0 +1,166 @@
+#include "Utils.h"
+
+#include <GameLib/GameEventDispatcher.h>
+#include <GameLib/GameParameters.h>
+#include <GameLib/Physics.h>
+#include <GameLib/ShipBuilder.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    inline ElementIndex GetGridPointIndex(
+        int x,
+        int y,
+        int size)
+    {
+        return static_cast<ElementIndex>(y * size + x);
+    }
+
+    /*
+     * The springs of a solid square ship, in the order in which they are tessellated - i.e.
+     * before being optimized.
+     */
+    std::vector<ShipBuilder::SpringInfo> MakeGridSpringInfos(int size)
+    {
+        std::vector<ShipBuilder::SpringInfo> springInfos;
+
+        for (int y = 0; y < size; ++y)
+        {
+            for (int x = 0; x < size; ++x)
+            {
+                if (x + 1 < size)
+                    springInfos.emplace_back(GetGridPointIndex(x, y, size), GetGridPointIndex(x + 1, y, size));
+
+                if (y + 1 < size)
+                    springInfos.emplace_back(GetGridPointIndex(x, y, size), GetGridPointIndex(x, y + 1, size));
+
+                if (x + 1 < size && y + 1 < size)
+                {
+                    springInfos.emplace_back(GetGridPointIndex(x, y, size), GetGridPointIndex(x + 1, y + 1, size));
+                    springInfos.emplace_back(GetGridPointIndex(x + 1, y, size), GetGridPointIndex(x, y + 1, size));
+                }
+            }
+        }
+
+        return springInfos;
+    }
+
+    /*
+     * The triangles of a solid square ship, in the order in which they are tessellated.
+     */
+    std::vector<ShipBuilder::TriangleInfo> MakeGridTriangleInfos(int size)
+    {
+        std::vector<ShipBuilder::TriangleInfo> triangleInfos;
+
+        for (int y = 0; y + 1 < size; ++y)
+        {
+            for (int x = 0; x + 1 < size; ++x)
+            {
+                triangleInfos.emplace_back(
+                    GetGridPointIndex(x, y + 1, size),
+                    GetGridPointIndex(x + 1, y + 1, size),
+                    GetGridPointIndex(x + 1, y, size));
+
+                triangleInfos.emplace_back(
+                    GetGridPointIndex(x, y + 1, size),
+                    GetGridPointIndex(x + 1, y, size),
+                    GetGridPointIndex(x, y, size));
+            }
+        }
+
+        return triangleInfos;
+    }
+}
+
+/*
+ * Measures the time it takes to load a ship, against the number of springs in the ship.
+ */
+static void ShipBuilder_Create(benchmark::State & state)
+{
+    int const size = static_cast<int>(state.range(0));
+
+    auto gameEventDispatcher = std::make_shared<GameEventDispatcher>();
+    GameParameters gameParameters;
+    MaterialDatabase materials = MakeSyntheticMaterialDatabase();
+    ShipDefinition shipDefinition = MakeSyntheticShipDefinition(size, size);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        Physics::World world(gameEventDispatcher, gameParameters);
+        state.ResumeTiming();
+
+        world.AddShip(shipDefinition, materials, gameParameters);
+    }
+
+    size_t const springCount = CalculateSyntheticShipSpringCount(size, size);
+    state.counters["Springs"] = static_cast<double>(springCount);
+    state.SetComplexityN(static_cast<int64_t>(springCount));
+}
+
+BENCHMARK(ShipBuilder_Create)
+    ->RangeMultiplier(2)
+    ->Range(32, 512)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
+
+/*
+ * Measures the vertex cache optimization of the springs of a ship, against the number
+ * of points in the ship.
+ */
+static void ShipBuilder_ReorderOptimally_Springs(benchmark::State & state)
+{
+    int const size = static_cast<int>(state.range(0));
+    size_t const pointCount = static_cast<size_t>(size) * static_cast<size_t>(size);
+
+    std::vector<ShipBuilder::SpringInfo> springInfos = MakeGridSpringInfos(size);
+
+    for (auto _ : state)
+    {
+        auto reorderedSpringInfos = ShipBuilder::ReorderOptimally(springInfos, pointCount);
+        benchmark::DoNotOptimize(reorderedSpringInfos.data());
+    }
+
+    state.counters["Points"] = static_cast<double>(pointCount);
+    state.counters["Springs"] = static_cast<double>(springInfos.size());
+    state.SetComplexityN(static_cast<int64_t>(pointCount));
+}
+
+BENCHMARK(ShipBuilder_ReorderOptimally_Springs)
+    ->RangeMultiplier(2)
+    ->Range(32, 1024)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
+
+/*
+ * Measures the vertex cache optimization of the triangles of a ship, against the number
+ * of points in the ship.
+ */
+static void ShipBuilder_ReorderOptimally_Triangles(benchmark::State & state)
+{
+    int const size = static_cast<int>(state.range(0));
+    size_t const pointCount = static_cast<size_t>(size) * static_cast<size_t>(size);
+
+    std::vector<ShipBuilder::TriangleInfo> triangleInfos = MakeGridTriangleInfos(size);
+
+    for (auto _ : state)
+    {
+        auto reorderedTriangleInfos = ShipBuilder::ReorderOptimally(triangleInfos, pointCount);
+        benchmark::DoNotOptimize(reorderedTriangleInfos.data());
+    }
+
+    state.counters["Points"] = static_cast<double>(pointCount);
+    state.counters["Triangles"] = static_cast<double>(triangleInfos.size());
+    state.SetComplexityN(static_cast<int64_t>(pointCount));
+}
+
+BENCHMARK(ShipBuilder_ReorderOptimally_Triangles)
+    ->RangeMultiplier(2)
+    ->Range(32, 1024)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
@@ -0,0 +1,118 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-02
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameLib/Material.h>
+#include <GameLib/MaterialDatabase.h>
+#include <GameLib/ShipDefinition.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/*
+ * Helpers for building synthetic workloads for the benchmarks.
+ */
+
+// The structural colour of the material our synthetic ships are made of
+static constexpr std::array<uint8_t, 3u> SyntheticShipStructuralColour = { 0x80, 0x80, 0x80 };
+
+// The structural colour of the lamps of our synthetic ships
+static constexpr std::array<uint8_t, 3u> SyntheticShipLampColour = { 0xff, 0xff, 0x00 };
+
+inline MaterialDatabase MakeSyntheticMaterialDatabase()
+{
+    std::vector<std::unique_ptr<Material const>> materials;
+
+    materials.emplace_back(
+        new Material(
+            "Iron",
+            1.0f,
+            100.0f,
+            1.0f,
+            SyntheticShipStructuralColour,
+            SyntheticShipStructuralColour,
+            false,
+            false,
+            std::nullopt,
+            std::nullopt));
+
+    materials.emplace_back(
+        new Material(
+            "Lamp",
+            1.0f,
+            100.0f,
+            1.0f,
+            SyntheticShipLampColour,
+            SyntheticShipLampColour,
+            false,
+            false,
+            Material::ElectricalProperties(Material::ElectricalProperties::ElectricalElementType::Lamp, 1.0f, 0.0f),
+            std::nullopt));
+
+    materials.emplace_back(
+        new Material(
+            "Rope",
+            0.5f,
+            10.0f,
+            0.5f,
+            { 0x00, 0x00, 0x00 },
+            { 0x00, 0x00, 0x00 },
+            false,
+            true,
+            std::nullopt,
+            std::nullopt));
+
+    return MaterialDatabase::Create(std::move(materials));
+}
+
+/*
+ * Makes a solid rectangular ship of the specified size, with the specified number of
+ * lamps evenly spread over it.
+ */
+inline ShipDefinition MakeSyntheticShipDefinition(
+    int width,
+    int height,
+    size_t lampCount = 0)
+{
+    size_t const pixelCount = static_cast<size_t>(width) * static_cast<size_t>(height);
+    std::unique_ptr<unsigned char[]> data(new unsigned char[pixelCount * 3]);
+    for (size_t p = 0; p < pixelCount; ++p)
+    {
+        data[p * 3 + 0] = SyntheticShipStructuralColour[0];
+        data[p * 3 + 1] = SyntheticShipStructuralColour[1];
+        data[p * 3 + 2] = SyntheticShipStructuralColour[2];
+    }
+
+    for (size_t l = 0; l < lampCount; ++l)
+    {
+        size_t const p = (2 * l + 1) * pixelCount / (2 * lampCount);
+        data[p * 3 + 0] = SyntheticShipLampColour[0];
+        data[p * 3 + 1] = SyntheticShipLampColour[1];
+        data[p * 3 + 2] = SyntheticShipLampColour[2];
+    }
+
+    return ShipDefinition(
+        ImageData(width, height, std::unique_ptr<unsigned char const[]>(std::move(data))),
+        std::nullopt,
+        "Synthetic",
+        vec2f(0.0f, 0.0f));
+}
+
+/*
+ * The number of springs that ShipBuilder creates for a solid rectangular ship.
+ */
+inline size_t CalculateSyntheticShipSpringCount(
+    int width,
+    int height)
+{
+    size_t const w = static_cast<size_t>(width);
+    size_t const h = static_cast<size_t>(height);
+
+    return (w - 1) * h + w * (h - 1) + 2 * (w - 1) * (h - 1);
+}
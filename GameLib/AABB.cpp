@@ -27,6 +27,26 @@ void AABB::extendTo(AABB other)
         topright.y = other.topright.y;
 }
 
+void AABB::extendTo(vec2 point)
+{
+    if (point.x < bottomleft.x)
+        bottomleft.x = point.x;
+    if (point.y < bottomleft.y)
+        bottomleft.y = point.y;
+    if (point.x > topright.x)
+        topright.x = point.x;
+    if (point.y > topright.y)
+        topright.y = point.y;
+}
+
+bool AABB::intersects(AABB const & other) const
+{
+    return bottomleft.x <= other.topright.x
+        && topright.x >= other.bottomleft.x
+        && bottomleft.y <= other.topright.y
+        && topright.y >= other.bottomleft.y;
+}
+
 void AABB::render() const
 {
     //RenderUtils::RenderBox(
@@ -19,6 +19,8 @@ public:
     AABB() {}
     AABB(vec2 _bottomleft, vec2 _topright);
     void extendTo(AABB other);
+    void extendTo(vec2 point);
+    bool intersects(AABB const & other) const;
     void render() const;
 };
 
@@ -5,16 +5,20 @@
 ***************************************************************************************/
 #pragma once
 
+#include "GameEventDispatcher.h"
+#include "GameException.h"
 #include "GameParameters.h"
 #include "GameTypes.h"
 #include "GameWallClock.h"
-#include "IGameEventHandler.h"
+#include "IRenderBackend.h"
 #include "Physics.h"
-#include "RenderContext.h"
+#include "Snapshot.h"
 #include "Vectors.h"
 
 #include <cassert>
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <optional>
 
@@ -63,7 +67,15 @@ public:
      */
     virtual void Upload(
         int shipId,
-        RenderContext & renderContext) const = 0;
+        IRenderBackend & renderContext) const = 0;
+
+    /*
+     * Writes the state of the bomb to a snapshot - not including its type and ID.
+     * Time points are written relative to the specified current time.
+     */
+    virtual void WriteSnapshot(
+        SnapshotWriter & writer,
+        GameWallClock::time_point now) const = 0;
 
     /*
      * If the bomb is attached, saves its current position and detaches itself from the Springs container;
@@ -187,7 +199,7 @@ protected:
         BombType type,
         ElementIndex springIndex,
         World & parentWorld,
-        std::shared_ptr<IGameEventHandler> gameEventHandler,
+        std::shared_ptr<GameEventDispatcher> gameEventHandler,
         BlastHandler blastHandler,
         Points & shipPoints,
         Springs & shipSprings)
@@ -206,6 +218,81 @@ protected:
     {
     }
 
+    /*
+     * Restores a bomb from a snapshot; the members are read in declaration order.
+     */
+    Bomb(
+        ObjectId id,
+        BombType type,
+        SnapshotReader & reader,
+        World & parentWorld,
+        std::shared_ptr<GameEventDispatcher> gameEventHandler,
+        BlastHandler blastHandler,
+        Points & shipPoints,
+        Springs & shipSprings)
+        : mId(id)
+        , mParentWorld(parentWorld)
+        , mGameEventHandler(std::move(gameEventHandler))
+        , mBlastHandler(blastHandler)
+        , mShipPoints(shipPoints)
+        , mShipSprings(shipSprings)
+        , mRotationBaseAxis(reader.Read<vec2f>())
+        , mType(type)
+        , mSpringIndex(reader.ReadOptional<ElementIndex>())
+        , mMidpointPosition(reader.ReadOptional<vec2f>())
+        , mRotationOffsetAxis(reader.ReadOptional<vec2f>())
+        , mConnectedComponentId(reader.ReadOptional<ConnectedComponentId>())
+    {
+        if (!!mSpringIndex && *mSpringIndex >= mShipSprings.GetElementCount())
+        {
+            throw GameException("Bomb spring out of range");
+        }
+
+        // There are at most as many connected components as points
+        if (!!mConnectedComponentId && *mConnectedComponentId > mShipPoints.GetElementCount())
+        {
+            throw GameException("Bomb connected component out of range");
+        }
+    }
+
+    /*
+     * Time points are stored in snapshots relative to the current time, as neither the wall
+     * clock nor the simulation clock carry over across worlds; the minimum time point is
+     * stored as such.
+     */
+
+    static int64_t ToSnapshotTime(
+        GameWallClock::time_point timePoint,
+        GameWallClock::time_point now)
+    {
+        if (GameWallClock::time_point::min() == timePoint)
+            return std::numeric_limits<int64_t>::min();
+        else
+            return static_cast<int64_t>((timePoint - now).count());
+    }
+
+    static GameWallClock::time_point FromSnapshotTime(
+        int64_t snapshotTime,
+        GameWallClock::time_point now)
+    {
+        if (std::numeric_limits<int64_t>::min() == snapshotTime)
+            return GameWallClock::time_point::min();
+        else
+            return now + GameWallClock::duration(snapshotTime);
+    }
+
+    /*
+     * Writes the state that is common to all bombs, as expected by the restoring constructor.
+     */
+    void WriteBaseSnapshot(SnapshotWriter & writer) const
+    {
+        writer.Write(mRotationBaseAxis);
+        writer.WriteOptional(mSpringIndex);
+        writer.WriteOptional(mMidpointPosition);
+        writer.WriteOptional(mRotationOffsetAxis);
+        writer.WriteOptional(mConnectedComponentId);
+    }
+
     // Our ID
     ObjectId const mId;
 
@@ -213,7 +300,7 @@ protected:
     World & mParentWorld;
 
     // The game event handler
-    std::shared_ptr<IGameEventHandler> mGameEventHandler;
+    std::shared_ptr<GameEventDispatcher> mGameEventHandler;
 
     // The handler to invoke for each explosion
     BlastHandler mBlastHandler;
@@ -5,11 +5,13 @@
 ***************************************************************************************/
 #include "Physics.h"
 
+#include "GameException.h"
+
 namespace Physics {
 
 void Bombs::Update(GameParameters const & gameParameters)
 {
-    auto now = GameWallClock::GetInstance().Now();
+    auto now = mParentWorld.GetCurrentClockTime();
 
     // Run through all bombs and invoke Update() on each;
     // remove those bombs that have expired
@@ -99,7 +101,7 @@ void Bombs::DetonateRCBombs()
 
 void Bombs::Upload(
     int shipId,
-    RenderContext & renderContext) const
+    IRenderBackend & renderContext) const
 {
     renderContext.UploadShipElementBombsStart(
         shipId,
@@ -113,4 +115,88 @@ void Bombs::Upload(
     renderContext.UploadShipElementBombsEnd(shipId);
 }
 
+void Bombs::WriteSnapshot(
+    SnapshotWriter & writer,
+    GameWallClock::time_point now) const
+{
+    // The list visits the most recent bombs first, while they need to be re-added oldest first
+    std::vector<Bomb const *> bombs;
+    for (auto const & bomb : mCurrentBombs)
+    {
+        bombs.push_back(bomb.get());
+    }
+
+    writer.Write<uint32_t>(static_cast<uint32_t>(bombs.size()));
+    for (auto it = bombs.crbegin(); it != bombs.crend(); ++it)
+    {
+        writer.Write<uint8_t>(static_cast<uint8_t>((*it)->GetType()));
+        (*it)->WriteSnapshot(writer, now);
+    }
+}
+
+void Bombs::ReadSnapshot(
+    SnapshotReader & reader,
+    GameWallClock::time_point now)
+{
+    assert(mCurrentBombs.empty());
+
+    uint32_t const bombCount = reader.Read<uint32_t>();
+    if (bombCount > GameParameters::MaxBombs)
+    {
+        throw GameException("Too many bombs");
+    }
+
+    for (uint32_t b = 0; b < bombCount; ++b)
+    {
+        std::unique_ptr<Bomb> bomb;
+        switch (static_cast<BombType>(reader.Read<uint8_t>()))
+        {
+            case BombType::RCBomb:
+            {
+                bomb.reset(
+                    new RCBomb(
+                        ObjectIdGenerator::GetInstance().Generate(),
+                        reader,
+                        now,
+                        mParentWorld,
+                        mGameEventHandler,
+                        mBlastHandler,
+                        mShipPoints,
+                        mShipSprings));
+
+                break;
+            }
+
+            case BombType::TimerBomb:
+            {
+                bomb.reset(
+                    new TimerBomb(
+                        ObjectIdGenerator::GetInstance().Generate(),
+                        reader,
+                        now,
+                        mParentWorld,
+                        mGameEventHandler,
+                        mBlastHandler,
+                        mShipPoints,
+                        mShipSprings));
+
+                break;
+            }
+
+            default:
+            {
+                throw GameException("Unknown bomb type");
+            }
+        }
+
+        mCurrentBombs.emplace(
+            [](std::unique_ptr<Bomb> const &)
+            {
+                // Can't happen, as we never exceed the maximum number of bombs
+                assert(false);
+            },
+            std::move(bomb));
+    }
+}
+
 }
\ No newline at end of file
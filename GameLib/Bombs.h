@@ -6,15 +6,17 @@
 #pragma once
 
 #include "CircularList.h"
+#include "GameEventDispatcher.h"
 #include "GameParameters.h"
-#include "IGameEventHandler.h"
+#include "IRenderBackend.h"
 #include "ObjectIdGenerator.h"
 #include "Physics.h"
-#include "RenderContext.h"
+#include "Snapshot.h"
 #include "Vectors.h"
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace Physics
 {	
@@ -32,7 +34,7 @@ public:
 
     Bombs(
         World & parentWorld,
-        std::shared_ptr<IGameEventHandler> gameEventHandler,
+        std::shared_ptr<GameEventDispatcher> gameEventHandler,
         Bomb::BlastHandler blastHandler,
         Points & shipPoints,
         Springs & shipSprings)
@@ -72,7 +74,22 @@ public:
 
     void Upload(
         int shipId,
-        RenderContext & renderContext) const;
+        IRenderBackend & renderContext) const;
+
+    /*
+     * Writes all bombs to a snapshot, oldest first.
+     */
+    void WriteSnapshot(
+        SnapshotWriter & writer,
+        GameWallClock::time_point now) const;
+
+    /*
+     * Reads all bombs from a snapshot; bombs get new IDs. Only valid on an empty set of bombs,
+     * and after the ship's springs have been restored.
+     */
+    void ReadSnapshot(
+        SnapshotReader & reader,
+        GameWallClock::time_point now);
 
 private:
 
@@ -148,7 +165,8 @@ private:
                     mGameEventHandler,
                     mBlastHandler,
                     mShipPoints,
-                    mShipSprings));
+                    mShipSprings,
+                    gameParameters));
 
             // Attach bomb to the spring
             mShipSprings.AttachBomb(
@@ -186,7 +204,7 @@ private:
     World & mParentWorld;
 
     // The game event handler
-    std::shared_ptr<IGameEventHandler> mGameEventHandler;
+    std::shared_ptr<GameEventDispatcher> mGameEventHandler;
 
     // The handler to invoke for each explosion
     Bomb::BlastHandler const mBlastHandler;
@@ -10,7 +10,9 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
 #include <stdexcept>
+#include <type_traits>
 
 /*
 * This class implements a simple buffer of "things". The buffer is fixed-size and cannot
@@ -65,6 +67,29 @@ public:
         }
     }
 
+    /*
+     * Adds the specified elements to the buffer by copying their bits at once; only
+     * for elements that may be copied this way. Assumed to be invoked only at initialization time.
+     *
+     * Cannot add more elements than the size specified at constructor time.
+     */
+    void append_bitwise(
+        void const * elements,
+        size_t count)
+    {
+        static_assert(std::is_trivially_copyable<TElement>::value);
+
+        if (count <= mSize - mCurrentSize)
+        {
+            std::memcpy(mBuffer + mCurrentSize, elements, count * sizeof(TElement));
+            mCurrentSize += count;
+        }
+        else
+        {
+            throw std::runtime_error("The repository is already full");
+        }
+    }
+
     /*
      * Gets an element.
      */
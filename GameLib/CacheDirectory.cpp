@@ -0,0 +1,111 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-18
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "CacheDirectory.h"
+
+#include "GameException.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace /* anonymous */ {
+
+    static constexpr uint64_t FnvPrime = 1099511628211ull;
+}
+
+uint64_t CacheDirectory::HashKey(
+    uint64_t key,
+    void const * data,
+    size_t size)
+{
+    unsigned char const * bytes = static_cast<unsigned char const *>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        key ^= static_cast<uint64_t>(bytes[i]);
+        key *= FnvPrime;
+    }
+
+    return key;
+}
+
+uint64_t CacheDirectory::HashFileStamp(
+    uint64_t key,
+    std::filesystem::path const & filePath)
+{
+    std::string const fileName = filePath.filename().string();
+    key = HashKey(key, fileName.data(), fileName.size());
+
+    uint64_t const fileSize = static_cast<uint64_t>(std::filesystem::file_size(filePath));
+    key = HashKey(key, fileSize);
+
+    int64_t const lastWriteTime = static_cast<int64_t>(std::filesystem::last_write_time(filePath).time_since_epoch().count());
+    key = HashKey(key, lastWriteTime);
+
+    return key;
+}
+
+uint64_t CacheDirectory::HashFileContent(
+    uint64_t key,
+    std::filesystem::path const & filePath)
+{
+    MemoryMappedFile const mappedFile(filePath);
+
+    uint64_t const contentSize = static_cast<uint64_t>(mappedFile.GetSize());
+    key = HashKey(key, contentSize);
+    key = HashKey(key, mappedFile.GetData(), mappedFile.GetSize());
+
+    return key;
+}
+
+std::filesystem::path CacheDirectory::GetEntryFilePath(uint64_t key) const
+{
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << key << mEntryFileExtension;
+
+    return mDirectoryPath / ss.str();
+}
+
+std::optional<MemoryMappedFile> CacheDirectory::MapEntryFile(uint64_t key) const
+{
+    std::filesystem::path const entryFilePath = GetEntryFilePath(key);
+    if (!std::filesystem::exists(entryFilePath))
+    {
+        return std::nullopt;
+    }
+
+    return MemoryMappedFile(entryFilePath);
+}
+
+void CacheDirectory::WriteEntryFile(
+    uint64_t key,
+    std::vector<Chunk> const & chunks) const
+{
+    std::filesystem::path const entryFilePath = GetEntryFilePath(key);
+    std::filesystem::path temporaryFilePath = entryFilePath;
+    temporaryFilePath += ".tmp";
+
+    std::filesystem::create_directories(mDirectoryPath);
+
+    {
+        std::ofstream file(temporaryFilePath.string(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            throw GameException("Cannot create file \"" + temporaryFilePath.string() + "\"");
+        }
+
+        for (auto const & chunk : chunks)
+        {
+            file.write(reinterpret_cast<char const *>(chunk.Data), chunk.Size);
+        }
+
+        if (!file)
+        {
+            throw GameException("Cannot write file \"" + temporaryFilePath.string() + "\"");
+        }
+    }
+
+    std::filesystem::rename(temporaryFilePath, entryFilePath);
+}
@@ -0,0 +1,125 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-18
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "MemoryMappedFile.h"
+#include "SysSpecifics.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+ * A directory of cache entry files, each one named after the 64-bit key of its entry.
+ *
+ * This is the plumbing shared by all of our caches: calculating keys, naming entry files,
+ * and writing them atomically; the layout of the entries is up to each cache.
+ *
+ * Its methods may be invoked concurrently.
+ */
+class CacheDirectory
+{
+public:
+
+    /*
+     * A piece of an entry file.
+     */
+    struct Chunk
+    {
+        void const * Data;
+        size_t Size;
+
+        Chunk(
+            void const * data,
+            size_t size)
+            : Data(data)
+            , Size(size)
+        {}
+    };
+
+public:
+
+    CacheDirectory(
+        std::filesystem::path directoryPath,
+        std::string entryFileExtension)
+        : mDirectoryPath(std::move(directoryPath))
+        , mEntryFileExtension(std::move(entryFileExtension))
+    {
+    }
+
+    //
+    // Keys are FNV-1a hashes, built by hashing into InitialKey whatever the
+    // entry depends on
+    //
+
+    static constexpr uint64_t InitialKey = 14695981039346656037ull;
+
+    static uint64_t HashKey(
+        uint64_t key,
+        void const * data,
+        size_t size);
+
+    template<typename T>
+    static uint64_t HashKey(
+        uint64_t key,
+        T const & value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value);
+
+        return HashKey(key, &value, sizeof(T));
+    }
+
+    /*
+     * Hashes the name, size, and last modification time of a file; this is much cheaper
+     * than hashing its contents, but does not notice a file being replaced with one of
+     * the same size and time.
+     */
+    static uint64_t HashFileStamp(
+        uint64_t key,
+        std::filesystem::path const & filePath);
+
+    /*
+     * Hashes the contents of a file, together with their size so that contents can't
+     * move across files.
+     */
+    static uint64_t HashFileContent(
+        uint64_t key,
+        std::filesystem::path const & filePath);
+
+    //
+    // Entry files
+    //
+
+    std::filesystem::path GetEntryFilePath(uint64_t key) const;
+
+    /*
+     * Maps the entry file with the specified key, if there is one.
+     *
+     * Throws when the file exists but cannot be mapped.
+     */
+    std::optional<MemoryMappedFile> MapEntryFile(uint64_t key) const;
+
+    /*
+     * Writes the entry file with the specified key, made of the specified chunks in order.
+     *
+     * The file is written under a temporary name and then renamed, so that a concurrent or
+     * interrupted write never leaves a partial entry behind.
+     *
+     * Throws when the file cannot be written.
+     */
+    void WriteEntryFile(
+        uint64_t key,
+        std::vector<Chunk> const & chunks) const;
+
+private:
+
+    std::filesystem::path const mDirectoryPath;
+    std::string const mEntryFileExtension;
+};
@@ -0,0 +1,146 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "DecodedTexture.h"
+
+#include <cassert>
+
+DecodedTexture DecodedTexture::FromImage(
+    ImageData image,
+    bool withMipmaps)
+{
+    DecodedTexture texture;
+
+    texture.mLevelSizes.push_back(image.Size);
+    texture.mLevelData.push_back(image.Data.get());
+    texture.mOwnedLevels.emplace_back(std::move(image.Data));
+
+    if (!withMipmaps)
+        return texture;
+
+    //
+    // Create minified levels
+    //
+
+    for (ImageSize readImageSize = texture.mLevelSizes.back();
+        readImageSize.Width != 1 || readImageSize.Height != 1;
+        readImageSize = texture.mLevelSizes.back())
+    {
+        // Calculate dimensions of new level
+        ImageSize const writeImageSize = GetNextLevelSize(readImageSize);
+        int const width = writeImageSize.Width;
+        int const height = writeImageSize.Height;
+
+        // Allocate new level
+        std::unique_ptr<unsigned char[]> writeBuffer(new unsigned char[width * height * 4]);
+
+        // Create new level
+        unsigned char const * rp = texture.mLevelData.back();
+        unsigned char * wp = writeBuffer.get();
+        for (int h = 0; h < height; ++h)
+        {
+            for (int w = 0; w < width; ++w)
+            {
+                //
+                // Apply box filter
+                //
+
+                int wIndex = ((h * width) + w) * 4;
+
+                int rIndex = (((h * 2) * readImageSize.Width) + (w * 2)) * 4;
+                int rIndexNextLine = ((((h * 2) + 1) * readImageSize.Width) + (w * 2)) * 4;
+
+                for (int comp = 0; comp < 4; ++comp)
+                {
+                    int sum = 0;
+                    int count = 0;
+
+                    sum += static_cast<int>(rp[rIndex + comp]);
+                    ++count;
+
+                    if (readImageSize.Width > 1)
+                    {
+                        sum += static_cast<int>(rp[rIndex + 4 + comp]);
+                        ++count;
+                    }
+
+                    if (readImageSize.Height > 1)
+                    {
+                        sum += static_cast<int>(rp[rIndexNextLine + comp]);
+                        ++count;
+
+                        if (readImageSize.Width > 1)
+                        {
+                            sum += static_cast<int>(rp[rIndexNextLine + 4 + comp]);
+                            ++count;
+                        }
+                    }
+
+                    wp[wIndex + comp] = static_cast<unsigned char>(sum / count);
+                }
+            }
+        }
+
+        // Store level
+        texture.mLevelSizes.push_back(writeImageSize);
+        texture.mLevelData.push_back(writeBuffer.get());
+        texture.mOwnedLevels.emplace_back(std::move(writeBuffer));
+    }
+
+    assert(texture.mLevelSizes.size() == CalculateMipmapLevelCount(texture.mLevelSizes[0]));
+
+    return texture;
+}
+
+DecodedTexture::DecodedTexture(
+    MemoryMappedFile mappedFile,
+    size_t levelsOffset,
+    ImageSize size,
+    size_t levelCount)
+    : mOwnedLevels()
+    , mMappedFile(std::move(mappedFile))
+    , mLevelSizes()
+    , mLevelData()
+{
+    assert(levelCount > 0);
+    assert(levelsOffset + CalculateDataSize(size, levelCount) <= mMappedFile->GetSize());
+
+    unsigned char const * levelData = mMappedFile->GetData() + levelsOffset;
+    ImageSize levelSize = size;
+    for (size_t l = 0; l < levelCount; ++l)
+    {
+        mLevelSizes.push_back(levelSize);
+        mLevelData.push_back(levelData);
+
+        levelData += static_cast<size_t>(levelSize.Width) * static_cast<size_t>(levelSize.Height) * 4;
+        levelSize = GetNextLevelSize(levelSize);
+    }
+}
+
+size_t DecodedTexture::CalculateMipmapLevelCount(ImageSize size)
+{
+    size_t levelCount = 1;
+    while (size.Width != 1 || size.Height != 1)
+    {
+        size = GetNextLevelSize(size);
+        ++levelCount;
+    }
+
+    return levelCount;
+}
+
+size_t DecodedTexture::CalculateDataSize(
+    ImageSize size,
+    size_t levelCount)
+{
+    size_t dataSize = 0;
+    for (size_t l = 0; l < levelCount; ++l)
+    {
+        dataSize += static_cast<size_t>(size.Width) * static_cast<size_t>(size.Height) * 4;
+        size = GetNextLevelSize(size);
+    }
+
+    return dataSize;
+}
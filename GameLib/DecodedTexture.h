@@ -0,0 +1,102 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "ImageData.h"
+#include "ImageSize.h"
+#include "MemoryMappedFile.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/*
+ * An RGBA texture ready to be uploaded, optionally with all of its mipmap levels.
+ *
+ * The levels live either in memory, or in a memory-mapped file.
+ */
+class DecodedTexture
+{
+public:
+
+    /*
+     * Makes a texture out of an RGBA image; the mipmaps, if requested, are calculated
+     * with a box filter, down to 1x1.
+     */
+    static DecodedTexture FromImage(
+        ImageData image,
+        bool withMipmaps);
+
+    /*
+     * A texture whose levels are laid out one after the other, from the base level
+     * down, starting at the specified offset.
+     */
+    DecodedTexture(
+        MemoryMappedFile mappedFile,
+        size_t levelsOffset,
+        ImageSize size,
+        size_t levelCount);
+
+    ImageSize GetSize() const
+    {
+        return mLevelSizes[0];
+    }
+
+    size_t GetLevelCount() const
+    {
+        return mLevelSizes.size();
+    }
+
+    ImageSize GetLevelSize(size_t level) const
+    {
+        return mLevelSizes[level];
+    }
+
+    unsigned char const * GetLevelData(size_t level) const
+    {
+        return mLevelData[level];
+    }
+
+    /*
+     * The number of levels of a complete mipmap chain for a texture of the specified size.
+     */
+    static size_t CalculateMipmapLevelCount(ImageSize size);
+
+    /*
+     * The number of bytes of the specified levels of a texture of the specified size.
+     */
+    static size_t CalculateDataSize(
+        ImageSize size,
+        size_t levelCount);
+
+private:
+
+    DecodedTexture()
+        : mOwnedLevels()
+        , mMappedFile()
+        , mLevelSizes()
+        , mLevelData()
+    {
+    }
+
+    static ImageSize GetNextLevelSize(ImageSize size)
+    {
+        return ImageSize(
+            std::max(1, size.Width / 2),
+            std::max(1, size.Height / 2));
+    }
+
+private:
+
+    // Moving either keeps the levels where they are
+    std::vector<std::unique_ptr<unsigned char const[]>> mOwnedLevels;
+    std::optional<MemoryMappedFile> mMappedFile;
+
+    std::vector<ImageSize> mLevelSizes;
+    std::vector<unsigned char const *> mLevelData;
+};
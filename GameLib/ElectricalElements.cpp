@@ -5,6 +5,8 @@
 ***************************************************************************************/
 #include "Physics.h"
 
+#include "GameException.h"
+
 namespace Physics {
 
 void ElectricalElements::Add(std::unique_ptr<ElectricalElement> electricalElement)
@@ -29,4 +31,64 @@ void ElectricalElements::Destroy(ElementIndex electricalElementIndex)
     mIsDeletedBuffer[electricalElementIndex] = true;
 }
 
+void ElectricalElements::WriteSnapshot(SnapshotWriter & writer) const
+{
+    writer.WriteBuffer(mIsDeletedBuffer, mElementCount);
+
+    for (ElementIndex i : *this)
+    {
+        writer.Write<uint8_t>(static_cast<uint8_t>(mElectricalElementBuffer[i]->GetType()));
+        writer.Write(mElectricalElementBuffer[i]->GetPointIndex());
+        writer.Write(mElectricalElementBuffer[i]->GetLastGraphVisitStepSequenceNumber());
+    }
+}
+
+void ElectricalElements::ReadSnapshot(
+    SnapshotReader & reader,
+    ElementCount pointCount)
+{
+    reader.ReadBuffer(mIsDeletedBuffer, mElementCount);
+
+    for (ElementIndex i = 0; i < mElementCount; ++i)
+    {
+        auto const type = static_cast<ElectricalElement::Type>(reader.Read<uint8_t>());
+        ElementIndex const pointIndex = reader.Read<ElementIndex>();
+        if (pointIndex >= pointCount)
+        {
+            throw GameException("Electrical element point out of range");
+        }
+
+        std::unique_ptr<ElectricalElement> electricalElement;
+        switch (type)
+        {
+            case ElectricalElement::Type::Cable:
+            {
+                electricalElement.reset(new Cable(pointIndex));
+                break;
+            }
+
+            case ElectricalElement::Type::Generator:
+            {
+                electricalElement.reset(new Generator(pointIndex));
+                break;
+            }
+
+            case ElectricalElement::Type::Lamp:
+            {
+                electricalElement.reset(new Lamp(pointIndex));
+                break;
+            }
+
+            default:
+            {
+                throw GameException("Unknown electrical element type");
+            }
+        }
+
+        electricalElement->RecordGraphVisit(reader.Read<uint64_t>());
+
+        mElectricalElementBuffer.emplace_back(std::move(electricalElement));
+    }
+}
+
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 #include "Buffer.h"
 #include "ElementContainer.h"
+#include "Snapshot.h"
 
 #include <cassert>
 #include <functional>
@@ -61,6 +62,21 @@ public:
 
     void Destroy(ElementIndex electricalElementIndex);
 
+    /*
+     * Writes the state of all electrical elements to a snapshot.
+     */
+    void WriteSnapshot(SnapshotWriter & writer) const;
+
+    /*
+     * Reads the state of all electrical elements from a snapshot; only valid on a container
+     * that has just been constructed with the snapshot's number of electrical elements.
+     *
+     * Throws if an element's point is not one of the specified number of points.
+     */
+    void ReadSnapshot(
+        SnapshotReader & reader,
+        ElementCount pointCount);
+
 public:
 
     inline bool IsDeleted(ElementIndex electricalElementIndex) const
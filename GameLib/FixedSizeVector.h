@@ -139,6 +139,11 @@ public:
         return mCurrentSize;
     }
 
+    static constexpr size_t max_size() noexcept
+    {
+        return MaxSize;
+    }
+
     inline bool empty() const noexcept
     {
         return mCurrentSize == 0u;
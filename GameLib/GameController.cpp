@@ -5,13 +5,29 @@
 ***************************************************************************************/
 #include "GameController.h"
 
+#include "GameException.h"
 #include "GameMath.h"
 #include "Log.h"
+#include "ShipBuilder.h"
+#include "Snapshot.h"
+#include "Trace.h"
+
+#include <array>
+
+namespace /* anonymous */ {
+
+    // Bump whenever the layout of snapshots changes
+    static constexpr uint32_t SnapshotFormatVersion = 5;
+
+    static constexpr std::array<char, 4> SnapshotMagic = { 'S', 'S', 'W', 'S' };
+}
 
 std::unique_ptr<GameController> GameController::Create(
     std::shared_ptr<ResourceLoader> resourceLoader,
     ProgressCallback const & progressCallback)
 {
+    TraceSpan span("GameController::Create");
+
     // Load materials
     auto materials = resourceLoader->LoadMaterials();
 
@@ -48,20 +64,42 @@ void GameController::RegisterGameEventHandler(IGameEventHandler * gameEventHandl
 
 void GameController::ResetAndLoadShip(std::filesystem::path const & filepath)
 {
-    auto shipDefinition = mResourceLoader->LoadShipDefinition(filepath);
+    CancelShipLoad();
+
+    auto newWorld = std::make_unique<Physics::World>(mGameEventDispatcher, mGameParameters);
+
+    auto loadedShip = LoadShip(
+        filepath,
+        *newWorld,
+        newWorld->GetNextShipId(),
+        newWorld->GetCurrentStepSequenceNumber(),
+        mGameParameters,
+        ProgressCallback());
 
-    Reset();
+    Reset(std::move(newWorld));
 
-    AddShip(std::move(shipDefinition));
+    AddShip(std::move(loadedShip));
     
 	mLastShipLoadedFilePath = filepath;
 }
 
 void GameController::AddShip(std::filesystem::path const & filepath)
 {
-    auto shipDefinition = mResourceLoader->LoadShipDefinition(filepath);
+    if (IsLoadingShip())
+    {
+        CompleteShipLoad();
+    }
 
-    AddShip(std::move(shipDefinition));
+    assert(!!mWorld);
+    auto loadedShip = LoadShip(
+        filepath,
+        *mWorld,
+        mWorld->GetNextShipId(),
+        mWorld->GetCurrentStepSequenceNumber(),
+        mGameParameters,
+        ProgressCallback());
+
+    AddShip(std::move(loadedShip));
 
 	mLastShipLoadedFilePath = filepath;
 }
@@ -73,15 +111,171 @@ void GameController::ReloadLastShip()
 		throw std::runtime_error("No ship has been loaded yet");
 	}
 
-    auto shipDefinition = mResourceLoader->LoadShipDefinition(mLastShipLoadedFilePath);
+    CancelShipLoad();
+
+    auto newWorld = std::make_unique<Physics::World>(mGameEventDispatcher, mGameParameters);
+
+    auto loadedShip = LoadShip(
+        mLastShipLoadedFilePath,
+        *newWorld,
+        newWorld->GetNextShipId(),
+        newWorld->GetCurrentStepSequenceNumber(),
+        mGameParameters,
+        ProgressCallback());
+
+    Reset(std::move(newWorld));
+
+    AddShip(std::move(loadedShip));
+}
+
+void GameController::ResetAndLoadShipAsync(
+    std::filesystem::path const & filepath,
+    ProgressCallback progressCallback)
+{
+    CancelShipLoad();
+
+    // Create the new world now, so that the ship may be built for it;
+    // the current world stays in place until the ship is ready
+    mPendingShipLoadWorld = std::make_unique<Physics::World>(mGameEventDispatcher, mGameParameters);
+
+    StartShipLoad(
+        filepath,
+        *mPendingShipLoadWorld,
+        std::move(progressCallback));
+}
+
+void GameController::AddShipAsync(
+    std::filesystem::path const & filepath,
+    ProgressCallback progressCallback)
+{
+    if (IsLoadingShip())
+    {
+        CompleteShipLoad();
+    }
+
+    assert(!!mWorld);
+    StartShipLoad(
+        filepath,
+        *mWorld,
+        std::move(progressCallback));
+}
+
+void GameController::SaveSnapshot(std::filesystem::path const & filepath) const
+{
+    assert(!!mWorld);
+    assert(mShipFilePaths.size() == static_cast<size_t>(mWorld->GetNextShipId()));
+
+    SnapshotWriter writer;
+
+    writer.Write(SnapshotMagic.data(), SnapshotMagic.size());
+    writer.Write<uint32_t>(SnapshotFormatVersion);
+
+    writer.Write<uint32_t>(static_cast<uint32_t>(mShipFilePaths.size()));
+    for (auto const & shipFilePath : mShipFilePaths)
+    {
+        writer.Write(shipFilePath.string());
+    }
+
+    mWorld->WriteSnapshot(writer);
+
+    writer.SaveToFile(filepath);
 
-    Reset();
+    LogMessage("Saved snapshot \"", filepath.string(), "\": ", writer.GetBuffer().size(), " bytes");
+}
+
+void GameController::LoadSnapshot(std::filesystem::path const & filepath)
+{
+    CancelShipLoad();
+
+    SnapshotReader reader = SnapshotReader::FromFile(filepath);
+
+    //
+    // Header
+    //
+
+    std::array<char, 4> magic;
+    reader.Read(magic.data(), magic.size());
+    if (magic != SnapshotMagic
+        || reader.Read<uint32_t>() != SnapshotFormatVersion)
+    {
+        throw GameException("\"" + filepath.string() + "\" is not a snapshot of this version");
+    }
 
-    AddShip(std::move(shipDefinition));
+    std::vector<std::filesystem::path> shipFilePaths;
+    for (uint32_t s = reader.Read<uint32_t>(); s > 0; --s)
+    {
+        shipFilePaths.emplace_back(reader.ReadString());
+    }
+
+    //
+    // World
+    //
+
+    auto newWorld = Physics::World::ReadSnapshot(
+        reader,
+        mGameEventDispatcher,
+        mMaterials,
+        mGameParameters);
+
+    if (!reader.IsAtEnd()
+        || static_cast<size_t>(newWorld->GetNextShipId()) != shipFilePaths.size())
+    {
+        throw GameException("\"" + filepath.string() + "\" is corrupted");
+    }
+
+    //
+    // Textures - loaded before swapping the world, so that failures leave the current world in place
+    //
+
+    std::vector<ShipCache::Entry> compiledShips;
+    for (auto const & shipFilePath : shipFilePaths)
+    {
+        compiledShips.emplace_back(LoadCompiledShip(shipFilePath, ProgressCallback()));
+    }
+
+    Reset(std::move(newWorld));
+
+    for (size_t s = 0; s < compiledShips.size(); ++s)
+    {
+        int const shipId = static_cast<int>(s);
+
+        mRenderContext->AddShip(shipId, std::move(compiledShips[s].TextureImage));
+
+        mGameEventDispatcher->OnShipLoaded(shipId, compiledShips[s].ShipName);
+    }
+
+    mShipFilePaths = std::move(shipFilePaths);
+}
+
+void GameController::StartRecording(std::filesystem::path const & filepath)
+{
+    StopRecording();
+
+    assert(!!mWorld);
+    mInputRecorder = std::make_unique<InputRecorder>(*mWorld, mGameParameters);
+    mInputRecordingFilePath = filepath;
+}
+
+void GameController::StopRecording()
+{
+    if (!!mInputRecorder)
+    {
+        // Forget about the recording even if it can't be saved
+        auto inputRecorder = std::move(mInputRecorder);
+
+        inputRecorder->SaveToFile(mInputRecordingFilePath);
+
+        LogMessage("Saved recording \"", mInputRecordingFilePath.string(), "\": ", inputRecorder->GetStepCount(), " steps");
+    }
 }
 
 void GameController::DoStep()
 {
+    TraceSpan span("GameController::DoStep");
+
+    if (!!mInputRecorder)
+        mInputRecorder->RecordStep(mGameParameters);
+
 	// Update world
 	assert(!!mWorld);
     mWorld->Update(mGameParameters);
@@ -92,6 +286,18 @@ void GameController::DoStep()
 
 void GameController::Render()
 {
+    TraceSpan span("GameController::Render");
+
+    //
+    // Complete the pending ship load, if it's ready
+    //
+
+    if (IsLoadingShip()
+        && std::future_status::ready == mPendingShipLoad.wait_for(std::chrono::seconds(0)))
+    {
+        CompleteShipLoad();
+    }
+
     //
     // Do zoom smoothing
     //
@@ -149,11 +355,16 @@ void GameController::DestroyAt(
 
     LogMessage("DestroyAt: ", worldCoordinates.toString(), " * ", radiusMultiplier);
 
+    float radius = mGameParameters.DestroyRadius * radiusMultiplier;
+
+    if (!!mInputRecorder)
+        mInputRecorder->RecordDestroyAt(worldCoordinates, radius);
+
 	// Apply action
 	assert(!!mWorld);
     mWorld->DestroyAt(
 		worldCoordinates,
-		mGameParameters.DestroyRadius * radiusMultiplier);
+		radius);
 }
 
 void GameController::SawThrough(
@@ -163,6 +374,9 @@ void GameController::SawThrough(
     vec2f startWorldCoordinates = mRenderContext->ScreenToWorld(startScreenCoordinates);
     vec2f endWorldCoordinates = mRenderContext->ScreenToWorld(endScreenCoordinates);
 
+    if (!!mInputRecorder)
+        mInputRecorder->RecordSawThrough(startWorldCoordinates, endWorldCoordinates);
+
     // Apply action
     assert(!!mWorld);
     mWorld->SawThrough(startWorldCoordinates, endWorldCoordinates);
@@ -178,6 +392,9 @@ void GameController::DrawTo(
     if (mGameParameters.IsUltraViolentMode)
         strength *= 10.0f;
 
+    if (!!mInputRecorder)
+        mInputRecorder->RecordDrawTo(worldCoordinates, strength);
+
 	// Apply action
 	assert(!!mWorld);
     mWorld->DrawTo(
@@ -195,6 +412,9 @@ void GameController::SwirlAt(
     if (mGameParameters.IsUltraViolentMode)
         strength *= 20.0f;
 
+    if (!!mInputRecorder)
+        mInputRecorder->RecordSwirlAt(worldCoordinates, strength);
+
     // Apply action
     assert(!!mWorld);
     mWorld->SwirlAt(worldCoordinates, strength);
@@ -204,6 +424,9 @@ void GameController::TogglePinAt(vec2 const & screenCoordinates)
 {
     vec2f worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
+    if (!!mInputRecorder)
+        mInputRecorder->RecordTogglePinAt(worldCoordinates);
+
     // Apply action
     assert(!!mWorld);
     mWorld->TogglePinAt(
@@ -219,6 +442,9 @@ void GameController::ToggleTimerBombAt(vec2f const & screenCoordinates)
 {
     vec2f worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
+    if (!!mInputRecorder)
+        mInputRecorder->RecordToggleTimerBombAt(worldCoordinates);
+
     // Apply action
     assert(!!mWorld);
     mWorld->ToggleTimerBombAt(
@@ -230,6 +456,9 @@ void GameController::ToggleRCBombAt(vec2f const & screenCoordinates)
 {
     vec2f worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
+    if (!!mInputRecorder)
+        mInputRecorder->RecordToggleRCBombAt(worldCoordinates);
+
     // Apply action
     assert(!!mWorld);
     mWorld->ToggleRCBombAt(
@@ -239,6 +468,9 @@ void GameController::ToggleRCBombAt(vec2f const & screenCoordinates)
 
 void GameController::DetonateRCBombs()
 {
+    if (!!mInputRecorder)
+        mInputRecorder->RecordDetonateRCBombs();
+
     // Apply action
     assert(!!mWorld);
     mWorld->DetonateRCBombs();
@@ -281,11 +513,15 @@ void GameController::SmoothToTarget(
     }
 }
 
-void GameController::Reset()
+void GameController::Reset(std::unique_ptr<Physics::World> newWorld)
 {
+    // The recording is of the world we're about to lose
+    StopRecording();
+
     // Reset world
-    assert(!!mWorld);
-    mWorld.reset(new Physics::World(mGameEventDispatcher, mGameParameters));
+    assert(!!newWorld);
+    mWorld = std::move(newWorld);
+    mShipFilePaths.clear();
 
     // Reset rendering engine
     assert(!!mRenderContext);
@@ -295,17 +531,183 @@ void GameController::Reset()
     mGameEventDispatcher->OnGameReset();
 }
 
-void GameController::AddShip(ShipDefinition shipDefinition)
+void GameController::AddShip(LoadedShip loadedShip)
 {
+    // Recordings can't capture ships being added
+    StopRecording();
+
     // Add ship to world
-    int shipId = mWorld->AddShip(
-        shipDefinition, 
-        mMaterials,
-        mGameParameters);
+    assert(!!mWorld);
+    int shipId = mWorld->AddShip(std::move(loadedShip.Ship));
+    mShipFilePaths.push_back(std::move(loadedShip.FilePath));
 
     // Add ship to rendering engine
-    mRenderContext->AddShip(shipId, std::move(shipDefinition.TextureImage));
+    mRenderContext->AddShip(shipId, std::move(loadedShip.TextureImage));
 
     // Notify
-    mGameEventDispatcher->OnShipLoaded(shipId, shipDefinition.ShipName);
+    mGameEventDispatcher->OnShipLoaded(shipId, loadedShip.ShipName);
+}
+
+GameController::LoadedShip GameController::LoadShip(
+    std::filesystem::path const & filepath,
+    Physics::World & targetWorld,
+    int shipId,
+    uint64_t currentStepSequenceNumber,
+    GameParameters const & gameParameters,
+    ProgressCallback const & progressCallback) const
+{
+    TraceSpan span("GameController::LoadShip");
+
+    ShipCache::Entry compiledShip = LoadCompiledShip(
+        filepath,
+        [&progressCallback](float progress, std::string const & message)
+        {
+            if (progressCallback)
+                progressCallback(0.9f * progress, message);
+        });
+
+    //
+    // Make the ship
+    //
+
+    if (progressCallback)
+        progressCallback(0.9f, "Creating ship...");
+
+    auto ship = ShipBuilder::Create(
+        shipId,
+        targetWorld,
+        mGameEventDispatcher,
+        compiledShip.CompiledShip,
+        gameParameters,
+        currentStepSequenceNumber);
+
+    if (progressCallback)
+        progressCallback(1.0f, "Creating ship...");
+
+    return LoadedShip{
+        std::move(ship),
+        std::move(compiledShip.TextureImage),
+        compiledShip.ShipName,
+        filepath };
+}
+
+ShipCache::Entry GameController::LoadCompiledShip(
+    std::filesystem::path const & filepath,
+    ProgressCallback const & progressCallback) const
+{
+    TraceSpan span("GameController::LoadCompiledShip");
+
+    if (progressCallback)
+        progressCallback(0.1f, "Loading ship...");
+
+    std::vector<std::filesystem::path> sourceFilepaths = mResourceLoader->GetShipSourceFilepaths(filepath);
+    sourceFilepaths.push_back(mResourceLoader->GetMaterialsFilepath());
+
+    uint64_t const cacheKey = ShipCache::CalculateKey(sourceFilepaths);
+
+    std::optional<ShipCache::Entry> cacheEntry = mShipCache.TryLoad(cacheKey, mMaterials);
+    if (!cacheEntry)
+    {
+        auto shipDefinition = mResourceLoader->LoadShipDefinition(filepath);
+
+        if (progressCallback)
+            progressCallback(0.2f, "Loading ship...");
+
+        auto compiledShip = ShipBuilder::Compile(
+            shipDefinition,
+            mMaterials,
+            [&progressCallback](float progress, std::string const & message)
+            {
+                if (progressCallback)
+                    progressCallback(0.2f + 0.8f * progress, message);
+            });
+
+        mShipCache.Store(
+            cacheKey,
+            compiledShip,
+            shipDefinition.TextureImage,
+            shipDefinition.ShipName);
+
+        cacheEntry.emplace(
+            ShipCache::Entry{
+                std::move(compiledShip),
+                std::move(shipDefinition.TextureImage),
+                shipDefinition.ShipName });
+    }
+    else
+    {
+        LogMessage("Loaded compiled ship for \"", filepath.string(), "\"");
+    }
+
+    return std::move(*cacheEntry);
+}
+
+void GameController::StartShipLoad(
+    std::filesystem::path const & filepath,
+    Physics::World & targetWorld,
+    ProgressCallback progressCallback)
+{
+    assert(!IsLoadingShip());
+
+    mPendingShipLoadFilePath = filepath;
+
+    // Everything the worker needs is either copied, or guaranteed to outlive it
+    mPendingShipLoad = std::async(
+        std::launch::async,
+        [this,
+         &targetWorld,
+         shipId = targetWorld.GetNextShipId(),
+         currentStepSequenceNumber = targetWorld.GetCurrentStepSequenceNumber(),
+         gameParameters = mGameParameters,
+         filepath,
+         progressCallback = std::move(progressCallback)]() -> LoadedShip
+        {
+            Tracer::Instance.SetThreadName("Ship Loader");
+
+            return LoadShip(
+                filepath,
+                targetWorld,
+                shipId,
+                currentStepSequenceNumber,
+                gameParameters,
+                progressCallback);
+        });
+}
+
+void GameController::CompleteShipLoad()
+{
+    assert(IsLoadingShip());
+
+    // Take the new world now, so that it's discarded if the load failed
+    std::unique_ptr<Physics::World> newWorld = std::move(mPendingShipLoadWorld);
+
+    // Wait for the worker; this re-throws whatever the worker might have thrown
+    LoadedShip loadedShip = mPendingShipLoad.get();
+
+    // Swap the world, if the ship replaces it
+    if (!!newWorld)
+    {
+        Reset(std::move(newWorld));
+    }
+
+    AddShip(std::move(loadedShip));
+
+    mLastShipLoadedFilePath = mPendingShipLoadFilePath;
+}
+
+void GameController::CancelShipLoad()
+{
+    if (IsLoadingShip())
+    {
+        // Wait for the worker, and discard its result - whatever it is
+        try
+        {
+            mPendingShipLoad.get();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    mPendingShipLoadWorld.reset();
 }
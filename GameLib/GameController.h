@@ -8,18 +8,23 @@
 #include "GameEventDispatcher.h"
 #include "GameParameters.h"
 #include "GameTypes.h"
+#include "InputRecording.h"
 #include "MaterialDatabase.h"
 #include "Physics.h"
 #include "ProgressCallback.h"
 #include "RenderContext.h"
 #include "ResourceLoader.h"
+#include "ShipCache.h"
 #include "Vectors.h"
 
 #include <cassert>
 #include <chrono>
 #include <filesystem>
+#include <future>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 /*
  * This class is responsible for managing the game, from its lifetime to the user
@@ -45,6 +50,52 @@ public:
     void AddShip(std::filesystem::path const & filepath);
     void ReloadLastShip();
 
+    /*
+     * Loads a ship asynchronously: the ship is decoded and built on a worker thread, while
+     * the current world keeps being simulated; the ship is then swapped into the world - and
+     * uploaded to the render context - by the first Render() after the build has completed.
+     *
+     * The progress callback is invoked on the worker thread. Errors that occur while loading
+     * the ship are re-thrown by the Render() that would have completed the load.
+     *
+     * Only one ship may be loading at any given moment: resetting cancels the pending load,
+     * while adding waits for it to complete first.
+     */
+    void ResetAndLoadShipAsync(
+        std::filesystem::path const & filepath,
+        ProgressCallback progressCallback);
+
+    void AddShipAsync(
+        std::filesystem::path const & filepath,
+        ProgressCallback progressCallback);
+
+    bool IsLoadingShip() const
+    {
+        return mPendingShipLoad.valid();
+    }
+
+    /*
+     * Saves the current world to a snapshot file, and replaces the current world with the one
+     * in a snapshot file. Snapshots hold the whole state of the simulation, but not the ships'
+     * textures, which are re-loaded from the files that the ships were loaded from.
+     */
+    void SaveSnapshot(std::filesystem::path const & filepath) const;
+    void LoadSnapshot(std::filesystem::path const & filepath);
+
+    /*
+     * Records the interactions with the current world, together with the changes to the
+     * game parameters, so that they may be replayed headless. Recording stops - and the
+     * recording is saved - when explicitly stopped, or when the world changes by other
+     * means, e.g. when a ship is loaded.
+     */
+    void StartRecording(std::filesystem::path const & filepath);
+    void StopRecording();
+
+    bool IsRecording() const
+    {
+        return !!mInputRecorder;
+    }
+
     void DoStep();
     void Render();
 
@@ -173,6 +224,9 @@ public:
     bool GetShowShipStress() const { return mRenderContext->GetShowStressedSprings(); }
     void SetShowShipStress(bool value) { mRenderContext->SetShowStressedSprings(value); }
 
+    RenderStatistics const & GetLastFrameRenderStatistics() const { return mRenderContext->GetLastFrameStatistics(); }
+    void SetSynchronousRenderStatistics(bool value) { mRenderContext->SetSynchronousRenderStatistics(value); }
+
     vec2f ScreenToWorld(vec2f const & screenCoordinates) const
     {
         return mRenderContext->ScreenToWorld(screenCoordinates);
@@ -198,7 +252,14 @@ private:
         , mWorld(new Physics::World(
             mGameEventDispatcher,
             mGameParameters))
-        , mMaterials(std::move(materials))        
+        , mMaterials(std::move(materials))
+        , mShipCache(mResourceLoader->GetShipCacheDirectoryPath())
+        , mShipFilePaths()
+        , mPendingShipLoadWorld()
+        , mPendingShipLoadFilePath()
+        , mPendingShipLoad()
+        , mInputRecorder()
+        , mInputRecordingFilePath()
          // Smoothing
         , mCurrentZoom(mRenderContext->GetZoom())
         , mTargetZoom(mCurrentZoom)
@@ -217,9 +278,46 @@ private:
         float targetValue,
         std::chrono::steady_clock::time_point startingTime);
 
-    void Reset();
+    void Reset(std::unique_ptr<Physics::World> newWorld);
 
-    void AddShip(ShipDefinition shipDefinition);
+    struct LoadedShip
+    {
+        std::unique_ptr<Physics::Ship> Ship;
+        std::optional<ImageData> TextureImage;
+        std::string ShipName;
+        std::filesystem::path FilePath;
+    };
+
+    void AddShip(LoadedShip loadedShip);
+
+    /*
+     * Looks up the compiled ship, compiling the ship and storing it first if it's not there.
+     */
+    ShipCache::Entry LoadCompiledShip(
+        std::filesystem::path const & filepath,
+        ProgressCallback const & progressCallback) const;
+
+    /*
+     * Loads a ship from its compiled form - compiling it first if needed - and makes it for
+     * the specified world, without adding it to the world. Safe to invoke from a worker
+     * thread, as long as the world is not changed meanwhile.
+     */
+    LoadedShip LoadShip(
+        std::filesystem::path const & filepath,
+        Physics::World & targetWorld,
+        int shipId,
+        uint64_t currentStepSequenceNumber,
+        GameParameters const & gameParameters,
+        ProgressCallback const & progressCallback) const;
+
+    void StartShipLoad(
+        std::filesystem::path const & filepath,
+        Physics::World & targetWorld,
+        ProgressCallback progressCallback);
+
+    void CompleteShipLoad();
+
+    void CancelShipLoad();
 
 private:
 
@@ -244,7 +342,32 @@ private:
 
     std::unique_ptr<Physics::World> mWorld;
     MaterialDatabase mMaterials;
-        
+    ShipCache const mShipCache;
+
+    // The files that the ships of the current world were loaded from, by ship ID
+    std::vector<std::filesystem::path> mShipFilePaths;
+
+    //
+    // The ship being loaded asynchronously
+    //
+
+    // The world that the pending ship will replace the current world with;
+    // empty when the pending ship is to be added to the current world
+    std::unique_ptr<Physics::World> mPendingShipLoadWorld;
+
+    std::filesystem::path mPendingShipLoadFilePath;
+
+    // Declared after everything the worker uses - including the pending world -
+    // as destroying the future waits for the worker
+    std::future<LoadedShip> mPendingShipLoad;
+
+    //
+    // The recording in progress, if any
+    //
+
+    std::unique_ptr<InputRecorder> mInputRecorder;
+    std::filesystem::path mInputRecordingFilePath;
+
 
     //
     // The current render parameters that we're smoothing to
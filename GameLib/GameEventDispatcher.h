@@ -9,15 +9,34 @@
 #include "TupleKeys.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
 #include <vector>
 
-class GameEventDispatcher : public IGameEventHandler
+/*
+ * This class aggregates game events and publishes them to the registered sinks
+ * at each Flush().
+ *
+ * The events that are fired once per element - destroy, stress, and break - are
+ * appended to a fixed-capacity buffer of the firing thread, without any hashing;
+ * the buffers are merged into the aggregations when they fill up and at Flush(),
+ * which must not run concurrently with the threads firing events. All other events
+ * are to be fired by the thread that flushes.
+ */
+class GameEventDispatcher final : public IGameEventHandler
 {
 public:
 
     GameEventDispatcher()
-        : mDestroyEvents()
+        : mId(GenerateId())
+        , mEventBuffers()
+        , mEventBuffersMutex()
+        , mDestroyEvents()
         , mPinToggledEvents()
         , mStressEvents()
         , mBreakEvents()
@@ -56,7 +75,7 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mDestroyEvents[std::make_tuple(material, isUnderwater)] += size;
+        GetThreadEventBuffer().Append(MaterialEventType::Destroy, material, isUnderwater, size, *this);
     }
 
     virtual void OnSaw(std::optional<bool> isUnderwater) override
@@ -98,7 +117,7 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mStressEvents[std::make_tuple(material, isUnderwater)] += size;
+        GetThreadEventBuffer().Append(MaterialEventType::Stress, material, isUnderwater, size, *this);
     }
 
     virtual void OnBreak(
@@ -106,7 +125,7 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mBreakEvents[std::make_tuple(material, isUnderwater)] += size;
+        GetThreadEventBuffer().Append(MaterialEventType::Break, material, isUnderwater, size, *this);
     }
 
     virtual void OnSinkingBegin(unsigned int shipId) override
@@ -192,6 +211,16 @@ public:
      */
     void Flush()
     {
+        // Merge the events of all threads
+        {
+            std::lock_guard<std::mutex> lock(mEventBuffersMutex);
+
+            for (auto const & eventBuffer : mEventBuffers)
+            {
+                MergeEventBuffer(*eventBuffer);
+            }
+        }
+
         // Publish aggregations
         for (IGameEventHandler * sink : mSinks)
         {
@@ -254,6 +283,172 @@ public:
 
 private:
 
+    enum class MaterialEventType : uint8_t
+    {
+        Destroy,
+        Stress,
+        Break
+    };
+
+    /*
+     * The events of one thread that have not been aggregated yet.
+     */
+    class EventBuffer
+    {
+    public:
+
+        struct Entry
+        {
+            Material const * Mtl;
+            unsigned int Size;
+            MaterialEventType Type;
+            bool IsUnderwater;
+        };
+
+        // Plenty for a step; mass breakups mostly hit the same few materials,
+        // which are coalesced anyway
+        static constexpr size_t Capacity = 1024;
+
+        explicit EventBuffer(std::thread::id threadId)
+            : mThreadId(threadId)
+            , mEntries()
+            , mSize(0)
+        {
+        }
+
+        inline std::thread::id GetThreadId() const
+        {
+            return mThreadId;
+        }
+
+        inline void Append(
+            MaterialEventType type,
+            Material const * material,
+            bool isUnderwater,
+            unsigned int size,
+            GameEventDispatcher & dispatcher)
+        {
+            // Coalesce with the previous event, if it's the same
+            if (mSize > 0)
+            {
+                Entry & lastEntry = mEntries[mSize - 1];
+                if (lastEntry.Mtl == material
+                    && lastEntry.Type == type
+                    && lastEntry.IsUnderwater == isUnderwater)
+                {
+                    lastEntry.Size += size;
+                    return;
+                }
+            }
+
+            if (mSize == Capacity)
+            {
+                std::lock_guard<std::mutex> lock(dispatcher.mEventBuffersMutex);
+
+                dispatcher.MergeEventBuffer(*this);
+            }
+
+            mEntries[mSize++] = Entry{ material, size, type, isUnderwater };
+        }
+
+        inline Entry const * begin() const
+        {
+            return mEntries.data();
+        }
+
+        inline Entry const * end() const
+        {
+            return mEntries.data() + mSize;
+        }
+
+        inline void clear()
+        {
+            mSize = 0;
+        }
+
+    private:
+
+        std::thread::id const mThreadId;
+        std::array<Entry, Capacity> mEntries;
+        size_t mSize;
+    };
+
+    EventBuffer & GetThreadEventBuffer()
+    {
+        // Each thread remembers the last buffer it used, which is the only
+        // one it ever uses unless there are multiple dispatchers around
+        thread_local uint64_t lastDispatcherId = 0;
+        thread_local EventBuffer * lastEventBuffer = nullptr;
+
+        if (lastDispatcherId != mId)
+        {
+            std::lock_guard<std::mutex> lock(mEventBuffersMutex);
+
+            auto const threadId = std::this_thread::get_id();
+
+            auto it = std::find_if(
+                mEventBuffers.begin(),
+                mEventBuffers.end(),
+                [threadId](auto const & eventBuffer)
+                {
+                    return eventBuffer->GetThreadId() == threadId;
+                });
+
+            if (it == mEventBuffers.end())
+            {
+                mEventBuffers.emplace_back(new EventBuffer(threadId));
+                it = std::prev(mEventBuffers.end());
+            }
+
+            lastDispatcherId = mId;
+            lastEventBuffer = it->get();
+        }
+
+        return *lastEventBuffer;
+    }
+
+    /*
+     * Moves the events of the buffer into the aggregations; invoked under the lock.
+     */
+    void MergeEventBuffer(EventBuffer & eventBuffer)
+    {
+        for (auto const & entry : eventBuffer)
+        {
+            switch (entry.Type)
+            {
+                case MaterialEventType::Destroy:
+                    mDestroyEvents[std::make_tuple(entry.Mtl, entry.IsUnderwater)] += entry.Size;
+                    break;
+
+                case MaterialEventType::Stress:
+                    mStressEvents[std::make_tuple(entry.Mtl, entry.IsUnderwater)] += entry.Size;
+                    break;
+
+                case MaterialEventType::Break:
+                    mBreakEvents[std::make_tuple(entry.Mtl, entry.IsUnderwater)] += entry.Size;
+                    break;
+            }
+        }
+
+        eventBuffer.clear();
+    }
+
+    static uint64_t GenerateId()
+    {
+        // Starts from 1, as 0 means "no dispatcher" to the threads' caches
+        static std::atomic<uint64_t> nextId(1u);
+        return nextId.fetch_add(1u);
+    }
+
+private:
+
+    // Our ID, to tell us apart from other dispatchers that might have lived at the same address
+    uint64_t const mId;
+
+    // The buffers of all the threads that have fired events
+    std::vector<std::unique_ptr<EventBuffer>> mEventBuffers;
+    std::mutex mEventBuffersMutex;
+
     // The current events being aggregated
     unordered_tuple_map<std::tuple<Material const *, bool>, unsigned int> mDestroyEvents;
     unordered_tuple_set<std::tuple<bool, bool>> mPinToggledEvents;
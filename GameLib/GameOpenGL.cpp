@@ -69,100 +69,201 @@ GLint GameOpenGL::GetParameterLocation(
 
 void GameOpenGL::UploadMipmappedTexture(ImageData baseTexture)
 {
-    //
-    // Upload base image
-    //
+    UploadTexture(
+        DecodedTexture::FromImage(
+            std::move(baseTexture),
+            true));
+}
 
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, baseTexture.Size.Width, baseTexture.Size.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, baseTexture.Data.get());
-    GLenum glError = glGetError();
-    if (GL_NO_ERROR != glError)
+void GameOpenGL::UploadTexture(DecodedTexture const & texture)
+{
+    for (size_t level = 0; level < texture.GetLevelCount(); ++level)
     {
-        throw GameException("Error uploading ship texture onto GPU: " + std::to_string(glError));
-    }
+        ImageSize const levelSize = texture.GetLevelSize(level);
 
+        glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), GL_RGBA, levelSize.Width, levelSize.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, texture.GetLevelData(level));
+        GLenum glError = glGetError();
+        if (GL_NO_ERROR != glError)
+        {
+            throw GameException("Error uploading level " + std::to_string(level) + " of texture onto GPU: " + std::to_string(glError));
+        }
+    }
+}
 
-    //
-    // Create minified textures
-    //
+//////////////////////////////////////////////////////////////////////////////////
 
-    ImageSize readImageSize(baseTexture.Size);
+GameOpenGLStreamingVBO::GameOpenGLStreamingVBO()
+    : mIsPersistentlyMapped(IsPersistentMappingSupported())
+    , mVBO()
+    , mSegmentSize(0)
+    , mCurrentSegment(0)
+    , mCurrentSize(0)
+    , mMappedMemory(nullptr)
+    , mSegmentFences()
+    , mStagingMemory()
+{
+    for (size_t s = 0; s < SegmentCount; ++s)
+    {
+        mSegmentFences[s] = nullptr;
+    }
+}
 
-    std::unique_ptr<unsigned char const []> readBuffer(std::move(baseTexture.Data));
-    std::unique_ptr<unsigned char []> writeBuffer;
-    
-    for (GLint textureLevel = 1; ; ++textureLevel)
+GameOpenGLStreamingVBO::~GameOpenGLStreamingVBO()
+{
+    for (size_t s = 0; s < SegmentCount; ++s)
     {
-        if (readImageSize.Width == 1 && readImageSize.Height == 1)
+        if (nullptr != mSegmentFences[s])
         {
-            // We're done!
-            break;
+            glDeleteSync(mSegmentFences[s]);
         }
+    }
+
+    if (nullptr != mMappedMemory)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, *mVBO);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0u);
+    }
+}
 
-        // Calculate dimensions of new write buffer
-        int width = std::max(1, readImageSize.Width / 2);
-        int height = std::max(1, readImageSize.Height / 2);
+bool GameOpenGLStreamingVBO::IsPersistentMappingSupported()
+{
+    return GLAD_GL_ARB_buffer_storage
+        && GLAD_GL_ARB_map_buffer_range
+        && GLAD_GL_ARB_sync;
+}
 
-        // Allocate new write buffer
-        writeBuffer.reset(new unsigned char[width * height * 4]);
+void * GameOpenGLStreamingVBO::Map(size_t size)
+{
+    if (size > mSegmentSize)
+    {
+        // Grow, leaving room for a few more bytes to avoid re-allocating at each frame
+        Allocate(std::max(size + size / 8, static_cast<size_t>(256)));
+    }
+    else
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, *mVBO);
+    }
 
-        // Create new buffer
-        unsigned char const * rp = readBuffer.get();
-        unsigned char * wp = writeBuffer.get();
-        for (int h = 0; h < height; ++h)
-        {
-            for (int w = 0; w < width; ++w)
-            {
-                //
-                // Apply box filter
-                //
+    mCurrentSize = size;
 
-                int wIndex = ((h * width) + w) * 4;
+    if (mIsPersistentlyMapped)
+    {
+        mCurrentSegment = (mCurrentSegment + 1) % SegmentCount;
 
-                int rIndex = (((h * 2) * readImageSize.Width) + (w * 2)) * 4;
-                int rIndexNextLine = ((((h * 2) + 1) * readImageSize.Width) + (w * 2)) * 4;
+        WaitForSegment(mCurrentSegment);
 
-                for (int comp = 0; comp < 4; ++comp)
-                {
-                    int sum = 0;
-                    int count = 0;
+        return mMappedMemory + mCurrentSegment * mSegmentSize;
+    }
+    else
+    {
+        return mStagingMemory.get();
+    }
+}
 
-                    sum += static_cast<int>(rp[rIndex + comp]);
-                    ++count;
+size_t GameOpenGLStreamingVBO::Unmap()
+{
+    if (mIsPersistentlyMapped)
+    {
+        // The mapping is coherent, nothing to do
+        return mCurrentSegment * mSegmentSize;
+    }
+    else
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, mCurrentSize, mStagingMemory.get());
 
-                    if (readImageSize.Width > 1)
-                    {
-                        sum += static_cast<int>(rp[rIndex + 4 + comp]);
-                        ++count;
-                    }
+        return 0;
+    }
+}
 
-                    if (readImageSize.Height > 1)
-                    {
-                        sum += static_cast<int>(rp[rIndexNextLine + comp]);
-                        ++count;
+void GameOpenGLStreamingVBO::Fence()
+{
+    if (mIsPersistentlyMapped)
+    {
+        if (nullptr != mSegmentFences[mCurrentSegment])
+        {
+            // Drawn more than once
+            glDeleteSync(mSegmentFences[mCurrentSegment]);
+        }
 
-                        if (readImageSize.Width > 1)
-                        {
-                            sum += static_cast<int>(rp[rIndexNextLine + 4 + comp]);
-                            ++count;
-                        }
-                    }
+        mSegmentFences[mCurrentSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
 
+void GameOpenGLStreamingVBO::Allocate(size_t segmentSize)
+{
+    // Keep segments aligned
+    segmentSize = (segmentSize + 255) & ~static_cast<size_t>(255);
 
-                    wp[wIndex + comp] = static_cast<unsigned char>(sum / count);
-                }                                   
+    if (mIsPersistentlyMapped)
+    {
+        // Storage is immutable, hence we need a new VBO; GL takes care of
+        // keeping the old one alive until the draw calls using it are done
+        for (size_t s = 0; s < SegmentCount; ++s)
+        {
+            if (nullptr != mSegmentFences[s])
+            {
+                glDeleteSync(mSegmentFences[s]);
+                mSegmentFences[s] = nullptr;
             }
-        }        
+        }
 
-        // Upload write buffer
-        glTexImage2D(GL_TEXTURE_2D, textureLevel, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, writeBuffer.get());
-        glError = glGetError();
-        if (GL_NO_ERROR != glError)
+        if (nullptr != mMappedMemory)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, *mVBO);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            mMappedMemory = nullptr;
+        }
+
+        GLuint vbo;
+        glGenBuffers(1, &vbo);
+        mVBO = vbo;
+
+        glBindBuffer(GL_ARRAY_BUFFER, *mVBO);
+
+        GLbitfield const flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, segmentSize * SegmentCount, nullptr, flags);
+        mMappedMemory = reinterpret_cast<char *>(glMapBufferRange(GL_ARRAY_BUFFER, 0, segmentSize * SegmentCount, flags));
+        if (nullptr == mMappedMemory)
         {
-            throw GameException("Error uploading minified ship texture onto GPU: " + std::to_string(glError));
+            throw GameException("Cannot map streaming VBO; OpenGL error: " + std::to_string(glGetError()));
         }
+    }
+    else
+    {
+        if (!mVBO)
+        {
+            GLuint vbo;
+            glGenBuffers(1, &vbo);
+            mVBO = vbo;
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, *mVBO);
+        glBufferData(GL_ARRAY_BUFFER, segmentSize, nullptr, GL_STREAM_DRAW);
+
+        mStagingMemory.reset(new char[segmentSize]);
+    }
 
-        // Swap buffer
-        readImageSize = ImageSize(width, height);
-        readBuffer = std::move(writeBuffer);
+    mSegmentSize = segmentSize;
+}
+
+void GameOpenGLStreamingVBO::WaitForSegment(size_t segment)
+{
+    GLsync const fence = mSegmentFences[segment];
+    if (nullptr == fence)
+        return;
+
+    while (true)
+    {
+        GLenum const result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+        if (result == GL_ALREADY_SIGNALED
+            || result == GL_CONDITION_SATISFIED
+            || result == GL_WAIT_FAILED)
+        {
+            break;
+        }
     }
+
+    glDeleteSync(fence);
+    mSegmentFences[segment] = nullptr;
 }
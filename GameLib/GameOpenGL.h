@@ -5,6 +5,7 @@
 ***************************************************************************************/
 #pragma once
 
+#include "DecodedTexture.h"
 #include "ImageData.h"
 
 #ifdef WIN32
@@ -16,6 +17,7 @@
 #include <glad/glad.h>
 
 #include <cstdio>
+#include <memory>
 #include <stdexcept>
 #include <string>
 
@@ -111,6 +113,78 @@ using GameOpenGLShaderProgram = GameOpenGLObject<GLuint, GameOpenGLProgramDelete
 using GameOpenGLVBO = GameOpenGLObject<GLuint, GameOpenGLVBODeleter>;
 using GameOpenGLTexture = GameOpenGLObject<GLuint, GameOpenGLTextureDeleter>;
 
+/*
+ * A VBO whose contents are re-written at each frame.
+ *
+ * When the driver supports it (ARB_buffer_storage, ARB_map_buffer_range, and ARB_sync), the
+ * storage is allocated once for SegmentCount frames and stays mapped; each frame writes
+ * into the next segment, after waiting for the fence of the draw calls that last read it.
+ * Otherwise, the contents are written into a staging area and uploaded with glBufferSubData,
+ * and storage is only reallocated when it needs to grow.
+ *
+ * Usage, at each frame: Map(), write, Unmap() (and set attribute pointers at the returned
+ * offset), draw, Fence().
+ */
+class GameOpenGLStreamingVBO
+{
+public:
+
+    GameOpenGLStreamingVBO();
+
+    ~GameOpenGLStreamingVBO();
+
+    GameOpenGLStreamingVBO(GameOpenGLStreamingVBO const & other) = delete;
+    GameOpenGLStreamingVBO & operator=(GameOpenGLStreamingVBO const & other) = delete;
+
+    static bool IsPersistentMappingSupported();
+
+    bool IsPersistentlyMapped() const
+    {
+        return mIsPersistentlyMapped;
+    }
+
+    /*
+     * Binds the VBO to GL_ARRAY_BUFFER, and returns the memory where the frame's data
+     * is to be written.
+     */
+    void * Map(size_t size);
+
+    /*
+     * Makes the frame's data available to GL, and returns the offset of the frame's data
+     * in the VBO. Leaves the VBO bound.
+     */
+    size_t Unmap();
+
+    /*
+     * Invoked after the draw calls that read the frame's data have been issued.
+     */
+    void Fence();
+
+private:
+
+    void Allocate(size_t segmentSize);
+
+    void WaitForSegment(size_t segment);
+
+private:
+
+    static constexpr size_t SegmentCount = 3;
+
+    bool const mIsPersistentlyMapped;
+
+    GameOpenGLVBO mVBO;
+    size_t mSegmentSize;
+    size_t mCurrentSegment;
+    size_t mCurrentSize;
+
+    // When persistently mapped
+    char * mMappedMemory;
+    GLsync mSegmentFences[SegmentCount];
+
+    // When not persistently mapped
+    std::unique_ptr<char[]> mStagingMemory;
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////
 // GameOpenGL
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -160,4 +234,9 @@ public:
         std::string const & parameterName);
 
     static void UploadMipmappedTexture(ImageData baseTexture);
+
+    /*
+     * Uploads all the levels of the texture to the currently-bound texture.
+     */
+    static void UploadTexture(DecodedTexture const & texture);
 };
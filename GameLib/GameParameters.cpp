@@ -26,5 +26,6 @@ GameParameters::GameParameters()
     , NumberOfClouds(50)
     , WindSpeed(3.0f)
     , IsUltraViolentMode(false)
+    , UseWallClockForBombs(false)
 {
 }
@@ -87,6 +87,7 @@ struct GameParameters
 
     static constexpr float BombNeighborhoodRadius = 3.5f;
 
+    // The time from placing a timer bomb to its explosion
     std::chrono::seconds TimerBombInterval;
 
     float BombMass;
@@ -101,6 +102,10 @@ struct GameParameters
 
     bool IsUltraViolentMode;
 
+    // Bombs are timed by the simulation time, unless this is set, in which case they're
+    // timed by the game wall clock; only looked at when a world is created
+    bool UseWallClockForBombs;
+
 
     //
     // Limits
@@ -5,28 +5,143 @@
 ***************************************************************************************/
 #pragma once
 
+#include "Snapshot.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
 #include <random>
+
+/*
+ * The xoshiro256** generator (see http://xoshiro.di.unimi.it/): much faster than the
+ * standard engines, with a state of only 32 bytes.
+ *
+ * Satisfies the UniformRandomBitGenerator requirements, hence it may be used with the
+ * standard distributions.
+ */
+class Xoshiro256StarStar
+{
+public:
+
+    using result_type = uint64_t;
+
+    static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /*
+     * Makes the state out of the seed and of the ID of the stream, so that different streams
+     * of the same seed are - for all practical purposes - independent from each other.
+     */
+    Xoshiro256StarStar(
+        uint64_t seed,
+        uint64_t streamId)
+    {
+        // As recommended by the authors, the state is filled in with SplitMix64
+        uint64_t splitMixState = seed ^ SplitMix64(streamId);
+        for (auto & s : mState)
+        {
+            s = SplitMix64(splitMixState);
+            splitMixState += 0x9e3779b97f4a7c15ull;
+        }
+    }
+
+    inline result_type operator()()
+    {
+        uint64_t const result = RotateLeft(mState[1] * 5, 7) * 9;
+
+        uint64_t const t = mState[1] << 17;
+
+        mState[2] ^= mState[0];
+        mState[3] ^= mState[1];
+        mState[1] ^= mState[2];
+        mState[0] ^= mState[3];
+
+        mState[2] ^= t;
+
+        mState[3] = RotateLeft(mState[3], 45);
+
+        return result;
+    }
+
+    void WriteSnapshot(SnapshotWriter & writer) const
+    {
+        writer.Write(mState);
+    }
+
+    void ReadSnapshot(SnapshotReader & reader)
+    {
+        mState = reader.Read<std::array<uint64_t, 4u>>();
+    }
+
+private:
+
+    static inline uint64_t RotateLeft(
+        uint64_t x,
+        int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    static inline uint64_t SplitMix64(uint64_t x)
+    {
+        x += 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    std::array<uint64_t, 4u> mState;
+};
+
 /*
- * The random engine for the entire game.
+ * A random engine of the game.
  *
  * Not so random - always uses the same seed. On purpose! We want two instances
  * of the game to be identical to each other.
  *
- * Singleton.
+ * Each engine draws from its own stream of the seed, and engines are not thread-safe:
+ * - Each world has its own engine, for everything that happens in the world (e.g. clouds);
+ * - GetInstance() returns the engine of the main thread, for everything else (e.g. sounds);
+ * - GetThreadInstance() returns the engine of the calling thread, for worker threads.
  */
 class GameRandomEngine
 {
 public:
 
+    static constexpr uint64_t Seed = 19730528u;
+
+    // The IDs of the streams
+    static constexpr uint64_t MainStreamId = 0u;
+    static constexpr uint64_t WorldStreamId = 1u;
+    static constexpr uint64_t FirstThreadStreamId = 2u;
+
 public:
 
+    explicit GameRandomEngine(uint64_t streamId)
+        : mRandomEngine(Seed, streamId)
+    {
+    }
+
     static GameRandomEngine & GetInstance()
     {
-        static GameRandomEngine * instance = new GameRandomEngine();
-        
+        static GameRandomEngine * instance = new GameRandomEngine(MainStreamId);
+
         return *instance;
     }
 
+    /*
+     * Threads get their streams in the order in which they first ask for them.
+     */
+    static GameRandomEngine & GetThreadInstance()
+    {
+        static std::atomic<uint64_t> nextThreadStreamId(FirstThreadStreamId);
+
+        thread_local GameRandomEngine instance(nextThreadStreamId.fetch_add(1u));
+
+        return instance;
+    }
+
     template <typename T>
     inline T Choose(T count)
     {
@@ -80,20 +195,26 @@ public:
         return dis(mRandomEngine);
     }
 
+    /*
+     * Returns a real uniformly distributed in [0.0, 1.0).
+     */
     inline float GenerateRandomNormalReal()
-    {        
-        return mRandomNormalDistribution(mRandomEngine);
+    {
+        // The top 24 bits make for all the floats in the range with the same spacing
+        return static_cast<float>(mRandomEngine() >> 40) * (1.0f / 16777216.0f);
     }
 
-private:
+    void WriteSnapshot(SnapshotWriter & writer) const
+    {
+        mRandomEngine.WriteSnapshot(writer);
+    }
 
-    GameRandomEngine()
+    void ReadSnapshot(SnapshotReader & reader)
     {
-        std::seed_seq seed_seq({ 1, 242, 19730528 });
-        mRandomEngine = std::ranlux48_base(seed_seq);
-        mRandomNormalDistribution = std::uniform_real_distribution<float>(0.0f, 1.0f);
+        mRandomEngine.ReadSnapshot(reader);
     }
 
-    std::ranlux48_base mRandomEngine;
-    std::uniform_real_distribution<float> mRandomNormalDistribution;
+private:
+
+    Xoshiro256StarStar mRandomEngine;
 };
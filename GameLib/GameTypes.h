@@ -5,6 +5,7 @@
 ***************************************************************************************/
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <limits>
 
@@ -46,6 +47,32 @@ enum class ShipRenderMode
     Texture
 };
 
+/*
+ * A height profile made of the sum of three sine waves, i.e.:
+ *
+ *     height(x) = Offset + sum(Amplitudes[i] * sin(x * Frequencies[i] + Phases[i]))
+ */
+struct SineWavesProfile
+{
+    std::array<float, 3u> Amplitudes;
+    std::array<float, 3u> Frequencies;
+    std::array<float, 3u> Phases;
+    float Offset;
+
+    bool operator==(SineWavesProfile const & other) const
+    {
+        return Amplitudes == other.Amplitudes
+            && Frequencies == other.Frequencies
+            && Phases == other.Phases
+            && Offset == other.Offset;
+    }
+
+    bool operator!=(SineWavesProfile const & other) const
+    {
+        return !(*this == other);
+    }
+};
+
 /*
  * Types of bombs (duh).
  */
@@ -0,0 +1,57 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-16
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <memory>
+
+/*
+ * One channel of an audio device, playing one sound buffer at a time.
+ *
+ * Volumes are in the [0, 100] range.
+ */
+template<typename TSoundBuffer>
+class IAudioVoice
+{
+public:
+
+    virtual ~IAudioVoice()
+    {
+    }
+
+    virtual void Play(
+        TSoundBuffer const & soundBuffer,
+        float volume) = 0;
+
+    virtual void Stop() = 0;
+
+    virtual void Pause() = 0;
+
+    virtual void Resume() = 0;
+
+    /*
+     * Whether the voice has finished playing its sound, or has been stopped.
+     */
+    virtual bool IsStopped() const = 0;
+
+    virtual float GetVolume() const = 0;
+
+    virtual void SetVolume(float volume) = 0;
+};
+
+/*
+ * The audio device that sounds are played through.
+ */
+template<typename TSoundBuffer>
+class IAudioDevice
+{
+public:
+
+    virtual ~IAudioDevice()
+    {
+    }
+
+    virtual std::unique_ptr<IAudioVoice<TSoundBuffer>> MakeVoice() = 0;
+};
@@ -0,0 +1,211 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-14
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "AABB.h"
+#include "GameTypes.h"
+#include "RotatedTextureRenderInfo.h"
+#include "SysSpecifics.h"
+#include "Vectors.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/*
+ * This interface defines the methods that the world uses to render itself.
+ *
+ * RenderContext implements it with OpenGL; NullRenderBackend and RecordingRenderBackend
+ * implement it without, so that the preparation of a frame may run - and be measured -
+ * without a display.
+ */
+class IRenderBackend
+{
+public:
+
+    virtual ~IRenderBackend()
+    {
+    }
+
+    virtual bool GetShowShipThroughWater() const = 0;
+
+    virtual bool GetShowStressedSprings() const = 0;
+
+    virtual void RenderStart() = 0;
+
+    //
+    // Clouds
+    //
+
+    virtual void RenderCloudsStart(size_t clouds) = 0;
+
+    virtual void RenderCloud(
+        float virtualX,
+        float virtualY,
+        float scale) = 0;
+
+    virtual void RenderCloudsEnd() = 0;
+
+    //
+    // Land and Water
+    //
+
+    virtual void UploadLandAndWater(
+        SineWavesProfile const & landProfile,
+        SineWavesProfile const & waterProfile,
+        float restWaterHeight) = 0;
+
+    virtual void RenderLand() = 0;
+
+    virtual void RenderWater() = 0;
+
+    //
+    // Ship points
+    //
+
+    virtual void UploadShipPointImmutableGraphicalAttributes(
+        int shipId,
+        size_t count,
+        vec3f const * restrict color,
+        vec2f const * restrict textureCoordinates) = 0;
+
+    virtual void UploadShipPoints(
+        int shipId,
+        size_t count,
+        vec2f const * restrict position,
+        float const * restrict light,
+        float const * restrict water,
+        float const * restrict stress) = 0;
+
+    //
+    // Ship elements (points, springs, ropes, and triangles)
+    //
+
+    virtual void UploadShipElementsStart(
+        int shipId,
+        std::vector<std::size_t> const & connectedComponentsMaxSizes) = 0;
+
+    virtual void UpdateShipElementsStart(
+        int shipId,
+        std::vector<std::size_t> const & connectedComponentsMaxSizes,
+        std::vector<ConnectedComponentId> const & changedConnectedComponentIds) = 0;
+
+    virtual void UploadShipElementPoint(
+        int shipId,
+        int shipPointIndex,
+        ConnectedComponentId connectedComponentId) = 0;
+
+    virtual void UploadShipElementSpring(
+        int shipId,
+        ElementIndex shipSpringIndex,
+        int shipPointIndex1,
+        int shipPointIndex2,
+        bool isCoarse,
+        ConnectedComponentId connectedComponentId) = 0;
+
+    virtual void UploadShipElementRope(
+        int shipId,
+        ElementIndex shipSpringIndex,
+        int shipPointIndex1,
+        int shipPointIndex2,
+        ConnectedComponentId connectedComponentId) = 0;
+
+    virtual void UploadShipElementTriangle(
+        int shipId,
+        ElementIndex shipTriangleIndex,
+        int shipPointIndex1,
+        int shipPointIndex2,
+        int shipPointIndex3,
+        ConnectedComponentId connectedComponentId) = 0;
+
+    virtual void UploadShipElementCoarseTriangle(
+        int shipId,
+        ElementIndex shipCoarseTriangleIndex,
+        int shipPointIndex1,
+        int shipPointIndex2,
+        int shipPointIndex3,
+        ConnectedComponentId connectedComponentId) = 0;
+
+    virtual void InsertShipElementCoarseTriangle(
+        int shipId,
+        ElementIndex shipCoarseTriangleIndex,
+        int shipPointIndex1,
+        int shipPointIndex2,
+        int shipPointIndex3,
+        ConnectedComponentId connectedComponentId) = 0;
+
+    virtual void RemoveShipElementPoint(
+        int shipId,
+        int shipPointIndex) = 0;
+
+    virtual void RemoveShipElementSpring(
+        int shipId,
+        ElementIndex shipSpringIndex) = 0;
+
+    virtual void RemoveShipElementRope(
+        int shipId,
+        ElementIndex shipSpringIndex) = 0;
+
+    virtual void RemoveShipElementTriangle(
+        int shipId,
+        ElementIndex shipTriangleIndex) = 0;
+
+    virtual void RemoveShipElementCoarseTriangle(
+        int shipId,
+        ElementIndex shipCoarseTriangleIndex) = 0;
+
+    virtual void UploadShipElementsEnd(int shipId) = 0;
+
+    //
+    // Ship pinned points and bombs
+    //
+
+    virtual void UploadShipElementPinnedPointsStart(
+        int shipId,
+        size_t count) = 0;
+
+    virtual void UploadShipElementPinnedPoint(
+        int shipId,
+        float x,
+        float y,
+        ConnectedComponentId connectedComponentId) = 0;
+
+    virtual void UploadShipElementPinnedPointsEnd(int shipId) = 0;
+
+    virtual void UploadShipElementBombsStart(
+        int shipId,
+        size_t count) = 0;
+
+    virtual void UploadShipElementBomb(
+        int shipId,
+        BombType bombType,
+        RotatedTextureRenderInfo const & renderInfo,
+        std::optional<uint32_t> lightedFrameIndex,
+        std::optional<uint32_t> unlightedFrameIndex,
+        ConnectedComponentId connectedComponentId) = 0;
+
+    virtual void UploadShipElementBombsEnd(int shipId) = 0;
+
+    //
+    // Ship rendering
+    //
+
+    /*
+     * Whether nothing of a ship with the specified bounding box may be visible.
+     */
+    virtual bool IsShipCulled(Geometry::AABB const & shipAABB) const = 0;
+
+    virtual void RenderShip(
+        int shipId,
+        std::vector<Geometry::AABB> const & connectedComponentAABBs) = 0;
+
+    //
+    // Final
+    //
+
+    virtual void RenderEnd() = 0;
+};
@@ -0,0 +1,208 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-02
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/*
+ * This class is a max-priority queue over a fixed domain of indices [0, maxIndex).
+ *
+ * Each index may appear at most once in the queue, and its priority may be changed
+ * in O(log N) while it's in the queue - which is what makes this different from
+ * std::priority_queue.
+ *
+ * Ties are broken in favor of the smaller index, so that the order in which elements
+ * are popped is deterministic.
+ */
+template<typename TPriority>
+class IndexedPriorityQueue
+{
+public:
+
+    explicit IndexedPriorityQueue(size_t maxIndex)
+        : mHeap()
+        , mHeapPositions(maxIndex, NoneHeapPosition)
+        , mPriorities(maxIndex)
+    {
+        mHeap.reserve(maxIndex);
+    }
+
+    // Make sure we don't introduce unnecessary copies inadvertently
+    IndexedPriorityQueue(IndexedPriorityQueue const & other) = delete;
+    IndexedPriorityQueue & operator=(IndexedPriorityQueue const & other) = delete;
+
+    //
+    // Visitors
+    //
+
+    inline size_t size() const noexcept
+    {
+        return mHeap.size();
+    }
+
+    inline bool empty() const noexcept
+    {
+        return mHeap.empty();
+    }
+
+    inline bool contains(size_t index) const noexcept
+    {
+        assert(index < mHeapPositions.size());
+        return mHeapPositions[index] != NoneHeapPosition;
+    }
+
+    inline TPriority priority(size_t index) const noexcept
+    {
+        assert(contains(index));
+        return mPriorities[index];
+    }
+
+    /*
+     * Returns the index with the highest priority.
+     */
+    inline size_t top() const noexcept
+    {
+        assert(!mHeap.empty());
+        return mHeap[0];
+    }
+
+    //
+    // Modifiers
+    //
+
+    void push(
+        size_t index,
+        TPriority priority)
+    {
+        assert(!contains(index));
+
+        mPriorities[index] = priority;
+        mHeapPositions[index] = mHeap.size();
+        mHeap.push_back(index);
+
+        SiftUp(mHeap.size() - 1);
+    }
+
+    void update(
+        size_t index,
+        TPriority priority)
+    {
+        assert(contains(index));
+
+        TPriority const oldPriority = mPriorities[index];
+        mPriorities[index] = priority;
+
+        if (priority > oldPriority)
+            SiftUp(mHeapPositions[index]);
+        else if (priority < oldPriority)
+            SiftDown(mHeapPositions[index]);
+    }
+
+    void pop()
+    {
+        assert(!mHeap.empty());
+
+        erase(mHeap[0]);
+    }
+
+    void erase(size_t index)
+    {
+        assert(contains(index));
+
+        size_t const heapPosition = mHeapPositions[index];
+        size_t const lastHeapPosition = mHeap.size() - 1;
+
+        if (heapPosition != lastHeapPosition)
+        {
+            Swap(heapPosition, lastHeapPosition);
+        }
+
+        mHeap.pop_back();
+        mHeapPositions[index] = NoneHeapPosition;
+
+        if (heapPosition < mHeap.size())
+        {
+            // The element that took our place may have to go either way
+            SiftUp(heapPosition);
+            SiftDown(heapPosition);
+        }
+    }
+
+private:
+
+    inline bool IsHigher(
+        size_t heapPositionA,
+        size_t heapPositionB) const noexcept
+    {
+        size_t const indexA = mHeap[heapPositionA];
+        size_t const indexB = mHeap[heapPositionB];
+
+        return mPriorities[indexA] > mPriorities[indexB]
+            || (mPriorities[indexA] == mPriorities[indexB] && indexA < indexB);
+    }
+
+    inline void Swap(
+        size_t heapPositionA,
+        size_t heapPositionB) noexcept
+    {
+        std::swap(mHeap[heapPositionA], mHeap[heapPositionB]);
+
+        mHeapPositions[mHeap[heapPositionA]] = heapPositionA;
+        mHeapPositions[mHeap[heapPositionB]] = heapPositionB;
+    }
+
+    void SiftUp(size_t heapPosition) noexcept
+    {
+        while (heapPosition > 0)
+        {
+            size_t const parent = (heapPosition - 1) / 2;
+            if (!IsHigher(heapPosition, parent))
+                break;
+
+            Swap(heapPosition, parent);
+            heapPosition = parent;
+        }
+    }
+
+    void SiftDown(size_t heapPosition) noexcept
+    {
+        for (;;)
+        {
+            size_t highest = heapPosition;
+
+            size_t const left = 2 * heapPosition + 1;
+            if (left < mHeap.size() && IsHigher(left, highest))
+                highest = left;
+
+            size_t const right = left + 1;
+            if (right < mHeap.size() && IsHigher(right, highest))
+                highest = right;
+
+            if (highest == heapPosition)
+                break;
+
+            Swap(heapPosition, highest);
+            heapPosition = highest;
+        }
+    }
+
+private:
+
+    static constexpr size_t NoneHeapPosition = std::numeric_limits<size_t>::max();
+
+    // The heap, storing indices
+    std::vector<size_t> mHeap;
+
+    // The position in the heap of each index; NoneHeapPosition if not in the heap
+    std::vector<size_t> mHeapPositions;
+
+    // The current priority of each index
+    std::vector<TPriority> mPriorities;
+};
@@ -0,0 +1,408 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-08
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "InputRecording.h"
+
+#include "GameException.h"
+
+#include <array>
+#include <cassert>
+
+namespace /* anonymous */ {
+
+    // Bump whenever the layout of recordings changes
+    static constexpr uint32_t RecordingFormatVersion = 5;
+
+    static constexpr std::array<char, 4> RecordingMagic = { 'S', 'S', 'I', 'R' };
+
+    enum class EventType : uint8_t
+    {
+        DestroyAt = 0,
+        SawThrough,
+        DrawTo,
+        SwirlAt,
+        TogglePinAt,
+        ToggleTimerBombAt,
+        ToggleRCBombAt,
+        DetonateRCBombs,
+        GameParameters
+    };
+}
+
+//
+// RecordedGameParameters
+//
+
+RecordedGameParameters RecordedGameParameters::From(GameParameters const & gameParameters)
+{
+    return RecordedGameParameters{
+        gameParameters.StiffnessAdjustment,
+        gameParameters.StrengthAdjustment,
+        gameParameters.BuoyancyAdjustment,
+        gameParameters.WaterPressureAdjustment,
+        gameParameters.WaveHeight,
+        gameParameters.SeaDepth,
+        gameParameters.DestroyRadius,
+        gameParameters.BombBlastRadius,
+        static_cast<int64_t>(gameParameters.TimerBombInterval.count()),
+        gameParameters.BombMass,
+        gameParameters.ToolSearchRadius,
+        gameParameters.LightDiffusionAdjustment,
+        static_cast<uint32_t>(gameParameters.NumberOfClouds),
+        gameParameters.WindSpeed,
+        gameParameters.IsUltraViolentMode };
+}
+
+void RecordedGameParameters::ApplyTo(GameParameters & gameParameters) const
+{
+    gameParameters.StiffnessAdjustment = StiffnessAdjustment;
+    gameParameters.StrengthAdjustment = StrengthAdjustment;
+    gameParameters.BuoyancyAdjustment = BuoyancyAdjustment;
+    gameParameters.WaterPressureAdjustment = WaterPressureAdjustment;
+    gameParameters.WaveHeight = WaveHeight;
+    gameParameters.SeaDepth = SeaDepth;
+    gameParameters.DestroyRadius = DestroyRadius;
+    gameParameters.BombBlastRadius = BombBlastRadius;
+    gameParameters.TimerBombInterval = std::chrono::seconds(TimerBombIntervalSeconds);
+    gameParameters.BombMass = BombMass;
+    gameParameters.ToolSearchRadius = ToolSearchRadius;
+    gameParameters.LightDiffusionAdjustment = LightDiffusionAdjustment;
+    gameParameters.NumberOfClouds = static_cast<size_t>(NumberOfClouds);
+    gameParameters.WindSpeed = WindSpeed;
+    gameParameters.IsUltraViolentMode = IsUltraViolentMode;
+}
+
+void RecordedGameParameters::WriteSnapshot(SnapshotWriter & writer) const
+{
+    // One field at a time, so that no padding makes it to the file
+    writer.Write(StiffnessAdjustment);
+    writer.Write(StrengthAdjustment);
+    writer.Write(BuoyancyAdjustment);
+    writer.Write(WaterPressureAdjustment);
+    writer.Write(WaveHeight);
+    writer.Write(SeaDepth);
+    writer.Write(DestroyRadius);
+    writer.Write(BombBlastRadius);
+    writer.Write(TimerBombIntervalSeconds);
+    writer.Write(BombMass);
+    writer.Write(ToolSearchRadius);
+    writer.Write(LightDiffusionAdjustment);
+    writer.Write(NumberOfClouds);
+    writer.Write(WindSpeed);
+    writer.Write<uint8_t>(IsUltraViolentMode ? 1 : 0);
+}
+
+RecordedGameParameters RecordedGameParameters::ReadSnapshot(SnapshotReader & reader)
+{
+    RecordedGameParameters gameParameters;
+
+    gameParameters.StiffnessAdjustment = reader.Read<float>();
+    gameParameters.StrengthAdjustment = reader.Read<float>();
+    gameParameters.BuoyancyAdjustment = reader.Read<float>();
+    gameParameters.WaterPressureAdjustment = reader.Read<float>();
+    gameParameters.WaveHeight = reader.Read<float>();
+    gameParameters.SeaDepth = reader.Read<float>();
+    gameParameters.DestroyRadius = reader.Read<float>();
+    gameParameters.BombBlastRadius = reader.Read<float>();
+    gameParameters.TimerBombIntervalSeconds = reader.Read<int64_t>();
+    gameParameters.BombMass = reader.Read<float>();
+    gameParameters.ToolSearchRadius = reader.Read<float>();
+    gameParameters.LightDiffusionAdjustment = reader.Read<float>();
+    gameParameters.NumberOfClouds = reader.Read<uint32_t>();
+    gameParameters.WindSpeed = reader.Read<float>();
+    gameParameters.IsUltraViolentMode = (0 != reader.Read<uint8_t>());
+
+    return gameParameters;
+}
+
+bool RecordedGameParameters::operator==(RecordedGameParameters const & other) const
+{
+    return StiffnessAdjustment == other.StiffnessAdjustment
+        && StrengthAdjustment == other.StrengthAdjustment
+        && BuoyancyAdjustment == other.BuoyancyAdjustment
+        && WaterPressureAdjustment == other.WaterPressureAdjustment
+        && WaveHeight == other.WaveHeight
+        && SeaDepth == other.SeaDepth
+        && DestroyRadius == other.DestroyRadius
+        && BombBlastRadius == other.BombBlastRadius
+        && TimerBombIntervalSeconds == other.TimerBombIntervalSeconds
+        && BombMass == other.BombMass
+        && ToolSearchRadius == other.ToolSearchRadius
+        && LightDiffusionAdjustment == other.LightDiffusionAdjustment
+        && NumberOfClouds == other.NumberOfClouds
+        && WindSpeed == other.WindSpeed
+        && IsUltraViolentMode == other.IsUltraViolentMode;
+}
+
+//
+// InputRecorder
+//
+
+InputRecorder::InputRecorder(
+    Physics::World const & world,
+    GameParameters const & gameParameters)
+    : mWorldSnapshot()
+    , mInitialGameParameters(RecordedGameParameters::From(gameParameters))
+    , mCurrentGameParameters(mInitialGameParameters)
+    , mEvents()
+    , mStepCount(0)
+{
+    world.WriteSnapshot(mWorldSnapshot);
+}
+
+void InputRecorder::RecordDestroyAt(
+    vec2f const & worldCoordinates,
+    float radius)
+{
+    WriteEventHeader(static_cast<uint8_t>(EventType::DestroyAt));
+    mEvents.Write(worldCoordinates);
+    mEvents.Write(radius);
+}
+
+void InputRecorder::RecordSawThrough(
+    vec2f const & startWorldCoordinates,
+    vec2f const & endWorldCoordinates)
+{
+    WriteEventHeader(static_cast<uint8_t>(EventType::SawThrough));
+    mEvents.Write(startWorldCoordinates);
+    mEvents.Write(endWorldCoordinates);
+}
+
+void InputRecorder::RecordDrawTo(
+    vec2f const & worldCoordinates,
+    float strength)
+{
+    WriteEventHeader(static_cast<uint8_t>(EventType::DrawTo));
+    mEvents.Write(worldCoordinates);
+    mEvents.Write(strength);
+}
+
+void InputRecorder::RecordSwirlAt(
+    vec2f const & worldCoordinates,
+    float strength)
+{
+    WriteEventHeader(static_cast<uint8_t>(EventType::SwirlAt));
+    mEvents.Write(worldCoordinates);
+    mEvents.Write(strength);
+}
+
+void InputRecorder::RecordTogglePinAt(vec2f const & worldCoordinates)
+{
+    WriteEventHeader(static_cast<uint8_t>(EventType::TogglePinAt));
+    mEvents.Write(worldCoordinates);
+}
+
+void InputRecorder::RecordToggleTimerBombAt(vec2f const & worldCoordinates)
+{
+    WriteEventHeader(static_cast<uint8_t>(EventType::ToggleTimerBombAt));
+    mEvents.Write(worldCoordinates);
+}
+
+void InputRecorder::RecordToggleRCBombAt(vec2f const & worldCoordinates)
+{
+    WriteEventHeader(static_cast<uint8_t>(EventType::ToggleRCBombAt));
+    mEvents.Write(worldCoordinates);
+}
+
+void InputRecorder::RecordDetonateRCBombs()
+{
+    WriteEventHeader(static_cast<uint8_t>(EventType::DetonateRCBombs));
+}
+
+void InputRecorder::RecordStep(GameParameters const & gameParameters)
+{
+    // Parameters are only recorded when they change, which is seldom
+    auto const recordedGameParameters = RecordedGameParameters::From(gameParameters);
+    if (recordedGameParameters != mCurrentGameParameters)
+    {
+        WriteEventHeader(static_cast<uint8_t>(EventType::GameParameters));
+        recordedGameParameters.WriteSnapshot(mEvents);
+
+        mCurrentGameParameters = recordedGameParameters;
+    }
+
+    ++mStepCount;
+}
+
+void InputRecorder::SaveToFile(std::filesystem::path const & filePath) const
+{
+    SnapshotWriter writer;
+
+    writer.Write(RecordingMagic.data(), RecordingMagic.size());
+    writer.Write<uint32_t>(RecordingFormatVersion);
+
+    writer.Write<uint32_t>(mStepCount);
+    mInitialGameParameters.WriteSnapshot(writer);
+
+    writer.Write(mWorldSnapshot.GetBuffer().data(), mWorldSnapshot.GetBuffer().size());
+    writer.Write(mEvents.GetBuffer().data(), mEvents.GetBuffer().size());
+
+    writer.SaveToFile(filePath);
+}
+
+void InputRecorder::WriteEventHeader(uint8_t eventType)
+{
+    mEvents.Write<uint32_t>(mStepCount);
+    mEvents.Write<uint8_t>(eventType);
+}
+
+//
+// InputReplayer
+//
+
+std::unique_ptr<InputReplayer> InputReplayer::Load(
+    std::filesystem::path const & filePath,
+    std::shared_ptr<GameEventDispatcher> gameEventHandler,
+    MaterialDatabase const & materials)
+{
+    SnapshotReader reader = SnapshotReader::FromFile(filePath);
+
+    std::array<char, 4> magic;
+    reader.Read(magic.data(), magic.size());
+    if (magic != RecordingMagic
+        || reader.Read<uint32_t>() != RecordingFormatVersion)
+    {
+        throw GameException("\"" + filePath.string() + "\" is not a recording of this version");
+    }
+
+    uint32_t const stepCount = reader.Read<uint32_t>();
+    auto const initialGameParameters = RecordedGameParameters::ReadSnapshot(reader);
+
+    return std::unique_ptr<InputReplayer>(
+        new InputReplayer(
+            std::move(reader),
+            stepCount,
+            initialGameParameters,
+            std::move(gameEventHandler),
+            materials));
+}
+
+InputReplayer::InputReplayer(
+    SnapshotReader reader,
+    uint32_t stepCount,
+    RecordedGameParameters const & initialGameParameters,
+    std::shared_ptr<GameEventDispatcher> gameEventHandler,
+    MaterialDatabase const & materials)
+    : mReader(std::move(reader))
+    , mStepCount(stepCount)
+    , mGameParameters()
+    , mWorld()
+    , mCurrentStep(0)
+    , mNextEventStep()
+{
+    initialGameParameters.ApplyTo(mGameParameters);
+
+    mWorld = Physics::World::ReadSnapshot(
+        mReader,
+        std::move(gameEventHandler),
+        materials,
+        mGameParameters);
+
+    ReadNextEventStep();
+}
+
+void InputReplayer::Step()
+{
+    assert(!IsAtEnd());
+
+    while (!!mNextEventStep && *mNextEventStep == mCurrentStep)
+    {
+        ApplyNextEvent();
+        ReadNextEventStep();
+    }
+
+    mWorld->Update(mGameParameters);
+
+    ++mCurrentStep;
+}
+
+void InputReplayer::ApplyNextEvent()
+{
+    switch (static_cast<EventType>(mReader.Read<uint8_t>()))
+    {
+        case EventType::DestroyAt:
+        {
+            auto const worldCoordinates = mReader.Read<vec2f>();
+            auto const radius = mReader.Read<float>();
+            mWorld->DestroyAt(worldCoordinates, radius);
+            break;
+        }
+
+        case EventType::SawThrough:
+        {
+            auto const startWorldCoordinates = mReader.Read<vec2f>();
+            auto const endWorldCoordinates = mReader.Read<vec2f>();
+            mWorld->SawThrough(startWorldCoordinates, endWorldCoordinates);
+            break;
+        }
+
+        case EventType::DrawTo:
+        {
+            auto const worldCoordinates = mReader.Read<vec2f>();
+            auto const strength = mReader.Read<float>();
+            mWorld->DrawTo(worldCoordinates, strength);
+            break;
+        }
+
+        case EventType::SwirlAt:
+        {
+            auto const worldCoordinates = mReader.Read<vec2f>();
+            auto const strength = mReader.Read<float>();
+            mWorld->SwirlAt(worldCoordinates, strength);
+            break;
+        }
+
+        case EventType::TogglePinAt:
+        {
+            mWorld->TogglePinAt(mReader.Read<vec2f>(), mGameParameters);
+            break;
+        }
+
+        case EventType::ToggleTimerBombAt:
+        {
+            mWorld->ToggleTimerBombAt(mReader.Read<vec2f>(), mGameParameters);
+            break;
+        }
+
+        case EventType::ToggleRCBombAt:
+        {
+            mWorld->ToggleRCBombAt(mReader.Read<vec2f>(), mGameParameters);
+            break;
+        }
+
+        case EventType::DetonateRCBombs:
+        {
+            mWorld->DetonateRCBombs();
+            break;
+        }
+
+        case EventType::GameParameters:
+        {
+            RecordedGameParameters::ReadSnapshot(mReader).ApplyTo(mGameParameters);
+            break;
+        }
+
+        default:
+        {
+            throw GameException("The recording is corrupted");
+        }
+    }
+}
+
+void InputReplayer::ReadNextEventStep()
+{
+    if (mReader.IsAtEnd())
+    {
+        mNextEventStep.reset();
+    }
+    else
+    {
+        mNextEventStep = mReader.Read<uint32_t>();
+        if (*mNextEventStep < mCurrentStep)
+        {
+            throw GameException("The recording is corrupted");
+        }
+    }
+}
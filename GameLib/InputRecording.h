@@ -0,0 +1,192 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-08
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameEventDispatcher.h"
+#include "GameParameters.h"
+#include "MaterialDatabase.h"
+#include "Physics.h"
+#include "Snapshot.h"
+#include "Vectors.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+
+//
+// Input recordings are made of a snapshot of the world as it was when the recording
+// started, followed by the interactions with the world - in world coordinates - and
+// the changes to the game parameters, each tagged with the number of the simulation
+// step that it precedes. Replaying a recording feeds the same interactions into the
+// same world at the same steps, without any UI nor render context.
+//
+
+/*
+ * The game parameters that the user may change while the game runs.
+ */
+struct RecordedGameParameters
+{
+    float StiffnessAdjustment;
+    float StrengthAdjustment;
+    float BuoyancyAdjustment;
+    float WaterPressureAdjustment;
+    float WaveHeight;
+    float SeaDepth;
+    float DestroyRadius;
+    float BombBlastRadius;
+    int64_t TimerBombIntervalSeconds;
+    float BombMass;
+    float ToolSearchRadius;
+    float LightDiffusionAdjustment;
+    uint32_t NumberOfClouds;
+    float WindSpeed;
+    bool IsUltraViolentMode;
+
+    static RecordedGameParameters From(GameParameters const & gameParameters);
+
+    void ApplyTo(GameParameters & gameParameters) const;
+
+    void WriteSnapshot(SnapshotWriter & writer) const;
+
+    static RecordedGameParameters ReadSnapshot(SnapshotReader & reader);
+
+    bool operator==(RecordedGameParameters const & other) const;
+
+    bool operator!=(RecordedGameParameters const & other) const
+    {
+        return !(*this == other);
+    }
+};
+
+/*
+ * Accumulates a recording in memory, until it's saved.
+ */
+class InputRecorder
+{
+public:
+
+    InputRecorder(
+        Physics::World const & world,
+        GameParameters const & gameParameters);
+
+    void RecordDestroyAt(
+        vec2f const & worldCoordinates,
+        float radius);
+
+    void RecordSawThrough(
+        vec2f const & startWorldCoordinates,
+        vec2f const & endWorldCoordinates);
+
+    void RecordDrawTo(
+        vec2f const & worldCoordinates,
+        float strength);
+
+    void RecordSwirlAt(
+        vec2f const & worldCoordinates,
+        float strength);
+
+    void RecordTogglePinAt(vec2f const & worldCoordinates);
+
+    void RecordToggleTimerBombAt(vec2f const & worldCoordinates);
+
+    void RecordToggleRCBombAt(vec2f const & worldCoordinates);
+
+    void RecordDetonateRCBombs();
+
+    /*
+     * Invoked right before each simulation step, with the parameters that the step runs with.
+     */
+    void RecordStep(GameParameters const & gameParameters);
+
+    uint32_t GetStepCount() const
+    {
+        return mStepCount;
+    }
+
+    void SaveToFile(std::filesystem::path const & filePath) const;
+
+private:
+
+    void WriteEventHeader(uint8_t eventType);
+
+private:
+
+    SnapshotWriter mWorldSnapshot;
+    RecordedGameParameters const mInitialGameParameters;
+    RecordedGameParameters mCurrentGameParameters;
+
+    SnapshotWriter mEvents;
+    uint32_t mStepCount;
+};
+
+/*
+ * Re-creates the world of a recording, and steps it through the recording.
+ */
+class InputReplayer
+{
+public:
+
+    static std::unique_ptr<InputReplayer> Load(
+        std::filesystem::path const & filePath,
+        std::shared_ptr<GameEventDispatcher> gameEventHandler,
+        MaterialDatabase const & materials);
+
+    /*
+     * Applies the interactions that precede the current step, and runs the step.
+     */
+    void Step();
+
+    bool IsAtEnd() const
+    {
+        return mCurrentStep == mStepCount;
+    }
+
+    uint32_t GetCurrentStep() const
+    {
+        return mCurrentStep;
+    }
+
+    uint32_t GetStepCount() const
+    {
+        return mStepCount;
+    }
+
+    Physics::World const & GetWorld() const
+    {
+        return *mWorld;
+    }
+
+    GameParameters const & GetGameParameters() const
+    {
+        return mGameParameters;
+    }
+
+private:
+
+    InputReplayer(
+        SnapshotReader reader,
+        uint32_t stepCount,
+        RecordedGameParameters const & initialGameParameters,
+        std::shared_ptr<GameEventDispatcher> gameEventHandler,
+        MaterialDatabase const & materials);
+
+    void ApplyNextEvent();
+
+    void ReadNextEventStep();
+
+private:
+
+    SnapshotReader mReader;
+    uint32_t const mStepCount;
+    GameParameters mGameParameters;
+    std::unique_ptr<Physics::World> mWorld;
+
+    uint32_t mCurrentStep;
+
+    // The step of the event that comes next in the recording, if any
+    std::optional<uint32_t> mNextEventStep;
+};
@@ -5,4 +5,147 @@
 ***************************************************************************************/
 #include "Log.h"
 
+#include <chrono>
+#include <iostream>
+
 Logger Logger::Instance;
+
+Logger::Logger()
+#ifdef _DEBUG
+	: mLevel(LogLevel::Debug)
+#else
+	: mLevel(LogLevel::Info)
+#endif
+	, mSlots()
+	, mEnqueuePosition(0)
+	, mDequeuePosition(0)
+	, mDroppedMessageCount(0)
+	, mDrainMutex()
+	, mCurrentListener()
+	, mStoredMessages()
+	, mDrainThread()
+	, mDrainThreadMutex()
+	, mDrainThreadSignal()
+	, mIsStopping(false)
+{
+	for (size_t s = 0; s < RingSize; ++s)
+	{
+		mSlots[s].Sequence.store(s, std::memory_order_relaxed);
+	}
+
+	mDrainThread = std::thread(&Logger::DrainThreadLoop, this);
+}
+
+Logger::~Logger()
+{
+	{
+		std::lock_guard<std::mutex> lock(mDrainThreadMutex);
+		mIsStopping = true;
+	}
+
+	mDrainThreadSignal.notify_one();
+	mDrainThread.join();
+
+	// Output whatever got logged meanwhile
+	Flush();
+}
+
+void Logger::RegisterListener(
+	std::function<void(std::string const & message)> listener)
+{
+	std::lock_guard<std::mutex> lock(mDrainMutex);
+
+	assert(!mCurrentListener);
+	mCurrentListener = std::move(listener);
+
+	// Publish all the messages so far
+	for (std::string const & message : mStoredMessages)
+	{
+		mCurrentListener(message);
+	}
+}
+
+void Logger::UnregisterListener()
+{
+	std::lock_guard<std::mutex> lock(mDrainMutex);
+
+	assert(!!mCurrentListener);
+	mCurrentListener = {};
+}
+
+void Logger::Flush()
+{
+	std::lock_guard<std::mutex> lock(mDrainMutex);
+
+	DrainRing();
+}
+
+void Logger::DrainThreadLoop()
+{
+	// Messages are not urgent, hence rather than having loggers signal us we just poll
+	static constexpr auto DrainInterval = std::chrono::milliseconds(20);
+
+	std::unique_lock<std::mutex> threadLock(mDrainThreadMutex);
+
+	while (!mIsStopping)
+	{
+		mDrainThreadSignal.wait_for(threadLock, DrainInterval);
+
+		std::lock_guard<std::mutex> lock(mDrainMutex);
+
+		DrainRing();
+	}
+}
+
+void Logger::DrainRing()
+{
+	bool hasOutput = false;
+
+	while (true)
+	{
+		Slot & slot = mSlots[mDequeuePosition & (RingSize - 1)];
+		if (slot.Sequence.load(std::memory_order_acquire) != mDequeuePosition + 1)
+		{
+			// Empty, or the next message is still being formatted
+			break;
+		}
+
+		Output(std::string(slot.Text.data(), slot.Length));
+		hasOutput = true;
+
+		// Release the record
+		slot.Sequence.store(mDequeuePosition + RingSize, std::memory_order_release);
+		++mDequeuePosition;
+	}
+
+	size_t const droppedMessageCount = mDroppedMessageCount.exchange(0, std::memory_order_relaxed);
+	if (droppedMessageCount > 0)
+	{
+		Output("(" + std::to_string(droppedMessageCount) + " messages dropped)\n");
+		hasOutput = true;
+	}
+
+	if (hasOutput)
+	{
+		std::cout.flush();
+	}
+}
+
+void Logger::Output(std::string const & message)
+{
+	// Store
+	mStoredMessages.push_back(message);
+	if (mStoredMessages.size() > MaxStoredMessages)
+	{
+		mStoredMessages.pop_front();
+	}
+
+	// Publish
+	if (!!mCurrentListener)
+	{
+		mCurrentListener(message);
+	}
+
+	// Output
+	std::cout << message;
+}
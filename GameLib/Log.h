@@ -5,51 +5,129 @@
 ***************************************************************************************/
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <charconv>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <deque>
 #include <functional>
-#include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 
-namespace /* anonymous */ {
+enum class LogLevel : uint8_t
+{
+	Debug = 0,
+	Info = 1,
+	None = 2
+};
 
-	template<typename T>
-	std::stringstream & _LogToStream(std::stringstream & ss, T&& t)
+/*
+ * A fixed-size buffer that a message gets formatted into, without allocating.
+ *
+ * Messages that do not fit are truncated.
+ */
+class LogRecordWriter
+{
+public:
+
+	LogRecordWriter(
+		char * buffer,
+		size_t capacity)
+		: mBuffer(buffer)
+		, mCapacity(capacity)
+		, mLength(0)
 	{
-		ss << std::forward<T>(t) << std::endl;
-		return ss;
 	}
 
-	template<typename T, typename... TArgs>
-	std::stringstream & _LogToStream(std::stringstream & ss, T&& t, TArgs&&... args)
+	size_t GetLength() const
 	{
-		ss << std::forward<T>(t);
-		return _LogToStream(ss, std::forward<TArgs>(args)...);
+		return mLength;
 	}
 
-    template<typename T>
-    void _LogToNothing(T&& /*t*/)
-    {
-    }
+	void Append(
+		char const * text,
+		size_t length)
+	{
+		size_t const toCopy = std::min(length, mCapacity - mLength);
+		std::memcpy(mBuffer + mLength, text, toCopy);
+		mLength += toCopy;
+	}
 
-    template<typename T, typename... TArgs>
-    void _LogToNothing(T&& /*t*/, TArgs&&... args)
-    {
-        _LogToNothing(std::forward<TArgs>(args)...);
-    }
+	template<typename T>
+	void Append(T const & value)
+	{
+		using TValue = std::decay_t<T>;
 
-}
+		if constexpr (std::is_same_v<TValue, char>)
+		{
+			Append(&value, 1);
+		}
+		else if constexpr (std::is_same_v<TValue, bool>)
+		{
+			Append(value ? "1" : "0", 1);
+		}
+		else if constexpr (std::is_integral_v<TValue>)
+		{
+			auto const result = std::to_chars(mBuffer + mLength, mBuffer + mCapacity, value);
+			if (result.ec == std::errc())
+				mLength = result.ptr - mBuffer;
+		}
+		else if constexpr (std::is_floating_point_v<TValue>)
+		{
+			// Same format as the default formatting of streams
+			char text[32];
+			int const length = std::snprintf(text, sizeof(text), "%g", static_cast<double>(value));
+			if (length > 0)
+				Append(text, std::min(static_cast<size_t>(length), sizeof(text) - 1));
+		}
+		else if constexpr (std::is_convertible_v<T const &, std::string_view>)
+		{
+			std::string_view const text(value);
+			Append(text.data(), text.size());
+		}
+		else
+		{
+			// Anything else goes through its stream operator, and this allocates
+			std::ostringstream ss;
+			ss << value;
+			std::string const text = ss.str();
+			Append(text.data(), text.size());
+		}
+	}
+
+private:
 
+	char * const mBuffer;
+	size_t const mCapacity;
+	size_t mLength;
+};
+
+/*
+ * The logger.
+ *
+ * Messages are formatted by the logging thread into the records of a lock-free ring, and
+ * from there a background thread stores them, publishes them to the listener, and outputs
+ * them. Logging thus never waits for the output, nor - for the usual argument types -
+ * allocates; when the ring is full, messages are dropped and their number is reported.
+ *
+ * Note: the listener is invoked on the background thread.
+ */
 class Logger
 {
 public:
 
-	Logger()
-		: mCurrentListener()
-		, mStoredMessages()
-	{
-	}
+	Logger();
+
+	~Logger();
 
 	Logger(Logger const &) = delete;
 	Logger(Logger &&) = delete;
@@ -57,54 +135,72 @@ public:
 	Logger & operator=(Logger &&) = delete;
 
 	void RegisterListener(
-		std::function<void(std::string const & message)> listener)
+		std::function<void(std::string const & message)> listener);
+
+	void UnregisterListener();
+
+	LogLevel GetLevel() const
 	{
-		assert(!mCurrentListener);
-		mCurrentListener = std::move(listener);
+		return mLevel.load(std::memory_order_relaxed);
+	}
 
-		// Publish all the messages so far
-		for (std::string const & message : mStoredMessages)
-		{
-			mCurrentListener(message);
-		}
+	void SetLevel(LogLevel level)
+	{
+		mLevel.store(level, std::memory_order_relaxed);
 	}
 
-	void UnregisterListener()
+	inline bool IsEnabled(LogLevel level) const
 	{
-		assert(!!mCurrentListener);
-		mCurrentListener = {};
+		return level >= mLevel.load(std::memory_order_relaxed);
 	}
 
 	template<typename...TArgs>
 	void Log(TArgs&&... args)
 	{
-		std::stringstream ss;
-		_LogToStream(ss, std::forward<TArgs>(args)...);
-
-		std::string const & message = ss.str();
+		//
+		// Claim a record
+		//
 
-		// Store
-		mStoredMessages.push_back(message);
-		if (mStoredMessages.size() > MaxStoredMessages)
+		size_t position = mEnqueuePosition.load(std::memory_order_relaxed);
+		Slot * slot;
+		while (true)
 		{
-			mStoredMessages.pop_front();
+			slot = &(mSlots[position & (RingSize - 1)]);
+			size_t const sequence = slot->Sequence.load(std::memory_order_acquire);
+			intptr_t const difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+			if (difference == 0)
+			{
+				if (mEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (difference < 0)
+			{
+				// Full
+				mDroppedMessageCount.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			else
+			{
+				position = mEnqueuePosition.load(std::memory_order_relaxed);
+			}
 		}
 
-		// Publish
-		if (!!mCurrentListener)
-		{
-			mCurrentListener(message);
-		}
+		//
+		// Format into the record, and publish it
+		//
 
-        // Output
-        std::cout << message << std::endl;
+		LogRecordWriter writer(slot->Text.data(), slot->Text.size() - 1);
+		(writer.Append(std::forward<TArgs>(args)), ...);
+		slot->Text[writer.GetLength()] = '\n';
+		slot->Length = writer.GetLength() + 1;
+
+		slot->Sequence.store(position + 1, std::memory_order_release);
 	}
 
-    template<typename...TArgs>
-    void LogToNothing(TArgs&&... args)
-    {
-        _LogToNothing(std::forward<TArgs>(args)...);
-    }
+	/*
+	 * Waits until all the messages logged so far have been output.
+	 */
+	void Flush();
 
 public:
 
@@ -112,12 +208,54 @@ public:
 
 private:
 
+	void DrainThreadLoop();
+
+	// Invoked with the drain mutex held
+	void DrainRing();
+
+	void Output(std::string const & message);
+
+private:
+
+	std::atomic<LogLevel> mLevel;
+
+	//
+	// The ring
+	//
+
+	static constexpr size_t RingSize = 512; // Power of two
+	static constexpr size_t RecordSize = 512;
+
+	struct Slot
+	{
+		std::atomic<size_t> Sequence;
+		size_t Length;
+		std::array<char, RecordSize> Text;
+	};
+
+	std::array<Slot, RingSize> mSlots;
+	std::atomic<size_t> mEnqueuePosition;
+	size_t mDequeuePosition;
+	std::atomic<size_t> mDroppedMessageCount;
+
+	//
+	// The drain
+	//
+
+	// Guards the dequeue position, the stored messages, and the listener
+	std::mutex mDrainMutex;
+
 	// The current listener
 	std::function<void(std::string const & message)> mCurrentListener;
 
 	// The messages stored so far
 	std::deque<std::string> mStoredMessages;
 	static constexpr size_t MaxStoredMessages = 10000;
+
+	std::thread mDrainThread;
+	std::mutex mDrainThreadMutex;
+	std::condition_variable mDrainThreadSignal;
+	bool mIsStopping;
 };
 
 //
@@ -127,16 +265,17 @@ private:
 template<typename... TArgs>
 void LogMessage(TArgs&&... args)
 {
-	Logger::Instance.Log(std::forward<TArgs>(args)...);
+	if (Logger::Instance.IsEnabled(LogLevel::Info))
+	{
+		Logger::Instance.Log(std::forward<TArgs>(args)...);
+	}
 }
 
 template<typename... TArgs>
 void LogDebug(TArgs&&... args)
 {
-#ifdef _DEBUG
-	Logger::Instance.Log(std::forward<TArgs>(args)...);
-#else
-    Logger::Instance.LogToNothing(std::forward<TArgs>(args)...);
-#endif
+	if (Logger::Instance.IsEnabled(LogLevel::Debug))
+	{
+		Logger::Instance.Log(std::forward<TArgs>(args)...);
+	}
 }
-
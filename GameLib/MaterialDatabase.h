@@ -101,14 +101,40 @@ public:
 
     Material const * Get(std::array<uint8_t, 3u> const & structuralColourRgb) const
     {
-        auto srchIt = mMaterialsMap.find(structuralColourRgb);
-        if (srchIt != mMaterialsMap.end())
-        {
-            return srchIt->second.get();
-        }
-        else
+        return Get(
+            structuralColourRgb[0],
+            structuralColourRgb[1],
+            structuralColourRgb[2]);
+    }
+
+    inline Material const * Get(
+        uint8_t r,
+        uint8_t g,
+        uint8_t b) const
+    {
+        return mColourBlocks[mColourBlockIndices[(static_cast<size_t>(r) << 8) | g] * 256u + b];
+    }
+
+    /*
+     * Looks up the materials of a whole row of RGB pixels, storing them in the
+     * specified array; pixels that are not materials get nullptr.
+     */
+    void GetRow(
+        unsigned char const * rgbRow,
+        size_t pixelCount,
+        Material const ** rowMaterials) const
+    {
+        for (size_t p = 0; p < pixelCount; ++p, rgbRow += 3)
         {
-            return nullptr;
+            // Fast path for the background, which is what most of an image is made of
+            if (0xFF == rgbRow[0] && 0xFF == rgbRow[1] && 0xFF == rgbRow[2])
+            {
+                rowMaterials[p] = mBackgroundMaterial;
+            }
+            else
+            {
+                rowMaterials[p] = Get(rgbRow[0], rgbRow[1], rgbRow[2]);
+            }
         }
     }
 
@@ -124,9 +150,42 @@ private:
         Material const & ropeMaterial)
         : mMaterialsMap(std::move(materialsMap))
         , mRopeMaterial(ropeMaterial)
+        , mColourBlockIndices(256 * 256, 0)
+        , mColourBlocks(256, nullptr)
+        , mBackgroundMaterial(nullptr)
     {
+        //
+        // Build the colour lookup table
+        //
+
+        for (auto const & entry : mMaterialsMap)
+        {
+            size_t const blockIndexIndex = (static_cast<size_t>(entry.first[0]) << 8) | entry.first[1];
+            if (0 == mColourBlockIndices[blockIndexIndex])
+            {
+                // Allocate a new block for this R,G pair
+                mColourBlockIndices[blockIndexIndex] = static_cast<uint32_t>(mColourBlocks.size() / 256u);
+                mColourBlocks.resize(mColourBlocks.size() + 256u, nullptr);
+            }
+
+            mColourBlocks[mColourBlockIndices[blockIndexIndex] * 256u + entry.first[2]] = entry.second.get();
+        }
+
+        mBackgroundMaterial = Get(0xFF, 0xFF, 0xFF);
     }
 
     std::map<std::array<uint8_t, 3u>, std::unique_ptr<Material const>> mMaterialsMap;
     Material const & mRopeMaterial;
+
+    //
+    // Colour lookup table: a first level indexed by R and G, pointing to
+    // blocks of 256 materials indexed by B; block zero is the empty block,
+    // shared by all the R,G pairs for which there are no materials
+    //
+
+    std::vector<uint32_t> mColourBlockIndices;
+    std::vector<Material const *> mColourBlocks;
+
+    // The material of the background colour (white) - normally none
+    Material const * mBackgroundMaterial;
 };
@@ -0,0 +1,197 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-16
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "MemoryMappedFile.h"
+
+#include "GameException.h"
+
+#ifdef _MSC_VER
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _MSC_VER
+
+MemoryMappedFile::MemoryMappedFile(std::filesystem::path const & filePath)
+    : mData(nullptr)
+    , mSize(0)
+    , mMappingHandle(nullptr)
+{
+    HANDLE const fileHandle = ::CreateFileW(
+        filePath.wstring().c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+
+    if (INVALID_HANDLE_VALUE == fileHandle)
+    {
+        throw GameException("Cannot open file \"" + filePath.string() + "\"");
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!::GetFileSizeEx(fileHandle, &fileSize))
+    {
+        ::CloseHandle(fileHandle);
+        throw GameException("Cannot get the size of file \"" + filePath.string() + "\"");
+    }
+
+    mSize = static_cast<size_t>(fileSize.QuadPart);
+    if (0 == mSize)
+    {
+        // Empty files cannot be mapped
+        ::CloseHandle(fileHandle);
+        return;
+    }
+
+    // The mapping keeps the file open
+    mMappingHandle = ::CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(fileHandle);
+
+    if (nullptr == mMappingHandle)
+    {
+        throw GameException("Cannot map file \"" + filePath.string() + "\"");
+    }
+
+    mData = static_cast<unsigned char const *>(::MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (nullptr == mData)
+    {
+        ::CloseHandle(mMappingHandle);
+        throw GameException("Cannot map file \"" + filePath.string() + "\"");
+    }
+}
+
+void MemoryMappedFile::Unmap()
+{
+    if (nullptr != mData)
+    {
+        ::UnmapViewOfFile(mData);
+        mData = nullptr;
+    }
+
+    if (nullptr != mMappingHandle)
+    {
+        ::CloseHandle(mMappingHandle);
+        mMappingHandle = nullptr;
+    }
+
+    mSize = 0;
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile && other)
+    : mData(other.mData)
+    , mSize(other.mSize)
+    , mMappingHandle(other.mMappingHandle)
+{
+    other.mData = nullptr;
+    other.mSize = 0;
+    other.mMappingHandle = nullptr;
+}
+
+MemoryMappedFile & MemoryMappedFile::operator=(MemoryMappedFile && other)
+{
+    if (this != &other)
+    {
+        Unmap();
+
+        mData = other.mData;
+        mSize = other.mSize;
+        mMappingHandle = other.mMappingHandle;
+
+        other.mData = nullptr;
+        other.mSize = 0;
+        other.mMappingHandle = nullptr;
+    }
+
+    return *this;
+}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(std::filesystem::path const & filePath)
+    : mData(nullptr)
+    , mSize(0)
+{
+    int const fd = ::open(filePath.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw GameException("Cannot open file \"" + filePath.string() + "\"");
+    }
+
+    struct stat fileStat;
+    if (0 != ::fstat(fd, &fileStat))
+    {
+        ::close(fd);
+        throw GameException("Cannot get the size of file \"" + filePath.string() + "\"");
+    }
+
+    mSize = static_cast<size_t>(fileStat.st_size);
+    if (0 == mSize)
+    {
+        // Empty files cannot be mapped
+        ::close(fd);
+        return;
+    }
+
+    // The mapping keeps the file open
+    void * const data = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (MAP_FAILED == data)
+    {
+        throw GameException("Cannot map file \"" + filePath.string() + "\"");
+    }
+
+    mData = static_cast<unsigned char const *>(data);
+}
+
+void MemoryMappedFile::Unmap()
+{
+    if (nullptr != mData)
+    {
+        ::munmap(const_cast<unsigned char *>(mData), mSize);
+        mData = nullptr;
+    }
+
+    mSize = 0;
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile && other)
+    : mData(other.mData)
+    , mSize(other.mSize)
+{
+    other.mData = nullptr;
+    other.mSize = 0;
+}
+
+MemoryMappedFile & MemoryMappedFile::operator=(MemoryMappedFile && other)
+{
+    if (this != &other)
+    {
+        Unmap();
+
+        mData = other.mData;
+        mSize = other.mSize;
+
+        other.mData = nullptr;
+        other.mSize = 0;
+    }
+
+    return *this;
+}
+
+#endif
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    Unmap();
+}
@@ -0,0 +1,59 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-16
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "SysSpecifics.h"
+
+#include <cstddef>
+#include <filesystem>
+
+/*
+ * A read-only view of a whole file, mapped into memory.
+ *
+ * The file's pages are only read when they are touched, and they are shared with the
+ * OS file cache.
+ */
+class MemoryMappedFile
+{
+public:
+
+    /*
+     * Throws GameException when the file cannot be mapped.
+     */
+    explicit MemoryMappedFile(std::filesystem::path const & filePath);
+
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(MemoryMappedFile && other);
+    MemoryMappedFile & operator=(MemoryMappedFile && other);
+
+    MemoryMappedFile(MemoryMappedFile const &) = delete;
+    MemoryMappedFile & operator=(MemoryMappedFile const &) = delete;
+
+    unsigned char const * GetData() const
+    {
+        return mData;
+    }
+
+    size_t GetSize() const
+    {
+        return mSize;
+    }
+
+private:
+
+    void Unmap();
+
+private:
+
+    unsigned char const * mData;
+    size_t mSize;
+
+#ifdef _MSC_VER
+    // The mapping object's HANDLE
+    void * mMappingHandle;
+#endif
+};
@@ -0,0 +1,82 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-16
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "IAudioDevice.h"
+
+#include <memory>
+
+/*
+ * An audio device that plays nothing.
+ *
+ * Its voices keep "playing" until they are stopped, as if all sounds were very long; this
+ * way, whoever plays sounds through it goes through the same paths - e.g. running out of
+ * voices - as with a real device under load.
+ */
+template<typename TSoundBuffer>
+class NullAudioDevice : public IAudioDevice<TSoundBuffer>
+{
+public:
+
+    virtual std::unique_ptr<IAudioVoice<TSoundBuffer>> MakeVoice() override
+    {
+        return std::make_unique<NullAudioVoice>();
+    }
+
+private:
+
+    class NullAudioVoice : public IAudioVoice<TSoundBuffer>
+    {
+    public:
+
+        NullAudioVoice()
+            : mIsStopped(true)
+            , mVolume(100.0f)
+        {
+        }
+
+        virtual void Play(
+            TSoundBuffer const & /*soundBuffer*/,
+            float volume) override
+        {
+            mIsStopped = false;
+            mVolume = volume;
+        }
+
+        virtual void Stop() override
+        {
+            mIsStopped = true;
+        }
+
+        virtual void Pause() override
+        {
+        }
+
+        virtual void Resume() override
+        {
+        }
+
+        virtual bool IsStopped() const override
+        {
+            return mIsStopped;
+        }
+
+        virtual float GetVolume() const override
+        {
+            return mVolume;
+        }
+
+        virtual void SetVolume(float volume) override
+        {
+            mVolume = volume;
+        }
+
+    private:
+
+        bool mIsStopped;
+        float mVolume;
+    };
+};
@@ -0,0 +1,235 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-14
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "IRenderBackend.h"
+
+/*
+ * A render backend that renders nothing, and culls nothing - hence the world
+ * prepares everything it would prepare for a real backend.
+ */
+class NullRenderBackend : public IRenderBackend
+{
+public:
+
+    virtual bool GetShowShipThroughWater() const override
+    {
+        return false;
+    }
+
+    virtual bool GetShowStressedSprings() const override
+    {
+        return false;
+    }
+
+    virtual void RenderStart() override
+    {
+    }
+
+    virtual void RenderCloudsStart(size_t /*clouds*/) override
+    {
+    }
+
+    virtual void RenderCloud(
+        float /*virtualX*/,
+        float /*virtualY*/,
+        float /*scale*/) override
+    {
+    }
+
+    virtual void RenderCloudsEnd() override
+    {
+    }
+
+    virtual void UploadLandAndWater(
+        SineWavesProfile const & /*landProfile*/,
+        SineWavesProfile const & /*waterProfile*/,
+        float /*restWaterHeight*/) override
+    {
+    }
+
+    virtual void RenderLand() override
+    {
+    }
+
+    virtual void RenderWater() override
+    {
+    }
+
+    virtual void UploadShipPointImmutableGraphicalAttributes(
+        int /*shipId*/,
+        size_t /*count*/,
+        vec3f const * restrict /*color*/,
+        vec2f const * restrict /*textureCoordinates*/) override
+    {
+    }
+
+    virtual void UploadShipPoints(
+        int /*shipId*/,
+        size_t /*count*/,
+        vec2f const * restrict /*position*/,
+        float const * restrict /*light*/,
+        float const * restrict /*water*/,
+        float const * restrict /*stress*/) override
+    {
+    }
+
+    virtual void UploadShipElementsStart(
+        int /*shipId*/,
+        std::vector<std::size_t> const & /*connectedComponentsMaxSizes*/) override
+    {
+    }
+
+    virtual void UpdateShipElementsStart(
+        int /*shipId*/,
+        std::vector<std::size_t> const & /*connectedComponentsMaxSizes*/,
+        std::vector<ConnectedComponentId> const & /*changedConnectedComponentIds*/) override
+    {
+    }
+
+    virtual void UploadShipElementPoint(
+        int /*shipId*/,
+        int /*shipPointIndex*/,
+        ConnectedComponentId /*connectedComponentId*/) override
+    {
+    }
+
+    virtual void UploadShipElementSpring(
+        int /*shipId*/,
+        ElementIndex /*shipSpringIndex*/,
+        int /*shipPointIndex1*/,
+        int /*shipPointIndex2*/,
+        bool /*isCoarse*/,
+        ConnectedComponentId /*connectedComponentId*/) override
+    {
+    }
+
+    virtual void UploadShipElementRope(
+        int /*shipId*/,
+        ElementIndex /*shipSpringIndex*/,
+        int /*shipPointIndex1*/,
+        int /*shipPointIndex2*/,
+        ConnectedComponentId /*connectedComponentId*/) override
+    {
+    }
+
+    virtual void UploadShipElementTriangle(
+        int /*shipId*/,
+        ElementIndex /*shipTriangleIndex*/,
+        int /*shipPointIndex1*/,
+        int /*shipPointIndex2*/,
+        int /*shipPointIndex3*/,
+        ConnectedComponentId /*connectedComponentId*/) override
+    {
+    }
+
+    virtual void UploadShipElementCoarseTriangle(
+        int /*shipId*/,
+        ElementIndex /*shipCoarseTriangleIndex*/,
+        int /*shipPointIndex1*/,
+        int /*shipPointIndex2*/,
+        int /*shipPointIndex3*/,
+        ConnectedComponentId /*connectedComponentId*/) override
+    {
+    }
+
+    virtual void InsertShipElementCoarseTriangle(
+        int /*shipId*/,
+        ElementIndex /*shipCoarseTriangleIndex*/,
+        int /*shipPointIndex1*/,
+        int /*shipPointIndex2*/,
+        int /*shipPointIndex3*/,
+        ConnectedComponentId /*connectedComponentId*/) override
+    {
+    }
+
+    virtual void RemoveShipElementPoint(
+        int /*shipId*/,
+        int /*shipPointIndex*/) override
+    {
+    }
+
+    virtual void RemoveShipElementSpring(
+        int /*shipId*/,
+        ElementIndex /*shipSpringIndex*/) override
+    {
+    }
+
+    virtual void RemoveShipElementRope(
+        int /*shipId*/,
+        ElementIndex /*shipSpringIndex*/) override
+    {
+    }
+
+    virtual void RemoveShipElementTriangle(
+        int /*shipId*/,
+        ElementIndex /*shipTriangleIndex*/) override
+    {
+    }
+
+    virtual void RemoveShipElementCoarseTriangle(
+        int /*shipId*/,
+        ElementIndex /*shipCoarseTriangleIndex*/) override
+    {
+    }
+
+    virtual void UploadShipElementsEnd(int /*shipId*/) override
+    {
+    }
+
+    virtual void UploadShipElementPinnedPointsStart(
+        int /*shipId*/,
+        size_t /*count*/) override
+    {
+    }
+
+    virtual void UploadShipElementPinnedPoint(
+        int /*shipId*/,
+        float /*x*/,
+        float /*y*/,
+        ConnectedComponentId /*connectedComponentId*/) override
+    {
+    }
+
+    virtual void UploadShipElementPinnedPointsEnd(int /*shipId*/) override
+    {
+    }
+
+    virtual void UploadShipElementBombsStart(
+        int /*shipId*/,
+        size_t /*count*/) override
+    {
+    }
+
+    virtual void UploadShipElementBomb(
+        int /*shipId*/,
+        BombType /*bombType*/,
+        RotatedTextureRenderInfo const & /*renderInfo*/,
+        std::optional<uint32_t> /*lightedFrameIndex*/,
+        std::optional<uint32_t> /*unlightedFrameIndex*/,
+        ConnectedComponentId /*connectedComponentId*/) override
+    {
+    }
+
+    virtual void UploadShipElementBombsEnd(int /*shipId*/) override
+    {
+    }
+
+    virtual bool IsShipCulled(Geometry::AABB const & /*shipAABB*/) const override
+    {
+        return false;
+    }
+
+    virtual void RenderShip(
+        int /*shipId*/,
+        std::vector<Geometry::AABB> const & /*connectedComponentAABBs*/) override
+    {
+    }
+
+    virtual void RenderEnd() override
+    {
+    }
+};
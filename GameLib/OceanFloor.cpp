@@ -9,6 +9,11 @@ namespace Physics {
 
 OceanFloor::OceanFloor()
     : mSamples(new float[SamplesCount + 1])
+    , mProfile{
+        { Amplitude1, Amplitude2, -Amplitude3 },
+        { Frequency1, Frequency2, Frequency3 },
+        { 0.0f, 0.0f, 0.0f },
+        0.0f }
 {
 }
 
@@ -18,12 +23,14 @@ void OceanFloor::Update(GameParameters const & gameParameters)
     float x = 0;
     for (int64_t i = 0; i < SamplesCount + 1; i++, x += Dx)
     {
-        float const c1 = sinf(x * Frequency1) * 10.f;
-        float const c2 = sinf(x * Frequency2) * 6.f;
-        float const c3 = sinf(x * Frequency3) * 45.f;
+        float const c1 = sinf(x * Frequency1) * Amplitude1;
+        float const c2 = sinf(x * Frequency2) * Amplitude2;
+        float const c3 = sinf(x * Frequency3) * Amplitude3;
 
         mSamples[i] = (c1 + c2 - c3) - gameParameters.SeaDepth;
     }
+
+    mProfile.Offset = -gameParameters.SeaDepth;
 }
 
 }
\ No newline at end of file
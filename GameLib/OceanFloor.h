@@ -36,6 +36,14 @@ public:
             + (mSamples[index + 1] - mSamples[index]) * ((x / Dx) - absoluteSampleIndex);
     }
 
+    /*
+     * The exact profile that the samples are taken from.
+     */
+    SineWavesProfile const & GetProfile() const
+    {
+        return mProfile;
+    }
+
 private:
 
     // Frequencies of the wave components
@@ -43,6 +51,11 @@ private:
     static constexpr float Frequency2 = 0.015f;
     static constexpr float Frequency3 = 0.001f;
 
+    // Amplitudes of the wave components
+    static constexpr float Amplitude1 = 10.0f;
+    static constexpr float Amplitude2 = 6.0f;
+    static constexpr float Amplitude3 = 45.0f;
+
     // Period of the sum of the frequency components
     static constexpr float Period = 2000.0f * Pi<float>;
 
@@ -56,6 +69,8 @@ private:
 
     // The samples
     std::unique_ptr<float[]> mSamples;    
+
+    SineWavesProfile mProfile;
 };
 
 }
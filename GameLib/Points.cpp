@@ -5,6 +5,9 @@
 ***************************************************************************************/
 #include "Physics.h"
 
+#include "GameException.h"
+
+#include <array>
 #include <cmath>
 #include <limits>
 
@@ -33,6 +36,8 @@ void Points::Add(
 
     mLightBuffer.emplace_back(0.0f);
 
+    mStressBuffer.emplace_back(0.0f);
+
     mNetworkBuffer.emplace_back();
 
     mConnectedComponentIdBuffer.emplace_back(0u);
@@ -95,7 +100,7 @@ void Points::Breach(
 
 void Points::Upload(
     int shipId,
-    RenderContext & renderContext) const
+    IRenderBackend & renderContext) const
 {
     // Upload immutable attributes, if we haven't uploaded them yet
     if (!mAreImmutableRenderAttributesUploaded)
@@ -109,18 +114,19 @@ void Points::Upload(
         mAreImmutableRenderAttributesUploaded = true;
     }
 
-    // Upload mutable attributes
+    // Upload mutable attributes - stress only if it's shown
     renderContext.UploadShipPoints(
         shipId,  
         mElementCount,
         mPositionBuffer.data(),
         mLightBuffer.data(),
-        mWaterBuffer.data());
+        mWaterBuffer.data(),
+        renderContext.GetShowStressedSprings() ? mStressBuffer.data() : nullptr);
 }
 
 void Points::UploadElements(
     int shipId,
-    RenderContext & renderContext) const
+    IRenderBackend & renderContext) const
 {
     for (ElementIndex i : *this)
     {
@@ -153,6 +159,158 @@ void Points::SetMassToMaterialOffset(
     }
 }
 
+void Points::WriteSnapshot(SnapshotWriter & writer) const
+{
+    writer.WriteBuffer(mIsDeletedBuffer, mElementCount);
+
+    // Materials are stored by their structural colour
+    for (ElementIndex i : *this)
+    {
+        writer.Write(mMaterialBuffer[i]->StructuralColourRgb);
+    }
+
+    writer.WriteBuffer(mPositionBuffer, mElementCount);
+    writer.WriteBuffer(mVelocityBuffer, mElementCount);
+    writer.WriteBuffer(mForceBuffer, mElementCount);
+    writer.WriteBuffer(mIntegrationFactorBuffer, mElementCount);
+    writer.WriteBuffer(mMassBuffer, mElementCount);
+
+    writer.WriteBuffer(mBuoyancyBuffer, mElementCount);
+    writer.WriteBuffer(mWaterBuffer, mElementCount);
+    writer.WriteBuffer(mIsLeakingBuffer, mElementCount);
+
+    writer.WriteBuffer(mLightBuffer, mElementCount);
+
+    writer.WriteBuffer(mStressBuffer, mElementCount);
+
+    for (ElementIndex i : *this)
+    {
+        auto const & network = mNetworkBuffer[i];
+
+        writer.Write<uint32_t>(static_cast<uint32_t>(network.ConnectedSprings.size()));
+        for (auto springIndex : network.ConnectedSprings)
+        {
+            writer.Write(springIndex);
+        }
+
+        writer.Write<uint32_t>(static_cast<uint32_t>(network.ConnectedTriangles.size()));
+        for (auto triangleIndex : network.ConnectedTriangles)
+        {
+            writer.Write(triangleIndex);
+        }
+
+        writer.Write(network.ConnectedElectricalElement);
+    }
+
+    writer.WriteBuffer(mConnectedComponentIdBuffer, mElementCount);
+
+    writer.WriteBuffer(mIsPinnedBuffer, mElementCount);
+
+    writer.WriteBuffer(mColorBuffer, mElementCount);
+    writer.WriteBuffer(mTextureCoordinatesBuffer, mElementCount);
+}
+
+void Points::ReadSnapshot(
+    SnapshotReader & reader,
+    ElementCount springCount,
+    ElementCount triangleCount,
+    ElementCount electricalElementCount,
+    MaterialDatabase const & materials)
+{
+    reader.ReadBuffer(mIsDeletedBuffer, mElementCount);
+
+    for (ElementIndex i = 0; i < mElementCount; ++i)
+    {
+        Material const * material = materials.Get(reader.Read<std::array<uint8_t, 3u>>());
+        if (nullptr == material)
+        {
+            throw GameException("Unknown material");
+        }
+
+        mMaterialBuffer.emplace_back(material);
+    }
+
+    reader.ReadBuffer(mPositionBuffer, mElementCount);
+    reader.ReadBuffer(mVelocityBuffer, mElementCount);
+    reader.ReadBuffer(mForceBuffer, mElementCount);
+    reader.ReadBuffer(mIntegrationFactorBuffer, mElementCount);
+    reader.ReadBuffer(mMassBuffer, mElementCount);
+
+    reader.ReadBuffer(mBuoyancyBuffer, mElementCount);
+    reader.ReadBuffer(mWaterBuffer, mElementCount);
+    reader.ReadBuffer(mIsLeakingBuffer, mElementCount);
+
+    reader.ReadBuffer(mLightBuffer, mElementCount);
+
+    reader.ReadBuffer(mStressBuffer, mElementCount);
+
+    for (ElementIndex i = 0; i < mElementCount; ++i)
+    {
+        auto & network = mNetworkBuffer.emplace_back();
+
+        uint32_t const connectedSpringCount = reader.Read<uint32_t>();
+        if (connectedSpringCount > network.ConnectedSprings.max_size())
+        {
+            throw GameException("Too many connected springs");
+        }
+
+        for (uint32_t s = 0; s < connectedSpringCount; ++s)
+        {
+            ElementIndex const springIndex = reader.Read<ElementIndex>();
+            if (springIndex >= springCount || network.ConnectedSprings.is_in(springIndex))
+            {
+                throw GameException("Connected spring out of range");
+            }
+
+            network.ConnectedSprings.push_back(springIndex);
+        }
+
+        uint32_t const connectedTriangleCount = reader.Read<uint32_t>();
+        if (connectedTriangleCount > network.ConnectedTriangles.max_size())
+        {
+            throw GameException("Too many connected triangles");
+        }
+
+        for (uint32_t t = 0; t < connectedTriangleCount; ++t)
+        {
+            ElementIndex const triangleIndex = reader.Read<ElementIndex>();
+            if (triangleIndex >= triangleCount || network.ConnectedTriangles.is_in(triangleIndex))
+            {
+                throw GameException("Connected triangle out of range");
+            }
+
+            network.ConnectedTriangles.push_back(triangleIndex);
+        }
+
+        network.ConnectedElectricalElement = reader.Read<ElementIndex>();
+        if (NoneElementIndex != network.ConnectedElectricalElement
+            && network.ConnectedElectricalElement >= electricalElementCount)
+        {
+            throw GameException("Connected electrical element out of range");
+        }
+
+        mCurrentConnectedComponentDetectionStepSequenceNumberBuffer.emplace_back(0u);
+    }
+
+    reader.ReadBuffer(mConnectedComponentIdBuffer, mElementCount);
+
+    // There are at most as many connected components as points
+    for (ElementIndex i = 0; i < mElementCount; ++i)
+    {
+        if (mConnectedComponentIdBuffer[i] > mElementCount)
+        {
+            throw GameException("Connected component out of range");
+        }
+    }
+
+    reader.ReadBuffer(mIsPinnedBuffer, mElementCount);
+
+    reader.ReadBuffer(mColorBuffer, mElementCount);
+    reader.ReadBuffer(mTextureCoordinatesBuffer, mElementCount);
+
+    mAreImmutableRenderAttributesUploaded = false;
+}
+
 vec2f Points::CalculateIntegrationFactor(float mass)
 {
     assert(mass > 0.0f);
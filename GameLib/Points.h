@@ -8,11 +8,13 @@
 #include "Buffer.h"
 #include "ElementContainer.h"
 #include "FixedSizeVector.h"
+#include "GameEventDispatcher.h"
 #include "GameParameters.h"
 #include "GameTypes.h"
-#include "IGameEventHandler.h"
+#include "IRenderBackend.h"
 #include "Material.h"
-#include "RenderContext.h"
+#include "MaterialDatabase.h"
+#include "Snapshot.h"
 #include "Vectors.h"
 
 #include <cassert>
@@ -52,7 +54,7 @@ public:
     Points(
         ElementCount elementCount,
         World & parentWorld,
-        std::shared_ptr<IGameEventHandler> gameEventHandler)
+        std::shared_ptr<GameEventDispatcher> gameEventHandler)
         : ElementContainer(elementCount)
         //////////////////////////////////
         // Buffers
@@ -71,6 +73,8 @@ public:
         , mIsLeakingBuffer(elementCount)
         // Electrical dynamics
         , mLightBuffer(elementCount)
+        // Structural dynamics
+        , mStressBuffer(elementCount)
         // Structure
         , mNetworkBuffer(elementCount)
         // Connected component
@@ -126,11 +130,30 @@ public:
 
     void Upload(
         int shipId,
-        RenderContext & renderContext) const;
+        IRenderBackend & renderContext) const;
 
     void UploadElements(
         int shipId,
-        RenderContext & renderContext) const;
+        IRenderBackend & renderContext) const;
+
+    /*
+     * Writes the state of all points to a snapshot.
+     */
+    void WriteSnapshot(SnapshotWriter & writer) const;
+
+    /*
+     * Reads the state of all points from a snapshot; only valid on a container that
+     * has just been constructed with the snapshot's number of points.
+     *
+     * Throws if a point is connected to an element that is not one of the specified
+     * numbers of springs, triangles, and electrical elements.
+     */
+    void ReadSnapshot(
+        SnapshotReader & reader,
+        ElementCount springCount,
+        ElementCount triangleCount,
+        ElementCount electricalElementCount,
+        MaterialDatabase const & materials);
 
 public:
 
@@ -314,6 +337,24 @@ public:
         return mLightBuffer[pointElementIndex];
     }
 
+    //
+    // Structural dynamics
+    //
+
+    inline float GetStress(ElementIndex pointElementIndex) const
+    {
+        assert(pointElementIndex < mElementCount);
+
+        return mStressBuffer[pointElementIndex];
+    }
+
+    inline float & GetStress(ElementIndex pointElementIndex)
+    {
+        assert(pointElementIndex < mElementCount);
+
+        return mStressBuffer[pointElementIndex];
+    }
+
     //
     // Network
     //
@@ -520,6 +561,15 @@ private:
     // Total illumination, 0.0->1.0
     Buffer<float> mLightBuffer;
 
+    //
+    // Structural dynamics
+    //
+
+    // Number of stressed springs connected to the point, maintained by the springs as they
+    // enter and exit the stressed state; uploaded as-is, so that stress may be drawn
+    // without going through the springs
+    Buffer<float> mStressBuffer;
+
     //
     // Structure
     //
@@ -552,7 +602,7 @@ private:
     //////////////////////////////////////////////////////////
 
     World & mParentWorld;
-    std::shared_ptr<IGameEventHandler> const mGameEventHandler;
+    std::shared_ptr<GameEventDispatcher> const mGameEventHandler;
 
     // The handler registered for point deletions
     DestroyHandler mDestroyHandler;
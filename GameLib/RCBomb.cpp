@@ -13,10 +13,11 @@ RCBomb::RCBomb(
     ObjectId id,
     ElementIndex springIndex,
     World & parentWorld,
-    std::shared_ptr<IGameEventHandler> gameEventHandler,
+    std::shared_ptr<GameEventDispatcher> gameEventHandler,
     BlastHandler blastHandler,
     Points & shipPoints,
-    Springs & shipSprings)
+    Springs & shipSprings,
+    GameParameters const & /*gameParameters*/)
     : Bomb(
         id,
         BombType::RCBomb,
@@ -27,13 +28,45 @@ RCBomb::RCBomb(
         shipPoints,
         shipSprings)
     , mState(State::IdlePingOff)
-    , mNextStateTransitionTimePoint(GameWallClock::GetInstance().Now() + SlowPingOffInterval)
+    , mNextStateTransitionTimePoint(parentWorld.GetCurrentClockTime() + SlowPingOffInterval)
     , mExplosionTimePoint(GameWallClock::time_point::min())
     , mPingOnStepCounter(0u)
     , mExplodingStepCounter(0u)
 {
 }
 
+RCBomb::RCBomb(
+    ObjectId id,
+    SnapshotReader & reader,
+    GameWallClock::time_point now,
+    World & parentWorld,
+    std::shared_ptr<GameEventDispatcher> gameEventHandler,
+    BlastHandler blastHandler,
+    Points & shipPoints,
+    Springs & shipSprings)
+    : Bomb(
+        id,
+        BombType::RCBomb,
+        reader,
+        parentWorld,
+        std::move(gameEventHandler),
+        blastHandler,
+        shipPoints,
+        shipSprings)
+    // Read in declaration order
+    , mState(static_cast<State>(reader.Read<uint8_t>()))
+    , mNextStateTransitionTimePoint(FromSnapshotTime(reader.Read<int64_t>(), now))
+    , mExplosionTimePoint(FromSnapshotTime(reader.Read<int64_t>(), now))
+    , mPingOnStepCounter(reader.Read<uint8_t>())
+    , mExplodingStepCounter(reader.Read<uint8_t>())
+{
+    if (mState > State::Expired
+        || mExplodingStepCounter >= ExplosionStepsCount)
+    {
+        throw GameException("Invalid RC bomb state");
+    }
+}
+
 bool RCBomb::Update(
     GameWallClock::time_point now,
     GameParameters const & gameParameters)
@@ -139,7 +172,7 @@ bool RCBomb::Update(
 
 void RCBomb::Upload(
     int shipId,
-    RenderContext & renderContext) const
+    IRenderBackend & renderContext) const
 {
     switch (mState)
     {
@@ -222,6 +255,19 @@ void RCBomb::Upload(
     }
 }
 
+void RCBomb::WriteSnapshot(
+    SnapshotWriter & writer,
+    GameWallClock::time_point now) const
+{
+    WriteBaseSnapshot(writer);
+
+    writer.Write<uint8_t>(static_cast<uint8_t>(mState));
+    writer.Write<int64_t>(ToSnapshotTime(mNextStateTransitionTimePoint, now));
+    writer.Write<int64_t>(ToSnapshotTime(mExplosionTimePoint, now));
+    writer.Write(mPingOnStepCounter);
+    writer.Write(mExplodingStepCounter);
+}
+
 void RCBomb::Detonate()
 {
     if (State::IdlePingOff == mState
@@ -231,7 +277,7 @@ void RCBomb::Detonate()
         // Transition to DetonationLeadIn state
         //
 
-        auto now = GameWallClock::GetInstance().Now();
+        auto now = mParentWorld.GetCurrentClockTime();
 
         TransitionToDetonationLeadIn(now);
 
@@ -26,7 +26,18 @@ public:
         ObjectId id,
         ElementIndex springIndex,
         World & parentWorld,
-        std::shared_ptr<IGameEventHandler> gameEventHandler,
+        std::shared_ptr<GameEventDispatcher> gameEventHandler,
+        BlastHandler blastHandler,
+        Points & shipPoints,
+        Springs & shipSprings,
+        GameParameters const & gameParameters);
+
+    RCBomb(
+        ObjectId id,
+        SnapshotReader & reader,
+        GameWallClock::time_point now,
+        World & parentWorld,
+        std::shared_ptr<GameEventDispatcher> gameEventHandler,
         BlastHandler blastHandler,
         Points & shipPoints,
         Springs & shipSprings);
@@ -55,7 +66,11 @@ public:
 
     virtual void Upload(
         int shipId,
-        RenderContext & renderContext) const override;
+        IRenderBackend & renderContext) const override;
+
+    virtual void WriteSnapshot(
+        SnapshotWriter & writer,
+        GameWallClock::time_point now) const override;
 
     void Detonate();
 
@@ -0,0 +1,206 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-14
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "RecordingRenderBackend.h"
+
+size_t RecordingRenderBackend::RecordedUploads::GetTotalBytes() const
+{
+    return Clouds.Bytes
+        + LandAndWater.Bytes
+        + ShipPointImmutableGraphicalAttributes.Bytes
+        + ShipPoints.Bytes
+        + ShipElementPoints.Bytes
+        + ShipElementSprings.Bytes
+        + ShipElementRopes.Bytes
+        + ShipElementTriangles.Bytes
+        + ShipElementCoarseTriangles.Bytes
+        + RemovedShipElements.Bytes
+        + ShipPinnedPoints.Bytes
+        + ShipBombs.Bytes;
+}
+
+RecordingRenderBackend::RecordingRenderBackend()
+    : mRecordedUploads()
+    , mFrameCount(0)
+    , mRenderedShipCount(0)
+{
+}
+
+void RecordingRenderBackend::Reset()
+{
+    mRecordedUploads = RecordedUploads();
+    mFrameCount = 0;
+    mRenderedShipCount = 0;
+}
+
+void RecordingRenderBackend::RenderCloud(
+    float /*virtualX*/,
+    float /*virtualY*/,
+    float /*scale*/)
+{
+    mRecordedUploads.Clouds.Record(1, 3 * sizeof(float));
+}
+
+void RecordingRenderBackend::UploadLandAndWater(
+    SineWavesProfile const & /*landProfile*/,
+    SineWavesProfile const & /*waterProfile*/,
+    float /*restWaterHeight*/)
+{
+    mRecordedUploads.LandAndWater.Record(1, 2 * sizeof(SineWavesProfile) + sizeof(float));
+}
+
+void RecordingRenderBackend::UploadShipPointImmutableGraphicalAttributes(
+    int /*shipId*/,
+    size_t count,
+    vec3f const * restrict /*color*/,
+    vec2f const * restrict /*textureCoordinates*/)
+{
+    mRecordedUploads.ShipPointImmutableGraphicalAttributes.Record(
+        count,
+        count * (sizeof(vec3f) + sizeof(vec2f)));
+}
+
+void RecordingRenderBackend::UploadShipPoints(
+    int /*shipId*/,
+    size_t count,
+    vec2f const * restrict /*position*/,
+    float const * restrict /*light*/,
+    float const * restrict /*water*/,
+    float const * restrict stress)
+{
+    // Same accounting as RenderContext's frame statistics
+    mRecordedUploads.ShipPoints.Record(
+        count,
+        count * (sizeof(vec2f) + sizeof(float) + sizeof(float) + (nullptr != stress ? sizeof(float) : 0)));
+}
+
+void RecordingRenderBackend::UploadShipElementPoint(
+    int /*shipId*/,
+    int /*shipPointIndex*/,
+    ConnectedComponentId /*connectedComponentId*/)
+{
+    mRecordedUploads.ShipElementPoints.Record(1, sizeof(int));
+}
+
+void RecordingRenderBackend::UploadShipElementSpring(
+    int /*shipId*/,
+    ElementIndex /*shipSpringIndex*/,
+    int /*shipPointIndex1*/,
+    int /*shipPointIndex2*/,
+    bool /*isCoarse*/,
+    ConnectedComponentId /*connectedComponentId*/)
+{
+    mRecordedUploads.ShipElementSprings.Record(1, 2 * sizeof(int));
+}
+
+void RecordingRenderBackend::UploadShipElementRope(
+    int /*shipId*/,
+    ElementIndex /*shipSpringIndex*/,
+    int /*shipPointIndex1*/,
+    int /*shipPointIndex2*/,
+    ConnectedComponentId /*connectedComponentId*/)
+{
+    mRecordedUploads.ShipElementRopes.Record(1, 2 * sizeof(int));
+}
+
+void RecordingRenderBackend::UploadShipElementTriangle(
+    int /*shipId*/,
+    ElementIndex /*shipTriangleIndex*/,
+    int /*shipPointIndex1*/,
+    int /*shipPointIndex2*/,
+    int /*shipPointIndex3*/,
+    ConnectedComponentId /*connectedComponentId*/)
+{
+    mRecordedUploads.ShipElementTriangles.Record(1, 3 * sizeof(int));
+}
+
+void RecordingRenderBackend::UploadShipElementCoarseTriangle(
+    int /*shipId*/,
+    ElementIndex /*shipCoarseTriangleIndex*/,
+    int /*shipPointIndex1*/,
+    int /*shipPointIndex2*/,
+    int /*shipPointIndex3*/,
+    ConnectedComponentId /*connectedComponentId*/)
+{
+    mRecordedUploads.ShipElementCoarseTriangles.Record(1, 3 * sizeof(int));
+}
+
+void RecordingRenderBackend::InsertShipElementCoarseTriangle(
+    int /*shipId*/,
+    ElementIndex /*shipCoarseTriangleIndex*/,
+    int /*shipPointIndex1*/,
+    int /*shipPointIndex2*/,
+    int /*shipPointIndex3*/,
+    ConnectedComponentId /*connectedComponentId*/)
+{
+    mRecordedUploads.ShipElementCoarseTriangles.Record(1, 3 * sizeof(int));
+}
+
+void RecordingRenderBackend::RemoveShipElementPoint(
+    int /*shipId*/,
+    int /*shipPointIndex*/)
+{
+    mRecordedUploads.RemovedShipElements.Record(1, 0);
+}
+
+void RecordingRenderBackend::RemoveShipElementSpring(
+    int /*shipId*/,
+    ElementIndex /*shipSpringIndex*/)
+{
+    mRecordedUploads.RemovedShipElements.Record(1, 0);
+}
+
+void RecordingRenderBackend::RemoveShipElementRope(
+    int /*shipId*/,
+    ElementIndex /*shipSpringIndex*/)
+{
+    mRecordedUploads.RemovedShipElements.Record(1, 0);
+}
+
+void RecordingRenderBackend::RemoveShipElementTriangle(
+    int /*shipId*/,
+    ElementIndex /*shipTriangleIndex*/)
+{
+    mRecordedUploads.RemovedShipElements.Record(1, 0);
+}
+
+void RecordingRenderBackend::RemoveShipElementCoarseTriangle(
+    int /*shipId*/,
+    ElementIndex /*shipCoarseTriangleIndex*/)
+{
+    mRecordedUploads.RemovedShipElements.Record(1, 0);
+}
+
+void RecordingRenderBackend::UploadShipElementPinnedPoint(
+    int /*shipId*/,
+    float /*x*/,
+    float /*y*/,
+    ConnectedComponentId /*connectedComponentId*/)
+{
+    mRecordedUploads.ShipPinnedPoints.Record(1, 2 * sizeof(float));
+}
+
+void RecordingRenderBackend::UploadShipElementBomb(
+    int /*shipId*/,
+    BombType /*bombType*/,
+    RotatedTextureRenderInfo const & /*renderInfo*/,
+    std::optional<uint32_t> /*lightedFrameIndex*/,
+    std::optional<uint32_t> /*unlightedFrameIndex*/,
+    ConnectedComponentId /*connectedComponentId*/)
+{
+    mRecordedUploads.ShipBombs.Record(1, sizeof(RotatedTextureRenderInfo));
+}
+
+void RecordingRenderBackend::RenderShip(
+    int /*shipId*/,
+    std::vector<Geometry::AABB> const & /*connectedComponentAABBs*/)
+{
+    ++mRenderedShipCount;
+}
+
+void RecordingRenderBackend::RenderEnd()
+{
+    ++mFrameCount;
+}
@@ -0,0 +1,207 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-14
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "NullRenderBackend.h"
+
+#include <cstddef>
+
+/*
+ * A render backend that renders nothing, but keeps count of the data that it's handed,
+ * per kind of upload.
+ */
+class RecordingRenderBackend final : public NullRenderBackend
+{
+public:
+
+    struct UploadStatistics
+    {
+        // The number of upload calls
+        size_t Calls;
+
+        // The number of elements uploaded by the calls
+        size_t Elements;
+
+        // The number of bytes of data handed over by the calls
+        size_t Bytes;
+
+        UploadStatistics()
+            : Calls(0)
+            , Elements(0)
+            , Bytes(0)
+        {}
+
+        void Record(
+            size_t elements,
+            size_t bytes)
+        {
+            ++Calls;
+            Elements += elements;
+            Bytes += bytes;
+        }
+    };
+
+    struct RecordedUploads
+    {
+        UploadStatistics Clouds;
+        UploadStatistics LandAndWater;
+        UploadStatistics ShipPointImmutableGraphicalAttributes;
+        UploadStatistics ShipPoints;
+        UploadStatistics ShipElementPoints;
+        UploadStatistics ShipElementSprings;
+        UploadStatistics ShipElementRopes;
+        UploadStatistics ShipElementTriangles;
+        UploadStatistics ShipElementCoarseTriangles;
+        UploadStatistics RemovedShipElements;
+        UploadStatistics ShipPinnedPoints;
+        UploadStatistics ShipBombs;
+
+        size_t GetTotalBytes() const;
+    };
+
+public:
+
+    RecordingRenderBackend();
+
+    RecordedUploads const & GetRecordedUploads() const
+    {
+        return mRecordedUploads;
+    }
+
+    /*
+     * The number of frames rendered since the last reset.
+     */
+    size_t GetFrameCount() const
+    {
+        return mFrameCount;
+    }
+
+    /*
+     * The number of ships rendered since the last reset.
+     */
+    size_t GetRenderedShipCount() const
+    {
+        return mRenderedShipCount;
+    }
+
+    void Reset();
+
+public:
+
+    virtual void RenderCloud(
+        float virtualX,
+        float virtualY,
+        float scale) override;
+
+    virtual void UploadLandAndWater(
+        SineWavesProfile const & landProfile,
+        SineWavesProfile const & waterProfile,
+        float restWaterHeight) override;
+
+    virtual void UploadShipPointImmutableGraphicalAttributes(
+        int shipId,
+        size_t count,
+        vec3f const * restrict color,
+        vec2f const * restrict textureCoordinates) override;
+
+    virtual void UploadShipPoints(
+        int shipId,
+        size_t count,
+        vec2f const * restrict position,
+        float const * restrict light,
+        float const * restrict water,
+        float const * restrict stress) override;
+
+    virtual void UploadShipElementPoint(
+        int shipId,
+        int shipPointIndex,
+        ConnectedComponentId connectedComponentId) override;
+
+    virtual void UploadShipElementSpring(
+        int shipId,
+        ElementIndex shipSpringIndex,
+        int shipPointIndex1,
+        int shipPointIndex2,
+        bool isCoarse,
+        ConnectedComponentId connectedComponentId) override;
+
+    virtual void UploadShipElementRope(
+        int shipId,
+        ElementIndex shipSpringIndex,
+        int shipPointIndex1,
+        int shipPointIndex2,
+        ConnectedComponentId connectedComponentId) override;
+
+    virtual void UploadShipElementTriangle(
+        int shipId,
+        ElementIndex shipTriangleIndex,
+        int shipPointIndex1,
+        int shipPointIndex2,
+        int shipPointIndex3,
+        ConnectedComponentId connectedComponentId) override;
+
+    virtual void UploadShipElementCoarseTriangle(
+        int shipId,
+        ElementIndex shipCoarseTriangleIndex,
+        int shipPointIndex1,
+        int shipPointIndex2,
+        int shipPointIndex3,
+        ConnectedComponentId connectedComponentId) override;
+
+    virtual void InsertShipElementCoarseTriangle(
+        int shipId,
+        ElementIndex shipCoarseTriangleIndex,
+        int shipPointIndex1,
+        int shipPointIndex2,
+        int shipPointIndex3,
+        ConnectedComponentId connectedComponentId) override;
+
+    virtual void RemoveShipElementPoint(
+        int shipId,
+        int shipPointIndex) override;
+
+    virtual void RemoveShipElementSpring(
+        int shipId,
+        ElementIndex shipSpringIndex) override;
+
+    virtual void RemoveShipElementRope(
+        int shipId,
+        ElementIndex shipSpringIndex) override;
+
+    virtual void RemoveShipElementTriangle(
+        int shipId,
+        ElementIndex shipTriangleIndex) override;
+
+    virtual void RemoveShipElementCoarseTriangle(
+        int shipId,
+        ElementIndex shipCoarseTriangleIndex) override;
+
+    virtual void UploadShipElementPinnedPoint(
+        int shipId,
+        float x,
+        float y,
+        ConnectedComponentId connectedComponentId) override;
+
+    virtual void UploadShipElementBomb(
+        int shipId,
+        BombType bombType,
+        RotatedTextureRenderInfo const & renderInfo,
+        std::optional<uint32_t> lightedFrameIndex,
+        std::optional<uint32_t> unlightedFrameIndex,
+        ConnectedComponentId connectedComponentId) override;
+
+    virtual void RenderShip(
+        int shipId,
+        std::vector<Geometry::AABB> const & connectedComponentAABBs) override;
+
+    virtual void RenderEnd() override;
+
+private:
+
+    RecordedUploads mRecordedUploads;
+    size_t mFrameCount;
+    size_t mRenderedShipCount;
+};
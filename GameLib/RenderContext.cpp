@@ -6,6 +6,9 @@
 #include "RenderContext.h"
 
 #include "GameException.h"
+#include "TaskThreadPool.h"
+#include "TextureCache.h"
+#include "Trace.h"
 
 #include <cstring>
 
@@ -26,21 +29,27 @@ RenderContext::RenderContext(
     , mLandShaderProgram()
     , mLandShaderAmbientLightIntensityParameter(0)
     , mLandShaderOrthoMatrixParameter(0)
-    , mLandBuffer()
-    , mLandBufferSize(0u)
-    , mLandBufferMaxSize(0u)
-    , mLandVBO()
+    , mLandShaderVisibleWorldParameter(0)
+    , mLandShaderLandProfileParameter(0)
+    , mLandShaderLandOffsetParameter(0)
     , mLandTexture()
+    , mLandProfile()
     // Water
     , mWaterShaderProgram()
     , mWaterShaderAmbientLightIntensityParameter(0)
     , mWaterShaderWaterTransparencyParameter(0)
     , mWaterShaderOrthoMatrixParameter(0)
-    , mWaterBuffer()
-    , mWaterBufferSize(0u)
-    , mWaterBufferMaxSize(0u)
-    , mWaterVBO()
+    , mWaterShaderVisibleWorldParameter(0)
+    , mWaterShaderLandProfileParameter(0)
+    , mWaterShaderLandOffsetParameter(0)
+    , mWaterShaderWaterProfileParameter(0)
+    , mWaterShaderWaterOffsetParameter(0)
+    , mWaterShaderRestWaterHeightParameter(0)
     , mWaterTexture()
+    , mWaterProfile()
+    , mRestWaterHeight(0.0f)
+    // Land and water slices
+    , mLandAndWaterSliceVBO()
     // Ships
     , mShips()
     , mRopeColour(ropeColour)
@@ -69,7 +78,14 @@ RenderContext::RenderContext(
     , mShowShipThroughWater(false)
     , mShipRenderMode(ShipRenderMode::Texture)
     , mShowStressedSprings(false)
+    // Statistics
+    , mCurrentFrameStatistics()
+    , mLastFrameStatistics()
+    , mAreRenderStatisticsSynchronous(false)
+    , mFrameStartTime()
 {
+    TraceSpan span("RenderContext::RenderContext");
+
     GLuint tmpGLuint;
 
     //
@@ -85,45 +101,67 @@ RenderContext::RenderContext(
     //
     // Load textures
     //
+    // Textures are loaded - from the texture cache when possible - on a pool of threads,
+    // while we go ahead with compiling shaders; each texture is waited for - or loaded
+    // right away on this thread, if no thread has got to it yet - where it's uploaded
+    //
 
-    auto cloudTextureDatas = resourceLoader.LoadTexturesRgba(
-        "cloud",
-        [&progressCallback](float progress, std::string const &)
-        {
-            if (progressCallback)
-                progressCallback(progress / 6.0f, "Loading textures...");
-        });
+    TextureCache const textureCache(resourceLoader.GetTextureCacheDirectoryPath());
+    TaskThreadPool textureLoadingThreadPool(TaskThreadPool::GetDefaultThreadCount());
 
-    if (progressCallback)
-        progressCallback(2.0f/6.0f, "Loading textures...");
+    using TextureLoadTask = std::shared_ptr<OnDemandTask<DecodedTexture>>;
 
-    auto landTextureData = resourceLoader.LoadTextureRgba(std::string("sand_1.jpg"));
+    auto const startTextureLoad = [&](std::filesystem::path filePath, bool withMipmaps) -> TextureLoadTask
+    {
+        auto task = std::make_shared<OnDemandTask<DecodedTexture>>(
+            [&resourceLoader, &textureCache, filePath = std::move(filePath), withMipmaps]()
+            {
+                return resourceLoader.LoadDecodedTextureRgba(filePath, withMipmaps, &textureCache);
+            });
 
-    if (progressCallback)
-        progressCallback(3.0f / 6.0f, "Loading textures...");
+        OnDemandTask<DecodedTexture>::Prefetch(task, textureLoadingThreadPool);
 
-    auto waterTextureData = resourceLoader.LoadTextureRgba(std::string("water_1.jpg"));
+        return task;
+    };
 
-    if (progressCallback)
-        progressCallback(4.0f / 6.0f, "Loading textures...");
+    std::vector<TextureLoadTask> cloudTextureLoads;
+    for (auto const & filePath : resourceLoader.GetTextureFilePaths("cloud"))
+        cloudTextureLoads.push_back(startTextureLoad(filePath, false));
 
-    auto pinnedPointTextureData = resourceLoader.LoadTextureRgba(std::string("pin_down_1.png"));
+    TextureLoadTask const landTextureLoad = startTextureLoad(resourceLoader.GetTextureFilePath("sand_1.jpg"), false);
 
-    auto rcBombTextureDatas = resourceLoader.LoadTexturesRgba(
-        "rc_bomb",
-        [&progressCallback](float progress, std::string const &)
-        {
-            if (progressCallback)
-                progressCallback((4.0f + progress) / 6.0f, "Loading textures...");
-        });
+    TextureLoadTask const waterTextureLoad = startTextureLoad(resourceLoader.GetTextureFilePath("water_1.jpg"), false);
+
+    TextureLoadTask const pinnedPointTextureLoad = startTextureLoad(resourceLoader.GetTextureFilePath("pin_down_1.png"), true);
 
-    auto timerBombTextureDatas = resourceLoader.LoadTexturesRgba(
-        "timer_bomb",
-        [&progressCallback](float progress, std::string const &)
+    std::vector<TextureLoadTask> rcBombTextureLoads;
+    for (auto const & filePath : resourceLoader.GetTextureFilePaths("rc_bomb"))
+        rcBombTextureLoads.push_back(startTextureLoad(filePath, true));
+
+    std::vector<TextureLoadTask> timerBombTextureLoads;
+    for (auto const & filePath : resourceLoader.GetTextureFilePaths("timer_bomb"))
+        timerBombTextureLoads.push_back(startTextureLoad(filePath, true));
+
+    size_t const textureCount =
+        cloudTextureLoads.size()
+        + 3
+        + rcBombTextureLoads.size()
+        + timerBombTextureLoads.size();
+
+    size_t loadedTextureCount = 0;
+
+    auto const waitForTexture = [&](TextureLoadTask const & textureLoad) -> DecodedTexture const &
     {
+        TraceSpan waitSpan("RenderContext::WaitForTexture");
+
+        DecodedTexture const & texture = textureLoad->Get();
+
+        ++loadedTextureCount;
         if (progressCallback)
-            progressCallback((5.0f + progress) / 6.0f, "Loading textures...");
-    });
+            progressCallback(static_cast<float>(loadedTextureCount) / static_cast<float>(textureCount), "Loading textures...");
+
+        return texture;
+    };
 
 
     //
@@ -190,8 +228,10 @@ RenderContext::RenderContext(
     glUseProgram(0);
 
     // Create textures
-    for (size_t i = 0; i < cloudTextureDatas.size(); ++i)
+    for (size_t i = 0; i < cloudTextureLoads.size(); ++i)
     {
+        DecodedTexture const & cloudTexture = waitForTexture(cloudTextureLoads[i]);
+
         // Create texture name
         glGenTextures(1, &tmpGLuint);
         mCloudTextures.emplace_back(tmpGLuint);
@@ -208,14 +248,14 @@ RenderContext::RenderContext(
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
         // Upload texture data
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, cloudTextureDatas[i].Size.Width, cloudTextureDatas[i].Size.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, cloudTextureDatas[i].Data.get());
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, cloudTexture.GetSize().Width, cloudTexture.GetSize().Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, cloudTexture.GetLevelData(0));
         if (GL_NO_ERROR != glGetError())
         {
             throw GameException("Error uploading cloud texture onto GPU");
         }
 
         // Store size
-        mCloudTextureSizes.push_back(cloudTextureDatas[i].Size);
+        mCloudTextureSizes.push_back(cloudTexture.GetSize());
 
         // Unbind texture
         glBindTexture(GL_TEXTURE_2D, 0);
@@ -234,18 +274,26 @@ RenderContext::RenderContext(
     char const * landVertexShaderSource = R"(
 
         // Inputs
-        attribute vec2 inputPos;
+        attribute vec2 inputSlice;
         
         // Parameters
         uniform mat4 paramOrthoMatrix;
+        uniform vec3 paramVisibleWorld; // Left, bottom, width
+        uniform vec3 paramLandProfile[3]; // Amplitudes, frequencies, phases
+        uniform float paramLandOffset;
 
         // Outputs
         varying vec2 texturePos;
 
         void main()
         {
-            gl_Position = paramOrthoMatrix * vec4(inputPos.xy, -1.0, 1.0);
-            texturePos = inputPos.xy;
+            float x = paramVisibleWorld.x + inputSlice.x * paramVisibleWorld.z;
+            float landHeight = paramLandOffset + dot(paramLandProfile[0], sin(x * paramLandProfile[1] + paramLandProfile[2]));
+
+            vec2 pos = vec2(x, mix(paramVisibleWorld.y, landHeight, inputSlice.y));
+
+            gl_Position = paramOrthoMatrix * vec4(pos, -1.0, 1.0);
+            texturePos = pos;
         }
     )";
 
@@ -272,7 +320,7 @@ RenderContext::RenderContext(
     GameOpenGL::CompileShader(landFragmentShaderSource, GL_FRAGMENT_SHADER, mLandShaderProgram);
 
     // Bind attribute locations
-    glBindAttribLocation(*mLandShaderProgram, 0, "inputPos");
+    glBindAttribLocation(*mLandShaderProgram, 0, "inputSlice");
 
     // Link
     GameOpenGL::LinkShaderProgram(mLandShaderProgram, "Land");
@@ -281,10 +329,9 @@ RenderContext::RenderContext(
     mLandShaderAmbientLightIntensityParameter = GameOpenGL::GetParameterLocation(mLandShaderProgram, "paramAmbientLightIntensity");
     GLint landShaderTextureScalingParameter = GameOpenGL::GetParameterLocation(mLandShaderProgram, "paramTextureScaling");
     mLandShaderOrthoMatrixParameter = GameOpenGL::GetParameterLocation(mLandShaderProgram, "paramOrthoMatrix");
-
-    // Create VBO    
-    glGenBuffers(1, &tmpGLuint);
-    mLandVBO = tmpGLuint;
+    mLandShaderVisibleWorldParameter = GameOpenGL::GetParameterLocation(mLandShaderProgram, "paramVisibleWorld");
+    mLandShaderLandProfileParameter = GameOpenGL::GetParameterLocation(mLandShaderProgram, "paramLandProfile");
+    mLandShaderLandOffsetParameter = GameOpenGL::GetParameterLocation(mLandShaderProgram, "paramLandOffset");
 
     // Calculate scaling: we want a tile to be repeated every these many world units
     static constexpr float LandTileWorldSize = 128.0f;
@@ -313,7 +360,8 @@ RenderContext::RenderContext(
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     // Upload texture data
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, landTextureData.Size.Width, landTextureData.Size.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, landTextureData.Data.get());
+    DecodedTexture const & landTexture = waitForTexture(landTextureLoad);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, landTexture.GetSize().Width, landTexture.GetSize().Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, landTexture.GetLevelData(0));
     GLenum glError = glGetError();
     if (GL_NO_ERROR != glError)
     {
@@ -335,19 +383,31 @@ RenderContext::RenderContext(
     char const * waterVertexShaderSource = R"(
 
         // Inputs
-        attribute vec2 inputPos;
-        attribute float inputTextureY;
+        attribute vec2 inputSlice;
 
         // Parameters
         uniform mat4 paramOrthoMatrix;
+        uniform vec3 paramVisibleWorld; // Left, bottom, width
+        uniform vec3 paramLandProfile[3]; // Amplitudes, frequencies, phases
+        uniform float paramLandOffset;
+        uniform vec3 paramWaterProfile[3]; // Amplitudes, frequencies, phases
+        uniform float paramWaterOffset;
+        uniform float paramRestWaterHeight;
 
         // Outputs
         varying vec2 texturePos;
 
         void main()
         {
-            gl_Position = paramOrthoMatrix * vec4(inputPos.xy, -1.0, 1.0);
-            texturePos = vec2(inputPos.x, inputTextureY);
+            float x = paramVisibleWorld.x + inputSlice.x * paramVisibleWorld.z;
+            float landHeight = paramLandOffset + dot(paramLandProfile[0], sin(x * paramLandProfile[1] + paramLandProfile[2]));
+            float waterHeight = paramWaterOffset + dot(paramWaterProfile[0], sin(x * paramWaterProfile[1] + paramWaterProfile[2]));
+
+            // Make sure that islands are not covered in water!
+            waterHeight = max(waterHeight, landHeight);
+
+            gl_Position = paramOrthoMatrix * vec4(x, mix(landHeight, waterHeight, inputSlice.y), -1.0, 1.0);
+            texturePos = vec2(x, inputSlice.y * paramRestWaterHeight);
         }
     )";
 
@@ -376,8 +436,7 @@ RenderContext::RenderContext(
     GameOpenGL::CompileShader(waterFragmentShaderSource, GL_FRAGMENT_SHADER, mWaterShaderProgram);
 
     // Bind attribute locations
-    glBindAttribLocation(*mWaterShaderProgram, 0, "inputPos");
-    glBindAttribLocation(*mWaterShaderProgram, 1, "inputTextureY");
+    glBindAttribLocation(*mWaterShaderProgram, 0, "inputSlice");
 
     // Link
     GameOpenGL::LinkShaderProgram(mWaterShaderProgram, "Water");
@@ -387,10 +446,12 @@ RenderContext::RenderContext(
     mWaterShaderWaterTransparencyParameter = GameOpenGL::GetParameterLocation(mWaterShaderProgram, "paramWaterTransparency");
     GLint waterShaderTextureScalingParameter = GameOpenGL::GetParameterLocation(mWaterShaderProgram, "paramTextureScaling");
     mWaterShaderOrthoMatrixParameter = GameOpenGL::GetParameterLocation(mWaterShaderProgram, "paramOrthoMatrix");
-
-    // Create VBO
-    glGenBuffers(1, &tmpGLuint);
-    mWaterVBO = tmpGLuint;
+    mWaterShaderVisibleWorldParameter = GameOpenGL::GetParameterLocation(mWaterShaderProgram, "paramVisibleWorld");
+    mWaterShaderLandProfileParameter = GameOpenGL::GetParameterLocation(mWaterShaderProgram, "paramLandProfile");
+    mWaterShaderLandOffsetParameter = GameOpenGL::GetParameterLocation(mWaterShaderProgram, "paramLandOffset");
+    mWaterShaderWaterProfileParameter = GameOpenGL::GetParameterLocation(mWaterShaderProgram, "paramWaterProfile");
+    mWaterShaderWaterOffsetParameter = GameOpenGL::GetParameterLocation(mWaterShaderProgram, "paramWaterOffset");
+    mWaterShaderRestWaterHeightParameter = GameOpenGL::GetParameterLocation(mWaterShaderProgram, "paramRestWaterHeight");
 
     // Calculate scaling: we want a tile to be repeated every these many world units
     static constexpr float WaterTileWorldSize = 128.0f;
@@ -419,7 +480,8 @@ RenderContext::RenderContext(
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     // Upload texture data
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, waterTextureData.Size.Width, waterTextureData.Size.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, waterTextureData.Data.get());
+    DecodedTexture const & waterTexture = waitForTexture(waterTextureLoad);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, waterTexture.GetSize().Width, waterTexture.GetSize().Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, waterTexture.GetLevelData(0));
     if (GL_NO_ERROR != glGetError())
     {
         throw GameException("Error uploading water texture onto GPU");
@@ -429,12 +491,40 @@ RenderContext::RenderContext(
     glBindTexture(GL_TEXTURE_2D, 0);
 
 
+    //
+    // Land and water slices
+    //
+
+    // Create VBO
+    glGenBuffers(1, &tmpGLuint);
+    mLandAndWaterSliceVBO = tmpGLuint;
+
+    // Upload the top and bottom vertices of each slice, once and for all
+    std::vector<vec2f> sliceVertices;
+    sliceVertices.reserve(2 * (LandAndWaterSlicesCount + 1));
+    for (size_t i = 0; i <= LandAndWaterSlicesCount; ++i)
+    {
+        float const sliceX = static_cast<float>(i) / static_cast<float>(LandAndWaterSlicesCount);
+        sliceVertices.emplace_back(sliceX, 1.0f);
+        sliceVertices.emplace_back(sliceX, 0.0f);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, *mLandAndWaterSliceVBO);
+    glBufferData(GL_ARRAY_BUFFER, sliceVertices.size() * sizeof(vec2f), sliceVertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0u);
+
+    // Unbind texture
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+
     //
     // Pinned points
     //
 
+    DecodedTexture const & pinnedPointTexture = waitForTexture(pinnedPointTextureLoad);
+
     // Store texture size
-    mPinnedPointTextureSize = pinnedPointTextureData.Size;
+    mPinnedPointTextureSize = pinnedPointTexture.GetSize();
 
     // Create texture name
     glGenTextures(1, &tmpGLuint);
@@ -444,7 +534,7 @@ RenderContext::RenderContext(
     glBindTexture(GL_TEXTURE_2D, *mPinnedPointTexture);
 
     // Upload texture
-    GameOpenGL::UploadMipmappedTexture(std::move(pinnedPointTextureData));
+    GameOpenGL::UploadTexture(pinnedPointTexture);
 
     // Set repeat mode
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -463,10 +553,12 @@ RenderContext::RenderContext(
     //
 
     // Create textures
-    for (size_t i = 0; i < rcBombTextureDatas.size(); ++i)
+    for (size_t i = 0; i < rcBombTextureLoads.size(); ++i)
     {
+        DecodedTexture const & rcBombTexture = waitForTexture(rcBombTextureLoads[i]);
+
         // Store size
-        mRCBombTextureSizes.push_back(rcBombTextureDatas[i].Size);
+        mRCBombTextureSizes.push_back(rcBombTexture.GetSize());
 
         // Create texture name
         glGenTextures(1, &tmpGLuint);
@@ -476,7 +568,7 @@ RenderContext::RenderContext(
         glBindTexture(GL_TEXTURE_2D, *mRCBombTextures.back());
 
         // Upload texture
-        GameOpenGL::UploadMipmappedTexture(std::move(rcBombTextureDatas[i]));
+        GameOpenGL::UploadTexture(rcBombTexture);
 
         // Set repeat mode
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -496,10 +588,12 @@ RenderContext::RenderContext(
     //
 
     // Create textures
-    for (size_t i = 0; i < timerBombTextureDatas.size(); ++i)
+    for (size_t i = 0; i < timerBombTextureLoads.size(); ++i)
     {
+        DecodedTexture const & timerBombTexture = waitForTexture(timerBombTextureLoads[i]);
+
         // Store size
-        mTimerBombTextureSizes.push_back(timerBombTextureDatas[i].Size);
+        mTimerBombTextureSizes.push_back(timerBombTexture.GetSize());
 
         // Create texture name
         glGenTextures(1, &tmpGLuint);
@@ -509,7 +603,7 @@ RenderContext::RenderContext(
         glBindTexture(GL_TEXTURE_2D, *mTimerBombTextures.back());
 
         // Upload texture
-        GameOpenGL::UploadMipmappedTexture(std::move(timerBombTextureDatas[i]));
+        GameOpenGL::UploadTexture(timerBombTexture);
 
         // Set repeat mode
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -690,6 +784,12 @@ void RenderContext::AddShip(
 
 void RenderContext::RenderStart()
 {
+    if (mAreRenderStatisticsSynchronous)
+        glFinish();
+
+    mCurrentFrameStatistics = RenderStatistics();
+    mFrameStartTime = std::chrono::steady_clock::now();
+
     // Set anti-aliasing for lines and polygons
     glEnable(GL_LINE_SMOOTH);
     glHint(GL_LINE_SMOOTH, GL_NICEST);
@@ -727,22 +827,24 @@ void RenderContext::RenderCloudsStart(size_t clouds)
 
 void RenderContext::RenderCloudsEnd()
 {
+    RenderPassTimer passTimer(mCurrentFrameStatistics.CloudsDuration, mAreRenderStatisticsSynchronous);
+
     //
     // Draw stencil
     //
 
-    // Use matte world program
-    glUseProgram(*mMatteWorldShaderProgram);
+    // Use water program - we only care about its geometry
+    glUseProgram(*mWaterShaderProgram);
 
     // Set parameters
-    glUniform4f(mMatteWorldShaderColorParameter, 1.0f, 1.0f, 1.0f, 1.0f);
-    glUniformMatrix4fv(mMatteWorldShaderOrthoMatrixParameter, 1, GL_FALSE, &(mOrthoMatrix[0][0]));
+    glUniformMatrix4fv(mWaterShaderOrthoMatrixParameter, 1, GL_FALSE, &(mOrthoMatrix[0][0]));
+    SetVisibleWorldParameter(mWaterShaderVisibleWorldParameter);
 
-    // Bind water buffer
-    glBindBuffer(GL_ARRAY_BUFFER, *mWaterVBO);
+    // Bind slice buffer
+    glBindBuffer(GL_ARRAY_BUFFER, *mLandAndWaterSliceVBO);
 
-    // Describe InputPos
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, (2 + 1) * sizeof(float), (void*)0);
+    // Describe InputSlice
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
 
     // Disable writing to the color buffer
@@ -754,7 +856,7 @@ void RenderContext::RenderCloudsEnd()
     glStencilMask(0xFF);
 
     // Draw
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, static_cast<GLsizei>(2 * mWaterBufferSize));
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, static_cast<GLsizei>(2 * (LandAndWaterSlicesCount + 1)));
 
     // Don't write anything to stencil buffer now
     glStencilMask(0x00);
@@ -813,90 +915,61 @@ void RenderContext::RenderCloudsEnd()
     glUseProgram(0);
 }
 
-void RenderContext::UploadLandAndWaterStart(size_t slices)
+void RenderContext::UploadLandAndWater(
+    SineWavesProfile const & landProfile,
+    SineWavesProfile const & waterProfile,
+    float restWaterHeight)
 {
-    //
-    // Prepare land buffer
-    //
-
-    if (slices + 1 != mLandBufferMaxSize)
+    if (landProfile != mLandProfile)
     {
-        // Realloc
-        mLandBuffer.reset();
-        mLandBuffer.reset(new LandElement[slices + 1]);
-        mLandBufferMaxSize = slices + 1;
-    }
+        glUseProgram(*mLandShaderProgram);
+        SetProfileParameters(mLandShaderLandProfileParameter, mLandShaderLandOffsetParameter, landProfile);
 
-    mLandBufferSize = 0u;
+        glUseProgram(*mWaterShaderProgram);
+        SetProfileParameters(mWaterShaderLandProfileParameter, mWaterShaderLandOffsetParameter, landProfile);
 
-    //
-    // Prepare water buffer
-    //
+        glUseProgram(0);
 
-    if (slices + 1 != mWaterBufferMaxSize)
-    {
-        // Realloc
-        mWaterBuffer.reset();
-        mWaterBuffer.reset(new WaterElement[slices + 1]);
-        mWaterBufferMaxSize = slices + 1;
+        mLandProfile = landProfile;
     }
 
-    mWaterBufferSize = 0u;
-}
-
-void RenderContext::UploadLandAndWaterEnd()
-{
-    //
-    // Upload land buffer
-    //
-
-    // Bind VBO
-    glBindBuffer(GL_ARRAY_BUFFER, *mLandVBO);
-
-    // Upload land buffer
-    glBufferData(GL_ARRAY_BUFFER, mLandBufferSize * sizeof(LandElement), mLandBuffer.get(), GL_DYNAMIC_DRAW);
-
-    // Unbind VBO
-    glBindBuffer(GL_ARRAY_BUFFER, 0u);
-
-
-    //
-    // Upload water buffer
-    //
-
-    assert(mWaterBufferSize == mWaterBufferMaxSize);
-
-    // Bind VBO
-    glBindBuffer(GL_ARRAY_BUFFER, *mWaterVBO);
+    if (waterProfile != mWaterProfile || restWaterHeight != mRestWaterHeight)
+    {
+        glUseProgram(*mWaterShaderProgram);
+        SetProfileParameters(mWaterShaderWaterProfileParameter, mWaterShaderWaterOffsetParameter, waterProfile);
+        glUniform1f(mWaterShaderRestWaterHeightParameter, restWaterHeight);
 
-    // Upload water buffer
-    glBufferData(GL_ARRAY_BUFFER, mWaterBufferSize * sizeof(WaterElement), mWaterBuffer.get(), GL_DYNAMIC_DRAW);
+        glUseProgram(0);
 
-    // Unbind VBO
-    glBindBuffer(GL_ARRAY_BUFFER, 0u);
+        mWaterProfile = waterProfile;
+        mRestWaterHeight = restWaterHeight;
+    }
 }
 
 void RenderContext::RenderLand()
 {
+    RenderPassTimer passTimer(mCurrentFrameStatistics.LandDuration, mAreRenderStatisticsSynchronous);
+
     // Use program
     glUseProgram(*mLandShaderProgram);
 
     // Set parameters
     glUniform1f(mLandShaderAmbientLightIntensityParameter, mAmbientLightIntensity);
     glUniformMatrix4fv(mLandShaderOrthoMatrixParameter, 1, GL_FALSE, &(mOrthoMatrix[0][0]));
+    SetVisibleWorldParameter(mLandShaderVisibleWorldParameter);
 
     // Bind texture
     glBindTexture(GL_TEXTURE_2D, *mLandTexture);
 
-    // Bind land VBO
-    glBindBuffer(GL_ARRAY_BUFFER, *mLandVBO);
+    // Bind slice VBO
+    glBindBuffer(GL_ARRAY_BUFFER, *mLandAndWaterSliceVBO);
 
-    // Describe InputPos
+    // Describe InputSlice
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
 
     // Draw
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, static_cast<GLsizei>(2 * mLandBufferSize));
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, static_cast<GLsizei>(2 * (LandAndWaterSlicesCount + 1)));
 
     // Unbind texture
     glBindTexture(GL_TEXTURE_2D, 0);
@@ -907,6 +980,8 @@ void RenderContext::RenderLand()
 
 void RenderContext::RenderWater()
 {
+    RenderPassTimer passTimer(mCurrentFrameStatistics.WaterDuration, mAreRenderStatisticsSynchronous);
+
     // Use program
     glUseProgram(*mWaterShaderProgram);
 
@@ -914,23 +989,20 @@ void RenderContext::RenderWater()
     glUniform1f(mWaterShaderAmbientLightIntensityParameter, mAmbientLightIntensity);
     glUniform1f(mWaterShaderWaterTransparencyParameter, mWaterTransparency);
     glUniformMatrix4fv(mWaterShaderOrthoMatrixParameter, 1, GL_FALSE, &(mOrthoMatrix[0][0]));
+    SetVisibleWorldParameter(mWaterShaderVisibleWorldParameter);
 
     // Bind texture
     glBindTexture(GL_TEXTURE_2D, *mWaterTexture);
 
-    // Bind water VBO
-    glBindBuffer(GL_ARRAY_BUFFER, *mWaterVBO);
+    // Bind slice VBO
+    glBindBuffer(GL_ARRAY_BUFFER, *mLandAndWaterSliceVBO);
 
-    // Describe InputPos
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, (2 + 1) * sizeof(float), (void*)0);
+    // Describe InputSlice
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
 
-    // Describe InputTextureY
-    glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, (2 + 1) * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
     // Draw
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, static_cast<GLsizei>(2 * mWaterBufferSize));
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, static_cast<GLsizei>(2 * (LandAndWaterSlicesCount + 1)));
 
     // Unbind texture
     glBindTexture(GL_TEXTURE_2D, 0);
@@ -941,7 +1013,14 @@ void RenderContext::RenderWater()
 
 void RenderContext::RenderEnd()
 {
-    glFlush();
+    if (mAreRenderStatisticsSynchronous)
+        glFinish();
+    else
+        glFlush();
+
+    mCurrentFrameStatistics.FrameDuration = std::chrono::steady_clock::now() - mFrameStartTime;
+
+    mLastFrameStatistics = mCurrentFrameStatistics;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////
@@ -965,3 +1044,17 @@ void RenderContext::CalculateVisibleWorldCoordinates()
     mVisibleWorldHeight = 2.0f * 70.0f / (mZoom + 0.001f);
     mVisibleWorldWidth = static_cast<float>(mCanvasWidth) / static_cast<float>(mCanvasHeight) * mVisibleWorldHeight;
 }
+
+void RenderContext::SetProfileParameters(
+    GLint profileParameter,
+    GLint offsetParameter,
+    SineWavesProfile const & profile)
+{
+    GLfloat const profileValues[3][3] = {
+        { profile.Amplitudes[0], profile.Amplitudes[1], profile.Amplitudes[2] },
+        { profile.Frequencies[0], profile.Frequencies[1], profile.Frequencies[2] },
+        { profile.Phases[0], profile.Phases[1], profile.Phases[2] } };
+
+    glUniform3fv(profileParameter, 3, &(profileValues[0][0]));
+    glUniform1f(offsetParameter, profile.Offset);
+}
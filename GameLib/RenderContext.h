@@ -5,10 +5,13 @@
 ***************************************************************************************/
 #pragma once
 
+#include "AABB.h"
 #include "GameOpenGL.h"
 #include "GameTypes.h"
+#include "IRenderBackend.h"
 #include "ImageData.h"
 #include "ProgressCallback.h"
+#include "RenderStatistics.h"
 #include "ResourceLoader.h"
 #include "RotatedTextureRenderInfo.h"
 #include "ShipRenderContext.h"
@@ -17,11 +20,12 @@
 
 #include <array>
 #include <cassert>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
 
-class RenderContext
+class RenderContext : public IRenderBackend
 {
 public:
 
@@ -30,7 +34,7 @@ public:
         vec3f const & ropeColour,
         ProgressCallback const & progressCallback);
     
-    ~RenderContext();
+    virtual ~RenderContext();
 
 public:
 
@@ -129,7 +133,7 @@ public:
         mWaterTransparency = transparency;
     }
 
-    bool GetShowShipThroughWater() const
+    virtual bool GetShowShipThroughWater() const override
     {
         return mShowShipThroughWater;
     }
@@ -154,7 +158,7 @@ public:
         mShipRenderMode = shipRenderMode;
     }
 
-    bool GetShowStressedSprings() const
+    virtual bool GetShowStressedSprings() const override
     {
         return mShowStressedSprings;
     }
@@ -193,18 +197,18 @@ public:
 
 public:
 
-    void RenderStart();
+    virtual void RenderStart() override;
 
     //
     // Clouds
     //
 
-    void RenderCloudsStart(size_t clouds);
+    virtual void RenderCloudsStart(size_t clouds) override;
 
-    inline void RenderCloud(
+    virtual void RenderCloud(
         float virtualX,
         float virtualY,
-        float scale)
+        float scale) override
     {
         //
         // We use Normalized Device Coordinates here
@@ -261,64 +265,25 @@ public:
         ++mCloudBufferSize;
     }
 
-    void RenderCloudsEnd();
+    virtual void RenderCloudsEnd() override;
 
 
     //
     // Land and Water
     //
 
-    void UploadLandAndWaterStart(size_t slices);
+    /*
+     * Land and water are drawn by the shaders straight from their profiles, hence
+     * these only need to be uploaded when they change.
+     */
+    virtual void UploadLandAndWater(
+        SineWavesProfile const & landProfile,
+        SineWavesProfile const & waterProfile,
+        float restWaterHeight) override;
 
-    inline void UploadLandAndWater(
-        float x,
-        float yLand,
-        float yWater,
-        float restWaterHeight)
-    {
-        assert(mLandBufferMaxSize == mWaterBufferMaxSize);
-        assert(mLandBufferMaxSize > 0);
-
-        float const worldBottom = mCamY - (mVisibleWorldHeight / 2.0f);
-
-        //
-        // Store Land element
-        //
-
-        assert(mLandBufferSize + 1u <= mLandBufferMaxSize);
-        LandElement * landElement = &(mLandBuffer[mLandBufferSize]);
-
-        landElement->x1 = x;
-        landElement->y1 = yLand;
-        landElement->x2 = x;
-        landElement->y2 = worldBottom;
+    virtual void RenderLand() override;
 
-        ++mLandBufferSize;
-
-
-        //
-        // Store water element
-        //
-
-        assert(mWaterBufferSize + 1u <= mWaterBufferMaxSize);
-        WaterElement * waterElement = &(mWaterBuffer[mWaterBufferSize]);
-
-        waterElement->x1 = x;
-        waterElement->y1 = yWater > yLand ? yWater : yLand; // Make sure that islands are not covered in water!
-        waterElement->textureY1 = restWaterHeight;
-
-        waterElement->x2 = x;
-        waterElement->y2 = yLand;
-        waterElement->textureY2 = 0.0f;
-
-        ++mWaterBufferSize;
-    }
-
-    void UploadLandAndWaterEnd();
-
-    void RenderLand();
-
-    void RenderWater();
+    virtual void RenderWater() override;
 
 
     /////////////////////////////////////////////////////////////////////////
@@ -329,11 +294,11 @@ public:
     // Ship Points
     //
 
-    void UploadShipPointImmutableGraphicalAttributes(
+    virtual void UploadShipPointImmutableGraphicalAttributes(
         int shipId,
         size_t count,
         vec3f const * restrict color,
-        vec2f const * restrict textureCoordinates)
+        vec2f const * restrict textureCoordinates) override
     {
         assert(shipId < mShips.size());
 
@@ -343,39 +308,62 @@ public:
             textureCoordinates);
     }
 
-    void UploadShipPoints(
+    virtual void UploadShipPoints(
         int shipId,
         size_t count,
         vec2f const * restrict position,
         float const * restrict light,
-        float const * restrict water)
+        float const * restrict water,
+        float const * restrict stress) override
     {
         assert(shipId < mShips.size());
 
+        auto const startTime = std::chrono::steady_clock::now();
+
         mShips[shipId]->UploadPoints(
             count,
             position,
             light,
-            water);
+            water,
+            stress);
+
+        mCurrentFrameStatistics.PointUploadDuration += std::chrono::steady_clock::now() - startTime;
+        mCurrentFrameStatistics.PointUploadBytes += count * (sizeof(vec2f) + sizeof(float) + sizeof(float) + (nullptr != stress ? sizeof(float) : 0));
     }
 
     //
     // Ship elements (points, springs, ropes, and triangles)
     //
 
-    inline void UploadShipElementsStart(
+    virtual void UploadShipElementsStart(
         int shipId, 
-        std::vector<std::size_t> const & connectedComponentsMaxSizes)
+        std::vector<std::size_t> const & connectedComponentsMaxSizes) override
     {
         assert(shipId < mShips.size());
 
         mShips[shipId]->UploadElementsStart(connectedComponentsMaxSizes);
     }
 
-    inline void UploadShipElementPoint(
+    /*
+     * Starts telling the ship's render context about the changes to the elements uploaded
+     * so far - the elements removed since, and the connected components to be uploaded again.
+     */
+    virtual void UpdateShipElementsStart(
+        int shipId,
+        std::vector<std::size_t> const & connectedComponentsMaxSizes,
+        std::vector<ConnectedComponentId> const & changedConnectedComponentIds) override
+    {
+        assert(shipId < mShips.size());
+
+        mShips[shipId]->UpdateElementsStart(
+            connectedComponentsMaxSizes,
+            changedConnectedComponentIds);
+    }
+
+    virtual void UploadShipElementPoint(
         int shipId,
         int shipPointIndex,
-        ConnectedComponentId connectedComponentId)
+        ConnectedComponentId connectedComponentId) override
     {
         assert(shipId < mShips.size());
 
@@ -384,99 +372,160 @@ public:
             connectedComponentId);
     }
 
-    inline void UploadShipElementSpring(
+    virtual void UploadShipElementSpring(
         int shipId,
+        ElementIndex shipSpringIndex,
         int shipPointIndex1,
         int shipPointIndex2,
-        ConnectedComponentId connectedComponentId)
+        bool isCoarse,
+        ConnectedComponentId connectedComponentId) override
     {
         assert(shipId < mShips.size());
 
         mShips[shipId]->UploadElementSpring(
+            shipSpringIndex,
             shipPointIndex1,
             shipPointIndex2,
+            isCoarse,
             connectedComponentId);
     }
 
-    inline void UploadShipElementRope(
+    virtual void UploadShipElementRope(
         int shipId,
+        ElementIndex shipSpringIndex,
         int shipPointIndex1,
         int shipPointIndex2,
-        ConnectedComponentId connectedComponentId)
+        ConnectedComponentId connectedComponentId) override
     {
         assert(shipId < mShips.size());
 
         mShips[shipId]->UploadElementRope(
+            shipSpringIndex,
             shipPointIndex1,
             shipPointIndex2,
             connectedComponentId);
     }
 
-    inline void UploadShipElementTriangle(
+    virtual void UploadShipElementTriangle(
         int shipId,
+        ElementIndex shipTriangleIndex,
         int shipPointIndex1,
         int shipPointIndex2,
         int shipPointIndex3,
-        ConnectedComponentId connectedComponentId)
+        ConnectedComponentId connectedComponentId) override
     {
         assert(shipId < mShips.size());
 
         mShips[shipId]->UploadElementTriangle(
+            shipTriangleIndex,
             shipPointIndex1,
             shipPointIndex2,
             shipPointIndex3,
             connectedComponentId);
     }
 
-    inline void UploadShipElementsEnd(int shipId)
-    {
-        assert(shipId < mShips.size());
-
-        mShips[shipId]->UploadElementsEnd();
-    }
-
-    inline void UploadShipElementStressedSpringsStart(int shipId)
+    virtual void UploadShipElementCoarseTriangle(
+        int shipId,
+        ElementIndex shipCoarseTriangleIndex,
+        int shipPointIndex1,
+        int shipPointIndex2,
+        int shipPointIndex3,
+        ConnectedComponentId connectedComponentId) override
     {
         assert(shipId < mShips.size());
 
-        mShips[shipId]->UploadElementStressedSpringsStart();
+        mShips[shipId]->UploadElementCoarseTriangle(
+            shipCoarseTriangleIndex,
+            shipPointIndex1,
+            shipPointIndex2,
+            shipPointIndex3,
+            connectedComponentId);
     }
 
-    inline void UploadShipElementStressedSpring(
+    virtual void InsertShipElementCoarseTriangle(
         int shipId,
+        ElementIndex shipCoarseTriangleIndex,
         int shipPointIndex1,
         int shipPointIndex2,
-        ConnectedComponentId connectedComponentId)
+        int shipPointIndex3,
+        ConnectedComponentId connectedComponentId) override
     {
         assert(shipId < mShips.size());
 
-        mShips[shipId]->UploadElementStressedSpring(
+        mShips[shipId]->InsertElementCoarseTriangle(
+            shipCoarseTriangleIndex,
             shipPointIndex1,
             shipPointIndex2,
+            shipPointIndex3,
             connectedComponentId);
     }
 
-    void UploadShipElementStressedSpringsEnd(int shipId)
+    virtual void RemoveShipElementPoint(
+        int shipId,
+        int shipPointIndex) override
+    {
+        assert(shipId < mShips.size());
+
+        mShips[shipId]->RemoveElementPoint(shipPointIndex);
+    }
+
+    virtual void RemoveShipElementSpring(
+        int shipId,
+        ElementIndex shipSpringIndex) override
+    {
+        assert(shipId < mShips.size());
+
+        mShips[shipId]->RemoveElementSpring(shipSpringIndex);
+    }
+
+    virtual void RemoveShipElementRope(
+        int shipId,
+        ElementIndex shipSpringIndex) override
     {
         assert(shipId < mShips.size());
 
-        mShips[shipId]->UploadElementStressedSpringsEnd();
+        mShips[shipId]->RemoveElementRope(shipSpringIndex);
     }
 
-    inline void UploadShipElementPinnedPointsStart(
+    virtual void RemoveShipElementTriangle(
         int shipId,
-        size_t count)
+        ElementIndex shipTriangleIndex) override
+    {
+        assert(shipId < mShips.size());
+
+        mShips[shipId]->RemoveElementTriangle(shipTriangleIndex);
+    }
+
+    virtual void RemoveShipElementCoarseTriangle(
+        int shipId,
+        ElementIndex shipCoarseTriangleIndex) override
+    {
+        assert(shipId < mShips.size());
+
+        mShips[shipId]->RemoveElementCoarseTriangle(shipCoarseTriangleIndex);
+    }
+
+    virtual void UploadShipElementsEnd(int shipId) override
+    {
+        assert(shipId < mShips.size());
+
+        mShips[shipId]->UploadElementsEnd();
+    }
+
+    virtual void UploadShipElementPinnedPointsStart(
+        int shipId,
+        size_t count) override
     {
         assert(shipId < mShips.size());
 
         mShips[shipId]->UploadElementPinnedPointsStart(count);
     }
 
-    inline void UploadShipElementPinnedPoint(
+    virtual void UploadShipElementPinnedPoint(
         int shipId,
         float x,
         float y,
-        ConnectedComponentId connectedComponentId)
+        ConnectedComponentId connectedComponentId) override
     {
         assert(shipId < mShips.size());
 
@@ -486,29 +535,29 @@ public:
             connectedComponentId);
     }
 
-    inline void UploadShipElementPinnedPointsEnd(int shipId)
+    virtual void UploadShipElementPinnedPointsEnd(int shipId) override
     {
         assert(shipId < mShips.size());
 
         mShips[shipId]->UploadElementPinnedPointsEnd();
     }
 
-    inline void UploadShipElementBombsStart(
+    virtual void UploadShipElementBombsStart(
         int shipId,
-        size_t count)
+        size_t count) override
     {
         assert(shipId < mShips.size());
 
         mShips[shipId]->UploadElementBombsStart(count);
     }
 
-    inline void UploadShipElementBomb(
+    virtual void UploadShipElementBomb(
         int shipId,
         BombType bombType,
         RotatedTextureRenderInfo const & renderInfo,
         std::optional<uint32_t> lightedFrameIndex,
         std::optional<uint32_t> unlightedFrameIndex,
-        ConnectedComponentId connectedComponentId)
+        ConnectedComponentId connectedComponentId) override
     {
         assert(shipId < mShips.size());
 
@@ -520,7 +569,7 @@ public:
             connectedComponentId);
     }
 
-    inline void UploadShipElementBombsEnd(int shipId)
+    virtual void UploadShipElementBombsEnd(int shipId) override
     {
         assert(shipId < mShips.size());
 
@@ -563,16 +612,29 @@ public:
         mShips[shipId]->UploadLampsEnd();
     }
 
-    void RenderShip(int shipId)
+    /*
+     * Whether nothing of a ship with the specified bounding box may be visible.
+     */
+    virtual bool IsShipCulled(Geometry::AABB const & shipAABB) const override
+    {
+        return !CalculateShipCullingAABB().intersects(shipAABB);
+    }
+
+    virtual void RenderShip(
+        int shipId,
+        std::vector<Geometry::AABB> const & connectedComponentAABBs) override
     {
         assert(shipId < mShips.size());
 
         mShips[shipId]->Render(
             mShipRenderMode,
-            mShowStressedSprings,
             mAmbientLightIntensity,
             static_cast<float>(mCanvasHeight) / mVisibleWorldHeight,
-            mOrthoMatrix);
+            mOrthoMatrix,
+            CalculateShipCullingAABB(),
+            connectedComponentAABBs,
+            mCurrentFrameStatistics,
+            mAreRenderStatisticsSynchronous);
     }
 
 
@@ -580,7 +642,24 @@ public:
     // Final
     //
 
-    void RenderEnd();
+    virtual void RenderEnd() override;
+
+    /*
+     * Returns the statistics of the last frame that was rendered.
+     */
+    RenderStatistics const & GetLastFrameStatistics() const
+    {
+        return mLastFrameStatistics;
+    }
+
+    /*
+     * When set, the durations of the render passes include the time the GL takes to
+     * execute them - at the cost of stalling the pipeline after each pass.
+     */
+    void SetSynchronousRenderStatistics(bool areSynchronous)
+    {
+        mAreRenderStatisticsSynchronous = areSynchronous;
+    }
 
 
 private:
@@ -589,6 +668,32 @@ private:
 
     void CalculateVisibleWorldCoordinates();
 
+    void SetVisibleWorldParameter(GLint visibleWorldParameter) const
+    {
+        glUniform3f(
+            visibleWorldParameter,
+            mCamX - (mVisibleWorldWidth / 2.0f),
+            mCamY - (mVisibleWorldHeight / 2.0f),
+            mVisibleWorldWidth);
+    }
+
+    static void SetProfileParameters(
+        GLint profileParameter,
+        GLint offsetParameter,
+        SineWavesProfile const & profile);
+
+    Geometry::AABB CalculateShipCullingAABB() const
+    {
+        // The visible world, extended by the largest of the textures that are drawn
+        // around the points of a ship (bombs), so that they don't get culled while
+        // still partially visible
+        static constexpr float Margin = 12.0f;
+
+        return Geometry::AABB(
+            vec2f(mCamX - mVisibleWorldWidth / 2.0f - Margin, mCamY - mVisibleWorldHeight / 2.0f - Margin),
+            vec2f(mCamX + mVisibleWorldWidth / 2.0f + Margin, mCamY + mVisibleWorldHeight / 2.0f + Margin));
+    }
+
 private:
 
     //
@@ -644,25 +749,14 @@ private:
     GameOpenGLShaderProgram mLandShaderProgram;
     GLint mLandShaderAmbientLightIntensityParameter;
     GLint mLandShaderOrthoMatrixParameter;
+    GLint mLandShaderVisibleWorldParameter;
+    GLint mLandShaderLandProfileParameter;
+    GLint mLandShaderLandOffsetParameter;
 
-#pragma pack(push)
-    struct LandElement
-    {
-        float x1;
-        float y1;
-        float x2;
-        float y2;
-    };
-#pragma pack(pop)
-
-    std::unique_ptr<LandElement[]> mLandBuffer;
-    size_t mLandBufferSize;
-    size_t mLandBufferMaxSize;
-
-    GameOpenGLVBO mLandVBO;
-    
     GameOpenGLTexture mLandTexture;
 
+    SineWavesProfile mLandProfile;
+
 
     //
     // Water
@@ -672,27 +766,29 @@ private:
     GLint mWaterShaderAmbientLightIntensityParameter;
     GLint mWaterShaderWaterTransparencyParameter;
     GLint mWaterShaderOrthoMatrixParameter;
+    GLint mWaterShaderVisibleWorldParameter;
+    GLint mWaterShaderLandProfileParameter;
+    GLint mWaterShaderLandOffsetParameter;
+    GLint mWaterShaderWaterProfileParameter;
+    GLint mWaterShaderWaterOffsetParameter;
+    GLint mWaterShaderRestWaterHeightParameter;
 
-#pragma pack(push)
-    struct WaterElement
-    {
-        float x1;
-        float y1;
-        float textureY1;
-        
-        float x2;
-        float y2;
-        float textureY2;
-    };
-#pragma pack(pop)
+    GameOpenGLTexture mWaterTexture;
 
-    std::unique_ptr<WaterElement[]> mWaterBuffer;
-    size_t mWaterBufferSize;
-    size_t mWaterBufferMaxSize;
+    SineWavesProfile mWaterProfile;
+    float mRestWaterHeight;
 
-    GameOpenGLVBO mWaterVBO;
 
-    GameOpenGLTexture mWaterTexture;
+    //
+    // Land and water slices
+    //
+
+    // The number of vertical slices that land and water are drawn with, across the visible world
+    static constexpr size_t LandAndWaterSlicesCount = 500;
+
+    // The top and bottom vertices of each slice, in fractions of the visible world width
+    // and of the height of the slice
+    GameOpenGLVBO mLandAndWaterSliceVBO;
 
     //
     // Ships
@@ -747,4 +843,13 @@ private:
     bool mShowShipThroughWater;
     ShipRenderMode mShipRenderMode;
     bool mShowStressedSprings;
+
+    //
+    // Statistics
+    //
+
+    RenderStatistics mCurrentFrameStatistics;
+    RenderStatistics mLastFrameStatistics;
+    bool mAreRenderStatisticsSynchronous;
+    std::chrono::steady_clock::time_point mFrameStartTime;
 };
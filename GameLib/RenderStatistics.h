@@ -0,0 +1,92 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-15
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameOpenGL.h"
+
+#include <chrono>
+#include <cstddef>
+
+/*
+ * Statistics about the rendering of a frame.
+ */
+struct RenderStatistics
+{
+    // From the start of the frame to its end
+    std::chrono::steady_clock::duration FrameDuration;
+
+    //
+    // The render passes
+    //
+
+    std::chrono::steady_clock::duration CloudsDuration;
+    std::chrono::steady_clock::duration LandDuration;
+    std::chrono::steady_clock::duration WaterDuration;
+    std::chrono::steady_clock::duration ShipPointsDuration;
+    std::chrono::steady_clock::duration ShipSpringsDuration; // Includes ropes
+    std::chrono::steady_clock::duration ShipTrianglesDuration;
+
+    //
+    // The uploads
+    //
+
+    std::chrono::steady_clock::duration PointUploadDuration;
+    size_t PointUploadBytes;
+
+    RenderStatistics()
+        : FrameDuration(std::chrono::steady_clock::duration::zero())
+        , CloudsDuration(std::chrono::steady_clock::duration::zero())
+        , LandDuration(std::chrono::steady_clock::duration::zero())
+        , WaterDuration(std::chrono::steady_clock::duration::zero())
+        , ShipPointsDuration(std::chrono::steady_clock::duration::zero())
+        , ShipSpringsDuration(std::chrono::steady_clock::duration::zero())
+        , ShipTrianglesDuration(std::chrono::steady_clock::duration::zero())
+        , PointUploadDuration(std::chrono::steady_clock::duration::zero())
+        , PointUploadBytes(0)
+    {}
+};
+
+/*
+ * Adds the time spent in its scope to a duration of the render statistics.
+ *
+ * Draw calls only queue work for the GL, hence by default the duration is the time it takes
+ * to issue the pass. When synchronous, the GL is drained before and after the pass, so that
+ * the duration is the time it takes to execute the pass; this stalls the pipeline, and is
+ * thus only meant for benchmarks.
+ */
+class RenderPassTimer
+{
+public:
+
+    RenderPassTimer(
+        std::chrono::steady_clock::duration & duration,
+        bool isSynchronous)
+        : mDuration(duration)
+        , mIsSynchronous(isSynchronous)
+    {
+        if (mIsSynchronous)
+            glFinish();
+
+        mStartTime = std::chrono::steady_clock::now();
+    }
+
+    ~RenderPassTimer()
+    {
+        if (mIsSynchronous)
+            glFinish();
+
+        mDuration += std::chrono::steady_clock::now() - mStartTime;
+    }
+
+    RenderPassTimer(RenderPassTimer const & other) = delete;
+    RenderPassTimer & operator=(RenderPassTimer const & other) = delete;
+
+private:
+
+    std::chrono::steady_clock::duration & mDuration;
+    bool const mIsSynchronous;
+    std::chrono::steady_clock::time_point mStartTime;
+};
@@ -10,19 +10,68 @@
 #include "GameException.h"
 #include "Log.h"
 #include "ShipDefinitionFile.h"
+#include "Trace.h"
 #include "Utils.h"
 
 #include <IL/il.h>
 #include <IL/ilu.h>
 
 #include <cstring>
+#include <mutex>
 #include <regex>
 
+namespace /* anonymous */ {
+
+    // DevIL works on a global "bound" image, hence only one thread may use it at a time
+    std::mutex DevILMutex;
+}
+
 ResourceLoader::ResourceLoader()
+    : mTextureFilePathsByPrefix()
 {
     // Initialize DevIL
     ilInit();
     iluInit();
+
+    //
+    // Index numbered textures
+    //
+
+    std::regex const textureFilenameRegex(R"((.+)_(\d+)\.png)");
+    std::smatch match;
+
+    std::map<std::string, std::vector<std::pair<int, std::filesystem::path>>> matchingEntriesByPrefix;
+    for (auto const & entryIt : std::filesystem::directory_iterator(std::filesystem::path("Data") / "Textures"))
+    {
+        std::string filename = entryIt.path().filename().string();
+
+        if (std::filesystem::is_regular_file(entryIt.path())
+            && std::regex_match(filename, match, textureFilenameRegex))
+        {
+            assert(match.size() == 1 + 2 && match[1].matched && match[2].matched);
+
+            matchingEntriesByPrefix[match[1].str()].emplace_back(
+                std::stoi(match[2].str()),
+                entryIt.path());
+        }
+    }
+
+    for (auto & prefixEntries : matchingEntriesByPrefix)
+    {
+        std::sort(
+            prefixEntries.second.begin(),
+            prefixEntries.second.end(),
+            [](auto const & entry1, auto const & entry2)
+            {
+                return entry1.first < entry2.first;
+            });
+
+        auto & textureFilePaths = mTextureFilePathsByPrefix[prefixEntries.first];
+        for (auto & entry : prefixEntries.second)
+        {
+            textureFilePaths.push_back(std::move(entry.second));
+        }
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -31,6 +80,8 @@ ResourceLoader::ResourceLoader()
 
 ShipDefinition ResourceLoader::LoadShipDefinition(std::filesystem::path const & filepath)
 {    
+    TraceSpan span("ResourceLoader::LoadShipDefinition");
+
     if (ShipDefinitionFile::IsShipDefinitionFile(filepath))
     {
         // 
@@ -94,6 +145,46 @@ ShipDefinition ResourceLoader::LoadShipDefinition(std::filesystem::path const &
     }
 }
 
+std::vector<std::filesystem::path> ResourceLoader::GetShipSourceFilepaths(std::filesystem::path const & filepath) const
+{
+    std::vector<std::filesystem::path> sourceFilepaths;
+
+    // The file itself
+    sourceFilepaths.push_back(filepath);
+
+    if (ShipDefinitionFile::IsShipDefinitionFile(filepath))
+    {
+        //
+        // Add the images referenced by the definition
+        //
+
+        picojson::value root = Utils::ParseJSONFile(filepath.string());
+        if (!root.is<picojson::object>())
+        {
+            throw GameException("File \"" + filepath.string() + "\" does not contain a JSON object");
+        }
+
+        ShipDefinitionFile sdf = ShipDefinitionFile::Create(root.get<picojson::object>());
+
+        std::filesystem::path basePath = filepath.parent_path();
+
+        sourceFilepaths.push_back(
+            std::filesystem::absolute(
+                sdf.StructuralImageFilePath,
+                basePath));
+
+        if (!!sdf.TextureImageFilePath)
+        {
+            sourceFilepaths.push_back(
+                std::filesystem::absolute(
+                    *sdf.TextureImageFilePath,
+                    basePath));
+        }
+    }
+
+    return sourceFilepaths;
+}
+
 std::filesystem::path ResourceLoader::GetDefaultShipDefinitionFilePath() const
 {
     std::filesystem::path defaultShipDefinitionFilePath = std::filesystem::path("Ships") / "default_ship.shp";
@@ -105,6 +196,11 @@ std::filesystem::path ResourceLoader::GetDefaultShipDefinitionFilePath() const
     return defaultShipDefinitionFilePath;
 }
 
+std::filesystem::path ResourceLoader::GetShipCacheDirectoryPath() const
+{
+    return std::filesystem::path("Data") / "Cache" / "Ships";
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 // Textures
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -112,7 +208,7 @@ std::filesystem::path ResourceLoader::GetDefaultShipDefinitionFilePath() const
 ImageData ResourceLoader::LoadTextureRgb(std::string const & name)
 {
     return LoadImage(
-        (std::filesystem::path("Data") / "Textures" / name).string(),
+        GetTextureFilePath(name),
         IL_RGB,
         IL_ORIGIN_LOWER_LEFT);
 }
@@ -128,7 +224,7 @@ ImageData ResourceLoader::LoadTextureRgb(std::filesystem::path const & filePath)
 ImageData ResourceLoader::LoadTextureRgba(std::string const & name)
 {
     return LoadImage(
-        (std::filesystem::path("Data") / "Textures" / name).string(),
+        GetTextureFilePath(name),
         IL_RGBA,
         IL_ORIGIN_LOWER_LEFT);
 }
@@ -145,53 +241,80 @@ std::vector<ImageData> ResourceLoader::LoadTexturesRgba(
     std::string const & prefix,
     ProgressCallback progressCallback)
 {
-    std::regex textureFilenameRegex(R"((.+)_(\d+)\.png)");
-    std::smatch match;
+    auto const & textureFilePaths = GetTextureFilePaths(prefix);
 
-    std::vector<std::pair<int, std::filesystem::path>> matchingEntries;
-    for (auto const & entryIt : std::filesystem::directory_iterator(std::filesystem::path("Data") / "Textures"))
+    std::vector<ImageData> textures;
+    for (size_t i = 0; i < textureFilePaths.size(); ++i)
     {
-        std::string filename = entryIt.path().filename().string();
+        if (progressCallback)
+            progressCallback(static_cast<float>(i + 1) / static_cast<float>(textureFilePaths.size()), "Loading texture...");
 
-        if (std::filesystem::is_regular_file(entryIt.path())
-            && std::regex_match(filename, match, textureFilenameRegex))
-        {
-            assert(match.size() == 1 + 2 && match[1].matched && match[2].matched);
+        auto imageData = LoadImage(
+            textureFilePaths[i],
+            IL_RGBA,
+            IL_ORIGIN_LOWER_LEFT);
 
-            if (match[1].str() == prefix)
-            {
-                int textureIndex = std::stoi(match[2].str());
+        textures.emplace_back(std::move(imageData));
+    }
 
-                matchingEntries.emplace_back(
-                    textureIndex,
-                    entryIt.path());
-            }
-        }
+    return textures;
+}
+
+std::vector<std::filesystem::path> const & ResourceLoader::GetTextureFilePaths(std::string const & prefix) const
+{
+    static std::vector<std::filesystem::path> const NoTextureFilePaths;
+
+    auto const it = mTextureFilePathsByPrefix.find(prefix);
+    if (it == mTextureFilePathsByPrefix.end())
+    {
+        return NoTextureFilePaths;
     }
 
-    std::sort(
-        matchingEntries.begin(),
-        matchingEntries.end(),
-        [](auto const & entry1, auto const & entry2)
-        {
-            return entry1.first < entry2.first;
-        });
+    return it->second;
+}
 
-    std::vector<ImageData> textures;
-    for (size_t i = 0; i < matchingEntries.size(); ++i)
+std::filesystem::path ResourceLoader::GetTextureFilePath(std::string const & name) const
+{
+    return std::filesystem::path("Data") / "Textures" / name;
+}
+
+DecodedTexture ResourceLoader::LoadDecodedTextureRgba(
+    std::filesystem::path const & filePath,
+    bool withMipmaps,
+    TextureCache const * textureCache)
+{
+    TraceSpan span("ResourceLoader::LoadDecodedTextureRgba");
+
+    std::optional<uint64_t> cacheKey;
+    if (nullptr != textureCache)
     {
-        if (progressCallback)
-            progressCallback(static_cast<float>(i + 1) / static_cast<float>(matchingEntries.size()), "Loading texture...");
+        cacheKey = TextureCache::CalculateKey(filePath, withMipmaps);
 
-        auto imageData = LoadImage(
-            matchingEntries[i].second,
+        std::optional<DecodedTexture> cachedTexture = textureCache->TryLoad(*cacheKey);
+        if (!!cachedTexture)
+        {
+            return std::move(*cachedTexture);
+        }
+    }
+
+    DecodedTexture decodedTexture = DecodedTexture::FromImage(
+        LoadImage(
+            filePath,
             IL_RGBA,
-            IL_ORIGIN_LOWER_LEFT);
+            IL_ORIGIN_LOWER_LEFT),
+        withMipmaps);
 
-        textures.emplace_back(std::move(imageData));
+    if (!!cacheKey)
+    {
+        textureCache->Store(*cacheKey, decodedTexture);
     }
 
-    return textures;
+    return decodedTexture;
+}
+
+std::filesystem::path ResourceLoader::GetTextureCacheDirectoryPath() const
+{
+    return std::filesystem::path("Data") / "Cache" / "Textures";
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -200,10 +323,17 @@ std::vector<ImageData> ResourceLoader::LoadTexturesRgba(
 
 MaterialDatabase ResourceLoader::LoadMaterials()
 {
-    picojson::value root = Utils::ParseJSONFile("Data/materials.json");
+    TraceSpan span("ResourceLoader::LoadMaterials");
+
+    picojson::value root = Utils::ParseJSONFile(GetMaterialsFilepath().string());
     return MaterialDatabase::Create(root);
 }
 
+std::filesystem::path ResourceLoader::GetMaterialsFilepath() const
+{
+    return std::filesystem::path("Data") / "materials.json";
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 // Music
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -239,6 +369,11 @@ std::filesystem::path ResourceLoader::GetSoundFilepath(std::string const & sound
     return std::filesystem::absolute(localPath);
 }
 
+std::filesystem::path ResourceLoader::GetSoundCacheDirectoryPath() const
+{
+    return std::filesystem::path("Data") / "Cache" / "Sounds";
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 // Resources
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -264,6 +399,11 @@ ImageData ResourceLoader::LoadImage(
     int format,
     int origin)
 {
+    // Includes the wait for DevIL
+    TraceSpan span("ResourceLoader::LoadImage");
+
+    std::lock_guard<std::mutex> const devILLock(DevILMutex);
+
     //
     // Load image
     //
@@ -5,14 +5,17 @@
 ***************************************************************************************/
 #pragma once
 
+#include "DecodedTexture.h"
 #include "ImageData.h"
 #include "MaterialDatabase.h"
 #include "ProgressCallback.h"
 #include "ShipDefinition.h"
 #include "SysSpecifics.h"
+#include "TextureCache.h"
 
 #include <cstdint>
 #include <filesystem>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -31,8 +34,16 @@ public:
 
     ShipDefinition LoadShipDefinition(std::filesystem::path const & filepath);
 
+    /*
+     * Returns the paths of all the files whose contents make up the specified ship,
+     * without loading the ship.
+     */
+    std::vector<std::filesystem::path> GetShipSourceFilepaths(std::filesystem::path const & filepath) const;
+
     std::filesystem::path GetDefaultShipDefinitionFilePath() const;
 
+    std::filesystem::path GetShipCacheDirectoryPath() const;
+
 
     //
     // Textures
@@ -50,6 +61,24 @@ public:
         std::string const & prefix, 
         ProgressCallback progressCallback);
 
+    /*
+     * Returns the paths of the "<prefix>_<n>.png" textures, by increasing n.
+     */
+    std::vector<std::filesystem::path> const & GetTextureFilePaths(std::string const & prefix) const;
+
+    std::filesystem::path GetTextureFilePath(std::string const & name) const;
+
+    /*
+     * Loads a texture, from the cache if it's there, and otherwise by decoding its
+     * image and storing it in the cache. May be invoked concurrently.
+     */
+    DecodedTexture LoadDecodedTextureRgba(
+        std::filesystem::path const & filePath,
+        bool withMipmaps,
+        TextureCache const * textureCache);
+
+    std::filesystem::path GetTextureCacheDirectoryPath() const;
+
 
     //
     // Materials
@@ -57,6 +86,8 @@ public:
 
     MaterialDatabase LoadMaterials();
 
+    std::filesystem::path GetMaterialsFilepath() const;
+
 
     //
     // Music
@@ -73,6 +104,8 @@ public:
 
     std::filesystem::path GetSoundFilepath(std::string const & soundName) const;
 
+    std::filesystem::path GetSoundCacheDirectoryPath() const;
+
 
     //
     // Resources
@@ -88,4 +121,10 @@ private:
         std::filesystem::path const & filepath,
         int format,
         int origin);
+
+private:
+
+    // The numbered textures in the textures directory, by prefix;
+    // made once, as scanning the directory is not free
+    std::map<std::string, std::vector<std::filesystem::path>> mTextureFilePathsByPrefix;
 };
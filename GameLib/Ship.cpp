@@ -7,8 +7,10 @@
 ***************************************************************************************/
 #include "Physics.h"
 
+#include "GameException.h"
 #include "Log.h"
 #include "Segment.h"
+#include "Trace.h"
 
 #include <algorithm>
 #include <cassert>
@@ -32,7 +34,7 @@ namespace Physics {
 Ship::Ship(
     int id,
     World & parentWorld,
-    std::shared_ptr<IGameEventHandler> gameEventHandler,
+    std::shared_ptr<GameEventDispatcher> gameEventHandler,
     Points && points,
     Springs && springs,
     Triangles && triangles,
@@ -46,7 +48,16 @@ Ship::Ship(
     , mTriangles(std::move(triangles))
     , mElectricalElements(std::move(electricalElements))
     , mConnectedComponentSizes()
+    , mConnectedComponentAABBs()
+    , mAABB()
     , mAreElementsDirty(true)
+    , mAreElementsUploaded(false)
+    , mDestroyedPointsSinceLastUpload()
+    , mDestroyedSpringsSinceLastUpload()
+    , mDestroyedTrianglesSinceLastUpload()
+    , mDestroyedCoarseTrianglesSinceLastUpload()
+    , mBrokenCoarseTriangleBlocksSinceLastUpload()
+    , mChangedConnectedComponentIdsSinceLastUpload()
     , mIsSinking(false)
     , mTotalWater(0.0)
     , mCurrentPinnedPoints()
@@ -78,8 +89,20 @@ Ship::Ship(
     mTriangles.RegisterDestroyHandler(std::bind(&Ship::TriangleDestroyHandler, this, std::placeholders::_1));
     mElectricalElements.RegisterDestroyHandler(std::bind(&Ship::ElectricalElementDestroyHandler, this, std::placeholders::_1));
 
+    // Make room for the connected components that the points already belong to - if any, as
+    // when the points come from a snapshot - so that they keep their IDs
+    ConnectedComponentId maxConnectedComponentId = 0;
+    for (auto pointIndex : mPoints)
+    {
+        maxConnectedComponentId = std::max(maxConnectedComponentId, mPoints.GetConnectedComponentId(pointIndex));
+    }
+
+    mConnectedComponentSizes.resize(maxConnectedComponentId, 0);
+
     // Do a first connected component detection pass 
     DetectConnectedComponents(currentStepSequenceNumber);
+
+    UpdateBoundingBoxes();
 }
 
 Ship::~Ship()
@@ -305,6 +328,8 @@ void Ship::Update(
     uint64_t currentStepSequenceNumber,
     GameParameters const & gameParameters)
 {
+    TraceSpan span("Ship::Update");
+
     //
     // Process eventual parameter changes
     //
@@ -318,7 +343,11 @@ void Ship::Update(
     // Update dynamics
     //
 
-    UpdateDynamics(gameParameters);
+    {
+        TraceSpan phaseSpan("Ship::UpdateDynamics");
+
+        UpdateDynamics(gameParameters);
+    }
 
 
     //
@@ -328,7 +357,11 @@ void Ship::Update(
     // (which would flag our elements as dirty)
     //
 
-    mBombs.Update(gameParameters);
+    {
+        TraceSpan phaseSpan("Ship::UpdateBombs");
+
+        mBombs.Update(gameParameters);
+    }
 
 
     //
@@ -336,9 +369,13 @@ void Ship::Update(
     // (which would flag our elements as dirty)
     //
 
-    mSprings.UpdateStrains(
-        gameParameters,
-        mPoints);
+    {
+        TraceSpan phaseSpan("Ship::UpdateStrains");
+
+        mSprings.UpdateStrains(
+            gameParameters,
+            mPoints);
+    }
 
 
     //
@@ -347,7 +384,11 @@ void Ship::Update(
 
     if (mAreElementsDirty)
     {
+        TraceSpan phaseSpan("Ship::DetectConnectedComponents");
+
         DetectConnectedComponents(currentStepSequenceNumber);
+
+        TraceCounter("Connected Components", static_cast<double>(mConnectedComponentSizes.size()));
     }
 
 
@@ -355,15 +396,19 @@ void Ship::Update(
     // Update water dynamics
     //
 
-    LeakWater(gameParameters);
+    {
+        TraceSpan phaseSpan("Ship::UpdateWaterDynamics");
+
+        LeakWater(gameParameters);
 
-    for (int i = 0; i < 4; i++)
-        BalancePressure(gameParameters);
+        for (int i = 0; i < 4; i++)
+            BalancePressure(gameParameters);
 
-    for (int i = 0; i < 4; i++)
-    {
-        BalancePressure(gameParameters);
-        GravitateWater(gameParameters);
+        for (int i = 0; i < 4; i++)
+        {
+            BalancePressure(gameParameters);
+            GravitateWater(gameParameters);
+        }
     }
 
 
@@ -371,21 +416,29 @@ void Ship::Update(
     // Update electrical dynamics
     //
 
-    DiffuseLight(gameParameters);
-}
+    {
+        TraceSpan phaseSpan("Ship::DiffuseLight");
+
+        DiffuseLight(gameParameters);
+    }
+
 
-void Ship::Render(
-    GameParameters const & /*gameParameters*/,
-    RenderContext & renderContext) const
-{
     //
-    // Upload points's mutable attributes
+    // Update bounding boxes, for the render to cull what's not visible
     //
 
-    mPoints.Upload(
-        mId,
-        renderContext);
+    {
+        TraceSpan phaseSpan("Ship::UpdateBoundingBoxes");
 
+        UpdateBoundingBoxes();
+    }
+}
+
+void Ship::Render(
+    GameParameters const & /*gameParameters*/,
+    IRenderBackend & renderContext) const
+{
+    TraceSpan span("Ship::Render");
 
     //
     // Upload elements
@@ -399,55 +452,102 @@ void Ship::Render(
 
         if (mAreElementsDirty)
         {
-            renderContext.UploadShipElementsStart(
-                mId,
-                mConnectedComponentSizes);
+            if (!mAreElementsUploaded)
+            {
+                renderContext.UploadShipElementsStart(
+                    mId,
+                    mConnectedComponentSizes);
+            }
+            else
+            {
+                //
+                // Patch the elements destroyed since the last upload out of the
+                // connected components that are still whole
+                //
 
-            //
-            // Upload all the point elements
-            //
+                renderContext.UpdateShipElementsStart(
+                    mId,
+                    mConnectedComponentSizes,
+                    mChangedConnectedComponentIdsSinceLastUpload);
 
-            mPoints.UploadElements(
-                mId,
-                renderContext);
+                for (auto pointIndex : mDestroyedPointsSinceLastUpload)
+                {
+                    renderContext.RemoveShipElementPoint(mId, pointIndex);
+                }
 
-            //
-            // Upload all the spring elements (including ropes)
-            //
+                for (auto springIndex : mDestroyedSpringsSinceLastUpload)
+                {
+                    if (mSprings.IsRope(springIndex))
+                        renderContext.RemoveShipElementRope(mId, springIndex);
+                    else
+                        renderContext.RemoveShipElementSpring(mId, springIndex);
+                }
 
-            mSprings.UploadElements(
-                mId,
-                renderContext,
-                mPoints);
+                for (auto triangleIndex : mDestroyedTrianglesSinceLastUpload)
+                {
+                    renderContext.RemoveShipElementTriangle(mId, triangleIndex);
+                }
+
+                for (auto coarseTriangleIndex : mDestroyedCoarseTrianglesSinceLastUpload)
+                {
+                    renderContext.RemoveShipElementCoarseTriangle(mId, coarseTriangleIndex);
+                }
+
+                for (auto coarseBlockIndex : mBrokenCoarseTriangleBlocksSinceLastUpload)
+                {
+                    mTriangles.UploadBrokenCoarseBlockElements(
+                        mId,
+                        renderContext,
+                        mPoints,
+                        coarseBlockIndex);
+                }
+            }
 
             //
-            // Upload all the triangle elements
+            // Upload the elements of the connected components that have to be uploaded
+            // from scratch - all of them at the first upload, else only the ones that
+            // have changed
             //
 
-            mTriangles.UploadElements(
-                mId,
-                renderContext,
-                mPoints);
+            if (!mAreElementsUploaded || !mChangedConnectedComponentIdsSinceLastUpload.empty())
+            {
+                //
+                // Upload all the point elements
+                //
 
-            renderContext.UploadShipElementsEnd(mId);            
-        }
+                mPoints.UploadElements(
+                    mId,
+                    renderContext);
 
+                //
+                // Upload all the spring elements (including ropes)
+                //
 
-        //
-        // Upload stressed springs
-        //
+                mSprings.UploadElements(
+                    mId,
+                    renderContext,
+                    mPoints);
 
-        renderContext.UploadShipElementStressedSpringsStart(mId);
+                //
+                // Upload all the triangle elements
+                //
 
-        if (renderContext.GetShowStressedSprings())
-        {        
-            mSprings.UploadStressedSpringElements(
-                mId,
-                renderContext,
-                mPoints);
-        }
+                mTriangles.UploadElements(
+                    mId,
+                    renderContext,
+                    mPoints);
+            }
+
+            renderContext.UploadShipElementsEnd(mId);
 
-        renderContext.UploadShipElementStressedSpringsEnd(mId);
+            mAreElementsUploaded = true;
+            mDestroyedPointsSinceLastUpload.clear();
+            mDestroyedSpringsSinceLastUpload.clear();
+            mDestroyedTrianglesSinceLastUpload.clear();
+            mDestroyedCoarseTrianglesSinceLastUpload.clear();
+            mBrokenCoarseTriangleBlocksSinceLastUpload.clear();
+            mChangedConnectedComponentIdsSinceLastUpload.clear();
+        }
 
 
         //
@@ -481,6 +581,27 @@ void Ship::Render(
     }        
 
 
+    //
+    // Nothing else to do if the ship is not visible: the elements are still
+    // kept up-to-date, as they only change when the ship changes, while all
+    // that is uploaded on each frame is skipped
+    //
+
+    if (renderContext.IsShipCulled(mAABB))
+    {
+        return;
+    }
+
+
+    //
+    // Upload points's mutable attributes
+    //
+
+    mPoints.Upload(
+        mId,
+        renderContext);
+
+
     //
     // Upload bombs
     //
@@ -493,7 +614,144 @@ void Ship::Render(
     // Render ship
     //
 
-    renderContext.RenderShip(mId);
+    renderContext.RenderShip(
+        mId,
+        mConnectedComponentAABBs);
+}
+
+void Ship::WriteSnapshot(
+    SnapshotWriter & writer,
+    GameWallClock::time_point now) const
+{
+    //
+    // Elements
+    //
+
+    writer.Write<uint32_t>(mPoints.GetElementCount());
+    writer.Write<uint32_t>(mSprings.GetElementCount());
+    writer.Write<uint32_t>(mTriangles.GetElementCount());
+    writer.Write<uint32_t>(mElectricalElements.GetElementCount());
+
+    mPoints.WriteSnapshot(writer);
+    mSprings.WriteSnapshot(writer);
+    mTriangles.WriteSnapshot(writer);
+    mElectricalElements.WriteSnapshot(writer);
+
+    //
+    // Sinking detection
+    //
+
+    writer.Write<uint8_t>(mIsSinking ? 1 : 0);
+    writer.Write(mTotalWater);
+
+    //
+    // Pinned points, oldest first
+    //
+
+    std::vector<ElementIndex> pinnedPoints;
+    for (auto pointIndex : mCurrentPinnedPoints)
+    {
+        pinnedPoints.push_back(pointIndex);
+    }
+
+    writer.Write<uint32_t>(static_cast<uint32_t>(pinnedPoints.size()));
+    for (auto it = pinnedPoints.crbegin(); it != pinnedPoints.crend(); ++it)
+    {
+        writer.Write(*it);
+    }
+
+    //
+    // Bombs
+    //
+
+    mBombs.WriteSnapshot(writer, now);
+}
+
+std::unique_ptr<Ship> Ship::ReadSnapshot(
+    SnapshotReader & reader,
+    int id,
+    World & parentWorld,
+    std::shared_ptr<GameEventDispatcher> gameEventHandler,
+    MaterialDatabase const & materials,
+    uint64_t currentStepSequenceNumber,
+    GameWallClock::time_point now)
+{
+    //
+    // Elements
+    //
+
+    ElementCount const pointCount = reader.Read<uint32_t>();
+    ElementCount const springCount = reader.Read<uint32_t>();
+    ElementCount const triangleCount = reader.Read<uint32_t>();
+    ElementCount const electricalElementCount = reader.Read<uint32_t>();
+
+    Points points(pointCount, parentWorld, gameEventHandler);
+    points.ReadSnapshot(reader, springCount, triangleCount, electricalElementCount, materials);
+
+    Springs springs(springCount, parentWorld, gameEventHandler);
+    springs.ReadSnapshot(reader, pointCount, materials);
+
+    Triangles triangles(triangleCount);
+    triangles.ReadSnapshot(reader, pointCount);
+
+    ElectricalElements electricalElements(electricalElementCount);
+    electricalElements.ReadSnapshot(reader, pointCount);
+
+    // This also re-detects connected components
+    std::unique_ptr<Ship> ship(
+        new Ship(
+            id,
+            parentWorld,
+            std::move(gameEventHandler),
+            std::move(points),
+            std::move(springs),
+            std::move(triangles),
+            std::move(electricalElements),
+            currentStepSequenceNumber));
+
+    //
+    // Sinking detection
+    //
+
+    ship->mIsSinking = (0 != reader.Read<uint8_t>());
+    ship->mTotalWater = reader.Read<float>();
+
+    //
+    // Pinned points
+    //
+
+    uint32_t const pinnedPointCount = reader.Read<uint32_t>();
+    if (pinnedPointCount > GameParameters::MaxPinnedPoints)
+    {
+        throw GameException("Too many pinned points");
+    }
+
+    for (uint32_t p = 0; p < pinnedPointCount; ++p)
+    {
+        ElementIndex const pointIndex = reader.Read<ElementIndex>();
+        if (pointIndex >= pointCount)
+        {
+            throw GameException("Pinned point out of range");
+        }
+
+        ship->mCurrentPinnedPoints.emplace(
+            [](ElementIndex)
+            {
+                // Can't happen, as we never exceed the maximum number of pinned points
+                assert(false);
+            },
+            pointIndex);
+    }
+
+    ship->mArePinnedPointsDirty = true;
+
+    //
+    // Bombs
+    //
+
+    ship->mBombs.ReadSnapshot(reader, now);
+
+    return ship;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////
@@ -718,9 +976,15 @@ void Ship::HandleCollisionsWithSeaFloor()
 
 void Ship::DetectConnectedComponents(uint64_t currentStepSequenceNumber)
 {
-    mConnectedComponentSizes.clear();
+    //
+    // Connected components keep their IDs across detections, so that only the ones that have
+    // changed need to be uploaded again: when a connected component breaks up, the first piece
+    // that we visit keeps the ID, and the other pieces get new IDs
+    //
+
+    std::vector<std::size_t> const previousConnectedComponentSizes = mConnectedComponentSizes;
+    std::fill(mConnectedComponentSizes.begin(), mConnectedComponentSizes.end(), 0);
 
-    ConnectedComponentId currentConnectedComponentId = 0;
     std::queue<ElementIndex> pointsToVisitForConnectedComponents;    
 
     // Visit all points
@@ -732,9 +996,17 @@ void Ship::DetectConnectedComponents(uint64_t currentStepSequenceNumber)
             // Check if visited
             if (mPoints.GetCurrentConnectedComponentDetectionStepSequenceNumber(pointIndex) != currentStepSequenceNumber)
             {
-                // This node has not been visited, hence it's the beginning of a new connected component
-                ++currentConnectedComponentId;
-                size_t pointsInCurrentConnectedComponent = 0;
+                // This node has not been visited, hence it's the beginning of a new connected component;
+                // it keeps the ID of its old connected component, unless another piece has taken it already
+                ConnectedComponentId currentConnectedComponentId = mPoints.GetConnectedComponentId(pointIndex);
+                assert(currentConnectedComponentId <= mConnectedComponentSizes.size());
+                if (0 == currentConnectedComponentId
+                    || 0 != mConnectedComponentSizes[currentConnectedComponentId - 1])
+                {
+                    // A new ID
+                    mConnectedComponentSizes.push_back(0);
+                    currentConnectedComponentId = static_cast<ConnectedComponentId>(mConnectedComponentSizes.size());
+                }
 
                 //
                 // Propagate the connected component ID to all points reachable from this point
@@ -749,9 +1021,22 @@ void Ship::DetectConnectedComponents(uint64_t currentStepSequenceNumber)
                     auto currentPointIndex = pointsToVisitForConnectedComponents.front();
                     pointsToVisitForConnectedComponents.pop();
 
-                    // Assign the connected component ID
-                    mPoints.SetConnectedComponentId(currentPointIndex, currentConnectedComponentId);
-                    ++pointsInCurrentConnectedComponent;
+                    // Assign the connected component ID, remembering whether the point has moved
+                    auto const previousConnectedComponentId = mPoints.GetConnectedComponentId(currentPointIndex);
+                    if (previousConnectedComponentId != currentConnectedComponentId)
+                    {
+                        if (0 != previousConnectedComponentId)
+                        {
+                            mChangedConnectedComponentIdsSinceLastUpload.push_back(previousConnectedComponentId);
+                        }
+
+                        mChangedConnectedComponentIdsSinceLastUpload.push_back(currentConnectedComponentId);
+
+                        mPoints.SetConnectedComponentId(currentPointIndex, currentConnectedComponentId);
+                    }
+
+                    // Update the size of the connected component
+                    ++(mConnectedComponentSizes[currentConnectedComponentId - 1]);
 
                     // Go through this point's adjacents
                     for (auto adjacentSpringElementIndex : mPoints.GetConnectedSprings(currentPointIndex))
@@ -775,12 +1060,55 @@ void Ship::DetectConnectedComponents(uint64_t currentStepSequenceNumber)
                         }
                     }
                 }
-
-                // Store number of connected components
-                mConnectedComponentSizes.push_back(pointsInCurrentConnectedComponent);
             }
         }
     }
+
+    //
+    // Connected components that have lost all of their points have changed too
+    //
+
+    for (size_t c = 0; c < previousConnectedComponentSizes.size(); ++c)
+    {
+        if (0 != previousConnectedComponentSizes[c]
+            && 0 == mConnectedComponentSizes[c])
+        {
+            mChangedConnectedComponentIdsSinceLastUpload.push_back(static_cast<ConnectedComponentId>(c + 1));
+        }
+    }
+
+    std::sort(mChangedConnectedComponentIdsSinceLastUpload.begin(), mChangedConnectedComponentIdsSinceLastUpload.end());
+    mChangedConnectedComponentIdsSinceLastUpload.erase(
+        std::unique(mChangedConnectedComponentIdsSinceLastUpload.begin(), mChangedConnectedComponentIdsSinceLastUpload.end()),
+        mChangedConnectedComponentIdsSinceLastUpload.end());
+}
+
+void Ship::UpdateBoundingBoxes()
+{
+    Geometry::AABB const emptyAABB(
+        vec2f(std::numeric_limits<float>::max(), std::numeric_limits<float>::max()),
+        vec2f(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()));
+
+    mConnectedComponentAABBs.resize(mConnectedComponentSizes.size());
+    std::fill(mConnectedComponentAABBs.begin(), mConnectedComponentAABBs.end(), emptyAABB);
+
+    mAABB = emptyAABB;
+
+    for (auto pointIndex : mPoints)
+    {
+        if (!mPoints.IsDeleted(pointIndex))
+        {
+            ConnectedComponentId const connectedComponentId = mPoints.GetConnectedComponentId(pointIndex);
+            assert(connectedComponentId > 0 && connectedComponentId <= mConnectedComponentAABBs.size());
+
+            mConnectedComponentAABBs[connectedComponentId - 1].extendTo(mPoints.GetPosition(pointIndex));
+        }
+    }
+
+    for (auto const & connectedComponentAABB : mConnectedComponentAABBs)
+    {
+        mAABB.extendTo(connectedComponentAABB);
+    }
 }
 
 void Ship::LeakWater(GameParameters const & gameParameters)
@@ -1122,6 +1450,9 @@ void Ship::PointDestroyHandler(ElementIndex pointElementIndex)
     // Notify bombs
     mBombs.OnPointDestroyed(pointElementIndex);
 
+    // Remember to remove the point from the rendering context
+    mDestroyedPointsSinceLastUpload.push_back(pointElementIndex);
+
     // Remember our elements are now dirty
     mAreElementsDirty = true;
 }
@@ -1187,6 +1518,9 @@ void Ship::SpringDestroyHandler(
     // Notify bombs
     mBombs.OnSpringDestroyed(springElementIndex);
 
+    // Remember to remove the spring from the rendering context
+    mDestroyedSpringsSinceLastUpload.push_back(springElementIndex);
+
     // Remember our elements are now dirty
     mAreElementsDirty = true;
 }
@@ -1198,6 +1532,30 @@ void Ship::TriangleDestroyHandler(ElementIndex triangleElementIndex)
     mPoints.RemoveConnectedTriangle(mTriangles.GetPointBIndex(triangleElementIndex), triangleElementIndex);
     mPoints.RemoveConnectedTriangle(mTriangles.GetPointCIndex(triangleElementIndex), triangleElementIndex);
 
+    // Remember to remove the triangle from the rendering context
+    mDestroyedTrianglesSinceLastUpload.push_back(triangleElementIndex);
+
+    // Remember to remove the triangle from the coarse mesh too - either as a coarse triangle
+    // of its own, or by breaking up its coarse block if it's the first triangle of the block
+    // to go; the triangles of a block that broke up since the last upload are not in the
+    // coarse mesh yet
+    ElementIndex const coarseBlockIndex = mTriangles.GetCoarseBlockIndex(triangleElementIndex);
+    if (NoneElementIndex == coarseBlockIndex)
+    {
+        mDestroyedCoarseTrianglesSinceLastUpload.push_back(triangleElementIndex);
+    }
+    else if (mTriangles.IsCoarseBlockWhole(coarseBlockIndex))
+    {
+        mBrokenCoarseTriangleBlocksSinceLastUpload.push_back(coarseBlockIndex);
+    }
+    else if (mBrokenCoarseTriangleBlocksSinceLastUpload.end() == std::find(
+        mBrokenCoarseTriangleBlocksSinceLastUpload.begin(),
+        mBrokenCoarseTriangleBlocksSinceLastUpload.end(),
+        coarseBlockIndex))
+    {
+        mDestroyedCoarseTrianglesSinceLastUpload.push_back(triangleElementIndex);
+    }
+
     // Remember our elements are now dirty
     mAreElementsDirty = true;
 }
@@ -7,15 +7,19 @@
 ***************************************************************************************/
 #pragma once
 
+#include "AABB.h"
 #include "CircularList.h"
 #include "GameParameters.h"
 #include "GameTypes.h"
+#include "GameWallClock.h"
+#include "IRenderBackend.h"
 #include "MaterialDatabase.h"
 #include "Physics.h"
-#include "RenderContext.h"
 #include "ShipDefinition.h"
+#include "Snapshot.h"
 #include "Vectors.h"
 
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -29,7 +33,7 @@ public:
     Ship(
         int id,
         World & parentWorld,
-        std::shared_ptr<IGameEventHandler> gameEventHandler,
+        std::shared_ptr<GameEventDispatcher> gameEventHandler,
         Points && points,
         Springs && springs,
         Triangles && triangles,
@@ -95,7 +99,31 @@ public:
 
     void Render(
         GameParameters const & gameParameters,
-        RenderContext & renderContext) const;
+        IRenderBackend & renderContext) const;
+
+    /*
+     * Writes the state of the ship to a snapshot; time points are written relative
+     * to the specified current time.
+     */
+    void WriteSnapshot(
+        SnapshotWriter & writer,
+        GameWallClock::time_point now) const;
+
+    /*
+     * Makes a ship out of a snapshot.
+     *
+     * Only the state of the simulation is restored: the elements are flagged as dirty, hence
+     * connected components are re-detected and elements re-uploaded, and pending tool forces
+     * are dropped.
+     */
+    static std::unique_ptr<Ship> ReadSnapshot(
+        SnapshotReader & reader,
+        int id,
+        World & parentWorld,
+        std::shared_ptr<GameEventDispatcher> gameEventHandler,
+        MaterialDatabase const & materials,
+        uint64_t currentStepSequenceNumber,
+        GameWallClock::time_point now);
 
 public:
 
@@ -123,6 +151,8 @@ public:
 
     void DetectConnectedComponents(uint64_t currentStepSequenceNumber);
 
+    void UpdateBoundingBoxes();
+
     void LeakWater(GameParameters const & gameParameters);
 
     void GravitateWater(GameParameters const & gameParameters);
@@ -160,7 +190,7 @@ private:
 
     unsigned int const mId;
     World & mParentWorld;
-    std::shared_ptr<IGameEventHandler> mGameEventHandler;
+    std::shared_ptr<GameEventDispatcher> mGameEventHandler;
 
     // All the ship elements - never removed, the repositories maintain their own size forever
     Points mPoints;
@@ -171,12 +201,34 @@ private:
     // Connected components metadata
     std::vector<std::size_t> mConnectedComponentSizes;
 
+    // The world bounding boxes of the connected components, and of the whole ship,
+    // as of the end of the last step; only used for culling what's not visible
+    std::vector<Geometry::AABB> mConnectedComponentAABBs;
+    Geometry::AABB mAABB;
+
     // Flag remembering whether points (elements) and/or springs (incl. ropes) and/or triangles have changed
     // since the last step.
     // When this flag is set, we'll re-detect connected components and re-upload elements
     // to the rendering context
     bool mutable mAreElementsDirty;
 
+    // Flag remembering whether the elements have been uploaded at least once; from then
+    // on, we only tell the rendering context about the elements destroyed since the last
+    // upload, and about the connected components that have changed
+    bool mutable mAreElementsUploaded;
+
+    // The elements destroyed since the last upload
+    std::vector<ElementIndex> mutable mDestroyedPointsSinceLastUpload;
+    std::vector<ElementIndex> mutable mDestroyedSpringsSinceLastUpload;
+    std::vector<ElementIndex> mutable mDestroyedTrianglesSinceLastUpload;
+    std::vector<ElementIndex> mutable mDestroyedCoarseTrianglesSinceLastUpload;
+
+    // The coarse triangle blocks that have lost their first triangle since the last upload
+    std::vector<ElementIndex> mutable mBrokenCoarseTriangleBlocksSinceLastUpload;
+
+    // The IDs of the connected components that have broken up or disappeared since the last upload
+    std::vector<ConnectedComponentId> mutable mChangedConnectedComponentIdsSinceLastUpload;
+
     // Sinking detection
     bool mIsSinking;
     float mTotalWater;
@@ -7,10 +7,13 @@
 ***************************************************************************************/
 #include "ShipBuilder.h"
 
+#include "IndexedPriorityQueue.h"
 #include "Log.h"
+#include "Trace.h"
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <limits>
 
 using namespace Physics;
@@ -45,12 +48,46 @@ namespace /* anonymous */ {
 std::unique_ptr<Ship> ShipBuilder::Create(
     int shipId,
     World & parentWorld,
-    std::shared_ptr<IGameEventHandler> gameEventHandler,
+    std::shared_ptr<GameEventDispatcher> gameEventHandler,
     ShipDefinition const & shipDefinition,
     MaterialDatabase const & materials,
-    GameParameters const & /*gameParameters*/,
-    uint64_t currentStepSequenceNumber)
+    GameParameters const & gameParameters,
+    uint64_t currentStepSequenceNumber,
+    ProgressCallback const & progressCallback)
 {
+    CompiledShip compiledShip = Compile(
+        shipDefinition,
+        materials,
+        [&progressCallback](float progress, std::string const & message)
+        {
+            if (progressCallback)
+                progressCallback(0.9f * progress, message);
+        });
+
+    if (progressCallback)
+        progressCallback(0.9f, "Creating springs and triangles...");
+
+    auto ship = Create(
+        shipId,
+        parentWorld,
+        std::move(gameEventHandler),
+        compiledShip,
+        gameParameters,
+        currentStepSequenceNumber);
+
+    if (progressCallback)
+        progressCallback(1.0f, "Creating springs and triangles...");
+
+    return ship;
+}
+
+ShipBuilder::CompiledShip ShipBuilder::Compile(
+    ShipDefinition const & shipDefinition,
+    MaterialDatabase const & materials,
+    ProgressCallback const & progressCallback)
+{
+    TraceSpan span("ShipBuilder::Compile");
+
     int const structureWidth = shipDefinition.StructuralImage.Size.Width;
     float const halfWidth = static_cast<float>(structureWidth) / 2.0f;
     int const structureHeight = shipDefinition.StructuralImage.Size.Height;
@@ -67,83 +104,134 @@ std::unique_ptr<Ship> ShipBuilder::Create(
     // TriangleInfo's
     std::vector<TriangleInfo> triangleInfos;
 
+    // The two triangles of the cell whose top-left corner is each point, if the cell
+    // is fully tessellated; indexed by point
+    std::vector<std::array<ElementIndex, 2u>> cellTriangleIndices;
+
+    // CoarseTriangleBlockInfo's
+    std::vector<CoarseTriangleBlockInfo> coarseTriangleBlockInfos;
+
 
     //
-    // Process image points and:
+    // Visit the structure one row at a time, from bottom to top, and:
     // - Identify all points, and create PointInfo's for them
-    // - Build a 2D matrix containing indices to the points above
     // - Identify rope endpoints, and create RopeSegment's for them
-    //    
+    // - Set non-fully-surrounded PointInfo's as "leaking"
+    // - Detect springs and create SpringInfo's for them
+    // - Do tessellation and create TriangleInfo's
+    // - Group fully-tessellated squares of cells into CoarseTriangleBlockInfo's
+    //
+    // Tessellating a row only needs the points of the rows around it, hence we only
+    // keep the point indices of three rows at any given moment: at each step we make
+    // the points of a row, and then tessellate the row below it
+    //
 
-    // Matrix of points - we allocate 2 extra dummy rows and cols to avoid checking for boundaries
-    std::unique_ptr<std::unique_ptr<std::optional<ElementIndex>[]>[]> pointIndexMatrix(new std::unique_ptr<std::optional<ElementIndex>[]>[structureWidth + 2]);
-    for (int c = 0; c < structureWidth + 2; ++c)
-    {
-        pointIndexMatrix[c] = std::unique_ptr<std::optional<ElementIndex>[]>(new std::optional<ElementIndex>[structureHeight + 2]);
-    }
+    if (progressCallback)
+        progressCallback(0.3f, "Processing structure...");
+
+    PointIndexRows pointIndexRows(structureWidth);
+
+    // Materials of the pixels of the row being visited
+    std::unique_ptr<Material const *[]> rowMaterials(new Material const *[structureWidth]);
+
+    size_t leakingPointsCount = 0;
 
-    // Visit all real columns
-    for (int x = 0; x < structureWidth; ++x)
+    for (int y = 0; y <= structureHeight; ++y)
     {
-        // From bottom to top
-        for (int y = 0; y < structureHeight; ++y)
+        if (y < structureHeight)
         {
-            // R G B
-            std::array<uint8_t, 3u> rgbColour = {
-                shipDefinition.StructuralImage.Data[(x + (structureHeight - y - 1) * structureWidth) * 3 + 0],
-                shipDefinition.StructuralImage.Data[(x + (structureHeight - y - 1) * structureWidth) * 3 + 1],
-                shipDefinition.StructuralImage.Data[(x + (structureHeight - y - 1) * structureWidth) * 3 + 2] };
-
-            Material const * material = materials.Get(rgbColour);
-            if (nullptr == material)
+            //
+            // Make the points of this row, which becomes the row above
+            //
+
+            materials.GetRow(
+                &(shipDefinition.StructuralImage.Data[static_cast<size_t>(structureHeight - y - 1) * structureWidth * 3]),
+                static_cast<size_t>(structureWidth),
+                rowMaterials.get());
+
+            for (int x = 0; x < structureWidth; ++x)
             {
-                // Check whether it's a rope endpoint (#000xxx)
-                if (0x00 == rgbColour[0]
-                    && 0 == (rgbColour[1] & 0xF0))
+                Material const * material = rowMaterials[x];
+                if (nullptr == material)
                 {
-                    // Store in RopeSegments
-                    RopeSegment & ropeSegment = ropeSegments[rgbColour];
-                    if (NoneElementIndex == ropeSegment.PointAIndex)
-                    {
-                        ropeSegment.PointAIndex = static_cast<ElementIndex>(pointInfos.size());
-                    }
-                    else if (NoneElementIndex == ropeSegment.PointBIndex)
+                    // R G B
+                    std::array<uint8_t, 3u> rgbColour = {
+                        shipDefinition.StructuralImage.Data[(x + (structureHeight - y - 1) * structureWidth) * 3 + 0],
+                        shipDefinition.StructuralImage.Data[(x + (structureHeight - y - 1) * structureWidth) * 3 + 1],
+                        shipDefinition.StructuralImage.Data[(x + (structureHeight - y - 1) * structureWidth) * 3 + 2] };
+
+                    // Check whether it's a rope endpoint (#000xxx)
+                    if (0x00 == rgbColour[0]
+                        && 0 == (rgbColour[1] & 0xF0))
                     {
-                        ropeSegment.PointBIndex = static_cast<ElementIndex>(pointInfos.size());
-                    }
-                    else
-                    {
-                        throw GameException(
-                            std::string("More than two rope endpoints found at (")
-                            + std::to_string(x) + "," + std::to_string(y) + ")");
+                        // Store in RopeSegments
+                        RopeSegment & ropeSegment = ropeSegments[rgbColour];
+                        if (NoneElementIndex == ropeSegment.PointAIndex)
+                        {
+                            ropeSegment.PointAIndex = static_cast<ElementIndex>(pointInfos.size());
+                        }
+                        else if (NoneElementIndex == ropeSegment.PointBIndex)
+                        {
+                            ropeSegment.PointBIndex = static_cast<ElementIndex>(pointInfos.size());
+                        }
+                        else
+                        {
+                            throw GameException(
+                                std::string("More than two rope endpoints found at (")
+                                + std::to_string(x) + "," + std::to_string(y) + ")");
+                        }
+
+                        // Point to rope (#000000)
+                        material = &(materials.GetRopeMaterial());
                     }
+                }
 
-                    // Point to rope (#000000)
-                    material = &(materials.GetRopeMaterial());
+                if (nullptr != material)
+                {
+                    //
+                    // Make a point
+                    //
+
+                    pointIndexRows.SetAbove(x + 1, static_cast<ElementIndex>(pointInfos.size()));
+
+                    pointInfos.emplace_back(
+                        vec2f(
+                            static_cast<float>(x) - halfWidth,
+                            static_cast<float>(y))
+                            + shipDefinition.Offset,
+                        vec2f(
+                            static_cast<float>(x) / static_cast<float>(structureWidth),
+                            static_cast<float>(y) / static_cast<float>(structureHeight)),
+                        material);
                 }
             }
+        }
 
-            if (nullptr != material)
-            {
-                //
-                // Make a point
-                //
-
-                pointIndexMatrix[x + 1][y + 1] = static_cast<ElementIndex>(pointInfos.size());
-
-                pointInfos.emplace_back(
-                    vec2f(
-                        static_cast<float>(x) - halfWidth,
-                        static_cast<float>(y))
-                        + shipDefinition.Offset,
-                    vec2f(
-                        static_cast<float>(x) / static_cast<float>(structureWidth),
-                        static_cast<float>(y) / static_cast<float>(structureHeight)),
-                    material);
-            }
+        if (y > 0)
+        {
+            //
+            // Tessellate the row below
+            //
+
+            CreateRowElementInfos(
+                pointIndexRows,
+                structureWidth,
+                y - 1,
+                pointInfos,
+                springInfos,
+                triangleInfos,
+                cellTriangleIndices,
+                coarseTriangleBlockInfos,
+                leakingPointsCount);
         }
+
+        pointIndexRows.Advance();
     }
 
+    MarkUntessellatedSpringsCoarse(
+        pointInfos.size(),
+        springInfos,
+        triangleInfos);
 
 
     //
@@ -152,6 +240,9 @@ std::unique_ptr<Ship> ShipBuilder::Create(
     // - Fill-in springs between each pair of points in the rope, creating SpringInfo's for them
     //    
 
+    if (progressCallback)
+        progressCallback(0.5f, "Creating ropes...");
+
     CreateRopeSegments(
         ropeSegments,
         shipDefinition.StructuralImage.Size,
@@ -160,58 +251,66 @@ std::unique_ptr<Ship> ShipBuilder::Create(
         springInfos);
 
 
-    //
-    // Visit all PointInfo's and create Points, i.e. the entire set of points
-    //
-
-    Points points = CreatePoints(
-        pointInfos,
-        parentWorld,
-        gameEventHandler);
-
-
-    //
-    // Visit point matrix and:
-    //  - Set non-fully-surrounded Points as "leaking"
-    //  - Detect springs and create SpringInfo's for them (additional to ropes)
-    //  - Do tessellation and create TriangleInfo's
-    //
-
-    size_t leakingPointsCount;
-
-    CreateShipElementInfos(
-        pointIndexMatrix,
-        shipDefinition.StructuralImage.Size,
-        points,
-        springInfos,
-        triangleInfos,
-        leakingPointsCount);
-
-
     //
     // Optimize order of SpringInfo's to minimize cache misses
     //
 
+    if (progressCallback)
+        progressCallback(0.8f, "Optimizing springs...");
+
     float originalSpringACMR = CalculateACMR(springInfos);
 
+    auto const reorderStartTime = std::chrono::steady_clock::now();
+
     springInfos = ReorderOptimally(springInfos, pointInfos.size());
 
+    auto const reorderElapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - reorderStartTime);
+
     float optimizedSpringACMR = CalculateACMR(springInfos);
 
-    LogMessage("Spring ACMR: original=", originalSpringACMR, ", optimized=", optimizedSpringACMR);
+    LogMessage("Spring ACMR: original=", originalSpringACMR, ", optimized=", optimizedSpringACMR,
+        " (", springInfos.size(), " springs reordered in ", reorderElapsed.count(), "us)");
 
 
     // Note: we don't optimize triangles, as tests indicate that performance gets (marginally) worse,
     // and at the same time, it makes sense to use the natural order of the triangles as it ensures
     // that higher elements in the ship cover lower elements when they are semi-detached
 
+    return CompiledShip(
+        shipDefinition.StructuralImage.Size,
+        std::move(pointInfos),
+        std::move(springInfos),
+        std::move(triangleInfos),
+        std::move(coarseTriangleBlockInfos));
+}
+
+std::unique_ptr<Ship> ShipBuilder::Create(
+    int shipId,
+    World & parentWorld,
+    std::shared_ptr<GameEventDispatcher> gameEventHandler,
+    CompiledShip const & compiledShip,
+    GameParameters const & /*gameParameters*/,
+    uint64_t currentStepSequenceNumber)
+{
+    TraceSpan span("ShipBuilder::Create");
+
+    //
+    // Visit all PointInfo's and create Points, i.e. the entire set of points
+    //
+
+    Points points = CreatePoints(
+        compiledShip.PointInfos,
+        parentWorld,
+        gameEventHandler);
+
 
     //
     // Create Springs for all SpringInfo's
     //
 
     Springs springs = CreateSprings(
-        springInfos,
+        compiledShip.SpringInfos,
         points,
         parentWorld,
         gameEventHandler);
@@ -224,7 +323,8 @@ std::unique_ptr<Ship> ShipBuilder::Create(
     //
 
     Triangles triangles = CreateTriangles(
-        triangleInfos,
+        compiledShip.TriangleInfos,
+        compiledShip.CoarseTriangleBlockInfos,
         points,
         springs);
 
@@ -240,7 +340,7 @@ std::unique_ptr<Ship> ShipBuilder::Create(
     // We're done!
     //
 
-    LogMessage("Created ship: W=", shipDefinition.StructuralImage.Size.Width, ", H=", shipDefinition.StructuralImage.Size.Height, ", ",
+    LogMessage("Created ship: W=", compiledShip.StructureSize.Width, ", H=", compiledShip.StructureSize.Height, ", ",
         points.GetElementCount(), " points, ", springs.GetElementCount(), " springs, ", triangles.GetElementCount(), " triangles, ",
         electricalElements.GetElementCount(), " electrical elements.");
 
@@ -266,6 +366,8 @@ void ShipBuilder::CreateRopeSegments(
     std::vector<PointInfo> & pointInfos,
     std::vector<SpringInfo> & springInfos)
 {
+    TraceSpan span("ShipBuilder::CreateRopeSegments");
+
     //
     // - Fill-in points between each pair of endpoints, creating additional PointInfo's for them
     // - Fill-in springs between each pair of points in the rope, creating SpringInfo's for them
@@ -369,8 +471,10 @@ void ShipBuilder::CreateRopeSegments(
 Points ShipBuilder::CreatePoints(
     std::vector<PointInfo> const & pointInfos,
     World & parentWorld,
-    std::shared_ptr<IGameEventHandler> gameEventHandler)
+    std::shared_ptr<GameEventDispatcher> gameEventHandler)
 {
+    TraceSpan span("ShipBuilder::CreatePoints");
+
     Physics::Points points(
         static_cast<ElementIndex>(pointInfos.size()),
         parentWorld,
@@ -394,28 +498,41 @@ Points ShipBuilder::CreatePoints(
             buoyancy,
             mtl->RenderColour,
             pointInfo.TextureCoordinates);
+
+        if (pointInfo.IsLeaking)
+        {
+            points.SetLeaking(static_cast<ElementIndex>(p));
+        }
     }
 
     return points;
 }
 
-void ShipBuilder::CreateShipElementInfos(
-    std::unique_ptr<std::unique_ptr<std::optional<ElementIndex>[]>[]> const & pointIndexMatrix,
-    ImageSize const & structureImageSize,
-    Physics::Points & points,
+void ShipBuilder::CreateRowElementInfos(
+    PointIndexRows const & pointIndexRows,
+    int structureWidth,
+    int y,
+    std::vector<PointInfo> & pointInfos,
     std::vector<SpringInfo> & springInfos,
     std::vector<TriangleInfo> & triangleInfos,
+    std::vector<std::array<ElementIndex, 2u>> & cellTriangleIndices,
+    std::vector<CoarseTriangleBlockInfo> & coarseTriangleBlockInfos,
     size_t & leakingPointsCount)
 {
     //
-    // Visit point matrix and:
+    // Visit the current row and:
     //  - Set non-fully-surrounded Points as "leaking"
     //  - Detect springs and create SpringInfo's for them (additional to ropes)
     //  - Do tessellation and create TriangleInfo's
+    //  - Group fully-tessellated squares of cells into CoarseTriangleBlockInfo's
+    //
+    // The coarse springs make a grid with a spacing of two points, which outlines
+    // the coarse triangle blocks
     //
 
-    // Initialize count of leaking points
-    leakingPointsCount = 0;
+    cellTriangleIndices.resize(
+        pointInfos.size(),
+        { NoneElementIndex, NoneElementIndex });
 
     // This is our local circular order
     static const int Directions[8][2] = {
@@ -429,135 +546,211 @@ void ShipBuilder::CreateShipElementInfos(
         {  1,  1 }   // NE
     };
 
-    // From bottom to top
-    for (int y = 1; y <= structureImageSize.Height; ++y)
-    {
-        // We're starting a new row, so we're not in a ship now
-        bool isInShip = false;
+    // We're starting a new row, so we're not in a ship now
+    bool isInShip = false;
 
-        for (int x = 1; x <= structureImageSize.Width; ++x)
+    for (int x = 1; x <= structureWidth; ++x)
+    {
+        if (!!pointIndexRows.Get(x, 0))
         {
-            if (!!pointIndexMatrix[x][y])
-            {
-                //
-                // A point exists at these coordinates
-                //
+            //
+            // A point exists at these coordinates
+            //
 
-                ElementIndex pointIndex = *pointIndexMatrix[x][y];
+            ElementIndex pointIndex = *pointIndexRows.Get(x, 0);
 
-                // If a non-hull node has empty space on one of its four sides, it is automatically leaking.
-                // Check if a is leaking; a is leaking if:
-                // - a is not hull, AND
-                // - there is at least a hole at E, S, W, N
-                if (!points.GetMaterial(pointIndex)->IsHull)
+            // If a non-hull node has empty space on one of its four sides, it is automatically leaking.
+            // Check if a is leaking; a is leaking if:
+            // - a is not hull, AND
+            // - there is at least a hole at E, S, W, N
+            if (!pointInfos[pointIndex].Mtl->IsHull)
+            {
+                if (!pointIndexRows.Get(x + 1, 0)
+                    || !pointIndexRows.Get(x, 1)
+                    || !pointIndexRows.Get(x - 1, 0)
+                    || !pointIndexRows.Get(x, -1))
                 {
-                    if (!pointIndexMatrix[x + 1][y]
-                        || !pointIndexMatrix[x][y + 1]
-                        || !pointIndexMatrix[x - 1][y]
-                        || !pointIndexMatrix[x][y - 1])
-                    {
-                        points.SetLeaking(pointIndex);
+                    pointInfos[pointIndex].IsLeaking = true;
 
-                        ++leakingPointsCount;
-                    }
+                    ++leakingPointsCount;
                 }
+            }
 
 
-                //
-                // Check if a spring exists
-                //
+            //
+            // Check if a spring exists
+            //
 
-                // First four directions out of 8: from 0 deg (+x) through to 225 deg (-x -y),
-                // i.e. E, SE, S, SW - this covers each pair of points in each direction
-                for (int i = 0; i < 4; ++i)
+            // First four directions out of 8: from 0 deg (+x) through to 225 deg (-x -y),
+            // i.e. E, SE, S, SW - this covers each pair of points in each direction
+            for (int i = 0; i < 4; ++i)
+            {
+                int adjx1 = x + Directions[i][0];
+                int adjdy1 = Directions[i][1];
+
+                if (!!pointIndexRows.Get(adjx1, adjdy1))
                 {
-                    int adjx1 = x + Directions[i][0];
-                    int adjy1 = y + Directions[i][1];
+                    // This point is adjacent to the first point at one of E, SE, S, SW
+
+                    //
+                    // Create SpringInfo
+                    // 
 
-                    if (!!pointIndexMatrix[adjx1][adjy1])
+                    springInfos.emplace_back(
+                        pointIndex,
+                        *pointIndexRows.Get(adjx1, adjdy1));
+
+                    if ((i == 0 && 0 == (y % 2))
+                        || (i == 2 && 0 == (x % 2)))
                     {
-                        // This point is adjacent to the first point at one of E, SE, S, SW
+                        springInfos.back().IsCoarse = true;
+                    }
 
-                        //
-                        // Create SpringInfo
-                        // 
 
-                        springInfos.emplace_back(
-                            pointIndex,
-                            *pointIndexMatrix[adjx1][adjy1]);
+                    //
+                    // Check if a triangle exists
+                    // - If this is the first point that is in a ship, we check all the way up to W;
+                    // - Else, we check up to S, so to avoid covering areas already covered by the triangulation
+                    //   at the previous point
+                    //
 
+                    // Check adjacent point in next CW direction
+                    int adjx2 = x + Directions[i + 1][0];
+                    int adjdy2 = Directions[i + 1][1];
+                    if ((!isInShip || i < 2)
+                        && !!pointIndexRows.Get(adjx2, adjdy2))
+                    {
+                        // This point is adjacent to the first point at one of SE, S, SW, W
 
                         //
-                        // Check if a triangle exists
-                        // - If this is the first point that is in a ship, we check all the way up to W;
-                        // - Else, we check up to S, so to avoid covering areas already covered by the triangulation
-                        //   at the previous point
-                        //
-
-                        // Check adjacent point in next CW direction
-                        int adjx2 = x + Directions[i + 1][0];
-                        int adjy2 = y + Directions[i + 1][1];
-                        if ((!isInShip || i < 2)
-                            && !!pointIndexMatrix[adjx2][adjy2])
-                        {
-                            // This point is adjacent to the first point at one of SE, S, SW, W
+                        // Create TriangleInfo
+                        // 
 
-                            //
-                            // Create TriangleInfo
-                            // 
+                        triangleInfos.emplace_back(
+                            pointIndex,
+                            *pointIndexRows.Get(adjx1, adjdy1),
+                            *pointIndexRows.Get(adjx2, adjdy2));
 
-                            triangleInfos.emplace_back(
-                                pointIndex,
-                                *pointIndexMatrix[adjx1][adjy1],
-                                *pointIndexMatrix[adjx2][adjy2]);
+                        // The two triangles at E-SE and SE-S make the cell below-right of this point
+                        if (i < 2)
+                        {
+                            cellTriangleIndices[pointIndex][i] = static_cast<ElementIndex>(triangleInfos.size() - 1);
                         }
+                    }
 
-                        // Now, we also want to check whether the single "irregular" triangle from this point exists, 
-                        // i.e. the triangle between this point, the point at its E, and the point at its
-                        // S, in case there is no point at SE.
-                        // We do this so that we can forget the entire W side for inner points and yet ensure
-                        // full coverage of the area
-                        if (i == 0
-                            && !pointIndexMatrix[x + Directions[1][0]][y + Directions[1][1]]
-                            && !!pointIndexMatrix[x + Directions[2][0]][y + Directions[2][1]])
-                        {
-                            // If we're here, the point at E exists
-                            assert(!!pointIndexMatrix[x + Directions[0][0]][y + Directions[0][1]]);
+                    // Now, we also want to check whether the single "irregular" triangle from this point exists, 
+                    // i.e. the triangle between this point, the point at its E, and the point at its
+                    // S, in case there is no point at SE.
+                    // We do this so that we can forget the entire W side for inner points and yet ensure
+                    // full coverage of the area
+                    if (i == 0
+                        && !pointIndexRows.Get(x + Directions[1][0], Directions[1][1])
+                        && !!pointIndexRows.Get(x + Directions[2][0], Directions[2][1]))
+                    {
+                        // If we're here, the point at E exists
+                        assert(!!pointIndexRows.Get(x + Directions[0][0], Directions[0][1]));
 
-                            //
-                            // Create TriangleInfo
-                            // 
+                        //
+                        // Create TriangleInfo
+                        // 
 
-                            triangleInfos.emplace_back(
-                                pointIndex,
-                                *pointIndexMatrix[x + Directions[0][0]][y + Directions[0][1]],
-                                *pointIndexMatrix[x + Directions[2][0]][y + Directions[2][1]]);
-                        }
+                        triangleInfos.emplace_back(
+                            pointIndex,
+                            *pointIndexRows.Get(x + Directions[0][0], Directions[0][1]),
+                            *pointIndexRows.Get(x + Directions[2][0], Directions[2][1]));
                     }
                 }
-
-                // Remember now that we're in a ship
-                isInShip = true;
             }
-            else
+
+            // Remember now that we're in a ship
+            isInShip = true;
+        }
+        else
+        {
+            //
+            // No point exists at these coordinates
+            //
+
+            // From now on we're not in a ship anymore
+            isInShip = false;
+        }
+    }
+
+    //
+    // Make a coarse triangle block out of each square of 2x2 fully-tessellated cells
+    // whose top-left corner is at an even column of an even row
+    //
+
+    if (0 == (y % 2))
+    {
+        auto const getCellTriangleIndices = [&](int x, int relativeRow) -> std::optional<std::array<ElementIndex, 2u>>
+        {
+            auto const & pointIndex = pointIndexRows.Get(x, relativeRow);
+            if (!pointIndex
+                || NoneElementIndex == cellTriangleIndices[*pointIndex][0]
+                || NoneElementIndex == cellTriangleIndices[*pointIndex][1])
             {
-                //
-                // No point exists at these coordinates
-                //
+                return std::nullopt;
+            }
 
-                // From now on we're not in a ship anymore
-                isInShip = false;
+            return cellTriangleIndices[*pointIndex];
+        };
+
+        for (int x = 2; x < structureWidth; x += 2)
+        {
+            auto const topLeft = getCellTriangleIndices(x, 0);
+            auto const topRight = getCellTriangleIndices(x + 1, 0);
+            auto const bottomLeft = getCellTriangleIndices(x, -1);
+            auto const bottomRight = getCellTriangleIndices(x + 1, -1);
+
+            if (!!topLeft && !!topRight && !!bottomLeft && !!bottomRight)
+            {
+                coarseTriangleBlockInfos.emplace_back(
+                    std::array<ElementIndex, 8u>{
+                        (*topLeft)[0], (*topLeft)[1],
+                        (*topRight)[0], (*topRight)[1],
+                        (*bottomLeft)[0], (*bottomLeft)[1],
+                        (*bottomRight)[0], (*bottomRight)[1] });
             }
         }
     }
 }
 
+void ShipBuilder::MarkUntessellatedSpringsCoarse(
+    size_t pointCount,
+    std::vector<SpringInfo> & springInfos,
+    std::vector<TriangleInfo> const & triangleInfos)
+{
+    //
+    // Springs hanging off points that are not part of any triangle make 1D chains -
+    // which are only visible as springs - hence they are always drawn
+    //
+
+    std::vector<bool> isTessellatedPoint(pointCount, false);
+    for (auto const & triangleInfo : triangleInfos)
+    {
+        isTessellatedPoint[triangleInfo.PointAIndex] = true;
+        isTessellatedPoint[triangleInfo.PointBIndex] = true;
+        isTessellatedPoint[triangleInfo.PointCIndex] = true;
+    }
+
+    for (auto & springInfo : springInfos)
+    {
+        if (!isTessellatedPoint[springInfo.PointAIndex] || !isTessellatedPoint[springInfo.PointBIndex])
+        {
+            springInfo.IsCoarse = true;
+        }
+    }
+}
+
 Physics::Springs ShipBuilder::CreateSprings(
     std::vector<SpringInfo> const & springInfos,
     Physics::Points & points,
     World & parentWorld,
-    std::shared_ptr<IGameEventHandler> gameEventHandler)
+    std::shared_ptr<GameEventDispatcher> gameEventHandler)
 {
+    TraceSpan span("ShipBuilder::CreateSprings");
+
     Physics::Springs springs(
         static_cast<ElementIndex>(springInfos.size()),
         parentWorld,
@@ -583,6 +776,8 @@ Physics::Springs ShipBuilder::CreateSprings(
         // (non-rope <-> rope springs are "connections" and not to be treated as ropes)
         if (pointAMaterial->IsRope && pointBMaterial->IsRope)
             characteristics |= static_cast<int>(Springs::Characteristics::Rope);
+        else if (springInfos[s].IsCoarse)
+            characteristics |= static_cast<int>(Springs::Characteristics::Coarse);
 
         // Create spring
         springs.Add(
@@ -602,9 +797,12 @@ Physics::Springs ShipBuilder::CreateSprings(
 
 Physics::Triangles ShipBuilder::CreateTriangles(
     std::vector<TriangleInfo> const & triangleInfos,
+    std::vector<CoarseTriangleBlockInfo> const & coarseTriangleBlockInfos,
     Physics::Points & points,
     Physics::Springs & springs)
 {
+    TraceSpan span("ShipBuilder::CreateTriangles");
+
     //
     // First pass: filter out triangles and keep indices of those that need to be created
     //
@@ -612,6 +810,9 @@ Physics::Triangles ShipBuilder::CreateTriangles(
     std::vector<ElementIndex> triangleIndices;
     triangleIndices.reserve(triangleInfos.size());
 
+    // The index of the triangle that is created for each TriangleInfo, if any
+    std::vector<ElementIndex> createdTriangleIndices(triangleInfos.size(), NoneElementIndex);
+
     for (ElementIndex t = 0; t < triangleInfos.size(); ++t)
     {
         if (points.GetMaterial(triangleInfos[t].PointAIndex)->IsRope
@@ -628,6 +829,7 @@ Physics::Triangles ShipBuilder::CreateTriangles(
         }
 
         // Remember to create this triangle
+        createdTriangleIndices[t] = static_cast<ElementIndex>(triangleIndices.size());
         triangleIndices.push_back(t);
     }
 
@@ -653,12 +855,35 @@ Physics::Triangles ShipBuilder::CreateTriangles(
         points.AddConnectedTriangle(triangleInfos[triangleIndex].PointCIndex, t);
     }
 
+    //
+    // Third pass: create coarse triangle blocks, unless any of their triangles has not been created
+    //
+
+    for (auto const & coarseTriangleBlockInfo : coarseTriangleBlockInfos)
+    {
+        std::array<ElementIndex, 8u> blockTriangleIndices;
+        for (size_t i = 0; i < blockTriangleIndices.size(); ++i)
+        {
+            blockTriangleIndices[i] = createdTriangleIndices[coarseTriangleBlockInfo.TriangleIndices[i]];
+        }
+
+        if (std::none_of(
+            blockTriangleIndices.cbegin(),
+            blockTriangleIndices.cend(),
+            [](ElementIndex triangleIndex) { return NoneElementIndex == triangleIndex; }))
+        {
+            triangles.AddCoarseBlock(blockTriangleIndices);
+        }
+    }
+
     return triangles;
 }
 
 ElectricalElements ShipBuilder::CreateElectricalElements(
     Physics::Points & points)
 {
+    TraceSpan span("ShipBuilder::CreateElectricalElements");
+
     ElementIndex electricalElementsCount = 0;
     for (auto pointIndex : points)
     {
@@ -714,22 +939,29 @@ std::vector<ShipBuilder::SpringInfo> ShipBuilder::ReorderOptimally(
     std::vector<SpringInfo> & springInfos,
     size_t vertexCount)
 {
+    TraceSpan span("ShipBuilder::ReorderOptimally");
+
     std::vector<VertexData> vertexData(vertexCount);
-    std::vector<ElementData> elementData(springInfos.size());
+    std::vector<ElementData<2>> elementData(springInfos.size());
 
-    // Fill-in cross-references between vertices and springs
+    // Fill-in springs' vertices
     for (size_t s = 0; s < springInfos.size(); ++s)
     {
-        vertexData[springInfos[s].PointAIndex].RemainingElementIndices.push_back(s);
-        vertexData[springInfos[s].PointBIndex].RemainingElementIndices.push_back(s);
-
-        elementData[s].VertexIndices.push_back(static_cast<size_t>(springInfos[s].PointAIndex));
-        elementData[s].VertexIndices.push_back(static_cast<size_t>(springInfos[s].PointBIndex));
+        elementData[s].VertexIndices[0] = static_cast<size_t>(springInfos[s].PointAIndex);
+        elementData[s].VertexIndices[1] = static_cast<size_t>(springInfos[s].PointBIndex);
     }
 
+    // Fill-in cross-references between vertices and springs
+    std::vector<size_t> vertexElementIndices;
+    CalculateVertexElementIndices(
+        elementData,
+        vertexData,
+        vertexElementIndices);
+
     // Get optimal indices
     auto optimalIndices = ReorderOptimally<2>(
         vertexData,
+        vertexElementIndices,
         elementData);
 
     // Build optimally-ordered set of springs
@@ -748,23 +980,27 @@ std::vector<ShipBuilder::TriangleInfo> ShipBuilder::ReorderOptimally(
     size_t vertexCount)
 {
     std::vector<VertexData> vertexData(vertexCount);
-    std::vector<ElementData> elementData(triangleInfos.size());
+    std::vector<ElementData<3>> elementData(triangleInfos.size());
 
-    // Fill-in cross-references between vertices and triangles
+    // Fill-in triangles' vertices
     for (size_t t = 0; t < triangleInfos.size(); ++t)
     {
-        vertexData[triangleInfos[t].PointAIndex].RemainingElementIndices.push_back(t);
-        vertexData[triangleInfos[t].PointBIndex].RemainingElementIndices.push_back(t);
-        vertexData[triangleInfos[t].PointCIndex].RemainingElementIndices.push_back(t);
-
-        elementData[t].VertexIndices.push_back(static_cast<size_t>(triangleInfos[t].PointAIndex));
-        elementData[t].VertexIndices.push_back(static_cast<size_t>(triangleInfos[t].PointBIndex));
-        elementData[t].VertexIndices.push_back(static_cast<size_t>(triangleInfos[t].PointCIndex));
+        elementData[t].VertexIndices[0] = static_cast<size_t>(triangleInfos[t].PointAIndex);
+        elementData[t].VertexIndices[1] = static_cast<size_t>(triangleInfos[t].PointBIndex);
+        elementData[t].VertexIndices[2] = static_cast<size_t>(triangleInfos[t].PointCIndex);
     }
 
+    // Fill-in cross-references between vertices and triangles
+    std::vector<size_t> vertexElementIndices;
+    CalculateVertexElementIndices(
+        elementData,
+        vertexData,
+        vertexElementIndices);
+
     // Get optimal indices
     auto optimalIndices = ReorderOptimally<3>(
         vertexData,
+        vertexElementIndices,
         elementData);
 
     // Build optimally-ordered set of triangles
@@ -778,10 +1014,52 @@ std::vector<ShipBuilder::TriangleInfo> ShipBuilder::ReorderOptimally(
     return newTriangleInfos;
 }
 
+template <size_t VerticesInElement>
+void ShipBuilder::CalculateVertexElementIndices(
+    std::vector<ElementData<VerticesInElement>> const & elementData,
+    std::vector<VertexData> & vertexData,
+    std::vector<size_t> & vertexElementIndices)
+{
+    //
+    // Lay out the elements of each vertex contiguously in a single array, so that
+    // we don't need one allocation per vertex
+    //
+
+    // Count elements of each vertex
+    for (auto const & e : elementData)
+    {
+        for (size_t vi : e.VertexIndices)
+        {
+            ++(vertexData[vi].RemainingElementsCount);
+        }
+    }
+
+    // Assign offsets
+    size_t currentOffset = 0;
+    for (VertexData & v : vertexData)
+    {
+        v.RemainingElementsOffset = currentOffset;
+        currentOffset += v.RemainingElementsCount;
+        v.RemainingElementsCount = 0;
+    }
+
+    // Fill-in
+    vertexElementIndices.resize(currentOffset);
+    for (size_t ei = 0; ei < elementData.size(); ++ei)
+    {
+        for (size_t vi : elementData[ei].VertexIndices)
+        {
+            vertexElementIndices[vertexData[vi].RemainingElementsOffset + vertexData[vi].RemainingElementsCount] = ei;
+            ++(vertexData[vi].RemainingElementsCount);
+        }
+    }
+}
+
 template <size_t VerticesInElement>
 std::vector<size_t> ShipBuilder::ReorderOptimally(
     std::vector<VertexData> & vertexData,
-    std::vector<ElementData> & elementData)
+    std::vector<size_t> & vertexElementIndices,
+    std::vector<ElementData<VerticesInElement>> & elementData)
 {
     // Calculate vertex scores
     for (VertexData & v : vertexData)
@@ -789,9 +1067,8 @@ std::vector<size_t> ShipBuilder::ReorderOptimally(
         v.CurrentScore = CalculateVertexScore<VerticesInElement>(v);
     }
 
-    // Calculate element scores, remembering best so far
-    float bestElementScore = std::numeric_limits<float>::lowest();
-    std::optional<size_t> bestElementIndex(std::nullopt);
+    // Calculate element scores, and queue all elements by their score
+    IndexedPriorityQueue<float> remainingElements(elementData.size());
     for (size_t ei = 0; ei < elementData.size(); ++ei)
     {
         for (size_t vi : elementData[ei].VertexIndices)
@@ -799,11 +1076,7 @@ std::vector<size_t> ShipBuilder::ReorderOptimally(
             elementData[ei].CurrentScore += vertexData[vi].CurrentScore;
         }
 
-        if (elementData[ei].CurrentScore > bestElementScore)
-        {
-            bestElementScore = elementData[ei].CurrentScore;
-            bestElementIndex = ei;
-        }
+        remainingElements.push(ei, elementData[ei].CurrentScore);
     }
 
 
@@ -811,11 +1084,19 @@ std::vector<size_t> ShipBuilder::ReorderOptimally(
     // Main loop - run until we've drawn all elements
     //
 
-    std::list<size_t> modelLruVertexCache;
+    ModelLRUVertexCache<VerticesInElement> modelLruVertexCache;
 
     std::vector<size_t> optimalElementIndices;
     optimalElementIndices.reserve(elementData.size());
 
+    // The best element among those using vertices in the cache
+    std::optional<size_t> bestElementIndex(std::nullopt);
+
+    // The elements whose score has changed since we've last updated the queue;
+    // we only need the queue when we run out of elements in the cache, hence
+    // we bring it up-to-date lazily
+    std::vector<size_t> staleQueuedElementIndices;
+
     while (optimalElementIndices.size() < elementData.size())
     {
         //
@@ -824,20 +1105,29 @@ std::vector<size_t> ShipBuilder::ReorderOptimally(
 
         if (!bestElementIndex)
         {
-            // Have to find best element
-            bestElementScore = std::numeric_limits<float>::lowest();
-            for (size_t ei = 0; ei < elementData.size(); ++ei)
+            // None of the vertices in the cache has elements left, so take the best element
+            // overall - after bringing the queue up-to-date with the scores we've changed
+            for (size_t ei : staleQueuedElementIndices)
             {
-                if (!elementData[ei].HasBeenDrawn
-                    && elementData[ei].CurrentScore > bestElementScore)
+                if (!elementData[ei].HasBeenDrawn)
                 {
-                    bestElementScore = elementData[ei].CurrentScore > bestElementScore;
-                    bestElementIndex = ei;
+                    remainingElements.update(ei, elementData[ei].CurrentScore);
                 }
+
+                elementData[ei].IsQueuedScoreStale = false;
+            }
+
+            staleQueuedElementIndices.clear();
+
+            // Drawn elements are removed from the queue lazily, only when they get in the way
+            while (elementData[remainingElements.top()].HasBeenDrawn)
+            {
+                remainingElements.pop();
             }
+
+            bestElementIndex = remainingElements.top();
         }
 
-        assert(!!bestElementIndex);
         assert(!elementData[*bestElementIndex].HasBeenDrawn);
 
         // Add the best element to the optimal list
@@ -849,45 +1139,72 @@ std::vector<size_t> ShipBuilder::ReorderOptimally(
         // Update all of the element's vertices
         for (auto vi : elementData[*bestElementIndex].VertexIndices)
         {
-            // Remove the best element element from the lists of remaining elements for this vertex
-            vertexData[vi].RemainingElementIndices.erase(
-                std::remove(
-                    vertexData[vi].RemainingElementIndices.begin(),
-                    vertexData[vi].RemainingElementIndices.end(),
-                    *bestElementIndex));
+            // Remove the best element from the list of remaining elements for this vertex
+            size_t * const remainingElementIndices = vertexElementIndices.data() + vertexData[vi].RemainingElementsOffset;
+            for (size_t i = 0; i < vertexData[vi].RemainingElementsCount; ++i)
+            {
+                if (remainingElementIndices[i] == *bestElementIndex)
+                {
+                    remainingElementIndices[i] = remainingElementIndices[vertexData[vi].RemainingElementsCount - 1];
+                    --(vertexData[vi].RemainingElementsCount);
+                    break;
+                }
+            }
 
             // Update the LRU cache with this vertex
             AddVertexToCache(vi, modelLruVertexCache);
         }
 
-        // Re-assign positions and scores of all vertices in the cache
-        int32_t currentCachePosition = 0;
-        for (auto it = modelLruVertexCache.begin(); it != modelLruVertexCache.end(); ++it, ++currentCachePosition)
+        // Re-assign positions and scores of all vertices in the cache,
+        // including those that are about to be pushed out of it
+        for (size_t c = 0; c < modelLruVertexCache.Size; ++c)
         {
-            vertexData[*it].CachePosition = (currentCachePosition < VertexCacheSize)
-                ? currentCachePosition
+            size_t const vi = modelLruVertexCache.Entries[c];
+
+            vertexData[vi].CachePosition = (c < VertexCacheSize)
+                ? static_cast<int32_t>(c)
                 : -1;
 
-            vertexData[*it].CurrentScore = CalculateVertexScore<VerticesInElement>(vertexData[*it]);
+            vertexData[vi].CurrentScore = CalculateVertexScore<VerticesInElement>(vertexData[vi]);
+        }
 
-            // Zero the score of this vertices' elements, as we'll be updating it next
-            for (size_t ei : vertexData[*it].RemainingElementIndices)
+        // Zero the score of these vertices' elements, as we'll be updating it next
+        for (size_t c = 0; c < modelLruVertexCache.Size; ++c)
+        {
+            VertexData const & v = vertexData[modelLruVertexCache.Entries[c]];
+            for (size_t i = v.RemainingElementsOffset; i < v.RemainingElementsOffset + v.RemainingElementsCount; ++i)
             {
-                elementData[ei].CurrentScore = 0.0f;
+                elementData[vertexElementIndices[i]].CurrentScore = 0.0f;
             }
         }
 
-        // Update scores of all elements in the cache, maintaining best score at the same time
-        bestElementScore = std::numeric_limits<float>::lowest();
+        // Update scores of all elements in the cache
+        for (size_t c = 0; c < modelLruVertexCache.Size; ++c)
+        {
+            VertexData const & v = vertexData[modelLruVertexCache.Entries[c]];
+            for (size_t i = v.RemainingElementsOffset; i < v.RemainingElementsOffset + v.RemainingElementsCount; ++i)
+            {
+                elementData[vertexElementIndices[i]].CurrentScore += v.CurrentScore;
+            }
+        }
+
+        // Find the best among these elements, remembering which ones have a stale score in the queue
+        float bestElementScore = std::numeric_limits<float>::lowest();
         bestElementIndex = std::nullopt;
-        for (size_t vi : modelLruVertexCache)
+        for (size_t c = 0; c < modelLruVertexCache.Size; ++c)
         {
-            for (size_t ei : vertexData[vi].RemainingElementIndices)
+            VertexData const & v = vertexData[modelLruVertexCache.Entries[c]];
+            for (size_t i = v.RemainingElementsOffset; i < v.RemainingElementsOffset + v.RemainingElementsCount; ++i)
             {
+                size_t const ei = vertexElementIndices[i];
+
                 assert(!elementData[ei].HasBeenDrawn);
 
-                // Add this vertex's score to the element's score
-                elementData[ei].CurrentScore += vertexData[vi].CurrentScore;
+                if (!elementData[ei].IsQueuedScoreStale)
+                {
+                    elementData[ei].IsQueuedScoreStale = true;
+                    staleQueuedElementIndices.push_back(ei);
+                }
 
                 // Check if best so far
                 if (elementData[ei].CurrentScore > bestElementScore)
@@ -899,9 +1216,9 @@ std::vector<size_t> ShipBuilder::ReorderOptimally(
         }
 
         // Shrink cache back to its size
-        if (modelLruVertexCache.size() > VertexCacheSize)
+        if (modelLruVertexCache.Size > VertexCacheSize)
         {
-            modelLruVertexCache.resize(VertexCacheSize);
+            modelLruVertexCache.Size = VertexCacheSize;
         }
     }
 
@@ -975,26 +1292,31 @@ float ShipBuilder::CalculateACMR(std::vector<TriangleInfo> const & triangleInfos
     return cacheMisses / static_cast<float>(triangleInfos.size());
 }
 
+template <size_t VerticesInElement>
 void ShipBuilder::AddVertexToCache(
     size_t vertexIndex,
-    ModelLRUVertexCache & cache)
+    ModelLRUVertexCache<VerticesInElement> & cache)
 {
-    for (auto it = cache.begin(); it != cache.end(); ++it)
+    // Find the vertex in the cache; if it's not there, it goes in as a new entry
+    size_t position = 0;
+    while (position < cache.Size && cache.Entries[position] != vertexIndex)
     {
-        if (vertexIndex == *it)
-        {
-            // It's already in the cache...
-            // ...move it to front
-            cache.erase(it);
-            cache.push_front(vertexIndex);
+        ++position;
+    }
 
-            return;
-        }
+    if (position == cache.Size)
+    {
+        assert(cache.Size < cache.Entries.size());
+        ++(cache.Size);
     }
 
-    // Not in the cache...
-    // ...insert in front of cache
-    cache.push_front(vertexIndex);
+    // Move it to front
+    for (; position > 0; --position)
+    {
+        cache.Entries[position] = cache.Entries[position - 1];
+    }
+
+    cache.Entries[0] = vertexIndex;
 }
 
 template <size_t VerticesInElement>
@@ -1011,7 +1333,7 @@ float ShipBuilder::CalculateVertexScore(VertexData const & vertexData)
     static constexpr float FindVertexScore_ValenceBoostScale = 2.0f;
     static constexpr float FindVertexScore_ValenceBoostPower = 0.5f;        
 
-    if (vertexData.RemainingElementIndices.size() == 0)
+    if (vertexData.RemainingElementsCount == 0)
     {
         // No elements left using this vertex, give it a bad score
         return -1.0f;
@@ -1045,7 +1367,7 @@ float ShipBuilder::CalculateVertexScore(VertexData const & vertexData)
     // Bonus points for having a low number of elements still 
     // using this vertex, so we get rid of lone vertices quickly
     float valenceBoost = powf(
-        static_cast<float>(vertexData.RemainingElementIndices.size()),
+        static_cast<float>(vertexData.RemainingElementsCount),
         -FindVertexScore_ValenceBoostPower);
     score += FindVertexScore_ValenceBoostScale * valenceBoost;
 
@@ -1055,47 +1377,48 @@ float ShipBuilder::CalculateVertexScore(VertexData const & vertexData)
 template<size_t Size>
 bool ShipBuilder::TestLRUVertexCache<Size>::UseVertex(size_t vertexIndex)
 {
-    for (auto it = mEntries.begin(); it != mEntries.end(); ++it)
+    // Find the vertex in the cache
+    size_t position = 0;
+    while (position < mSize && mEntries[position] != vertexIndex)
     {
-        if (vertexIndex == *it)
-        {
-            // It's already in the cache...
-            // ...move it to front
-            mEntries.erase(it);
-            mEntries.push_front(vertexIndex);
+        ++position;
+    }
+
+    bool const isHit = (position < mSize);
 
-            // It was a cache hit
-            return true;
+    if (!isHit)
+    {
+        // Not in the cache...
+        // ...insert in front of cache, dropping the least recently used entry if full
+        if (mSize < Size)
+        {
+            ++mSize;
         }
-    }
 
-    // Not in the cache...
-    // ...insert in front of cache
-    mEntries.push_front(vertexIndex);
+        position = mSize - 1;
+    }
 
-    // Trim
-    while (mEntries.size() > Size)
+    // Move it to front
+    for (; position > 0; --position)
     {
-        mEntries.pop_back();
+        mEntries[position] = mEntries[position - 1];
     }
 
-    // It was a cache miss
-    return false;
+    mEntries[0] = vertexIndex;
+
+    return isHit;
 }
 
 template<size_t Size>
 std::optional<size_t> ShipBuilder::TestLRUVertexCache<Size>::GetCachePosition(size_t vertexIndex)
 {
-    size_t position = 0;
-    for (auto const & vi : mEntries)
+    for (size_t position = 0; position < mSize; ++position)
     {
-        if (vi == vertexIndex)
+        if (mEntries[position] == vertexIndex)
         {
             // Found!
             return position;
         }
-
-        ++position;
     }
 
     // Not found
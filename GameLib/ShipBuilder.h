@@ -9,12 +9,15 @@
 #include "ImageSize.h"
 #include "MaterialDatabase.h"
 #include "Physics.h"
+#include "ProgressCallback.h"
 #include "ShipDefinition.h"
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
-#include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <vector>
 
@@ -25,22 +28,16 @@ class ShipBuilder
 {
 public:
 
-    static std::unique_ptr<Physics::Ship> Create(
-        int shipId,        
-        Physics::World & parentWorld,
-        std::shared_ptr<IGameEventHandler> gameEventHandler,
-        ShipDefinition const & shipDefinition,
-        MaterialDatabase const & materials,
-        GameParameters const & gameParameters,
-        uint64_t currentStepSequenceNumber);
-
-private:
+    // The version of the builder's output; to be bumped whenever a change to the
+    // builder changes the ships it makes, as it invalidates compiled ships
+    static constexpr uint32_t Version = 3;
 
     struct PointInfo
     {
         vec2f Position;
         vec2f TextureCoordinates;
         Material const * Mtl;
+        bool IsLeaking;
 
         PointInfo(
             vec2f position,
@@ -49,18 +46,7 @@ private:
             : Position(position)
             , TextureCoordinates(textureCoordinates)
             , Mtl(mtl)
-        {
-        }
-    };
-
-    struct RopeSegment
-    {
-        ElementIndex PointAIndex;
-        ElementIndex PointBIndex;
-
-        RopeSegment()
-            : PointAIndex(NoneElementIndex)
-            , PointBIndex(NoneElementIndex)
+            , IsLeaking(false)
         {
         }
     };
@@ -70,11 +56,15 @@ private:
         ElementIndex PointAIndex;
         ElementIndex PointBIndex;
 
+        // Whether the spring is also drawn when the ship is drawn with less detail
+        bool IsCoarse;
+
         SpringInfo(
             ElementIndex pointAIndex,
             ElementIndex pointBIndex)
             : PointAIndex(pointAIndex)
             , PointBIndex(pointBIndex)
+            , IsCoarse(false)
         {
         }
     };
@@ -96,6 +86,157 @@ private:
         }
     };
 
+    /*
+     * A square of 2x2 cells of the structure, fully tessellated with two triangles per cell;
+     * when the ship is drawn with less detail, the square is drawn with two triangles instead
+     * of eight, for as long as all of its triangles are there.
+     *
+     * The triangles are those of the top-left, top-right, bottom-left, and bottom-right cells,
+     * in this order; the triangles of each cell are the one with the cell's top-left, top-right,
+     * and bottom-right corners, and then the one with its top-left, bottom-right, and bottom-left
+     * corners.
+     */
+    struct CoarseTriangleBlockInfo
+    {
+        std::array<ElementIndex, 8u> TriangleIndices;
+
+        explicit CoarseTriangleBlockInfo(std::array<ElementIndex, 8u> const & triangleIndices)
+            : TriangleIndices(triangleIndices)
+        {
+        }
+    };
+
+    /*
+     * A ship as it comes out of the expensive part of the build - i.e. decoding the
+     * structure, filling in ropes, tessellating, and optimizing - in the final order
+     * of its elements. It does not depend on the world, hence it may be cached.
+     */
+    struct CompiledShip
+    {
+        ImageSize StructureSize;
+        std::vector<PointInfo> PointInfos;
+        std::vector<SpringInfo> SpringInfos;
+        std::vector<TriangleInfo> TriangleInfos;
+        std::vector<CoarseTriangleBlockInfo> CoarseTriangleBlockInfos;
+
+        CompiledShip(
+            ImageSize structureSize,
+            std::vector<PointInfo> pointInfos,
+            std::vector<SpringInfo> springInfos,
+            std::vector<TriangleInfo> triangleInfos,
+            std::vector<CoarseTriangleBlockInfo> coarseTriangleBlockInfos)
+            : StructureSize(structureSize)
+            , PointInfos(std::move(pointInfos))
+            , SpringInfos(std::move(springInfos))
+            , TriangleInfos(std::move(triangleInfos))
+            , CoarseTriangleBlockInfos(std::move(coarseTriangleBlockInfos))
+        {
+        }
+    };
+
+    static std::unique_ptr<Physics::Ship> Create(
+        int shipId,
+        Physics::World & parentWorld,
+        std::shared_ptr<GameEventDispatcher> gameEventHandler,
+        ShipDefinition const & shipDefinition,
+        MaterialDatabase const & materials,
+        GameParameters const & gameParameters,
+        uint64_t currentStepSequenceNumber,
+        ProgressCallback const & progressCallback);
+
+    /*
+     * Runs the expensive part of the build.
+     */
+    static CompiledShip Compile(
+        ShipDefinition const & shipDefinition,
+        MaterialDatabase const & materials,
+        ProgressCallback const & progressCallback);
+
+    /*
+     * Makes a ship for the specified world out of a compiled ship; this is cheap.
+     */
+    static std::unique_ptr<Physics::Ship> Create(
+        int shipId,
+        Physics::World & parentWorld,
+        std::shared_ptr<GameEventDispatcher> gameEventHandler,
+        CompiledShip const & compiledShip,
+        GameParameters const & gameParameters,
+        uint64_t currentStepSequenceNumber);
+
+    /*
+     * Reorder elements so that drawing them makes the best use of the GPU's vertex cache;
+     * public for the benchmarks.
+     */
+    static std::vector<SpringInfo> ReorderOptimally(
+        std::vector<SpringInfo> & springInfos,
+        size_t vertexCount);
+
+    static std::vector<TriangleInfo> ReorderOptimally(
+        std::vector<TriangleInfo> & triangleInfos,
+        size_t vertexCount);
+
+private:
+
+    struct RopeSegment
+    {
+        ElementIndex PointAIndex;
+        ElementIndex PointBIndex;
+
+        RopeSegment()
+            : PointAIndex(NoneElementIndex)
+            , PointBIndex(NoneElementIndex)
+        {
+        }
+    };
+
+    /*
+     * The point indices of the three rows of the structure around the row being tessellated -
+     * the row below it, the row itself, and the row above it - which is all that tessellating
+     * a row needs. Each row has a dummy column at both ends, to avoid checking for boundaries.
+     */
+    class PointIndexRows
+    {
+    public:
+
+        explicit PointIndexRows(int structureWidth)
+            : mRows()
+        {
+            for (auto & row : mRows)
+            {
+                row.resize(structureWidth + 2);
+            }
+        }
+
+        // The column is 1-based; the row is -1 for the row below, 0, or 1 for the row above
+        inline std::optional<ElementIndex> const & Get(
+            int column,
+            int relativeRow) const
+        {
+            return mRows[1 + relativeRow][column];
+        }
+
+        inline void SetAbove(
+            int column,
+            ElementIndex pointIndex)
+        {
+            mRows[2][column] = pointIndex;
+        }
+
+        /*
+         * Moves up by one row, making room for a new row above.
+         */
+        void Advance()
+        {
+            std::swap(mRows[0], mRows[1]);
+            std::swap(mRows[1], mRows[2]);
+            std::fill(mRows[2].begin(), mRows[2].end(), std::nullopt);
+        }
+
+    private:
+
+        std::array<std::vector<std::optional<ElementIndex>>, 3u> mRows;
+    };
+
 private:
 
     /////////////////////////////////////////////////////////////////
@@ -112,24 +253,33 @@ private:
     static Physics::Points CreatePoints(
         std::vector<PointInfo> const & pointInfos,
         Physics::World & parentWorld,
-        std::shared_ptr<IGameEventHandler> gameEventHandler);
+        std::shared_ptr<GameEventDispatcher> gameEventHandler);
 
-    static void CreateShipElementInfos(
-        std::unique_ptr<std::unique_ptr<std::optional<ElementIndex>[]>[]> const & pointIndexMatrix,
-        ImageSize const & structureImageSize,
-        Physics::Points & points,
+    static void CreateRowElementInfos(
+        PointIndexRows const & pointIndexRows,
+        int structureWidth,
+        int y,
+        std::vector<PointInfo> & pointInfos,
         std::vector<SpringInfo> & springInfos,
         std::vector<TriangleInfo> & triangleInfos,
+        std::vector<std::array<ElementIndex, 2u>> & cellTriangleIndices,
+        std::vector<CoarseTriangleBlockInfo> & coarseTriangleBlockInfos,
         size_t & leakingPointsCount);
 
+    static void MarkUntessellatedSpringsCoarse(
+        size_t pointCount,
+        std::vector<SpringInfo> & springInfos,
+        std::vector<TriangleInfo> const & triangleInfos);
+
     static Physics::Springs CreateSprings(
         std::vector<SpringInfo> const & springInfos,
         Physics::Points & points,
         Physics::World & parentWorld,
-        std::shared_ptr<IGameEventHandler> gameEventHandler);
+        std::shared_ptr<GameEventDispatcher> gameEventHandler);
 
     static Physics::Triangles CreateTriangles(
         std::vector<TriangleInfo> const & triangleInfos,
+        std::vector<CoarseTriangleBlockInfo> const & coarseTriangleBlockInfos,
         Physics::Points & points,
         Physics::Springs & springs);
 
@@ -145,57 +295,77 @@ private:
     // See Tom Forsyth's comments: using 32 is good enough; apparently 64 does not yield significant differences
     static constexpr size_t VertexCacheSize = 32;
 
-    using ModelLRUVertexCache = std::list<size_t>;
+    /*
+     * The LRU cache used while optimizing. It's a plain array, as it never holds more than
+     * the cache size plus the vertices of the element just added.
+     */
+    template <size_t VerticesInElement>
+    struct ModelLRUVertexCache
+    {
+        std::array<size_t, VertexCacheSize + VerticesInElement> Entries;
+        size_t Size;
+
+        ModelLRUVertexCache()
+            : Entries()
+            , Size(0)
+        {
+        }
+    };
 
     struct VertexData
     {
-        int32_t CachePosition;                          // Position in cache; -1 if not in cache
-        float CurrentScore;                             // Current score of the vertex
-        std::vector<size_t> RemainingElementIndices;    // Indices of not yet drawn elements that use this vertex
+        int32_t CachePosition;                  // Position in cache; -1 if not in cache
+        float CurrentScore;                     // Current score of the vertex
+        size_t RemainingElementsOffset;         // Start of this vertex's not yet drawn elements in the vertex-element index array
+        size_t RemainingElementsCount;          // Number of not yet drawn elements that use this vertex
 
         VertexData()
             : CachePosition(-1)
             , CurrentScore(0.0f)
-            , RemainingElementIndices()
+            , RemainingElementsOffset(0)
+            , RemainingElementsCount(0)
         {
         }
     };
 
+    template <size_t VerticesInElement>
     struct ElementData
     {
-        bool HasBeenDrawn;                  // Set to true when the element has been drawn already
-        float CurrentScore;                 // Current score of the element - sum of its vertices' scores
-        std::vector<size_t> VertexIndices;  // Indices of vertices in this element
+        bool HasBeenDrawn;                                          // Set to true when the element has been drawn already
+        float CurrentScore;                                         // Current score of the element - sum of its vertices' scores
+        bool IsQueuedScoreStale;                                    // Set to true when the score in the queue is not the current score
+        std::array<size_t, VerticesInElement> VertexIndices;        // Indices of vertices in this element
 
         ElementData()
             : HasBeenDrawn(false)
             , CurrentScore(0.0f)
+            , IsQueuedScoreStale(false)
             , VertexIndices()
         {
         }
     };
 
-    static std::vector<SpringInfo> ReorderOptimally(
-        std::vector<SpringInfo> & springInfos,
-        size_t vertexCount);
-
-    static std::vector<TriangleInfo> ReorderOptimally(
-        std::vector<TriangleInfo> & triangleInfos,
-        size_t vertexCount);
+    template <size_t VerticesInElement>
+    static void CalculateVertexElementIndices(
+        std::vector<ElementData<VerticesInElement>> const & elementData,
+        std::vector<VertexData> & vertexData,
+        std::vector<size_t> & vertexElementIndices);
 
     template <size_t VerticesInElement>
     static std::vector<size_t> ReorderOptimally(
         std::vector<VertexData> & vertexData,
-        std::vector<ElementData> & elementData);
+        std::vector<size_t> & vertexElementIndices,
+        std::vector<ElementData<VerticesInElement>> & elementData);
 
 
     static float CalculateACMR(std::vector<SpringInfo> const & springInfos);
 
     static float CalculateACMR(std::vector<TriangleInfo> const & triangleInfos);
 
+    template <size_t VerticesInElement>
     static void AddVertexToCache(
         size_t vertexIndex,
-        ModelLRUVertexCache & cache);
+        ModelLRUVertexCache<VerticesInElement> & cache);
 
     template <size_t VerticesInElement>
     static float CalculateVertexScore(VertexData const & vertexData);
@@ -205,12 +375,19 @@ private:
     {
     public:
 
+        TestLRUVertexCache()
+            : mEntries()
+            , mSize(0)
+        {
+        }
+
         bool UseVertex(size_t vertexIndex);
 
         std::optional<size_t> GetCachePosition(size_t vertexIndex);
 
     private:
 
-        std::list<size_t> mEntries;
-    };    
+        std::array<size_t, Size> mEntries;
+        size_t mSize;
+    };
 };
@@ -0,0 +1,446 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-05
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "ShipCache.h"
+
+#include "GameException.h"
+#include "Log.h"
+
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <map>
+#include <type_traits>
+
+namespace /* anonymous */ {
+
+    // Bump whenever the layout of the entry files changes
+    static constexpr uint32_t FormatVersion = 4;
+
+    static constexpr std::array<char, 4> Magic = { 'S', 'S', 'C', 'S' };
+
+    /*
+     * The header of an entry file; the following sections come right after it, each one
+     * padded to a multiple of SectionAlignment bytes so that all of them may be used in place:
+     *  - The structural colours of the materials of the ship
+     *  - The ship name
+     *  - The positions of the points
+     *  - The texture coordinates of the points
+     *  - The indices of the points' materials in the materials section
+     *  - Whether the points are leaking
+     *  - The endpoints of the springs
+     *  - Whether the springs are coarse
+     *  - The TriangleInfo's
+     *  - The CoarseTriangleBlockInfo's
+     *  - The RGBA texture, if the ship has one
+     */
+    struct EntryHeader
+    {
+        std::array<char, 4> Magic;
+        uint32_t FormatVersion;
+        uint64_t Key;
+        uint32_t BuilderVersion;
+        int32_t StructureWidth;
+        int32_t StructureHeight;
+        uint32_t MaterialCount;
+        uint32_t PointCount;
+        uint32_t SpringCount;
+        uint32_t TriangleCount;
+        uint32_t CoarseTriangleBlockCount;
+        uint32_t ShipNameLength;
+        uint32_t HasTexture;
+        int32_t TextureWidth;
+        int32_t TextureHeight;
+    };
+
+    static_assert(sizeof(EntryHeader) == 64);
+
+    static constexpr size_t SectionAlignment = 8;
+
+    static_assert(sizeof(EntryHeader) % SectionAlignment == 0);
+    static_assert(alignof(vec2f) <= SectionAlignment);
+    static_assert(alignof(ShipBuilder::TriangleInfo) <= SectionAlignment);
+    static_assert(alignof(ShipBuilder::CoarseTriangleBlockInfo) <= SectionAlignment);
+
+    // The triangles and coarse triangle blocks are stored as they are in memory, as they have
+    // no padding; the springs are split into their endpoints and flags instead, as SpringInfo
+    // has padding and a bool
+    static_assert(std::is_trivially_copyable<ShipBuilder::TriangleInfo>::value);
+    static_assert(std::is_trivially_copyable<ShipBuilder::CoarseTriangleBlockInfo>::value);
+    static_assert(sizeof(ShipBuilder::TriangleInfo) == 3 * sizeof(ElementIndex));
+    static_assert(sizeof(ShipBuilder::CoarseTriangleBlockInfo) == 8 * sizeof(ElementIndex));
+
+    using SpringEndpoints = std::array<ElementIndex, 2u>;
+
+    static constexpr size_t CalculatePaddingSize(size_t size)
+    {
+        return (SectionAlignment - size % SectionAlignment) % SectionAlignment;
+    }
+
+    /*
+     * Walks the sections of a mapped entry file.
+     */
+    class SectionReader
+    {
+    public:
+
+        explicit SectionReader(MemoryMappedFile const & mappedFile)
+            : mData(mappedFile.GetData())
+            , mSize(mappedFile.GetSize())
+            , mOffset(sizeof(EntryHeader))
+        {
+            assert(mSize >= sizeof(EntryHeader));
+        }
+
+        template<typename T>
+        T const * ReadSection(size_t count)
+        {
+            size_t const sectionSize = count * sizeof(T);
+            if (mSize - mOffset < sectionSize + CalculatePaddingSize(sectionSize))
+            {
+                throw GameException("Truncated section");
+            }
+
+            T const * const section = reinterpret_cast<T const *>(mData + mOffset);
+            mOffset += sectionSize + CalculatePaddingSize(sectionSize);
+
+            return section;
+        }
+
+        bool IsAtEnd() const
+        {
+            return mOffset == mSize;
+        }
+
+    private:
+
+        unsigned char const * const mData;
+        size_t const mSize;
+        size_t mOffset;
+    };
+}
+
+uint64_t ShipCache::CalculateKey(std::vector<std::filesystem::path> const & sourceFilePaths)
+{
+    uint32_t const builderVersion = ShipBuilder::Version;
+    uint64_t key = CacheDirectory::HashKey(CacheDirectory::InitialKey, builderVersion);
+
+    for (auto const & sourceFilePath : sourceFilePaths)
+    {
+        key = CacheDirectory::HashFileContent(key, sourceFilePath);
+    }
+
+    return key;
+}
+
+std::optional<ShipCache::Entry> ShipCache::TryLoad(
+    uint64_t key,
+    MaterialDatabase const & materials) const
+{
+    try
+    {
+        std::optional<MemoryMappedFile> mappedFile = mCacheDirectory.MapEntryFile(key);
+        if (!mappedFile)
+        {
+            return std::nullopt;
+        }
+
+        //
+        // Header
+        //
+
+        if (mappedFile->GetSize() < sizeof(EntryHeader))
+        {
+            throw GameException("Truncated header");
+        }
+
+        EntryHeader header;
+        std::memcpy(&header, mappedFile->GetData(), sizeof(EntryHeader));
+
+        if (header.Magic != Magic
+            || header.FormatVersion != FormatVersion
+            || header.BuilderVersion != ShipBuilder::Version
+            || header.Key != key)
+        {
+            throw GameException("Not a compiled ship of this version");
+        }
+
+        SectionReader reader(*mappedFile);
+
+        //
+        // Materials - resolved once for all the points
+        //
+
+        auto const * const structuralColours = reader.ReadSection<std::array<uint8_t, 3u>>(header.MaterialCount);
+
+        std::vector<Material const *> pointMaterials;
+        pointMaterials.reserve(header.MaterialCount);
+        for (uint32_t m = 0; m < header.MaterialCount; ++m)
+        {
+            Material const * material = materials.Get(structuralColours[m]);
+            if (nullptr == material)
+            {
+                throw GameException("Unknown material");
+            }
+
+            pointMaterials.push_back(material);
+        }
+
+        //
+        // Name
+        //
+
+        char const * const shipNameCharacters = reader.ReadSection<char>(header.ShipNameLength);
+        std::string shipName(shipNameCharacters, header.ShipNameLength);
+
+        //
+        // Points
+        //
+
+        vec2f const * const positions = reader.ReadSection<vec2f>(header.PointCount);
+        vec2f const * const textureCoordinates = reader.ReadSection<vec2f>(header.PointCount);
+        uint32_t const * const materialIndices = reader.ReadSection<uint32_t>(header.PointCount);
+        uint8_t const * const isLeaking = reader.ReadSection<uint8_t>(header.PointCount);
+
+        std::vector<ShipBuilder::PointInfo> pointInfos;
+        pointInfos.reserve(header.PointCount);
+        for (uint32_t p = 0; p < header.PointCount; ++p)
+        {
+            if (materialIndices[p] >= header.MaterialCount)
+            {
+                throw GameException("Point material out of range");
+            }
+
+            if (isLeaking[p] > 1)
+            {
+                throw GameException("Invalid point leaking flag");
+            }
+
+            pointInfos.emplace_back(positions[p], textureCoordinates[p], pointMaterials[materialIndices[p]]);
+            pointInfos.back().IsLeaking = (0 != isLeaking[p]);
+        }
+
+        //
+        // Springs
+        //
+
+        SpringEndpoints const * const springEndpoints = reader.ReadSection<SpringEndpoints>(header.SpringCount);
+        uint8_t const * const isCoarse = reader.ReadSection<uint8_t>(header.SpringCount);
+
+        std::vector<ShipBuilder::SpringInfo> springInfos;
+        springInfos.reserve(header.SpringCount);
+        for (uint32_t s = 0; s < header.SpringCount; ++s)
+        {
+            if (springEndpoints[s][0] >= header.PointCount || springEndpoints[s][1] >= header.PointCount)
+            {
+                throw GameException("Spring endpoint out of range");
+            }
+
+            if (isCoarse[s] > 1)
+            {
+                throw GameException("Invalid spring coarse flag");
+            }
+
+            springInfos.emplace_back(springEndpoints[s][0], springEndpoints[s][1]);
+            springInfos.back().IsCoarse = (0 != isCoarse[s]);
+        }
+
+        //
+        // Triangles and coarse triangle blocks - copied in bulk
+        //
+
+        auto const * const triangleInfosSection = reader.ReadSection<ShipBuilder::TriangleInfo>(header.TriangleCount);
+        std::vector<ShipBuilder::TriangleInfo> triangleInfos(triangleInfosSection, triangleInfosSection + header.TriangleCount);
+
+        for (auto const & triangleInfo : triangleInfos)
+        {
+            if (triangleInfo.PointAIndex >= header.PointCount
+                || triangleInfo.PointBIndex >= header.PointCount
+                || triangleInfo.PointCIndex >= header.PointCount)
+            {
+                throw GameException("Triangle vertex out of range");
+            }
+        }
+
+        auto const * const coarseTriangleBlockInfosSection = reader.ReadSection<ShipBuilder::CoarseTriangleBlockInfo>(header.CoarseTriangleBlockCount);
+        std::vector<ShipBuilder::CoarseTriangleBlockInfo> coarseTriangleBlockInfos(
+            coarseTriangleBlockInfosSection,
+            coarseTriangleBlockInfosSection + header.CoarseTriangleBlockCount);
+
+        for (auto const & coarseTriangleBlockInfo : coarseTriangleBlockInfos)
+        {
+            for (auto triangleIndex : coarseTriangleBlockInfo.TriangleIndices)
+            {
+                if (triangleIndex >= header.TriangleCount)
+                {
+                    throw GameException("Coarse triangle block triangle out of range");
+                }
+            }
+        }
+
+        //
+        // Texture
+        //
+
+        std::optional<ImageData> textureImage;
+        if (0 != header.HasTexture)
+        {
+            if (header.TextureWidth < 0 || header.TextureHeight < 0)
+            {
+                throw GameException("Invalid texture size");
+            }
+
+            size_t const textureSize = static_cast<size_t>(header.TextureWidth) * static_cast<size_t>(header.TextureHeight) * 4;
+            unsigned char const * const textureSection = reader.ReadSection<unsigned char>(textureSize);
+
+            std::unique_ptr<unsigned char[]> textureData(new unsigned char[textureSize]);
+            std::memcpy(textureData.get(), textureSection, textureSize);
+
+            textureImage.emplace(
+                header.TextureWidth,
+                header.TextureHeight,
+                std::unique_ptr<unsigned char const[]>(std::move(textureData)));
+        }
+
+        if (!reader.IsAtEnd())
+        {
+            throw GameException("Unexpected trailing data");
+        }
+
+        return Entry{
+            ShipBuilder::CompiledShip(
+                ImageSize(header.StructureWidth, header.StructureHeight),
+                std::move(pointInfos),
+                std::move(springInfos),
+                std::move(triangleInfos),
+                std::move(coarseTriangleBlockInfos)),
+            std::move(textureImage),
+            std::move(shipName) };
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("Ignoring compiled ship \"", mCacheDirectory.GetEntryFilePath(key).string(), "\": ", ex.what());
+        return std::nullopt;
+    }
+}
+
+void ShipCache::Store(
+    uint64_t key,
+    ShipBuilder::CompiledShip const & compiledShip,
+    std::optional<ImageData> const & textureImage,
+    std::string const & shipName) const
+{
+    size_t const pointCount = compiledShip.PointInfos.size();
+
+    //
+    // Split the points into their sections, collecting their materials
+    //
+
+    std::vector<std::array<uint8_t, 3u>> structuralColours;
+    std::map<Material const *, uint32_t> materialIndexByMaterial;
+
+    std::vector<vec2f> positions;
+    positions.reserve(pointCount);
+    std::vector<vec2f> textureCoordinates;
+    textureCoordinates.reserve(pointCount);
+    std::vector<uint32_t> materialIndices;
+    materialIndices.reserve(pointCount);
+    std::vector<uint8_t> isLeaking;
+    isLeaking.reserve(pointCount);
+
+    for (auto const & pointInfo : compiledShip.PointInfos)
+    {
+        auto const materialIt = materialIndexByMaterial.emplace(
+            pointInfo.Mtl,
+            static_cast<uint32_t>(structuralColours.size()));
+        if (materialIt.second)
+        {
+            structuralColours.push_back(pointInfo.Mtl->StructuralColourRgb);
+        }
+
+        positions.push_back(pointInfo.Position);
+        textureCoordinates.push_back(pointInfo.TextureCoordinates);
+        materialIndices.push_back(materialIt.first->second);
+        isLeaking.push_back(pointInfo.IsLeaking ? 1 : 0);
+    }
+
+    //
+    // Split the springs into their sections
+    //
+
+    std::vector<SpringEndpoints> springEndpoints;
+    springEndpoints.reserve(compiledShip.SpringInfos.size());
+    std::vector<uint8_t> isCoarse;
+    isCoarse.reserve(compiledShip.SpringInfos.size());
+
+    for (auto const & springInfo : compiledShip.SpringInfos)
+    {
+        springEndpoints.push_back({ springInfo.PointAIndex, springInfo.PointBIndex });
+        isCoarse.push_back(springInfo.IsCoarse ? 1 : 0);
+    }
+
+    //
+    // Header
+    //
+
+    EntryHeader header;
+    header.Magic = Magic;
+    header.FormatVersion = FormatVersion;
+    header.Key = key;
+    header.BuilderVersion = ShipBuilder::Version;
+    header.StructureWidth = compiledShip.StructureSize.Width;
+    header.StructureHeight = compiledShip.StructureSize.Height;
+    header.MaterialCount = static_cast<uint32_t>(structuralColours.size());
+    header.PointCount = static_cast<uint32_t>(pointCount);
+    header.SpringCount = static_cast<uint32_t>(compiledShip.SpringInfos.size());
+    header.TriangleCount = static_cast<uint32_t>(compiledShip.TriangleInfos.size());
+    header.CoarseTriangleBlockCount = static_cast<uint32_t>(compiledShip.CoarseTriangleBlockInfos.size());
+    header.ShipNameLength = static_cast<uint32_t>(shipName.size());
+    header.HasTexture = !!textureImage ? 1 : 0;
+    header.TextureWidth = !!textureImage ? textureImage->Size.Width : 0;
+    header.TextureHeight = !!textureImage ? textureImage->Size.Height : 0;
+
+    //
+    // Sections
+    //
+
+    static std::array<unsigned char, SectionAlignment> const Padding{};
+
+    std::vector<CacheDirectory::Chunk> chunks;
+    chunks.emplace_back(&header, sizeof(EntryHeader));
+
+    auto const addSection = [&chunks](void const * data, size_t size)
+    {
+        chunks.emplace_back(data, size);
+        chunks.emplace_back(Padding.data(), CalculatePaddingSize(size));
+    };
+
+    addSection(structuralColours.data(), structuralColours.size() * sizeof(std::array<uint8_t, 3u>));
+    addSection(shipName.data(), shipName.size());
+    addSection(positions.data(), pointCount * sizeof(vec2f));
+    addSection(textureCoordinates.data(), pointCount * sizeof(vec2f));
+    addSection(materialIndices.data(), pointCount * sizeof(uint32_t));
+    addSection(isLeaking.data(), pointCount * sizeof(uint8_t));
+    addSection(springEndpoints.data(), springEndpoints.size() * sizeof(SpringEndpoints));
+    addSection(isCoarse.data(), isCoarse.size() * sizeof(uint8_t));
+    addSection(compiledShip.TriangleInfos.data(), compiledShip.TriangleInfos.size() * sizeof(ShipBuilder::TriangleInfo));
+    addSection(compiledShip.CoarseTriangleBlockInfos.data(), compiledShip.CoarseTriangleBlockInfos.size() * sizeof(ShipBuilder::CoarseTriangleBlockInfo));
+
+    if (!!textureImage)
+    {
+        addSection(
+            textureImage->Data.get(),
+            static_cast<size_t>(textureImage->Size.Width) * static_cast<size_t>(textureImage->Size.Height) * 4);
+    }
+
+    try
+    {
+        mCacheDirectory.WriteEntryFile(key, chunks);
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("Cannot store compiled ship \"", mCacheDirectory.GetEntryFilePath(key).string(), "\": ", ex.what());
+    }
+}
@@ -0,0 +1,72 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-05
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "CacheDirectory.h"
+#include "ImageData.h"
+#include "MaterialDatabase.h"
+#include "ShipBuilder.h"
+#include "SysSpecifics.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+/*
+ * This class maintains a directory of compiled ships, i.e. of the ships as they come out
+ * of ShipBuilder::Compile, so that loading a ship again does not need to decode its images
+ * nor to run the builder.
+ *
+ * Compiled ships are memory-mapped when loaded; their materials are stored once, and their
+ * elements are laid out as arrays that are copied in bulk.
+ *
+ * Compiled ships are keyed by a hash of the contents of all the files the ship is made of,
+ * of the materials database, and of the builder version; a compiled ship is thus never stale,
+ * it simply stops being found.
+ *
+ * The cache is best-effort: failures to store or to load compiled ships are logged and
+ * otherwise ignored.
+ */
+class ShipCache
+{
+public:
+
+    struct Entry
+    {
+        ShipBuilder::CompiledShip CompiledShip;
+        std::optional<ImageData> TextureImage;
+        std::string ShipName;
+    };
+
+public:
+
+    explicit ShipCache(std::filesystem::path cacheDirectoryPath)
+        : mCacheDirectory(std::move(cacheDirectoryPath), ".shc")
+    {
+    }
+
+    /*
+     * Calculates the key of the ship made of the specified files - which are expected
+     * to include the materials database.
+     */
+    static uint64_t CalculateKey(std::vector<std::filesystem::path> const & sourceFilePaths);
+
+    std::optional<Entry> TryLoad(
+        uint64_t key,
+        MaterialDatabase const & materials) const;
+
+    void Store(
+        uint64_t key,
+        ShipBuilder::CompiledShip const & compiledShip,
+        std::optional<ImageData> const & textureImage,
+        std::string const & shipName) const;
+
+private:
+
+    CacheDirectory const mCacheDirectory;
+};
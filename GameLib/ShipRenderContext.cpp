@@ -6,6 +6,10 @@
 #include "ShipRenderContext.h"
 
 #include "GameException.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <cstring>
 
 ShipRenderContext::ShipRenderContext(
     std::optional<ImageData> texture,
@@ -15,9 +19,7 @@ ShipRenderContext::ShipRenderContext(
     std::vector<GLuint> timerBombTextures)
     // Points
     : mPointCount(0u)
-    , mPointPositionVBO()
-    , mPointLightVBO()
-    , mPointWaterVBO()
+    , mPointAttributesVBO()
     , mPointColorVBO()
     , mPointElementTextureCoordinatesVBO()
     // Elements
@@ -30,8 +32,6 @@ ShipRenderContext::ShipRenderContext(
     , mElementTextureShaderProgram()
     , mElementTextureShaderOrthoMatrixParameter(0)
     , mElementTextureShaderAmbientLightIntensityParameter(0)
-    , mElementStressedSpringShaderProgram(0)
-    , mElementStressedSpringShaderOrthoMatrixParameter(0)
     , mElementPinnedPointShaderProgram(0)
     , mElementPinnedPointShaderOrthoMatrixParameter(0)
     , mElementPinnedPointShaderAmbientLightIntensityParameter(0)
@@ -39,13 +39,18 @@ ShipRenderContext::ShipRenderContext(
     , mElementBombShaderOrthoMatrixParameter(0)
     , mElementBombShaderAmbientLightIntensityParameter(0)
     , mConnectedComponents()
+    , mPointElementVBO()
+    , mSpringElementVBO()
+    , mCoarseSpringElementVBO()
+    , mRopeElementVBO()
+    , mTriangleElementVBO()
+    , mCoarseTriangleElementVBO()
     , mPinnedPointElementBuffer()
     , mPinnedPointVBO()
     , mBombElementBuffer()
     , mBombVBO()
     // Texture
     , mElementTexture()
-    , mElementStressedSpringTexture()
     , mElementPinnedPointTexture(pinnedPointTexture)
     , mElementRCBombTextures(rcBombTextures)
     , mElementTimerBombTextures(timerBombTextures)
@@ -63,13 +68,24 @@ ShipRenderContext::ShipRenderContext(
     // Create point VBOs
     //
 
-    GLuint pointVBOs[5];
-    glGenBuffers(5, pointVBOs);
-    mPointPositionVBO = pointVBOs[0];
-    mPointLightVBO = pointVBOs[1];
-    mPointWaterVBO = pointVBOs[2];
-    mPointColorVBO = pointVBOs[3];
-    mPointElementTextureCoordinatesVBO = pointVBOs[4];
+    GLuint pointVBOs[2];
+    glGenBuffers(2, pointVBOs);
+    mPointColorVBO = pointVBOs[0];
+    mPointElementTextureCoordinatesVBO = pointVBOs[1];
+
+
+    //
+    // Create element VBOs
+    //
+
+    GLuint elementVBOs[6];
+    glGenBuffers(6, elementVBOs);
+    mPointElementVBO.vbo = elementVBOs[0];
+    mSpringElementVBO.vbo = elementVBOs[1];
+    mCoarseSpringElementVBO.vbo = elementVBOs[2];
+    mRopeElementVBO.vbo = elementVBOs[3];
+    mTriangleElementVBO.vbo = elementVBOs[4];
+    mCoarseTriangleElementVBO.vbo = elementVBOs[5];
     
 
 
@@ -85,11 +101,14 @@ ShipRenderContext::ShipRenderContext(
         attribute vec2 inputPos;        
         attribute float inputLight;
         attribute float inputWater;
+        attribute float inputStress;
         attribute vec3 inputCol;
 
         // Outputs        
+        varying vec2 vertexPos;
         varying float vertexLight;
         varying float vertexWater;
+        varying float vertexStress;
         varying vec3 vertexCol;
 
         // Params
@@ -97,8 +116,10 @@ ShipRenderContext::ShipRenderContext(
 
         void main()
         {            
+            vertexPos = inputPos;
             vertexLight = inputLight;
             vertexWater = inputWater;
+            vertexStress = inputStress;
             vertexCol = inputCol;
 
             gl_Position = paramOrthoMatrix * vec4(inputPos.xy, -1.0, 1.0);
@@ -110,8 +131,10 @@ ShipRenderContext::ShipRenderContext(
     char const * elementColorFragmentShaderSource = R"(
 
         // Inputs from previous shader        
+        varying vec2 vertexPos;
         varying float vertexLight;
         varying float vertexWater;
+        varying float vertexStress;
         varying vec3 vertexCol;
 
         // Params
@@ -120,6 +143,8 @@ ShipRenderContext::ShipRenderContext(
         // Constants
         vec3 lightColour = vec3(1.0, 1.0, 0.25);
         vec3 wetColour = vec3(0.0, 0.0, 0.8);
+        vec3 stressColour1 = vec3(0.94, 0.06, 0.15);
+        vec3 stressColour2 = vec3(1.0, 0.99, 0.71);
 
         void main()
         {
@@ -127,6 +152,10 @@ ShipRenderContext::ShipRenderContext(
             vec3 colour1 = vertexCol * (1.0 - colorWetness) + wetColour * colorWetness;
             colour1 *= paramAmbientLightIntensity;
             colour1 = colour1 * (1.0 - vertexLight) + lightColour * vertexLight;
+
+            // Apply point stress, as a checkerboard in world coordinates
+            float stressChecker = mod(floor(vertexPos.x * 3.0) + floor(vertexPos.y * 3.0), 2.0);
+            colour1 = mix(colour1, mix(stressColour1, stressColour2, stressChecker), min(vertexStress, 1.0));
             
             gl_FragColor = vec4(colour1.xyz, 1.0);
         } 
@@ -138,6 +167,7 @@ ShipRenderContext::ShipRenderContext(
     glBindAttribLocation(*mElementColorShaderProgram, PointPosVertexAttribute, "inputPos");
     glBindAttribLocation(*mElementColorShaderProgram, PointLightVertexAttribute, "inputLight");
     glBindAttribLocation(*mElementColorShaderProgram, PointWaterVertexAttribute, "inputWater");
+    glBindAttribLocation(*mElementColorShaderProgram, PointStressVertexAttribute, "inputStress");
     glBindAttribLocation(*mElementColorShaderProgram, PointColorVertexAttribute, "inputCol");
 
     // Link
@@ -159,16 +189,21 @@ ShipRenderContext::ShipRenderContext(
         // Inputs
         attribute vec2 inputPos;        
         attribute float inputLight;
+        attribute float inputStress;
 
         // Outputs        
+        varying vec2 vertexPos;
         varying float vertexLight;
+        varying float vertexStress;
 
         // Params
         uniform mat4 paramOrthoMatrix;
 
         void main()
         {            
+            vertexPos = inputPos;
             vertexLight = inputLight;
+            vertexStress = inputStress;
 
             gl_Position = paramOrthoMatrix * vec4(inputPos.xy, -1.0, 1.0);
         }
@@ -179,7 +214,9 @@ ShipRenderContext::ShipRenderContext(
     char const * elementRopeFragmentShaderSource = R"(
 
         // Inputs from previous shader        
+        varying vec2 vertexPos;
         varying float vertexLight;
+        varying float vertexStress;
 
         // Params
         uniform vec3 paramRopeColour;
@@ -187,11 +224,17 @@ ShipRenderContext::ShipRenderContext(
 
         // Constants
         vec3 lightColour = vec3(1.0, 1.0, 0.25);
+        vec3 stressColour1 = vec3(0.94, 0.06, 0.15);
+        vec3 stressColour2 = vec3(1.0, 0.99, 0.71);
 
         void main()
         {
             vec3 colour1 = paramRopeColour * paramAmbientLightIntensity;
             colour1 = colour1 * (1.0 - vertexLight) + lightColour * vertexLight;
+
+            // Apply point stress, as a checkerboard in world coordinates
+            float stressChecker = mod(floor(vertexPos.x * 3.0) + floor(vertexPos.y * 3.0), 2.0);
+            colour1 = mix(colour1, mix(stressColour1, stressColour2, stressChecker), min(vertexStress, 1.0));
             
             gl_FragColor = vec4(colour1.xyz, 1.0);
         } 
@@ -202,6 +245,7 @@ ShipRenderContext::ShipRenderContext(
     // Bind attribute locations
     glBindAttribLocation(*mElementRopeShaderProgram, PointPosVertexAttribute, "inputPos");
     glBindAttribLocation(*mElementRopeShaderProgram, PointLightVertexAttribute, "inputLight");
+    glBindAttribLocation(*mElementRopeShaderProgram, PointStressVertexAttribute, "inputStress");
 
     // Link
     GameOpenGL::LinkShaderProgram(mElementRopeShaderProgram, "Ship Rope Elements");
@@ -234,11 +278,14 @@ ShipRenderContext::ShipRenderContext(
         attribute vec2 inputPos;        
         attribute float inputLight;
         attribute float inputWater;
+        attribute float inputStress;
         attribute vec2 inputTextureCoords;
 
         // Outputs        
+        varying vec2 vertexPos;
         varying float vertexLight;
         varying float vertexWater;
+        varying float vertexStress;
         varying vec2 vertexTextureCoords;
 
         // Params
@@ -246,8 +293,10 @@ ShipRenderContext::ShipRenderContext(
 
         void main()
         {            
+            vertexPos = inputPos;
             vertexLight = inputLight;
             vertexWater = inputWater;
+            vertexStress = inputStress;
             vertexTextureCoords = inputTextureCoords;
 
             gl_Position = paramOrthoMatrix * vec4(inputPos.xy, -1.0, 1.0);
@@ -259,8 +308,10 @@ ShipRenderContext::ShipRenderContext(
     char const * elementTextureFragmentShaderSource = R"(
 
         // Inputs from previous shader        
+        varying vec2 vertexPos;
         varying float vertexLight;
         varying float vertexWater;
+        varying float vertexStress;
         varying vec2 vertexTextureCoords;
 
         // Input texture
@@ -272,6 +323,8 @@ ShipRenderContext::ShipRenderContext(
         // Constants
         vec4 lightColour = vec4(1.0, 1.0, 0.25, 1.0);
         vec4 wetColour = vec4(0.0, 0.0, 0.8, 1.0);
+        vec4 stressColour1 = vec4(0.94, 0.06, 0.15, 1.0);
+        vec4 stressColour2 = vec4(1.0, 0.99, 0.71, 1.0);
 
         void main()
         {
@@ -286,6 +339,10 @@ ShipRenderContext::ShipRenderContext(
 
             // Apply point light
             fragColour = fragColour * (1.0 - vertexLight) + lightColour * vertexLight;
+
+            // Apply point stress, as a checkerboard in world coordinates
+            float stressChecker = mod(floor(vertexPos.x * 3.0) + floor(vertexPos.y * 3.0), 2.0);
+            fragColour = mix(fragColour, mix(stressColour1, stressColour2, stressChecker), min(vertexStress, 1.0));
             
             gl_FragColor = vec4(fragColour.xyz, vertexCol.w);
         } 
@@ -297,6 +354,7 @@ ShipRenderContext::ShipRenderContext(
     glBindAttribLocation(*mElementTextureShaderProgram, PointPosVertexAttribute, "inputPos");
     glBindAttribLocation(*mElementTextureShaderProgram, PointLightVertexAttribute, "inputLight");
     glBindAttribLocation(*mElementTextureShaderProgram, PointWaterVertexAttribute, "inputWater");
+    glBindAttribLocation(*mElementTextureShaderProgram, PointStressVertexAttribute, "inputStress");
     glBindAttribLocation(*mElementTextureShaderProgram, PointTextureCoordinatesVertexAttribute, "inputTextureCoords");
 
     // Link
@@ -307,61 +365,6 @@ ShipRenderContext::ShipRenderContext(
     mElementTextureShaderAmbientLightIntensityParameter = GameOpenGL::GetParameterLocation(mElementTextureShaderProgram, "paramAmbientLightIntensity");
 
 
-    //
-    // Create stressed spring program
-    //
-
-    mElementStressedSpringShaderProgram = glCreateProgram();
-
-    char const * elementStressedSpringVertexShaderSource = R"(
-
-        // Inputs
-        attribute vec2 inputPos;
-        
-        // Outputs        
-        varying vec2 vertexTextureCoords;
-
-        // Params
-        uniform mat4 paramOrthoMatrix;
-
-        void main()
-        {
-            vertexTextureCoords = inputPos; 
-            gl_Position = paramOrthoMatrix * vec4(inputPos.xy, -1.0, 1.0);
-        }
-    )";
-
-    GameOpenGL::CompileShader(elementStressedSpringVertexShaderSource, GL_VERTEX_SHADER, mElementStressedSpringShaderProgram);
-
-    char const * elementStressedSpringFragmentShaderSource = R"(
-    
-        // Inputs
-        varying vec2 vertexTextureCoords;
-
-        // Input texture
-        uniform sampler2D inputTexture;
-
-        // Params
-        uniform float paramAmbientLightIntensity;
-
-        void main()
-        {
-            gl_FragColor = texture2D(inputTexture, vertexTextureCoords);
-        } 
-    )";
-
-    GameOpenGL::CompileShader(elementStressedSpringFragmentShaderSource, GL_FRAGMENT_SHADER, mElementStressedSpringShaderProgram);
-
-    // Bind attribute locations
-    glBindAttribLocation(*mElementStressedSpringShaderProgram, 0, "inputPos");
-
-    // Link
-    GameOpenGL::LinkShaderProgram(mElementStressedSpringShaderProgram, "Stressed Spring");
-
-    // Get uniform locations
-    mElementStressedSpringShaderOrthoMatrixParameter = GameOpenGL::GetParameterLocation(mElementStressedSpringShaderProgram, "paramOrthoMatrix");
-
-
     //
     // Create and upload ship texture, if present
     //
@@ -419,43 +422,6 @@ ShipRenderContext::ShipRenderContext(
     }
 
 
-    //
-    // Create stressed spring texture
-    //
-
-    // Create texture name
-    glGenTextures(1, &tmpGLuint);
-    mElementStressedSpringTexture = tmpGLuint;
-
-    // Bind texture
-    glBindTexture(GL_TEXTURE_2D, *mElementStressedSpringTexture);
-
-    // Set repeat mode
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    
-    // Set texture filtering parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    // Make texture data
-    unsigned char buf[] = {
-        239, 16, 39, 255,       255, 253, 181,  255,    239, 16, 39, 255,
-        255, 253, 181, 255,     239, 16, 39, 255,       255, 253, 181,  255,
-        239, 16, 39, 255,       255, 253, 181,  255,    239, 16, 39, 255
-    };
-
-    // Upload texture data
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 3, 3, 0, GL_RGBA, GL_UNSIGNED_BYTE, buf);
-    if (GL_NO_ERROR != glGetError())
-    {
-        throw GameException("Error uploading stressed spring texture onto GPU");
-    }
-
-    // Unbind texture
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-
     //
     // Create pinned points program
     //
@@ -647,36 +613,56 @@ void ShipRenderContext::UploadPoints(
     size_t count,
     vec2f const * restrict position,
     float const * restrict light,
-    float const * restrict water)
+    float const * restrict water,
+    float const * restrict stress)
 {
+    TraceSpan span("ShipRenderContext::UploadPoints");
+
     assert(count == mPointCount);
 
-    // Upload positions
-    glBindBuffer(GL_ARRAY_BUFFER, *mPointPositionVBO);
-    glBufferData(GL_ARRAY_BUFFER, count * sizeof(vec2f), position, GL_STREAM_DRAW);
-    glVertexAttribPointer(PointPosVertexAttribute, 2, GL_FLOAT, GL_FALSE, sizeof(vec2f), (void*)(0));
+    size_t const positionSize = count * sizeof(vec2f);
+    size_t const lightSize = count * sizeof(float);
+    size_t const waterSize = count * sizeof(float);
+    size_t const stressSize = (nullptr != stress) ? count * sizeof(float) : 0;
+
+    char * const data = reinterpret_cast<char *>(mPointAttributesVBO.Map(positionSize + lightSize + waterSize + stressSize));
+    std::memcpy(data, position, positionSize);
+    std::memcpy(data + positionSize, light, lightSize);
+    std::memcpy(data + positionSize + lightSize, water, waterSize);
+    if (nullptr != stress)
+        std::memcpy(data + positionSize + lightSize + waterSize, stress, stressSize);
+    size_t const offset = mPointAttributesVBO.Unmap();
+
+    // Describe positions
+    glVertexAttribPointer(PointPosVertexAttribute, 2, GL_FLOAT, GL_FALSE, sizeof(vec2f), (void*)(offset));
     glEnableVertexAttribArray(PointPosVertexAttribute);
 
-    // Upload lights
-    glBindBuffer(GL_ARRAY_BUFFER, *mPointLightVBO);
-    glBufferData(GL_ARRAY_BUFFER, count * sizeof(float), light, GL_STREAM_DRAW);
-    glVertexAttribPointer(PointLightVertexAttribute, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(0));
+    // Describe lights
+    glVertexAttribPointer(PointLightVertexAttribute, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(offset + positionSize));
     glEnableVertexAttribArray(PointLightVertexAttribute);
 
-    // Upload waters
-    glBindBuffer(GL_ARRAY_BUFFER, *mPointWaterVBO);
-    glBufferData(GL_ARRAY_BUFFER, count * sizeof(float), water, GL_STREAM_DRAW);
-    glVertexAttribPointer(PointWaterVertexAttribute, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(0));
+    // Describe waters
+    glVertexAttribPointer(PointWaterVertexAttribute, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(offset + positionSize + lightSize));
     glEnableVertexAttribArray(PointWaterVertexAttribute);
 
+    // Describe stresses - or make all points unstressed
+    if (nullptr != stress)
+    {
+        glVertexAttribPointer(PointStressVertexAttribute, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(offset + positionSize + lightSize + waterSize));
+        glEnableVertexAttribArray(PointStressVertexAttribute);
+    }
+    else
+    {
+        glDisableVertexAttribArray(PointStressVertexAttribute);
+        glVertexAttrib1f(PointStressVertexAttribute, 0.0f);
+    }
+
     // Unbind VBO
     glBindBuffer(GL_ARRAY_BUFFER, 0u);
 }
 
 void ShipRenderContext::UploadElementsStart(std::vector<std::size_t> const & connectedComponentsMaxSizes)
 {
-    GLuint elementVBO;
-
     if (connectedComponentsMaxSizes.size() != mConnectedComponents.size())
     {
         // A change in the number of connected components, nuke everything
@@ -686,177 +672,332 @@ void ShipRenderContext::UploadElementsStart(std::vector<std::size_t> const & con
     
     for (size_t c = 0; c < mConnectedComponents.size(); ++c)
     {
+        PrepareConnectedComponentElements(c, connectedComponentsMaxSizes[c]);
+
         //
-        // Prepare point elements
+        // Lay out all the elements again
         //
 
-        // Max # of points = number of points
-        size_t maxConnectedComponentPoints = connectedComponentsMaxSizes[c];
-        if (mConnectedComponents[c].pointElementMaxCount != maxConnectedComponentPoints)
-        {
-            // A change in the max size of this connected component
-            mConnectedComponents[c].pointElementBuffer.reset();
-            mConnectedComponents[c].pointElementBuffer.reset(new PointElement[maxConnectedComponentPoints]);
-            mConnectedComponents[c].pointElementMaxCount = maxConnectedComponentPoints;
-        }
+        mConnectedComponents[c].pointElements.vboCapacity = 0;
+        mConnectedComponents[c].springElements.vboCapacity = 0;
+        mConnectedComponents[c].coarseSpringElements.vboCapacity = 0;
+        mConnectedComponents[c].ropeElements.vboCapacity = 0;
+        mConnectedComponents[c].triangleElements.vboCapacity = 0;
+        mConnectedComponents[c].coarseTriangleElements.vboCapacity = 0;
 
-        mConnectedComponents[c].pointElementCount = 0;
+        //
+        // Prepare pinned point elements
+        //
+
+        mConnectedComponents[c].pinnedPointElementOffset = 0;
+        mConnectedComponents[c].pinnedPointElementCount = 0;
 
-        if (!mConnectedComponents[c].pointElementVBO)
-        {
-            glGenBuffers(1, &elementVBO);
-            mConnectedComponents[c].pointElementVBO = elementVBO;
-        }
-        
         //
-        // Prepare spring elements
+        // Prepare bomb elements
         //
 
-        // Max # of springs = number of points * 9 (8 neighbours plus one rope for endpoint points)
-        size_t maxConnectedComponentSprings = connectedComponentsMaxSizes[c] * 9;        
-        if (mConnectedComponents[c].springElementMaxCount != maxConnectedComponentSprings)
-        {
-            // A change in the max size of this connected component
-            mConnectedComponents[c].springElementBuffer.reset();
-            mConnectedComponents[c].springElementBuffer.reset(new SpringElement[maxConnectedComponentSprings]);
-            mConnectedComponents[c].springElementMaxCount = maxConnectedComponentSprings;
-        }
+        mConnectedComponents[c].bombElementOffset = 0;
+        mConnectedComponents[c].bombElementInfos.clear();
+    }
 
-        mConnectedComponents[c].springElementCount = 0;
+    mPointElementVBO.vboEnd = 0;
+    mPointElementVBO.slots.clear();
 
-        if (!mConnectedComponents[c].springElementVBO)
-        {
-            glGenBuffers(1, &elementVBO);
-            mConnectedComponents[c].springElementVBO = elementVBO;
-        }
+    mSpringElementVBO.vboEnd = 0;
+    mSpringElementVBO.slots.clear();
 
-        //
-        // Prepare rope elements
-        //
+    mCoarseSpringElementVBO.vboEnd = 0;
+    mCoarseSpringElementVBO.slots.clear();
 
-        // Max # of ropes = max number of springs
-        size_t maxConnectedComponentRopes = maxConnectedComponentSprings;
-        if (mConnectedComponents[c].ropeElementMaxCount != maxConnectedComponentRopes)
-        {
-            // A change in the max size of this connected component
-            mConnectedComponents[c].ropeElementBuffer.reset();
-            mConnectedComponents[c].ropeElementBuffer.reset(new RopeElement[maxConnectedComponentRopes]);
-            mConnectedComponents[c].ropeElementMaxCount = maxConnectedComponentRopes;
-        }
+    mRopeElementVBO.vboEnd = 0;
+    mRopeElementVBO.slots.clear();
 
-        mConnectedComponents[c].ropeElementCount = 0;
+    mTriangleElementVBO.vboEnd = 0;
+    mTriangleElementVBO.slots.clear();
 
-        if (!mConnectedComponents[c].ropeElementVBO)
-        {
-            glGenBuffers(1, &elementVBO);
-            mConnectedComponents[c].ropeElementVBO = elementVBO;
-        }
+    mCoarseTriangleElementVBO.vboEnd = 0;
+    mCoarseTriangleElementVBO.slots.clear();
+}
 
-        //
-        // Prepare triangle elements
-        //
+void ShipRenderContext::UpdateElementsStart(
+    std::vector<std::size_t> const & connectedComponentsMaxSizes,
+    std::vector<ConnectedComponentId> const & changedConnectedComponentIds)
+{
+    // Connected components are never removed, while new ones may appear
+    assert(connectedComponentsMaxSizes.size() >= mConnectedComponents.size());
+    mConnectedComponents.resize(connectedComponentsMaxSizes.size());
 
-        // Max # of triangles = number of points * 8 (each of the 8 directions)
-        size_t maxConnectedComponentTriangles = connectedComponentsMaxSizes[c] * 8;
-        if (mConnectedComponents[c].triangleElementMaxCount != maxConnectedComponentTriangles)
-        {
-            // A change in the max size of this connected component
-            mConnectedComponents[c].triangleElementBuffer.reset();
-            mConnectedComponents[c].triangleElementBuffer.reset(new TriangleElement[maxConnectedComponentTriangles]);
-            mConnectedComponents[c].triangleElementMaxCount = maxConnectedComponentTriangles;
-        }
+    for (auto connectedComponentId : changedConnectedComponentIds)
+    {
+        size_t const connectedComponentIndex = connectedComponentId - 1;
 
-        mConnectedComponents[c].triangleElementCount = 0;
+        assert(connectedComponentIndex < mConnectedComponents.size());
 
-        if (!mConnectedComponents[c].triangleElementVBO)
-        {
-            glGenBuffers(1, &elementVBO);
-            mConnectedComponents[c].triangleElementVBO = elementVBO;
-        }
+        PrepareConnectedComponentElements(
+            connectedComponentIndex,
+            connectedComponentsMaxSizes[connectedComponentIndex]);
+    }
+}
+
+void ShipRenderContext::RemoveElementPoint(int pointIndex)
+{
+    RemoveElement(
+        &ConnectedComponentData::pointElements,
+        mPointElementVBO,
+        pointIndex);
+}
+
+void ShipRenderContext::RemoveElementSpring(ElementIndex springIndex)
+{
+    RemoveElement(
+        &ConnectedComponentData::springElements,
+        mSpringElementVBO,
+        springIndex);
+
+    // Coarse springs are the ones that have a place among the coarse springs
+    if (springIndex < mCoarseSpringElementVBO.slots.size()
+        && NoneConnectedComponentIndex != mCoarseSpringElementVBO.slots[springIndex].connectedComponentIndex)
+    {
+        RemoveElement(
+            &ConnectedComponentData::coarseSpringElements,
+            mCoarseSpringElementVBO,
+            springIndex);
+    }
+}
+
+void ShipRenderContext::RemoveElementRope(ElementIndex springIndex)
+{
+    RemoveElement(
+        &ConnectedComponentData::ropeElements,
+        mRopeElementVBO,
+        springIndex);
+}
+
+void ShipRenderContext::RemoveElementTriangle(ElementIndex triangleIndex)
+{
+    RemoveElement(
+        &ConnectedComponentData::triangleElements,
+        mTriangleElementVBO,
+        triangleIndex);
+}
+
+void ShipRenderContext::RemoveElementCoarseTriangle(ElementIndex coarseTriangleIndex)
+{
+    RemoveElement(
+        &ConnectedComponentData::coarseTriangleElements,
+        mCoarseTriangleElementVBO,
+        coarseTriangleIndex);
+}
+
+void ShipRenderContext::UploadElementsEnd()
+{
+    //
+    // Upload all elements, except for pinned points and bombs
+    //
+
+    UploadElements<PointElement, 1>(
+        &ConnectedComponentData::pointElements,
+        mPointElementVBO,
+        GL_STATIC_DRAW);
+
+    UploadElements<SpringElement, 2>(
+        &ConnectedComponentData::springElements,
+        mSpringElementVBO,
+        GL_STATIC_DRAW);
+
+    UploadElements<SpringElement, 2>(
+        &ConnectedComponentData::coarseSpringElements,
+        mCoarseSpringElementVBO,
+        GL_STATIC_DRAW);
+
+    UploadElements<RopeElement, 2>(
+        &ConnectedComponentData::ropeElements,
+        mRopeElementVBO,
+        GL_STATIC_DRAW);
+
+    UploadElements<TriangleElement, 3>(
+        &ConnectedComponentData::triangleElements,
+        mTriangleElementVBO,
+        GL_STATIC_DRAW);
+
+    UploadElements<TriangleElement, 3>(
+        &ConnectedComponentData::coarseTriangleElements,
+        mCoarseTriangleElementVBO,
+        GL_STATIC_DRAW);
+
+    for (auto & connectedComponent : mConnectedComponents)
+    {
+        connectedComponent.isBeingUploaded = false;
+    }
+}
+
+void ShipRenderContext::PrepareConnectedComponentElements(
+    size_t connectedComponentIndex,
+    size_t connectedComponentMaxSize)
+{
+    auto & connectedComponent = mConnectedComponents[connectedComponentIndex];
+
+    // Max # of points = number of points
+    connectedComponent.pointElements.Reset(connectedComponentMaxSize);
+
+    // Max # of springs = number of points * 9 (8 neighbours plus one rope for endpoint points)
+    connectedComponent.springElements.Reset(connectedComponentMaxSize * 9);
+
+    // Max # of coarse springs = max number of springs
+    connectedComponent.coarseSpringElements.Reset(connectedComponentMaxSize * 9);
+
+    // Max # of ropes = max number of springs
+    connectedComponent.ropeElements.Reset(connectedComponentMaxSize * 9);
+
+    // Max # of triangles = number of points * 8 (each of the 8 directions)
+    connectedComponent.triangleElements.Reset(connectedComponentMaxSize * 8);
+
+    // Max # of coarse triangles = max number of triangles, as a block's two coarse
+    // triangles replace its eight triangles
+    connectedComponent.coarseTriangleElements.Reset(connectedComponentMaxSize * 8);
+
+    connectedComponent.isBeingUploaded = true;
+}
+
+template<typename TElement>
+void ShipRenderContext::RemoveElement(
+    ConnectedComponentElements<TElement> ConnectedComponentData::* elements,
+    ElementVBO<TElement> & elementVBO,
+    ElementIndex elementIndex)
+{
+    assert(elementIndex < elementVBO.slots.size());
+    assert(elementVBO.slots[elementIndex].connectedComponentIndex != NoneConnectedComponentIndex);
+
+    ElementSlot & slot = elementVBO.slots[elementIndex];
+
+    // The elements of the connected components that are being uploaded are gone already
+    if (!mConnectedComponents[slot.connectedComponentIndex].isBeingUploaded)
+    {
+        auto & connectedComponentElements = mConnectedComponents[slot.connectedComponentIndex].*elements;
+
+        assert(connectedComponentElements.count > 0);
+        size_t const lastPosition = connectedComponentElements.count - 1;
 
         //
-        // Prepare stressed spring elements
+        // Move the last element of the connected component into the place of the removed one
         //
 
-        // Max # of stressed springs = max number of springs
-        size_t maxConnectedComponentStressedSprings = maxConnectedComponentSprings;
-        if (mConnectedComponents[c].stressedSpringElementMaxCount != maxConnectedComponentStressedSprings)
+        if (slot.position != lastPosition)
         {
-            // A change in the max size of this connected component
-            mConnectedComponents[c].stressedSpringElementBuffer.reset();
-            mConnectedComponents[c].stressedSpringElementBuffer.reset(new StressedSpringElement[maxConnectedComponentStressedSprings]);
-            mConnectedComponents[c].stressedSpringElementMaxCount = maxConnectedComponentStressedSprings;
-        }
+            ElementIndex const movedElementIndex = connectedComponentElements.elementIndices[lastPosition];
 
-        mConnectedComponents[c].stressedSpringElementCount = 0;
+            connectedComponentElements.buffer[slot.position] = connectedComponentElements.buffer[lastPosition];
+            connectedComponentElements.elementIndices[slot.position] = movedElementIndex;
 
-        if (!mConnectedComponents[c].stressedSpringElementVBO)
-        {
-            glGenBuffers(1, &elementVBO);
-            mConnectedComponents[c].stressedSpringElementVBO = elementVBO;
+            elementVBO.slots[movedElementIndex].position = slot.position;
         }
-        
-        //
-        // Prepare pinned point elements
-        //
-
-        mConnectedComponents[c].pinnedPointElementOffset = 0;
-        mConnectedComponents[c].pinnedPointElementCount = 0;
 
-        //
-        // Prepare bomb elements
-        //
+        --(connectedComponentElements.count);
 
-        mConnectedComponents[c].bombElementOffset = 0;
-        mConnectedComponents[c].bombElementInfos.clear();
+        connectedComponentElements.firstDirtyElement = std::min(connectedComponentElements.firstDirtyElement, slot.position);
     }
+
+    slot.connectedComponentIndex = NoneConnectedComponentIndex;
 }
 
-void ShipRenderContext::UploadElementsEnd()
+template<typename TElement, size_t VerticesPerElement>
+void ShipRenderContext::UploadElements(
+    ConnectedComponentElements<TElement> ConnectedComponentData::* elements,
+    ElementVBO<TElement> & elementVBO,
+    GLenum usage)
 {
     //
-    // Upload all elements, except for stressed springs, pinned points, and bombs
+    // Give a new range to each connected component that has outgrown its own, after
+    // the last range; if there's no room left, lay out all connected components again,
+    // one after the other
     //
 
-    for (size_t c = 0; c < mConnectedComponents.size(); ++c)
+    bool doLayOutAgain = false;
+    for (auto & connectedComponent : mConnectedComponents)
     {
-        // Points
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mConnectedComponents[c].pointElementVBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mConnectedComponents[c].pointElementCount * sizeof(PointElement), mConnectedComponents[c].pointElementBuffer.get(), GL_STATIC_DRAW);
+        auto & connectedComponentElements = connectedComponent.*elements;
 
-        // Springs
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mConnectedComponents[c].springElementVBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mConnectedComponents[c].springElementCount * sizeof(SpringElement), mConnectedComponents[c].springElementBuffer.get(), GL_STATIC_DRAW);
+        if (connectedComponentElements.count > connectedComponentElements.vboCapacity)
+        {
+            if (elementVBO.vboEnd + connectedComponentElements.count > elementVBO.vboSize)
+            {
+                doLayOutAgain = true;
+                break;
+            }
 
-        // Ropes
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mConnectedComponents[c].ropeElementVBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mConnectedComponents[c].ropeElementCount * sizeof(RopeElement), mConnectedComponents[c].ropeElementBuffer.get(), GL_STATIC_DRAW);
+            connectedComponentElements.vboOffset = elementVBO.vboEnd;
+            connectedComponentElements.vboCapacity = connectedComponentElements.count;
+            connectedComponentElements.firstDirtyElement = 0;
 
-        // Triangles
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mConnectedComponents[c].triangleElementVBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mConnectedComponents[c].triangleElementCount * sizeof(TriangleElement), mConnectedComponents[c].triangleElementBuffer.get(), GL_STATIC_DRAW);
+            elementVBO.vboEnd += connectedComponentElements.count;
+        }
     }
-}
 
-void ShipRenderContext::UploadElementStressedSpringsStart()
-{
-    for (size_t c = 0; c < mConnectedComponents.size(); ++c)
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *elementVBO.vbo);
+
+    if (doLayOutAgain)
     {
-        // Zero-out count of stressed springs
-        mConnectedComponents[c].stressedSpringElementCount = 0;
+        size_t totalElementCount = 0;
+        for (auto & connectedComponent : mConnectedComponents)
+        {
+            auto & connectedComponentElements = connectedComponent.*elements;
+
+            connectedComponentElements.vboOffset = totalElementCount;
+            connectedComponentElements.vboCapacity = connectedComponentElements.count;
+            connectedComponentElements.firstDirtyElement = 0;
+
+            totalElementCount += connectedComponentElements.count;
+        }
+
+        // Leave some room for new connected components
+        elementVBO.vboEnd = totalElementCount;
+        elementVBO.vboSize = totalElementCount + totalElementCount / 4;
+
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, elementVBO.vboSize * sizeof(TElement), nullptr, usage);
     }
-}
 
-void ShipRenderContext::UploadElementStressedSpringsEnd()
-{
     //
-    // Upload stressed spring elements
+    // Upload the elements that have changed
     //
 
-    for (size_t c = 0; c < mConnectedComponents.size(); ++c)
+    for (auto & connectedComponent : mConnectedComponents)
+    {
+        auto & connectedComponentElements = connectedComponent.*elements;
+
+        if (connectedComponentElements.firstDirtyElement < connectedComponentElements.count)
+        {
+            glBufferSubData(
+                GL_ELEMENT_ARRAY_BUFFER,
+                (connectedComponentElements.vboOffset + connectedComponentElements.firstDirtyElement) * sizeof(TElement),
+                (connectedComponentElements.count - connectedComponentElements.firstDirtyElement) * sizeof(TElement),
+                &(connectedComponentElements.buffer[connectedComponentElements.firstDirtyElement]));
+        }
+
+        connectedComponentElements.firstDirtyElement = connectedComponentElements.count;
+    }
+
+    PrepareMultiDraw<TElement, VerticesPerElement>(
+        elements,
+        elementVBO);
+}
+
+template<typename TElement, size_t VerticesPerElement>
+void ShipRenderContext::PrepareMultiDraw(
+    ConnectedComponentElements<TElement> ConnectedComponentData::* elements,
+    ElementVBO<TElement> & elementVBO)
+{
+    elementVBO.multiDraw.counts.clear();
+    elementVBO.multiDraw.offsets.clear();
+
+    for (auto & connectedComponent : mConnectedComponents)
     {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mConnectedComponents[c].stressedSpringElementVBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mConnectedComponents[c].stressedSpringElementCount * sizeof(StressedSpringElement), mConnectedComponents[c].stressedSpringElementBuffer.get(), GL_DYNAMIC_DRAW);
+        auto & connectedComponentElements = connectedComponent.*elements;
+
+        if (connectedComponent.isVisible && connectedComponentElements.count > 0)
+        {
+            elementVBO.multiDraw.counts.push_back(static_cast<GLsizei>(VerticesPerElement * connectedComponentElements.count));
+            elementVBO.multiDraw.offsets.push_back(reinterpret_cast<GLvoid const *>(connectedComponentElements.vboOffset * sizeof(TElement)));
+        }
     }
 }
 
@@ -921,111 +1062,157 @@ void ShipRenderContext::UploadLampsEnd()
 
 void ShipRenderContext::Render(
     ShipRenderMode renderMode,
-    bool showStressedSprings,
     float ambientLightIntensity,
     float canvasToVisibleWorldHeightRatio,
-    float(&orthoMatrix)[4][4])
+    float(&orthoMatrix)[4][4],
+    Geometry::AABB const & visibleWorldAABB,
+    std::vector<Geometry::AABB> const & connectedComponentAABBs,
+    RenderStatistics & renderStatistics,
+    bool areRenderStatisticsSynchronous)
 {
+    TraceSpan span("ShipRenderContext::Render");
+
     //
-    // Process all connected components, from first to last, and draw all elements
+    // Cull the connected components that are not visible, preparing the draws
+    // again only if any connected component has come into view or gone out of it
     //
 
+    bool hasVisibilityChanged = false;
     for (size_t c = 0; c < mConnectedComponents.size(); ++c)
     {
-        //
-        // Draw points
-        //
+        bool const isVisible =
+            c >= connectedComponentAABBs.size()
+            || connectedComponentAABBs[c].intersects(visibleWorldAABB);
 
-        if (renderMode == ShipRenderMode::Points)
+        if (isVisible != mConnectedComponents[c].isVisible)
         {
-            RenderPointElements(
-                mConnectedComponents[c],
-                ambientLightIntensity,
-                canvasToVisibleWorldHeightRatio,
-                orthoMatrix);
+            mConnectedComponents[c].isVisible = isVisible;
+            hasVisibilityChanged = true;
         }
+    }
 
+    if (hasVisibilityChanged)
+    {
+        PrepareMultiDraw<PointElement, 1>(&ConnectedComponentData::pointElements, mPointElementVBO);
+        PrepareMultiDraw<SpringElement, 2>(&ConnectedComponentData::springElements, mSpringElementVBO);
+        PrepareMultiDraw<SpringElement, 2>(&ConnectedComponentData::coarseSpringElements, mCoarseSpringElementVBO);
+        PrepareMultiDraw<RopeElement, 2>(&ConnectedComponentData::ropeElements, mRopeElementVBO);
+        PrepareMultiDraw<TriangleElement, 3>(&ConnectedComponentData::triangleElements, mTriangleElementVBO);
+        PrepareMultiDraw<TriangleElement, 3>(&ConnectedComponentData::coarseTriangleElements, mCoarseTriangleElementVBO);
+    }
 
-        //
-        // Draw springs
-        //
-        // We draw springs when:
-        // - RenderMode is springs ("X-Ray Mode"), in which case we use colors - so to show structural springs -, or
-        // - RenderMode is structure (so to draw 1D chains), in which case we use colors, or
-        // - RenderMode is texture (so to draw 1D chains), in which case we use texture iff it is present
-        //
 
-        if (renderMode == ShipRenderMode::Springs
-            || renderMode == ShipRenderMode::Structure
-            || renderMode == ShipRenderMode::Texture)
-        {
-            RenderSpringElements(
-                mConnectedComponents[c],
-                renderMode == ShipRenderMode::Texture,
-                ambientLightIntensity,
-                canvasToVisibleWorldHeightRatio,
-                orthoMatrix);
-        }
+    //
+    // Draw all elements of each type across all visible connected components at once,
+    // from the first connected component to the last
+    //
 
+    bool const withCoarseMesh = canvasToVisibleWorldHeightRatio < CoarseMeshMaxCanvasToVisibleWorldHeightRatio;
 
-        //
-        // Draw ropes now if RenderMode is:
-        // - Springs
-        // - Texture (so rope endpoints are hidden behind texture, looks better)
-        //
+    //
+    // Draw points
+    //
 
-        if (renderMode == ShipRenderMode::Springs
-            || renderMode == ShipRenderMode::Texture)
-        {
-            RenderRopeElements(
-                mConnectedComponents[c],
-                ambientLightIntensity,
-                canvasToVisibleWorldHeightRatio,
-                orthoMatrix);
-        }
+    if (renderMode == ShipRenderMode::Points)
+    {
+        RenderPassTimer passTimer(renderStatistics.ShipPointsDuration, areRenderStatisticsSynchronous);
+        TraceSpan passSpan("ShipRenderContext::RenderPointElements");
 
+        RenderPointElements(
+            ambientLightIntensity,
+            canvasToVisibleWorldHeightRatio,
+            orthoMatrix);
+    }
 
-        //
-        // Draw triangles
-        //
 
-        if (renderMode == ShipRenderMode::Structure
-            || renderMode == ShipRenderMode::Texture)
-        {
-            RenderTriangleElements(
-                mConnectedComponents[c],
-                renderMode == ShipRenderMode::Texture,
-                ambientLightIntensity,
-                orthoMatrix);
-        }
+    //
+    // Draw springs
+    //
+    // We draw springs when:
+    // - RenderMode is springs ("X-Ray Mode"), in which case we use colors - so to show structural springs -, or
+    // - RenderMode is structure (so to draw 1D chains), in which case we use colors, or
+    // - RenderMode is texture (so to draw 1D chains), in which case we use texture iff it is present
+    //
+
+    if (renderMode == ShipRenderMode::Springs
+        || renderMode == ShipRenderMode::Structure
+        || renderMode == ShipRenderMode::Texture)
+    {
+        RenderPassTimer passTimer(renderStatistics.ShipSpringsDuration, areRenderStatisticsSynchronous);
+        TraceSpan passSpan("ShipRenderContext::RenderSpringElements");
 
+        RenderSpringElements(
+            withCoarseMesh,
+            renderMode == ShipRenderMode::Texture,
+            ambientLightIntensity,
+            canvasToVisibleWorldHeightRatio,
+            orthoMatrix);
+    }
 
-        //
-        // Draw ropes now if RenderMode is Structure (so rope endpoints on the structure are visible)
-        //
 
-        if (renderMode == ShipRenderMode::Structure)
-        {
-            RenderRopeElements(
-                mConnectedComponents[c],
-                ambientLightIntensity,
-                canvasToVisibleWorldHeightRatio,
-                orthoMatrix);
-        }
+    //
+    // Draw ropes now if RenderMode is:
+    // - Springs
+    // - Texture (so rope endpoints are hidden behind texture, looks better)
+    //
 
+    if (renderMode == ShipRenderMode::Springs
+        || renderMode == ShipRenderMode::Texture)
+    {
+        RenderPassTimer passTimer(renderStatistics.ShipSpringsDuration, areRenderStatisticsSynchronous);
+        TraceSpan passSpan("ShipRenderContext::RenderRopeElements");
 
-        //
-        // Draw stressed springs
-        //
+        RenderRopeElements(
+            ambientLightIntensity,
+            canvasToVisibleWorldHeightRatio,
+            orthoMatrix);
+    }
 
-        if (showStressedSprings)
-        {
-            RenderStressedSpringElements(
-                mConnectedComponents[c],
-                canvasToVisibleWorldHeightRatio,
-                orthoMatrix);
-        }
 
+    //
+    // Draw triangles
+    //
+
+    if (renderMode == ShipRenderMode::Structure
+        || renderMode == ShipRenderMode::Texture)
+    {
+        RenderPassTimer passTimer(renderStatistics.ShipTrianglesDuration, areRenderStatisticsSynchronous);
+        TraceSpan passSpan("ShipRenderContext::RenderTriangleElements");
+
+        RenderTriangleElements(
+            withCoarseMesh,
+            renderMode == ShipRenderMode::Texture,
+            ambientLightIntensity,
+            orthoMatrix);
+    }
+
+
+    //
+    // Draw ropes now if RenderMode is Structure (so rope endpoints on the structure are visible)
+    //
+
+    if (renderMode == ShipRenderMode::Structure)
+    {
+        RenderPassTimer passTimer(renderStatistics.ShipSpringsDuration, areRenderStatisticsSynchronous);
+        TraceSpan passSpan("ShipRenderContext::RenderRopeElements");
+
+        RenderRopeElements(
+            ambientLightIntensity,
+            canvasToVisibleWorldHeightRatio,
+            orthoMatrix);
+    }
+
+
+    //
+    // Process all visible connected components, from first to last, and draw bombs and pinned points
+    //
+
+    TraceSpan bombsAndPinnedPointsSpan("ShipRenderContext::RenderBombAndPinnedPointElements");
+
+    for (size_t c = 0; c < mConnectedComponents.size(); ++c)
+    {
+        if (!mConnectedComponents[c].isVisible)
+            continue;
 
         //
         // Draw bombs
@@ -1046,12 +1233,17 @@ void ShipRenderContext::Render(
             ambientLightIntensity,
             orthoMatrix);
     }
+
+    //
+    // Let the point attributes' memory be re-used once the GPU is done with it
+    //
+
+    mPointAttributesVBO.Fence();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 void ShipRenderContext::RenderPointElements(
-    ConnectedComponentData const & connectedComponent,
     float ambientLightIntensity,
     float canvasToVisibleWorldHeightRatio,
     float(&orthoMatrix)[4][4])
@@ -1067,17 +1259,17 @@ void ShipRenderContext::RenderPointElements(
     glPointSize(0.2f * 2.0f * canvasToVisibleWorldHeightRatio);
 
     // Bind VBO
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *connectedComponent.pointElementVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mPointElementVBO.vbo);
 
     // Draw
-    glDrawElements(GL_POINTS, static_cast<GLsizei>(1 * connectedComponent.pointElementCount), GL_UNSIGNED_INT, 0);
+    glMultiDrawElements(GL_POINTS, mPointElementVBO.multiDraw.counts.data(), GL_UNSIGNED_INT, mPointElementVBO.multiDraw.offsets.data(), static_cast<GLsizei>(mPointElementVBO.multiDraw.counts.size()));
 
     // Stop using program
     glUseProgram(0);
 }
 
 void ShipRenderContext::RenderSpringElements(
-    ConnectedComponentData const & connectedComponent,
+    bool withCoarseMesh,
     bool withTexture,
     float ambientLightIntensity,
     float canvasToVisibleWorldHeightRatio,
@@ -1108,11 +1300,13 @@ void ShipRenderContext::RenderSpringElements(
     // Set line size
     glLineWidth(0.1f * 2.0f * canvasToVisibleWorldHeightRatio);
 
+    auto const & springElementVBO = withCoarseMesh ? mCoarseSpringElementVBO : mSpringElementVBO;
+
     // Bind VBO
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *connectedComponent.springElementVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *springElementVBO.vbo);
 
     // Draw
-    glDrawElements(GL_LINES, static_cast<GLsizei>(2 * connectedComponent.springElementCount), GL_UNSIGNED_INT, 0);
+    glMultiDrawElements(GL_LINES, springElementVBO.multiDraw.counts.data(), GL_UNSIGNED_INT, springElementVBO.multiDraw.offsets.data(), static_cast<GLsizei>(springElementVBO.multiDraw.counts.size()));
 
     // Unbind texture (if any)
     if (withTexture && !!mElementTexture)
@@ -1125,7 +1319,6 @@ void ShipRenderContext::RenderSpringElements(
 }
 
 void ShipRenderContext::RenderRopeElements(
-    ConnectedComponentData const & connectedComponent,
     float ambientLightIntensity,
     float canvasToVisibleWorldHeightRatio,
     float(&orthoMatrix)[4][4])
@@ -1141,17 +1334,17 @@ void ShipRenderContext::RenderRopeElements(
     glLineWidth(0.1f * 2.0f * canvasToVisibleWorldHeightRatio);
 
     // Bind VBO
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *connectedComponent.ropeElementVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mRopeElementVBO.vbo);
 
     // Draw
-    glDrawElements(GL_LINES, static_cast<GLsizei>(2 * connectedComponent.ropeElementCount), GL_UNSIGNED_INT, 0);
+    glMultiDrawElements(GL_LINES, mRopeElementVBO.multiDraw.counts.data(), GL_UNSIGNED_INT, mRopeElementVBO.multiDraw.offsets.data(), static_cast<GLsizei>(mRopeElementVBO.multiDraw.counts.size()));
 
     // Stop using program
     glUseProgram(0);
 }
 
 void ShipRenderContext::RenderTriangleElements(
-    ConnectedComponentData const & connectedComponent,
+    bool withCoarseMesh,
     bool withTexture,
     float ambientLightIntensity,
     float(&orthoMatrix)[4][4])
@@ -1178,11 +1371,13 @@ void ShipRenderContext::RenderTriangleElements(
         glUniform1f(mElementColorShaderAmbientLightIntensityParameter, ambientLightIntensity);
     }
 
+    auto const & triangleElementVBO = withCoarseMesh ? mCoarseTriangleElementVBO : mTriangleElementVBO;
+
     // Bind VBO
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *connectedComponent.triangleElementVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *triangleElementVBO.vbo);
 
     // Draw
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(3 * connectedComponent.triangleElementCount), GL_UNSIGNED_INT, 0);
+    glMultiDrawElements(GL_TRIANGLES, triangleElementVBO.multiDraw.counts.data(), GL_UNSIGNED_INT, triangleElementVBO.multiDraw.offsets.data(), static_cast<GLsizei>(triangleElementVBO.multiDraw.counts.size()));
 
     // Unbind texture (if any)
     if (withTexture && !!mElementTexture)
@@ -1194,36 +1389,6 @@ void ShipRenderContext::RenderTriangleElements(
     glUseProgram(0);
 }
 
-void ShipRenderContext::RenderStressedSpringElements(
-    ConnectedComponentData const & connectedComponent,
-    float canvasToVisibleWorldHeightRatio,
-    float(&orthoMatrix)[4][4])
-{
-    // Use program
-    glUseProgram(*mElementStressedSpringShaderProgram);
-
-    // Set parameters
-    glUniformMatrix4fv(mElementStressedSpringShaderOrthoMatrixParameter, 1, GL_FALSE, &(orthoMatrix[0][0]));
-
-    // Bind texture
-    glBindTexture(GL_TEXTURE_2D, *mElementStressedSpringTexture);
-
-    // Bind VBO
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *connectedComponent.stressedSpringElementVBO);
-
-    // Set line size
-    glLineWidth(0.1f * 2.0f * canvasToVisibleWorldHeightRatio);
-
-    // Draw
-    glDrawElements(GL_LINES, static_cast<GLsizei>(2 * connectedComponent.stressedSpringElementCount), GL_UNSIGNED_INT, 0);
-
-    // Unbind texture
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    // Stop using program
-    glUseProgram(0);
-}
-
 void ShipRenderContext::RenderBombElements(
     ConnectedComponentData const & connectedComponent,
     float ambientLightIntensity,
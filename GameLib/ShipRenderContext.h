@@ -5,15 +5,19 @@
 ***************************************************************************************/
 #pragma once
 
+#include "AABB.h"
 #include "GameOpenGL.h"
 #include "GameTypes.h"
 #include "ImageData.h"
+#include "RenderStatistics.h"
 #include "RotatedTextureRenderInfo.h"
 #include "SysSpecifics.h"
 #include "Vectors.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
@@ -43,115 +47,190 @@ public:
         vec3f const * restrict color,
         vec2f const * restrict textureCoordinates);
 
+    /*
+     * Stress is optional: when not specified, points are drawn as unstressed.
+     */
     void UploadPoints(
         size_t count,
         vec2f const * restrict position,
         float const * restrict light,
-        float const * restrict water);
+        float const * restrict water,
+        float const * restrict stress);
 
 
     //
     // Springs and triangles
     //
 
+    /*
+     * Starts uploading all the elements of all the connected components from scratch.
+     */
     void UploadElementsStart(std::vector<std::size_t> const & connectedComponentsMaxSizes);
 
+    /*
+     * Starts updating the elements uploaded so far: elements may only be removed,
+     * and only the connected components that have changed are uploaded again - the
+     * elements uploaded for any other connected component are ignored.
+     */
+    void UpdateElementsStart(
+        std::vector<std::size_t> const & connectedComponentsMaxSizes,
+        std::vector<ConnectedComponentId> const & changedConnectedComponentIds);
+
     inline void UploadElementPoint(
         int pointIndex,
         ConnectedComponentId connectedComponentId)
     {
-        size_t const connectedComponentIndex = connectedComponentId - 1;
-
-        assert(connectedComponentIndex < mConnectedComponents.size());
-        assert(mConnectedComponents[connectedComponentIndex].pointElementCount + 1u <= mConnectedComponents[connectedComponentIndex].pointElementMaxCount);
-
-        PointElement * const pointElement = &(mConnectedComponents[connectedComponentIndex].pointElementBuffer[mConnectedComponents[connectedComponentIndex].pointElementCount]);
+        PointElement * const pointElement = AddElement(
+            &ConnectedComponentData::pointElements,
+            mPointElementVBO,
+            pointIndex,
+            connectedComponentId);
 
-        pointElement->pointIndex = pointIndex;
-
-        ++(mConnectedComponents[connectedComponentIndex].pointElementCount);
+        if (nullptr != pointElement)
+        {
+            pointElement->pointIndex = pointIndex;
+        }
     }
 
+    /*
+     * Coarse springs are also drawn when the ship is drawn with less detail.
+     */
     inline void UploadElementSpring(
+        ElementIndex springIndex,
         int pointIndex1,
         int pointIndex2,
+        bool isCoarse,
         ConnectedComponentId connectedComponentId)
     {
-        size_t const connectedComponentIndex = connectedComponentId - 1;
+        SpringElement * const springElement = AddElement(
+            &ConnectedComponentData::springElements,
+            mSpringElementVBO,
+            springIndex,
+            connectedComponentId);
 
-        assert(connectedComponentIndex < mConnectedComponents.size());
-        assert(mConnectedComponents[connectedComponentIndex].springElementCount + 1u <= mConnectedComponents[connectedComponentIndex].springElementMaxCount);
-
-        SpringElement * const springElement = &(mConnectedComponents[connectedComponentIndex].springElementBuffer[mConnectedComponents[connectedComponentIndex].springElementCount]);
-
-        springElement->pointIndex1 = pointIndex1;
-        springElement->pointIndex2 = pointIndex2;
+        if (nullptr != springElement)
+        {
+            springElement->pointIndex1 = pointIndex1;
+            springElement->pointIndex2 = pointIndex2;
+        }
 
-        ++(mConnectedComponents[connectedComponentIndex].springElementCount);
+        if (isCoarse)
+        {
+            SpringElement * const coarseSpringElement = AddElement(
+                &ConnectedComponentData::coarseSpringElements,
+                mCoarseSpringElementVBO,
+                springIndex,
+                connectedComponentId);
+
+            if (nullptr != coarseSpringElement)
+            {
+                coarseSpringElement->pointIndex1 = pointIndex1;
+                coarseSpringElement->pointIndex2 = pointIndex2;
+            }
+        }
     }
 
     inline void UploadElementRope(
+        ElementIndex springIndex,
         int pointIndex1,
         int pointIndex2,
         ConnectedComponentId connectedComponentId)
     {
-        size_t const connectedComponentIndex = connectedComponentId - 1;
+        RopeElement * const ropeElement = AddElement(
+            &ConnectedComponentData::ropeElements,
+            mRopeElementVBO,
+            springIndex,
+            connectedComponentId);
 
-        assert(connectedComponentIndex < mConnectedComponents.size());
-        assert(mConnectedComponents[connectedComponentIndex].ropeElementCount + 1u <= mConnectedComponents[connectedComponentIndex].ropeElementMaxCount);
-
-        RopeElement * const ropeElement = &(mConnectedComponents[connectedComponentIndex].ropeElementBuffer[mConnectedComponents[connectedComponentIndex].ropeElementCount]);
-
-        ropeElement->pointIndex1 = pointIndex1;
-        ropeElement->pointIndex2 = pointIndex2;
-
-        ++(mConnectedComponents[connectedComponentIndex].ropeElementCount);
+        if (nullptr != ropeElement)
+        {
+            ropeElement->pointIndex1 = pointIndex1;
+            ropeElement->pointIndex2 = pointIndex2;
+        }
     }
 
     inline void UploadElementTriangle(
+        ElementIndex triangleIndex,
         int pointIndex1,
         int pointIndex2,
         int pointIndex3,
         ConnectedComponentId connectedComponentId)
     {
-        size_t const connectedComponentIndex = connectedComponentId - 1;
-
-        assert(connectedComponentIndex < mConnectedComponents.size());
-        assert(mConnectedComponents[connectedComponentIndex].triangleElementCount + 1u <= mConnectedComponents[connectedComponentIndex].triangleElementMaxCount);
-
-        TriangleElement * const triangleElement = &(mConnectedComponents[connectedComponentIndex].triangleElementBuffer[mConnectedComponents[connectedComponentIndex].triangleElementCount]);
+        TriangleElement * const triangleElement = AddElement(
+            &ConnectedComponentData::triangleElements,
+            mTriangleElementVBO,
+            triangleIndex,
+            connectedComponentId);
 
-        triangleElement->pointIndex1 = pointIndex1;
-        triangleElement->pointIndex2 = pointIndex2;
-        triangleElement->pointIndex3 = pointIndex3;
-
-        ++(mConnectedComponents[connectedComponentIndex].triangleElementCount);
+        if (nullptr != triangleElement)
+        {
+            triangleElement->pointIndex1 = pointIndex1;
+            triangleElement->pointIndex2 = pointIndex2;
+            triangleElement->pointIndex3 = pointIndex3;
+        }
     }
 
-    void UploadElementsEnd();
-
+    /*
+     * Coarse triangles make the mesh that is drawn instead of the triangles when the ship is
+     * drawn with less detail; they are indexed independently of the triangles.
+     */
+    inline void UploadElementCoarseTriangle(
+        ElementIndex coarseTriangleIndex,
+        int pointIndex1,
+        int pointIndex2,
+        int pointIndex3,
+        ConnectedComponentId connectedComponentId)
+    {
+        TriangleElement * const triangleElement = AddElement(
+            &ConnectedComponentData::coarseTriangleElements,
+            mCoarseTriangleElementVBO,
+            coarseTriangleIndex,
+            connectedComponentId);
 
-    void UploadElementStressedSpringsStart();
+        if (nullptr != triangleElement)
+        {
+            triangleElement->pointIndex1 = pointIndex1;
+            triangleElement->pointIndex2 = pointIndex2;
+            triangleElement->pointIndex3 = pointIndex3;
+        }
+    }
 
-    inline void UploadElementStressedSpring(
+    /*
+     * Adds a coarse triangle to the elements uploaded so far, while updating them; ignored
+     * for the connected components that are being uploaded again.
+     */
+    inline void InsertElementCoarseTriangle(
+        ElementIndex coarseTriangleIndex,
         int pointIndex1,
         int pointIndex2,
+        int pointIndex3,
         ConnectedComponentId connectedComponentId)
     {
-        size_t const connectedComponentIndex = connectedComponentId - 1;
+        TriangleElement * const triangleElement = InsertElement(
+            &ConnectedComponentData::coarseTriangleElements,
+            mCoarseTriangleElementVBO,
+            coarseTriangleIndex,
+            connectedComponentId);
 
-        assert(connectedComponentIndex < mConnectedComponents.size());
-        assert(mConnectedComponents[connectedComponentIndex].stressedSpringElementCount + 1u <= mConnectedComponents[connectedComponentIndex].stressedSpringElementMaxCount);
+        if (nullptr != triangleElement)
+        {
+            triangleElement->pointIndex1 = pointIndex1;
+            triangleElement->pointIndex2 = pointIndex2;
+            triangleElement->pointIndex3 = pointIndex3;
+        }
+    }
 
-        StressedSpringElement * const stressedSpringElement = &(mConnectedComponents[connectedComponentIndex].stressedSpringElementBuffer[mConnectedComponents[connectedComponentIndex].stressedSpringElementCount]);
+    void RemoveElementPoint(int pointIndex);
 
-        stressedSpringElement->pointIndex1 = pointIndex1;
-        stressedSpringElement->pointIndex2 = pointIndex2;
+    void RemoveElementSpring(ElementIndex springIndex);
 
-        ++(mConnectedComponents[connectedComponentIndex].stressedSpringElementCount);
-    }
+    void RemoveElementRope(ElementIndex springIndex);
 
-    void UploadElementStressedSpringsEnd();
+    void RemoveElementTriangle(ElementIndex triangleIndex);
+
+    void RemoveElementCoarseTriangle(ElementIndex coarseTriangleIndex);
+
+    void UploadElementsEnd();
 
 
     void UploadElementPinnedPointsStart(size_t count);
@@ -326,47 +405,150 @@ public:
 
     /////////////////////////////////////////////////////////////
 
+    /*
+     * The connected components whose bounding boxes are entirely outside of the
+     * visible world are not drawn.
+     *
+     * Springs and triangles are drawn with less detail when the structure of the ship
+     * would be too fine to make out on the canvas.
+     */
     void Render(
         ShipRenderMode renderMode,
-        bool showStressedSprings,
         float ambientLightIntensity,
         float canvasToVisibleWorldHeightRatio,
-        float(&orthoMatrix)[4][4]);
+        float(&orthoMatrix)[4][4],
+        Geometry::AABB const & visibleWorldAABB,
+        std::vector<Geometry::AABB> const & connectedComponentAABBs,
+        RenderStatistics & renderStatistics,
+        bool areRenderStatisticsSynchronous);
 
 private:
 
     struct ConnectedComponentData;
 
+    template<typename TElement>
+    struct ConnectedComponentElements;
+
+    template<typename TElement>
+    struct ElementVBO;
+
+    template<typename TElement>
+    inline TElement * AddElement(
+        ConnectedComponentElements<TElement> ConnectedComponentData::* elements,
+        ElementVBO<TElement> & elementVBO,
+        ElementIndex elementIndex,
+        ConnectedComponentId connectedComponentId)
+    {
+        size_t const connectedComponentIndex = connectedComponentId - 1;
+
+        assert(connectedComponentIndex < mConnectedComponents.size());
+
+        // The elements of the connected components that are not being uploaded are already in place
+        if (!mConnectedComponents[connectedComponentIndex].isBeingUploaded)
+            return nullptr;
+
+        return AppendElement(
+            elements,
+            elementVBO,
+            elementIndex,
+            connectedComponentIndex);
+    }
+
+    template<typename TElement>
+    inline TElement * InsertElement(
+        ConnectedComponentElements<TElement> ConnectedComponentData::* elements,
+        ElementVBO<TElement> & elementVBO,
+        ElementIndex elementIndex,
+        ConnectedComponentId connectedComponentId)
+    {
+        size_t const connectedComponentIndex = connectedComponentId - 1;
+
+        assert(connectedComponentIndex < mConnectedComponents.size());
+
+        // The elements of the connected components that are being uploaded come with the upload
+        if (mConnectedComponents[connectedComponentIndex].isBeingUploaded)
+            return nullptr;
+
+        return AppendElement(
+            elements,
+            elementVBO,
+            elementIndex,
+            connectedComponentIndex);
+    }
+
+    template<typename TElement>
+    inline TElement * AppendElement(
+        ConnectedComponentElements<TElement> ConnectedComponentData::* elements,
+        ElementVBO<TElement> & elementVBO,
+        ElementIndex elementIndex,
+        size_t connectedComponentIndex)
+    {
+        auto & connectedComponentElements = mConnectedComponents[connectedComponentIndex].*elements;
+
+        assert(connectedComponentElements.count + 1u <= connectedComponentElements.maxCount);
+
+        size_t const position = connectedComponentElements.count;
+        connectedComponentElements.elementIndices[position] = elementIndex;
+        ++(connectedComponentElements.count);
+
+        connectedComponentElements.firstDirtyElement = std::min(connectedComponentElements.firstDirtyElement, position);
+
+        // Remember where the element is, for when it gets removed
+        if (elementIndex >= elementVBO.slots.size())
+        {
+            elementVBO.slots.resize(elementIndex + 1, ElementSlot());
+        }
+
+        elementVBO.slots[elementIndex].connectedComponentIndex = connectedComponentIndex;
+        elementVBO.slots[elementIndex].position = position;
+
+        return &(connectedComponentElements.buffer[position]);
+    }
+
+    template<typename TElement>
+    void RemoveElement(
+        ConnectedComponentElements<TElement> ConnectedComponentData::* elements,
+        ElementVBO<TElement> & elementVBO,
+        ElementIndex elementIndex);
+
+    void PrepareConnectedComponentElements(
+        size_t connectedComponentIndex,
+        size_t connectedComponentMaxSize);
+
+    template<typename TElement, size_t VerticesPerElement>
+    void UploadElements(
+        ConnectedComponentElements<TElement> ConnectedComponentData::* elements,
+        ElementVBO<TElement> & elementVBO,
+        GLenum usage);
+
+    template<typename TElement, size_t VerticesPerElement>
+    void PrepareMultiDraw(
+        ConnectedComponentElements<TElement> ConnectedComponentData::* elements,
+        ElementVBO<TElement> & elementVBO);
+
     void RenderPointElements(
-        ConnectedComponentData const & connectedComponent,
         float ambientLightIntensity,
         float canvasToVisibleWorldHeightRatio,
         float(&orthoMatrix)[4][4]);
 
     void RenderSpringElements(
-        ConnectedComponentData const & connectedComponent,
+        bool withCoarseMesh,
         bool withTexture,
         float ambientLightIntensity,
         float canvasToVisibleWorldHeightRatio,
         float(&orthoMatrix)[4][4]);
 
     void RenderRopeElements(
-        ConnectedComponentData const & connectedComponent,
         float ambientLightIntensity,
         float canvasToVisibleWorldHeightRatio,
         float(&orthoMatrix)[4][4]);
 
     void RenderTriangleElements(
-        ConnectedComponentData const & connectedComponent,
+        bool withCoarseMesh,
         bool withTexture,
         float ambientLightIntensity,
         float(&orthoMatrix)[4][4]);
 
-    void RenderStressedSpringElements(
-        ConnectedComponentData const & connectedComponent,
-        float canvasToVisibleWorldHeightRatio,
-        float(&orthoMatrix)[4][4]);
-
     void RenderBombElements(
         ConnectedComponentData const & connectedComponent,
         float ambientLightIntensity,
@@ -383,12 +565,13 @@ private:
     static constexpr GLuint PointPosVertexAttribute = 0;
     static constexpr GLuint PointLightVertexAttribute = 1;
     static constexpr GLuint PointWaterVertexAttribute = 2;
-    static constexpr GLuint PointColorVertexAttribute = 3;
-    static constexpr GLuint PointTextureCoordinatesVertexAttribute = 4;
-    static constexpr GLuint PinnedPointPosVertexAttribute = 5;
-    static constexpr GLuint PinnedPointTextureCoordinatesVertexAttribute = 6;
-    static constexpr GLuint BombPosVertexAttribute = 7;
-    static constexpr GLuint BombTextureCoordinatesVertexAttribute = 8;
+    static constexpr GLuint PointStressVertexAttribute = 3;
+    static constexpr GLuint PointColorVertexAttribute = 4;
+    static constexpr GLuint PointTextureCoordinatesVertexAttribute = 5;
+    static constexpr GLuint PinnedPointPosVertexAttribute = 6;
+    static constexpr GLuint PinnedPointTextureCoordinatesVertexAttribute = 7;
+    static constexpr GLuint BombPosVertexAttribute = 8;
+    static constexpr GLuint BombTextureCoordinatesVertexAttribute = 9;
 
 private:
 
@@ -398,14 +581,14 @@ private:
     
     size_t mPointCount;
 
-    GameOpenGLVBO mPointPositionVBO;
-    GameOpenGLVBO mPointLightVBO;
-    GameOpenGLVBO mPointWaterVBO;
+    // Positions, lights, waters, and stresses, one after the other
+    GameOpenGLStreamingVBO mPointAttributesVBO;
+
     GameOpenGLVBO mPointColorVBO;
     GameOpenGLVBO mPointElementTextureCoordinatesVBO;
     
     //
-    // Elements (points, springs, ropes, triangles, stressed springs, pinned points, bombs)
+    // Elements (points, springs, ropes, triangles, pinned points, bombs)
     //
 
     GameOpenGLShaderProgram mElementColorShaderProgram;
@@ -420,9 +603,6 @@ private:
     GLint mElementTextureShaderOrthoMatrixParameter;
     GLint mElementTextureShaderAmbientLightIntensityParameter;
 
-    GameOpenGLShaderProgram mElementStressedSpringShaderProgram;
-    GLint mElementStressedSpringShaderOrthoMatrixParameter;
-
     GameOpenGLShaderProgram mElementPinnedPointShaderProgram;
     GLint mElementPinnedPointShaderOrthoMatrixParameter;
     GLint mElementPinnedPointShaderAmbientLightIntensityParameter;
@@ -463,14 +643,6 @@ private:
     };
 #pragma pack(pop)
 
-#pragma pack(push)
-    struct StressedSpringElement
-    {
-        int pointIndex1;
-        int pointIndex2;
-    };
-#pragma pack(pop)
-
 #pragma pack(push)
     struct PinnedPointElement
     {
@@ -537,36 +709,71 @@ private:
         {}
     };
 
+    //
+    // The elements of one type that belong to a single connected component, together
+    // with the range of the element VBO that is reserved to them.
+    //
+
+    template<typename TElement>
+    struct ConnectedComponentElements
+    {
+        size_t count;
+        size_t maxCount;
+        std::unique_ptr<TElement[]> buffer;
+
+        // The index of the ship element at each position of the buffer
+        std::unique_ptr<ElementIndex[]> elementIndices;
+
+        // The range of the VBO reserved to this connected component, in elements
+        size_t vboOffset;
+        size_t vboCapacity;
+
+        // The elements from this position onwards have changed since they were last uploaded
+        size_t firstDirtyElement;
+
+        ConnectedComponentElements()
+            : count(0)
+            , maxCount(0)
+            , buffer()
+            , elementIndices()
+            , vboOffset(0)
+            , vboCapacity(0)
+            , firstDirtyElement(0)
+        {}
+
+        void Reset(size_t newMaxCount)
+        {
+            if (maxCount != newMaxCount)
+            {
+                // A change in the max size of this connected component
+                buffer.reset(new TElement[newMaxCount]);
+                elementIndices.reset(new ElementIndex[newMaxCount]);
+                maxCount = newMaxCount;
+            }
+
+            count = 0;
+            firstDirtyElement = 0;
+        }
+    };
+
     //
     // All the data that belongs to a single connected component.
     //
 
     struct ConnectedComponentData
     {
-        size_t pointElementCount;
-        size_t pointElementMaxCount;
-        std::unique_ptr<PointElement[]> pointElementBuffer;
-        GameOpenGLVBO pointElementVBO;
-
-        size_t springElementCount;
-        size_t springElementMaxCount;
-        std::unique_ptr<SpringElement[]> springElementBuffer;
-        GameOpenGLVBO springElementVBO;
-
-        size_t ropeElementCount;
-        size_t ropeElementMaxCount;
-        std::unique_ptr<RopeElement[]> ropeElementBuffer;
-        GameOpenGLVBO ropeElementVBO;
-
-        size_t triangleElementCount;
-        size_t triangleElementMaxCount;
-        std::unique_ptr<TriangleElement[]> triangleElementBuffer;
-        GameOpenGLVBO triangleElementVBO;
-
-        size_t stressedSpringElementCount;
-        size_t stressedSpringElementMaxCount;
-        std::unique_ptr<StressedSpringElement[]> stressedSpringElementBuffer;
-        GameOpenGLVBO stressedSpringElementVBO;
+        ConnectedComponentElements<PointElement> pointElements;
+        ConnectedComponentElements<SpringElement> springElements;
+        ConnectedComponentElements<SpringElement> coarseSpringElements;
+        ConnectedComponentElements<RopeElement> ropeElements;
+        ConnectedComponentElements<TriangleElement> triangleElements;
+        ConnectedComponentElements<TriangleElement> coarseTriangleElements;
+
+        // Whether the elements of this connected component are being uploaded from scratch
+        bool isBeingUploaded;
+
+        // Whether this connected component was within the visible world at the last render
+        bool isVisible;
 
         size_t pinnedPointElementOffset;
         size_t pinnedPointElementCount;
@@ -575,26 +782,14 @@ private:
         std::vector<BombElementInfo> bombElementInfos;
 
         ConnectedComponentData()
-            : pointElementCount(0)
-            , pointElementMaxCount(0)
-            , pointElementBuffer()
-            , pointElementVBO()
-            , springElementCount(0)
-            , springElementMaxCount(0)
-            , springElementBuffer()
-            , springElementVBO()
-            , ropeElementCount(0)
-            , ropeElementMaxCount(0)
-            , ropeElementBuffer()
-            , ropeElementVBO()
-            , triangleElementCount(0)
-            , triangleElementMaxCount(0)
-            , triangleElementBuffer()
-            , triangleElementVBO()
-            , stressedSpringElementCount(0)
-            , stressedSpringElementMaxCount(0)
-            , stressedSpringElementBuffer()
-            , stressedSpringElementVBO()
+            : pointElements()
+            , springElements()
+            , coarseSpringElements()
+            , ropeElements()
+            , triangleElements()
+            , coarseTriangleElements()
+            , isBeingUploaded(false)
+            , isVisible(true)
             , pinnedPointElementOffset(0)
             , pinnedPointElementCount(0)
             , bombElementOffset(0)
@@ -604,6 +799,72 @@ private:
 
     std::vector<ConnectedComponentData> mConnectedComponents;
 
+    //
+    // Element indices, stored globally once across all connected components - each connected
+    // component in its own range - so that each type of element is drawn with a single call,
+    // still in the order of the connected components.
+    //
+    // Ranges are only re-assigned when a connected component outgrows its own, so that
+    // elements may be removed - and connected components rebuilt - by only uploading
+    // the parts of the ranges that have changed.
+    //
+
+    struct ElementMultiDraw
+    {
+        // Number of indices, for each non-empty visible connected component
+        std::vector<GLsizei> counts;
+
+        // Offset of the indices in the VBO, for each non-empty visible connected component
+        std::vector<GLvoid const *> offsets;
+    };
+
+    struct ElementSlot
+    {
+        size_t connectedComponentIndex;
+        size_t position;
+
+        ElementSlot()
+            : connectedComponentIndex(NoneConnectedComponentIndex)
+            , position(0)
+        {}
+    };
+
+    template<typename TElement>
+    struct ElementVBO
+    {
+        GameOpenGLVBO vbo;
+
+        // The size of the VBO, and the end of the ranges reserved so far, in elements
+        size_t vboSize;
+        size_t vboEnd;
+
+        // Where each ship element is, indexed by the element's index
+        std::vector<ElementSlot> slots;
+
+        ElementMultiDraw multiDraw;
+
+        ElementVBO()
+            : vbo()
+            , vboSize(0)
+            , vboEnd(0)
+            , slots()
+            , multiDraw()
+        {}
+    };
+
+    static constexpr size_t NoneConnectedComponentIndex = std::numeric_limits<size_t>::max();
+
+    ElementVBO<PointElement> mPointElementVBO;
+    ElementVBO<SpringElement> mSpringElementVBO;
+    ElementVBO<SpringElement> mCoarseSpringElementVBO;
+    ElementVBO<RopeElement> mRopeElementVBO;
+    ElementVBO<TriangleElement> mTriangleElementVBO;
+    ElementVBO<TriangleElement> mCoarseTriangleElementVBO;
+
+    // Below this number of pixels per world unit - i.e. when points are closer
+    // than this on the canvas - springs and triangles are drawn with less detail
+    static constexpr float CoarseMeshMaxCanvasToVisibleWorldHeightRatio = 2.0f;
+
     //
     // Pinned point data, stored globally once across all connected components.
     //
@@ -623,7 +884,6 @@ private:
     //
 
     GameOpenGLTexture mElementTexture;
-    GameOpenGLTexture mElementStressedSpringTexture;
     GLuint const mElementPinnedPointTexture;
     std::vector<GLuint> const mElementRCBombTextures;
     std::vector<GLuint> const mElementTimerBombTextures;
@@ -0,0 +1,201 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-07
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Buffer.h"
+#include "GameException.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//
+// Snapshots are plain sequences of native-endian values, as they are only
+// ever meant to be read back on the same machine by the same build
+//
+
+class SnapshotWriter
+{
+public:
+
+    template<typename T>
+    void Write(T const & value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value);
+
+        Write(&value, sizeof(T));
+    }
+
+    void Write(
+        void const * data,
+        size_t size)
+    {
+        unsigned char const * bytes = static_cast<unsigned char const *>(data);
+        mBuffer.insert(mBuffer.end(), bytes, bytes + size);
+    }
+
+    void Write(std::string const & value)
+    {
+        Write<uint32_t>(static_cast<uint32_t>(value.size()));
+        Write(value.data(), value.size());
+    }
+
+    template<typename T>
+    void WriteOptional(std::optional<T> const & value)
+    {
+        Write<uint8_t>(!!value ? 1 : 0);
+        if (!!value)
+        {
+            Write(*value);
+        }
+    }
+
+    /*
+     * Writes the first count elements of the buffer with a single copy.
+     */
+    template<typename TElement>
+    void WriteBuffer(
+        Buffer<TElement> const & buffer,
+        size_t count)
+    {
+        static_assert(std::is_trivially_copyable<TElement>::value);
+
+        Write(buffer.data(), count * sizeof(TElement));
+    }
+
+    std::vector<unsigned char> const & GetBuffer() const
+    {
+        return mBuffer;
+    }
+
+    void SaveToFile(std::filesystem::path const & filePath) const
+    {
+        std::ofstream file(filePath.string(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            throw GameException("Cannot create file \"" + filePath.string() + "\"");
+        }
+
+        file.write(reinterpret_cast<char const *>(mBuffer.data()), mBuffer.size());
+        if (!file)
+        {
+            throw GameException("Cannot write file \"" + filePath.string() + "\"");
+        }
+    }
+
+private:
+
+    std::vector<unsigned char> mBuffer;
+};
+
+class SnapshotReader
+{
+public:
+
+    explicit SnapshotReader(std::vector<unsigned char> buffer)
+        : mBuffer(std::move(buffer))
+        , mPosition(0)
+    {
+    }
+
+    /*
+     * Reads the whole file at once, so that it may be decoded from memory.
+     */
+    static SnapshotReader FromFile(std::filesystem::path const & filePath)
+    {
+        std::ifstream file(filePath.string(), std::ios::in | std::ios::binary);
+        if (!file.is_open())
+        {
+            throw GameException("Cannot open file \"" + filePath.string() + "\"");
+        }
+
+        return SnapshotReader(
+            std::vector<unsigned char>(
+                std::istreambuf_iterator<char>(file),
+                std::istreambuf_iterator<char>()));
+    }
+
+    template<typename T>
+    T Read()
+    {
+        static_assert(std::is_trivially_copyable<T>::value);
+
+        T value;
+        Read(&value, sizeof(T));
+        return value;
+    }
+
+    void Read(
+        void * data,
+        size_t size)
+    {
+        std::memcpy(data, ReadBytes(size), size);
+    }
+
+    std::string ReadString()
+    {
+        std::string value(Read<uint32_t>(), '\0');
+        Read(&(value[0]), value.size());
+        return value;
+    }
+
+    template<typename T>
+    std::optional<T> ReadOptional()
+    {
+        if (0 != Read<uint8_t>())
+        {
+            return Read<T>();
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+
+    /*
+     * Appends count elements to the buffer with a single copy.
+     */
+    template<typename TElement>
+    void ReadBuffer(
+        Buffer<TElement> & buffer,
+        size_t count)
+    {
+        buffer.append_bitwise(
+            ReadBytes(count * sizeof(TElement)),
+            count);
+    }
+
+    /*
+     * Returns the next bytes in place, skipping them.
+     */
+    unsigned char const * ReadBytes(size_t size)
+    {
+        if (size > mBuffer.size() - mPosition)
+        {
+            throw GameException("Unexpected end of file");
+        }
+
+        unsigned char const * bytes = mBuffer.data() + mPosition;
+        mPosition += size;
+
+        return bytes;
+    }
+
+    bool IsAtEnd() const
+    {
+        return mPosition == mBuffer.size();
+    }
+
+private:
+
+    std::vector<unsigned char> mBuffer;
+    size_t mPosition;
+};
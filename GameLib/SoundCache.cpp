@@ -0,0 +1,112 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-16
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "SoundCache.h"
+
+#include "GameException.h"
+#include "Log.h"
+
+#include <array>
+#include <cstring>
+
+namespace /* anonymous */ {
+
+    // Bump whenever the layout of the entry files changes
+    static constexpr uint32_t FormatVersion = 1;
+
+    static constexpr std::array<char, 4> Magic = { 'S', 'S', 'D', 'S' };
+
+    /*
+     * The header of an entry file; the samples follow right after it.
+     */
+    struct EntryHeader
+    {
+        std::array<char, 4> Magic;
+        uint32_t FormatVersion;
+        uint64_t Key;
+        uint32_t ChannelCount;
+        uint32_t SampleRate;
+        uint64_t SampleCount;
+    };
+
+    static_assert(sizeof(EntryHeader) == 32);
+    static_assert(sizeof(EntryHeader) % alignof(int16_t) == 0);
+}
+
+uint64_t SoundCache::CalculateKey(std::filesystem::path const & soundFilePath)
+{
+    return CacheDirectory::HashFileStamp(CacheDirectory::InitialKey, soundFilePath);
+}
+
+std::optional<DecodedSound> SoundCache::TryLoad(uint64_t key) const
+{
+    try
+    {
+        std::optional<MemoryMappedFile> mappedFile = mCacheDirectory.MapEntryFile(key);
+        if (!mappedFile)
+        {
+            return std::nullopt;
+        }
+
+        if (mappedFile->GetSize() < sizeof(EntryHeader))
+        {
+            throw GameException("Truncated header");
+        }
+
+        EntryHeader header;
+        std::memcpy(&header, mappedFile->GetData(), sizeof(EntryHeader));
+
+        if (header.Magic != Magic
+            || header.FormatVersion != FormatVersion
+            || header.Key != key)
+        {
+            throw GameException("Not a decoded sound of this version");
+        }
+
+        if (mappedFile->GetSize() != sizeof(EntryHeader) + header.SampleCount * sizeof(int16_t))
+        {
+            throw GameException("Unexpected size");
+        }
+
+        return DecodedSound(
+            std::move(*mappedFile),
+            sizeof(EntryHeader),
+            static_cast<size_t>(header.SampleCount),
+            header.ChannelCount,
+            header.SampleRate);
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("Ignoring decoded sound \"", mCacheDirectory.GetEntryFilePath(key).string(), "\": ", ex.what());
+        return std::nullopt;
+    }
+}
+
+void SoundCache::Store(
+    uint64_t key,
+    DecodedSound const & decodedSound) const
+{
+    EntryHeader header;
+    header.Magic = Magic;
+    header.FormatVersion = FormatVersion;
+    header.Key = key;
+    header.ChannelCount = decodedSound.GetChannelCount();
+    header.SampleRate = decodedSound.GetSampleRate();
+    header.SampleCount = decodedSound.GetSampleCount();
+
+    try
+    {
+        mCacheDirectory.WriteEntryFile(
+            key,
+            {
+                { &header, sizeof(EntryHeader) },
+                { decodedSound.GetSamples(), decodedSound.GetSampleCount() * sizeof(int16_t) }
+            });
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("Cannot store decoded sound \"", mCacheDirectory.GetEntryFilePath(key).string(), "\": ", ex.what());
+    }
+}
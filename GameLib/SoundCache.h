@@ -0,0 +1,118 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-16
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "CacheDirectory.h"
+#include "MemoryMappedFile.h"
+#include "SysSpecifics.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+/*
+ * The 16-bit PCM samples of a sound, interleaved by channel.
+ *
+ * The samples live either in memory, or in a memory-mapped file.
+ */
+class DecodedSound
+{
+public:
+
+    DecodedSound(
+        std::vector<int16_t> samples,
+        unsigned int channelCount,
+        unsigned int sampleRate)
+        : mSamples(std::move(samples))
+        , mMappedFile()
+        , mSampleData(mSamples.data())
+        , mSampleCount(mSamples.size())
+        , mChannelCount(channelCount)
+        , mSampleRate(sampleRate)
+    {
+    }
+
+    DecodedSound(
+        MemoryMappedFile mappedFile,
+        size_t samplesOffset,
+        size_t sampleCount,
+        unsigned int channelCount,
+        unsigned int sampleRate)
+        : mSamples()
+        , mMappedFile(std::move(mappedFile))
+        , mSampleData(reinterpret_cast<int16_t const *>(mMappedFile->GetData() + samplesOffset))
+        , mSampleCount(sampleCount)
+        , mChannelCount(channelCount)
+        , mSampleRate(sampleRate)
+    {
+    }
+
+    int16_t const * GetSamples() const
+    {
+        return mSampleData;
+    }
+
+    // Across all channels
+    size_t GetSampleCount() const
+    {
+        return mSampleCount;
+    }
+
+    unsigned int GetChannelCount() const
+    {
+        return mChannelCount;
+    }
+
+    unsigned int GetSampleRate() const
+    {
+        return mSampleRate;
+    }
+
+private:
+
+    // Moving either keeps the samples where they are
+    std::vector<int16_t> mSamples;
+    std::optional<MemoryMappedFile> mMappedFile;
+
+    int16_t const * mSampleData;
+    size_t mSampleCount;
+    unsigned int mChannelCount;
+    unsigned int mSampleRate;
+};
+
+/*
+ * This class maintains a directory of decoded sounds, so that sounds don't need to be
+ * decoded again at each launch; cached sounds are memory-mapped when loaded.
+ *
+ * Decoded sounds are keyed by the name, size, and last modification time of their sound
+ * file; unlike compiled ships, they are not keyed by the contents of their files, as reading
+ * those would take a good part of the time we're trying to save.
+ *
+ * The cache is best-effort: failures to store or to load decoded sounds are logged and
+ * otherwise ignored. Its methods may be invoked concurrently.
+ */
+class SoundCache
+{
+public:
+
+    explicit SoundCache(std::filesystem::path cacheDirectoryPath)
+        : mCacheDirectory(std::move(cacheDirectoryPath), ".sds")
+    {
+    }
+
+    static uint64_t CalculateKey(std::filesystem::path const & soundFilePath);
+
+    std::optional<DecodedSound> TryLoad(uint64_t key) const;
+
+    void Store(
+        uint64_t key,
+        DecodedSound const & decodedSound) const;
+
+private:
+
+    CacheDirectory const mCacheDirectory;
+};
@@ -5,6 +5,9 @@
 ***************************************************************************************/
 #include "Physics.h"
 
+#include "GameException.h"
+
+#include <array>
 #include <cmath>
 
 namespace Physics {
@@ -37,7 +40,7 @@ void Springs::Add(
 void Springs::Destroy(
     ElementIndex springElementIndex,
     DestroyOptions destroyOptions,
-    Points const & points)
+    Points & points)
 {
     assert(springElementIndex < mElementCount);
     assert(!IsDeleted(springElementIndex));
@@ -70,6 +73,14 @@ void Springs::Destroy(
     // avoid draining water to destroyed points
     mWaterPermeabilityBuffer[springElementIndex] = 0.0f;
 
+    // Release our stress from our endpoints
+    if (mIsStressedBuffer[springElementIndex])
+    {
+        points.GetStress(GetPointAIndex(springElementIndex)) -= 1.0f;
+        points.GetStress(GetPointBIndex(springElementIndex)) -= 1.0f;
+        mIsStressedBuffer[springElementIndex] = false;
+    }
+
     // Flag ourselves as deleted
     mIsDeletedBuffer[springElementIndex] = true;
 }
@@ -101,7 +112,7 @@ void Springs::SetStiffnessAdjustment(
 
 void Springs::UploadElements(
     int shipId,
-    RenderContext & renderContext,
+    IRenderBackend & renderContext,
     Points const & points) const
 {
     for (ElementIndex i : *this)
@@ -114,6 +125,7 @@ void Springs::UploadElements(
             {
                 renderContext.UploadShipElementRope(
                     shipId,
+                    i,
                     GetPointAIndex(i),
                     GetPointBIndex(i),
                     points.GetConnectedComponentId(GetPointAIndex(i)));
@@ -122,31 +134,10 @@ void Springs::UploadElements(
             {
                 renderContext.UploadShipElementSpring(
                     shipId,
+                    i,
                     GetPointAIndex(i),
                     GetPointBIndex(i),
-                    points.GetConnectedComponentId(GetPointAIndex(i)));
-            }
-        }
-    }
-}
-
-void Springs::UploadStressedSpringElements(
-    int shipId,
-    RenderContext & renderContext,
-    Points const & points) const
-{
-    for (ElementIndex i : *this)
-    {
-        if (!mIsDeletedBuffer[i])
-        {
-            if (mIsStressedBuffer[i])
-            {
-                assert(points.GetConnectedComponentId(GetPointAIndex(i)) == points.GetConnectedComponentId(GetPointBIndex(i)));
-                
-                renderContext.UploadShipElementStressedSpring(
-                    shipId,
-                    GetPointAIndex(i),
-                    GetPointBIndex(i),
+                    IsCoarse(i),
                     points.GetConnectedComponentId(GetPointAIndex(i)));
             }
         }
@@ -190,6 +181,10 @@ bool Springs::UpdateStrains(
                 {
                     mIsStressedBuffer[i] = true;
 
+                    // Tell the endpoints
+                    points.GetStress(mEndpointsBuffer[i].PointAIndex) += 1.0f;
+                    points.GetStress(mEndpointsBuffer[i].PointBIndex) += 1.0f;
+
                     // Notify stress
                     mGameEventHandler->OnStress(
                         mMaterialBuffer[i],
@@ -200,7 +195,14 @@ bool Springs::UpdateStrains(
             else
             {
                 // Just fine
-                mIsStressedBuffer[i] = false;
+                if (mIsStressedBuffer[i])
+                {
+                    mIsStressedBuffer[i] = false;
+
+                    // Tell the endpoints
+                    points.GetStress(mEndpointsBuffer[i].PointAIndex) -= 1.0f;
+                    points.GetStress(mEndpointsBuffer[i].PointBIndex) -= 1.0f;
+                }
             }
         }
     }
@@ -208,6 +210,67 @@ bool Springs::UpdateStrains(
     return isAtLeastOneBroken;
 }
 
+void Springs::WriteSnapshot(SnapshotWriter & writer) const
+{
+    writer.WriteBuffer(mIsDeletedBuffer, mElementCount);
+    writer.WriteBuffer(mEndpointsBuffer, mElementCount);
+
+    writer.WriteBuffer(mRestLengthBuffer, mElementCount);
+    writer.WriteBuffer(mCoefficientsBuffer, mElementCount);
+    writer.WriteBuffer(mCharacteristicsBuffer, mElementCount);
+
+    // Materials are stored by their structural colour
+    for (ElementIndex i : *this)
+    {
+        writer.Write(mMaterialBuffer[i]->StructuralColourRgb);
+    }
+
+    writer.WriteBuffer(mWaterPermeabilityBuffer, mElementCount);
+    writer.WriteBuffer(mIsStressedBuffer, mElementCount);
+    writer.WriteBuffer(mIsBombAttachedBuffer, mElementCount);
+
+    writer.Write(mCurrentStiffnessAdjustment);
+}
+
+void Springs::ReadSnapshot(
+    SnapshotReader & reader,
+    ElementCount pointCount,
+    MaterialDatabase const & materials)
+{
+    reader.ReadBuffer(mIsDeletedBuffer, mElementCount);
+    reader.ReadBuffer(mEndpointsBuffer, mElementCount);
+
+    for (ElementIndex i = 0; i < mElementCount; ++i)
+    {
+        if (mEndpointsBuffer[i].PointAIndex >= pointCount
+            || mEndpointsBuffer[i].PointBIndex >= pointCount)
+        {
+            throw GameException("Spring endpoint out of range");
+        }
+    }
+
+    reader.ReadBuffer(mRestLengthBuffer, mElementCount);
+    reader.ReadBuffer(mCoefficientsBuffer, mElementCount);
+    reader.ReadBuffer(mCharacteristicsBuffer, mElementCount);
+
+    for (ElementIndex i = 0; i < mElementCount; ++i)
+    {
+        Material const * material = materials.Get(reader.Read<std::array<uint8_t, 3u>>());
+        if (nullptr == material)
+        {
+            throw GameException("Unknown material");
+        }
+
+        mMaterialBuffer.emplace_back(material);
+    }
+
+    reader.ReadBuffer(mWaterPermeabilityBuffer, mElementCount);
+    reader.ReadBuffer(mIsStressedBuffer, mElementCount);
+    reader.ReadBuffer(mIsBombAttachedBuffer, mElementCount);
+
+    mCurrentStiffnessAdjustment = reader.Read<float>();
+}
+
 float Springs::CalculateStiffnessCoefficient(    
     ElementIndex pointAIndex,
     ElementIndex pointBIndex,
@@ -9,10 +9,12 @@
 #include "ElementContainer.h"
 #include "EnumFlags.h"
 #include "FixedSizeVector.h"
+#include "GameEventDispatcher.h"
 #include "GameParameters.h"
-#include "IGameEventHandler.h"
+#include "IRenderBackend.h"
 #include "Material.h"
-#include "RenderContext.h"
+#include "MaterialDatabase.h"
+#include "Snapshot.h"
 
 #include <cassert>
 #include <functional>
@@ -38,7 +40,8 @@ public:
     {
         None = 0,
         Hull = 1,    // Does not take water
-        Rope = 2     // Ropes are drawn differently
+        Rope = 2,    // Ropes are drawn differently
+        Coarse = 4   // Also drawn when the ship is drawn with less detail
     };
 
     using DestroyHandler = std::function<void(ElementIndex, bool)>;
@@ -82,7 +85,7 @@ public:
     Springs(
         ElementCount elementCount,
         World & parentWorld,
-        std::shared_ptr<IGameEventHandler> gameEventHandler)
+        std::shared_ptr<GameEventDispatcher> gameEventHandler)
         : ElementContainer(elementCount)
         //////////////////////////////////
         // Buffers
@@ -141,7 +144,7 @@ public:
     void Destroy(
         ElementIndex springElementIndex,
         DestroyOptions destroyOptions,
-        Points const & points);
+        Points & points);
 
     void SetStiffnessAdjustment(
         float stiffnessAdjustment,
@@ -163,12 +166,7 @@ public:
 
     void UploadElements(
         int shipId,
-        RenderContext & renderContext,
-        Points const & points) const;
-
-    void UploadStressedSpringElements(
-        int shipId,
-        RenderContext & renderContext,
+        IRenderBackend & renderContext,
         Points const & points) const;
 
     /*
@@ -180,6 +178,22 @@ public:
         GameParameters const & gameParameters,
         Points & points);
 
+    /*
+     * Writes the state of all springs to a snapshot.
+     */
+    void WriteSnapshot(SnapshotWriter & writer) const;
+
+    /*
+     * Reads the state of all springs from a snapshot; only valid on a container that
+     * has just been constructed with the snapshot's number of springs.
+     *
+     * Throws if an endpoint is not one of the specified number of points.
+     */
+    void ReadSnapshot(
+        SnapshotReader & reader,
+        ElementCount pointCount,
+        MaterialDatabase const & materials);
+
 public:
 
     //
@@ -273,6 +287,7 @@ public:
 
     inline bool IsHull(ElementIndex springElementIndex) const;
     inline bool IsRope(ElementIndex springElementIndex) const;
+    inline bool IsCoarse(ElementIndex springElementIndex) const;
 
     //
     // Water characteristics
@@ -394,7 +409,7 @@ private:
     //////////////////////////////////////////////////////////
 
     World & mParentWorld;
-    std::shared_ptr<IGameEventHandler> const mGameEventHandler;
+    std::shared_ptr<GameEventDispatcher> const mGameEventHandler;
 
     // The handler registered for spring deletions
     DestroyHandler mDestroyHandler;
@@ -421,3 +436,10 @@ inline bool Physics::Springs::IsRope(ElementIndex springElementIndex) const
 
     return !!(mCharacteristicsBuffer[springElementIndex] & Physics::Springs::Characteristics::Rope);
 }
+
+inline bool Physics::Springs::IsCoarse(ElementIndex springElementIndex) const
+{
+    assert(springElementIndex < mElementCount);
+
+    return !!(mCharacteristicsBuffer[springElementIndex] & Physics::Springs::Characteristics::Coarse);
+}
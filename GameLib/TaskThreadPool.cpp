@@ -0,0 +1,128 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-16
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "TaskThreadPool.h"
+
+#include "Log.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <cassert>
+
+TaskThreadPool::TaskThreadPool(size_t threadCount)
+    : mThreads()
+    , mMutex()
+    , mTaskAvailableCondition()
+    , mIdleCondition()
+    , mTasks()
+    , mRunningTaskCount(0)
+    , mIsStopping(false)
+{
+    assert(threadCount > 0);
+
+    mThreads.reserve(threadCount);
+    for (size_t t = 0; t < threadCount; ++t)
+    {
+        mThreads.emplace_back(&TaskThreadPool::RunWorker, this);
+    }
+}
+
+TaskThreadPool::~TaskThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mTasks.clear();
+        mIsStopping = true;
+    }
+
+    mTaskAvailableCondition.notify_all();
+
+    for (auto & thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+size_t TaskThreadPool::GetDefaultThreadCount()
+{
+    // May be zero when unknown
+    size_t const hardwareThreadCount = static_cast<size_t>(std::thread::hardware_concurrency());
+
+    return std::max(hardwareThreadCount, size_t(2)) - 1;
+}
+
+void TaskThreadPool::Submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mTasks.push_back(std::move(task));
+    }
+
+    mTaskAvailableCondition.notify_one();
+}
+
+void TaskThreadPool::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    mIdleCondition.wait(
+        lock,
+        [this]()
+        {
+            return mTasks.empty() && 0 == mRunningTaskCount;
+        });
+}
+
+void TaskThreadPool::RunWorker()
+{
+    Tracer::Instance.SetThreadName("Task Pool");
+
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    while (true)
+    {
+        mTaskAvailableCondition.wait(
+            lock,
+            [this]()
+            {
+                return mIsStopping || !mTasks.empty();
+            });
+
+        if (mIsStopping)
+            break;
+
+        std::function<void()> task = std::move(mTasks.front());
+        mTasks.pop_front();
+        ++mRunningTaskCount;
+
+        lock.unlock();
+
+        try
+        {
+            task();
+        }
+        catch (std::exception const & ex)
+        {
+            LogMessage("Task failed: ", ex.what());
+        }
+        catch (...)
+        {
+            LogMessage("Task failed");
+        }
+
+        // Release whatever the task holds before declaring it done
+        task = nullptr;
+
+        lock.lock();
+
+        --mRunningTaskCount;
+        if (mTasks.empty() && 0 == mRunningTaskCount)
+        {
+            mIdleCondition.notify_all();
+        }
+    }
+}
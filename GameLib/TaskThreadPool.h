@@ -0,0 +1,147 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-16
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * A fixed set of worker threads running tasks in the order in which they are submitted.
+ *
+ * Tasks are not expected to throw; exceptions escaping a task are logged and swallowed.
+ */
+class TaskThreadPool
+{
+public:
+
+    explicit TaskThreadPool(size_t threadCount);
+
+    /*
+     * Discards the tasks that have not started yet, and waits for the running ones.
+     */
+    ~TaskThreadPool();
+
+    TaskThreadPool(TaskThreadPool const &) = delete;
+    TaskThreadPool & operator=(TaskThreadPool const &) = delete;
+
+    /*
+     * One thread per hardware thread, leaving one to the main thread.
+     */
+    static size_t GetDefaultThreadCount();
+
+    size_t GetThreadCount() const
+    {
+        return mThreads.size();
+    }
+
+    void Submit(std::function<void()> task);
+
+    /*
+     * Waits until all submitted tasks have completed.
+     */
+    void WaitIdle();
+
+private:
+
+    void RunWorker();
+
+private:
+
+    std::vector<std::thread> mThreads;
+
+    std::mutex mMutex;
+    std::condition_variable mTaskAvailableCondition;
+    std::condition_variable mIdleCondition;
+
+    std::deque<std::function<void()>> mTasks;
+    size_t mRunningTaskCount;
+    bool mIsStopping;
+};
+
+/*
+ * A task that runs at most once, either on a pool - ahead of time - or on the first thread
+ * that needs its result, whichever comes first.
+ *
+ * When the result is needed while the task is running elsewhere, the caller waits for it.
+ */
+template<typename TResult>
+class OnDemandTask
+{
+public:
+
+    explicit OnDemandTask(std::function<TResult()> function)
+        : mFunction(std::move(function))
+        , mIsClaimed(false)
+        , mPromise()
+        , mResult(mPromise.get_future().share())
+    {
+    }
+
+    /*
+     * Runs the task on the calling thread, unless it has already been run or is running.
+     */
+    void Run()
+    {
+        if (mIsClaimed.exchange(true))
+            return;
+
+        try
+        {
+            mPromise.set_value(mFunction());
+        }
+        catch (...)
+        {
+            mPromise.set_exception(std::current_exception());
+        }
+    }
+
+    /*
+     * Returns the result, running the task first if nobody has done so yet; rethrows
+     * whatever the task threw.
+     */
+    TResult const & Get()
+    {
+        Run();
+
+        return mResult.get();
+    }
+
+    bool IsDone() const
+    {
+        return std::future_status::ready == mResult.wait_for(std::chrono::seconds(0));
+    }
+
+    /*
+     * Queues the task on the pool, so that it's likely done by the time it's needed.
+     */
+    static void Prefetch(
+        std::shared_ptr<OnDemandTask> const & task,
+        TaskThreadPool & taskThreadPool)
+    {
+        taskThreadPool.Submit(
+            [task]()
+            {
+                task->Run();
+            });
+    }
+
+private:
+
+    std::function<TResult()> const mFunction;
+    std::atomic<bool> mIsClaimed;
+    std::promise<TResult> mPromise;
+    std::shared_future<TResult> const mResult;
+};
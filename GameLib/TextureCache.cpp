@@ -0,0 +1,133 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "TextureCache.h"
+
+#include "GameException.h"
+#include "Log.h"
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+namespace /* anonymous */ {
+
+    // Bump whenever the layout of the entry files changes
+    static constexpr uint32_t FormatVersion = 1;
+
+    static constexpr std::array<char, 4> Magic = { 'S', 'S', 'D', 'T' };
+
+    /*
+     * The header of an entry file; the levels follow right after it, from the base
+     * level down.
+     */
+    struct EntryHeader
+    {
+        std::array<char, 4> Magic;
+        uint32_t FormatVersion;
+        uint64_t Key;
+        int32_t Width;
+        int32_t Height;
+        uint32_t LevelCount;
+        uint32_t Padding;
+    };
+
+    static_assert(sizeof(EntryHeader) == 32);
+}
+
+uint64_t TextureCache::CalculateKey(
+    std::filesystem::path const & imageFilePath,
+    bool withMipmaps)
+{
+    uint64_t key = CacheDirectory::HashFileStamp(CacheDirectory::InitialKey, imageFilePath);
+
+    uint8_t const hasMipmaps = withMipmaps ? 1 : 0;
+    key = CacheDirectory::HashKey(key, hasMipmaps);
+
+    return key;
+}
+
+std::optional<DecodedTexture> TextureCache::TryLoad(uint64_t key) const
+{
+    try
+    {
+        std::optional<MemoryMappedFile> mappedFile = mCacheDirectory.MapEntryFile(key);
+        if (!mappedFile)
+        {
+            return std::nullopt;
+        }
+
+        if (mappedFile->GetSize() < sizeof(EntryHeader))
+        {
+            throw GameException("Truncated header");
+        }
+
+        EntryHeader header;
+        std::memcpy(&header, mappedFile->GetData(), sizeof(EntryHeader));
+
+        if (header.Magic != Magic
+            || header.FormatVersion != FormatVersion
+            || header.Key != key)
+        {
+            throw GameException("Not a decoded texture of this version");
+        }
+
+        ImageSize const size(header.Width, header.Height);
+        if (size.Width <= 0 || size.Height <= 0
+            || header.LevelCount == 0 || header.LevelCount > DecodedTexture::CalculateMipmapLevelCount(size))
+        {
+            throw GameException("Invalid texture size");
+        }
+
+        if (mappedFile->GetSize() != sizeof(EntryHeader) + DecodedTexture::CalculateDataSize(size, header.LevelCount))
+        {
+            throw GameException("Unexpected size");
+        }
+
+        return DecodedTexture(
+            std::move(*mappedFile),
+            sizeof(EntryHeader),
+            size,
+            header.LevelCount);
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("Ignoring decoded texture \"", mCacheDirectory.GetEntryFilePath(key).string(), "\": ", ex.what());
+        return std::nullopt;
+    }
+}
+
+void TextureCache::Store(
+    uint64_t key,
+    DecodedTexture const & decodedTexture) const
+{
+    EntryHeader header;
+    header.Magic = Magic;
+    header.FormatVersion = FormatVersion;
+    header.Key = key;
+    header.Width = decodedTexture.GetSize().Width;
+    header.Height = decodedTexture.GetSize().Height;
+    header.LevelCount = static_cast<uint32_t>(decodedTexture.GetLevelCount());
+    header.Padding = 0;
+
+    std::vector<CacheDirectory::Chunk> chunks;
+    chunks.emplace_back(&header, sizeof(EntryHeader));
+    for (size_t l = 0; l < decodedTexture.GetLevelCount(); ++l)
+    {
+        ImageSize const levelSize = decodedTexture.GetLevelSize(l);
+        chunks.emplace_back(
+            decodedTexture.GetLevelData(l),
+            static_cast<size_t>(levelSize.Width) * static_cast<size_t>(levelSize.Height) * 4);
+    }
+
+    try
+    {
+        mCacheDirectory.WriteEntryFile(key, chunks);
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("Cannot store decoded texture \"", mCacheDirectory.GetEntryFilePath(key).string(), "\": ", ex.what());
+    }
+}
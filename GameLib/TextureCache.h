@@ -0,0 +1,49 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-17
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "CacheDirectory.h"
+#include "DecodedTexture.h"
+#include "SysSpecifics.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+/*
+ * This class maintains a directory of decoded textures, together with their mipmaps when
+ * they have any, so that textures don't need to be decoded again at each launch; cached
+ * textures are memory-mapped when loaded.
+ *
+ * Decoded textures are keyed by the name, size, and last modification time of their image
+ * file, and by whether they have mipmaps.
+ *
+ * The cache is best-effort: failures to store or to load decoded textures are logged and
+ * otherwise ignored. Its methods may be invoked concurrently.
+ */
+class TextureCache
+{
+public:
+
+    explicit TextureCache(std::filesystem::path cacheDirectoryPath)
+        : mCacheDirectory(std::move(cacheDirectoryPath), ".sdt")
+    {
+    }
+
+    static uint64_t CalculateKey(
+        std::filesystem::path const & imageFilePath,
+        bool withMipmaps);
+
+    std::optional<DecodedTexture> TryLoad(uint64_t key) const;
+
+    void Store(
+        uint64_t key,
+        DecodedTexture const & decodedTexture) const;
+
+private:
+
+    CacheDirectory const mCacheDirectory;
+};
@@ -7,16 +7,19 @@
 
 #include "GameRandomEngine.h"
 
+#include <algorithm>
+
 namespace Physics {
 
 TimerBomb::TimerBomb(
     ObjectId id,
     ElementIndex springIndex,
     World & parentWorld,
-    std::shared_ptr<IGameEventHandler> gameEventHandler,
+    std::shared_ptr<GameEventDispatcher> gameEventHandler,
     BlastHandler blastHandler,
     Points & shipPoints,
-    Springs & shipSprings)
+    Springs & shipSprings,
+    GameParameters const & gameParameters)
     : Bomb(
         id,
         BombType::TimerBomb,
@@ -27,7 +30,7 @@ TimerBomb::TimerBomb(
         shipPoints,
         shipSprings)
     , mState(State::SlowFuseBurning)
-    , mNextStateTransitionTimePoint(GameWallClock::GetInstance().Now() + SlowFuseToDetonationLeadInInterval / FuseStepCount)
+    , mNextStateTransitionTimePoint(parentWorld.GetCurrentClockTime() + CalculateSlowFuseStepInterval(gameParameters))
     , mFuseFlameFrameIndex(0)
     , mFuseStepCounter(0)
     , mExplodingStepCounter(0)
@@ -40,6 +43,52 @@ TimerBomb::TimerBomb(
         false);
 }
 
+TimerBomb::TimerBomb(
+    ObjectId id,
+    SnapshotReader & reader,
+    GameWallClock::time_point now,
+    World & parentWorld,
+    std::shared_ptr<GameEventDispatcher> gameEventHandler,
+    BlastHandler blastHandler,
+    Points & shipPoints,
+    Springs & shipSprings)
+    : Bomb(
+        id,
+        BombType::TimerBomb,
+        reader,
+        parentWorld,
+        std::move(gameEventHandler),
+        blastHandler,
+        shipPoints,
+        shipSprings)
+    // Read in declaration order
+    , mState(static_cast<State>(reader.Read<uint8_t>()))
+    , mNextStateTransitionTimePoint(FromSnapshotTime(reader.Read<int64_t>(), now))
+    , mFuseFlameFrameIndex(reader.Read<uint32_t>())
+    , mFuseStepCounter(reader.Read<uint8_t>())
+    , mExplodingStepCounter(reader.Read<uint8_t>())
+    , mDefuseStepCounter(reader.Read<uint8_t>())
+    , mDetonationLeadInShapeFrameCounter(reader.Read<uint8_t>())
+{
+    if (mState > State::Expired
+        || mFuseStepCounter >= FuseStepCount
+        || mFuseFlameFrameIndex > FuseStepCount
+        || mExplodingStepCounter >= ExplosionStepsCount
+        || mDefuseStepCounter >= DefuseStepsCount)
+    {
+        throw GameException("Invalid timer bomb state");
+    }
+
+    // Resume fuse, if it's burning
+    if (State::SlowFuseBurning == mState
+        || State::FastFuseBurning == mState)
+    {
+        mGameEventHandler->OnTimerBombFuse(
+            mId,
+            State::FastFuseBurning == mState);
+    }
+}
+
 bool TimerBomb::Update(
     GameWallClock::time_point now,
     GameParameters const & gameParameters)
@@ -79,7 +128,7 @@ bool TimerBomb::Update(
                     mGameEventHandler->OnTimerBombFuse(mId, std::nullopt);
 
                     // Schedule next transition
-                    mNextStateTransitionTimePoint = now + DetonationLeadInToExplosionInterval;
+                    mNextStateTransitionTimePoint += DetonationLeadInToExplosionInterval;
                 }
                 else
                 {
@@ -88,9 +137,9 @@ bool TimerBomb::Update(
 
                     // Schedule next transition
                     if (State::SlowFuseBurning == mState)
-                        mNextStateTransitionTimePoint = now + SlowFuseToDetonationLeadInInterval / FuseStepCount;
+                        mNextStateTransitionTimePoint += CalculateSlowFuseStepInterval(gameParameters);
                     else
-                        mNextStateTransitionTimePoint = now + FastFuseToDetonationLeadInInterval / FuseStepCount;
+                        mNextStateTransitionTimePoint += FastFuseToDetonationLeadInInterval / FuseStepCount;
                 }
             }
 
@@ -204,6 +253,15 @@ bool TimerBomb::Update(
     }
 }
 
+GameWallClock::duration TimerBomb::CalculateSlowFuseStepInterval(GameParameters const & gameParameters)
+{
+    auto const slowFuseInterval = std::max(
+        std::chrono::duration_cast<GameWallClock::duration>(gameParameters.TimerBombInterval - DetonationLeadInToExplosionInterval),
+        GameWallClock::duration::zero());
+
+    return slowFuseInterval / FuseStepCount;
+}
+
 void TimerBomb::OnNeighborhoodDisturbed()
 {
     if (State::SlowFuseBurning == mState
@@ -228,14 +286,14 @@ void TimerBomb::OnNeighborhoodDisturbed()
             true);
 
         // Schedule next transition
-        mNextStateTransitionTimePoint = GameWallClock::GetInstance().Now() 
+        mNextStateTransitionTimePoint = mParentWorld.GetCurrentClockTime()
             + FastFuseToDetonationLeadInInterval / FuseStepCount;
     }
 }
 
 void TimerBomb::Upload(
     int shipId,
-    RenderContext & renderContext) const
+    IRenderBackend & renderContext) const
 {
     switch (mState)
     {
@@ -341,4 +399,19 @@ void TimerBomb::Upload(
     }
 }
 
+void TimerBomb::WriteSnapshot(
+    SnapshotWriter & writer,
+    GameWallClock::time_point now) const
+{
+    WriteBaseSnapshot(writer);
+
+    writer.Write<uint8_t>(static_cast<uint8_t>(mState));
+    writer.Write<int64_t>(ToSnapshotTime(mNextStateTransitionTimePoint, now));
+    writer.Write(mFuseFlameFrameIndex);
+    writer.Write(mFuseStepCounter);
+    writer.Write(mExplodingStepCounter);
+    writer.Write(mDefuseStepCounter);
+    writer.Write(mDetonationLeadInShapeFrameCounter);
+}
+
 }
\ No newline at end of file
@@ -26,7 +26,18 @@ public:
         ObjectId id,
         ElementIndex springIndex,
         World & parentWorld,
-        std::shared_ptr<IGameEventHandler> gameEventHandler,
+        std::shared_ptr<GameEventDispatcher> gameEventHandler,
+        BlastHandler blastHandler,
+        Points & shipPoints,
+        Springs & shipSprings,
+        GameParameters const & gameParameters);
+
+    TimerBomb(
+        ObjectId id,
+        SnapshotReader & reader,
+        GameWallClock::time_point now,
+        World & parentWorld,
+        std::shared_ptr<GameEventDispatcher> gameEventHandler,
         BlastHandler blastHandler,
         Points & shipPoints,
         Springs & shipSprings);
@@ -59,7 +70,11 @@ public:
 
     virtual void Upload(
         int shipId,
-        RenderContext & renderContext) const override;
+        IRenderBackend & renderContext) const override;
+
+    virtual void WriteSnapshot(
+        SnapshotWriter & writer,
+        GameWallClock::time_point now) const override;
 
 private:
 
@@ -95,7 +110,10 @@ private:
         Expired
     };
 
-    static constexpr auto SlowFuseToDetonationLeadInInterval = 8000ms;
+    // The slow fuse burns for as long as it takes for the bomb to explode at the
+    // timer bomb interval after it's been placed
+    static GameWallClock::duration CalculateSlowFuseStepInterval(GameParameters const & gameParameters);
+
     static constexpr auto FastFuseToDetonationLeadInInterval = 2000ms;
     static constexpr int FuseStepCount = 16;
     static constexpr int FuseLengthStepCount = 4;
@@ -111,7 +129,9 @@ private:
 
     State mState;
 
-    // The next timestamp at which we'll automatically transition state
+    // The next timestamp at which we'll automatically transition state; the transitions
+    // of the fuse and of the detonation lead-in are scheduled from the previous one, so
+    // that they don't drift with the steps that they happen at
     GameWallClock::time_point mNextStateTransitionTimePoint;
 
     // The fuse flame frame index, which is calculated at state transitions
@@ -0,0 +1,362 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-18
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "Trace.h"
+
+#include "GameException.h"
+
+#include <cassert>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace /* anonymous */ {
+
+    void WriteJsonString(
+        std::ostream & output,
+        char const * text)
+    {
+        output << '"';
+
+        for (char const * c = text; *c != '\0'; ++c)
+        {
+            if (*c == '"' || *c == '\\')
+                output << '\\' << *c;
+            else if (static_cast<unsigned char>(*c) < 0x20)
+                output << ' ';
+            else
+                output << *c;
+        }
+
+        output << '"';
+    }
+
+    // Trace viewers want microseconds
+    void WriteTimestamp(
+        std::ostream & output,
+        int64_t timestamp)
+    {
+        output << (timestamp / 1000) << '.' << std::setw(3) << std::setfill('0') << (timestamp % 1000);
+    }
+}
+
+Tracer Tracer::Instance;
+
+thread_local Tracer::ThreadBufferOwner Tracer::CurrentThreadBufferOwner;
+
+Tracer::ThreadBufferOwner::~ThreadBufferOwner()
+{
+    if (nullptr != Buffer)
+    {
+        Buffer->IsOwned.store(false, std::memory_order_release);
+    }
+}
+
+Tracer::Tracer()
+    : mOrigin(std::chrono::steady_clock::now())
+    , mIsEnabled(false)
+    , mCurrentSession(0)
+    , mMutex()
+    , mThreadBuffers()
+{
+}
+
+void Tracer::Start()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Zero is "no session"
+    uint32_t session = mCurrentSession.load(std::memory_order_relaxed) + 1;
+    if (session == 0)
+        session = 1;
+
+    mCurrentSession.store(session, std::memory_order_release);
+    mIsEnabled.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::Stop()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mIsEnabled.store(false, std::memory_order_relaxed);
+}
+
+void Tracer::SetThreadName(char const * name)
+{
+    GetThreadBuffer().ThreadName.store(name, std::memory_order_relaxed);
+}
+
+void Tracer::EndSpan(
+    char const * name,
+    uint32_t session)
+{
+    assert(session != 0);
+
+    if (session != mCurrentSession.load(std::memory_order_acquire))
+    {
+        // Its begin has been discarded
+        return;
+    }
+
+    Record(
+        GetThreadBuffer(),
+        session,
+        TraceEventType::End,
+        name,
+        0.0);
+}
+
+void Tracer::ExportChromeTrace(std::ostream & output)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    uint32_t const session = mCurrentSession.load(std::memory_order_relaxed);
+
+    output << "{\"traceEvents\":[";
+
+    bool isFirstEvent = true;
+    auto const beginEvent = [&output, &isFirstEvent](char const * phase, uint32_t threadId)
+    {
+        if (!isFirstEvent)
+            output << ",";
+
+        output << "\n{\"ph\":\"" << phase << "\",\"pid\":1,\"tid\":" << threadId;
+
+        isFirstEvent = false;
+    };
+
+    size_t droppedEventCount = 0;
+
+    for (auto const & threadBuffer : mThreadBuffers)
+    {
+        if (session == 0
+            || threadBuffer->Session.load(std::memory_order_acquire) != session)
+        {
+            // Nothing recorded in this session
+            continue;
+        }
+
+        size_t const eventCount = threadBuffer->EventCount.load(std::memory_order_acquire);
+        droppedEventCount += threadBuffer->DroppedEventCount.load(std::memory_order_relaxed);
+
+        //
+        // Name the thread
+        //
+
+        beginEvent("M", threadBuffer->ThreadId);
+        output << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+
+        char const * const threadName = threadBuffer->ThreadName.load(std::memory_order_relaxed);
+        if (nullptr != threadName)
+            WriteJsonString(output, threadName);
+        else
+            output << "\"Thread " << threadBuffer->ThreadId << "\"";
+
+        output << "}}";
+
+        //
+        // Write the events
+        //
+
+        for (size_t e = 0; e < eventCount; ++e)
+        {
+            TraceEvent const & event = threadBuffer->Chunks[e / ChunkSize][e % ChunkSize];
+
+            switch (event.Type)
+            {
+                case TraceEventType::Begin:
+                {
+                    beginEvent("B", threadBuffer->ThreadId);
+                    break;
+                }
+
+                case TraceEventType::End:
+                {
+                    beginEvent("E", threadBuffer->ThreadId);
+                    break;
+                }
+
+                case TraceEventType::Counter:
+                {
+                    beginEvent("C", threadBuffer->ThreadId);
+                    break;
+                }
+            }
+
+            output << ",\"name\":";
+            WriteJsonString(output, event.Name);
+
+            output << ",\"ts\":";
+            WriteTimestamp(output, event.Timestamp);
+
+            if (event.Type == TraceEventType::Counter)
+            {
+                output << ",\"args\":{\"value\":"
+                    << std::setprecision(15) << (std::isfinite(event.Value) ? event.Value : 0.0)
+                    << "}";
+            }
+
+            output << "}";
+        }
+    }
+
+    output << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEventCount\":\"" << droppedEventCount << "\"}}\n";
+}
+
+void Tracer::ExportChromeTrace(std::filesystem::path const & filePath)
+{
+    std::ofstream file(filePath.string(), std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+    {
+        throw GameException("Cannot create file \"" + filePath.string() + "\"");
+    }
+
+    ExportChromeTrace(file);
+
+    file.flush();
+    if (!file)
+    {
+        throw GameException("Cannot write file \"" + filePath.string() + "\"");
+    }
+}
+
+Tracer::ThreadBuffer & Tracer::GetThreadBuffer()
+{
+    ThreadBufferOwner & owner = CurrentThreadBufferOwner;
+    if (nullptr == owner.Buffer)
+    {
+        //
+        // First time for this thread: take over the buffer of a thread that is gone,
+        // as long as it has no events of the current session, or make a new one
+        //
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        uint32_t const session = mCurrentSession.load(std::memory_order_relaxed);
+
+        for (auto & threadBuffer : mThreadBuffers)
+        {
+            if (!threadBuffer->IsOwned.load(std::memory_order_acquire)
+                && (threadBuffer->Session.load(std::memory_order_relaxed) != session
+                    || threadBuffer->EventCount.load(std::memory_order_relaxed) == 0))
+            {
+                threadBuffer->IsOwned.store(true, std::memory_order_relaxed);
+                threadBuffer->ThreadName.store(nullptr, std::memory_order_relaxed);
+                owner.Buffer = threadBuffer.get();
+                break;
+            }
+        }
+
+        if (nullptr == owner.Buffer)
+        {
+            mThreadBuffers.emplace_back(
+                std::make_unique<ThreadBuffer>(static_cast<uint32_t>(mThreadBuffers.size() + 1)));
+
+            owner.Buffer = mThreadBuffers.back().get();
+        }
+    }
+
+    return *owner.Buffer;
+}
+
+uint32_t Tracer::RecordBeginSpan(char const * name)
+{
+    uint32_t const session = mCurrentSession.load(std::memory_order_acquire);
+
+    bool const isRecorded = Record(
+        GetThreadBuffer(),
+        session,
+        TraceEventType::Begin,
+        name,
+        0.0);
+
+    return isRecorded ? session : 0;
+}
+
+void Tracer::RecordCounterValue(
+    char const * name,
+    double value)
+{
+    uint32_t const session = mCurrentSession.load(std::memory_order_acquire);
+
+    Record(
+        GetThreadBuffer(),
+        session,
+        TraceEventType::Counter,
+        name,
+        value);
+}
+
+bool Tracer::Record(
+    ThreadBuffer & threadBuffer,
+    uint32_t session,
+    TraceEventType type,
+    char const * name,
+    double value)
+{
+    int64_t const timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - mOrigin).count();
+
+    if (threadBuffer.Session.load(std::memory_order_relaxed) != session)
+    {
+        //
+        // First event of this thread in this session; the events of the previous
+        // session get overwritten
+        //
+
+        threadBuffer.EventCount.store(0, std::memory_order_relaxed);
+        threadBuffer.DroppedEventCount.store(0, std::memory_order_relaxed);
+        threadBuffer.OpenSpanCount = 0;
+
+        // Publish the reset together with the session
+        threadBuffer.Session.store(session, std::memory_order_release);
+    }
+
+    size_t const eventCount = threadBuffer.EventCount.load(std::memory_order_relaxed);
+
+    //
+    // Make sure there's always room for the ends of the open spans, including
+    // the one we're beginning
+    //
+
+    if (type != TraceEventType::End)
+    {
+        size_t const reservedEventCount = threadBuffer.OpenSpanCount + (type == TraceEventType::Begin ? 1 : 0);
+        if (eventCount + 1 + reservedEventCount > MaxThreadEventCount)
+        {
+            threadBuffer.DroppedEventCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    assert(eventCount < MaxThreadEventCount);
+
+    auto & chunk = threadBuffer.Chunks[eventCount / ChunkSize];
+    if (!chunk)
+    {
+        chunk.reset(new TraceEvent[ChunkSize]);
+    }
+
+    TraceEvent & event = chunk[eventCount % ChunkSize];
+    event.Name = name;
+    event.Timestamp = timestamp;
+    event.Value = value;
+    event.Type = type;
+
+    // Publish the event
+    threadBuffer.EventCount.store(eventCount + 1, std::memory_order_release);
+
+    if (type == TraceEventType::Begin)
+    {
+        ++(threadBuffer.OpenSpanCount);
+    }
+    else if (type == TraceEventType::End)
+    {
+        assert(threadBuffer.OpenSpanCount > 0);
+        --(threadBuffer.OpenSpanCount);
+    }
+
+    return true;
+}
@@ -0,0 +1,234 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-18
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+enum class TraceEventType : uint8_t
+{
+    Begin = 0,
+    End = 1,
+    Counter = 2
+};
+
+struct TraceEvent
+{
+    // Must outlive the session - in practice, a string literal
+    char const * Name;
+
+    // Nanoseconds since the tracer was created
+    int64_t Timestamp;
+
+    // Counters only
+    double Value;
+
+    TraceEventType Type;
+};
+
+/*
+ * The tracer.
+ *
+ * Spans and counters are recorded - while a session is running - into per-thread buffers,
+ * which only their own thread writes into and which grow in chunks up to a maximum number
+ * of events; recording thus never waits for another thread, and when a thread's buffer is
+ * full its new events are dropped and their number is reported.
+ *
+ * Starting a session discards the events of the previous one; a session's events may be
+ * exported as Chrome trace-event JSON, which trace viewers (chrome://tracing, Perfetto)
+ * open as a timeline of the spans of each thread.
+ */
+class Tracer
+{
+public:
+
+    Tracer(Tracer const &) = delete;
+    Tracer(Tracer &&) = delete;
+    Tracer & operator=(Tracer const &) = delete;
+    Tracer & operator=(Tracer &&) = delete;
+
+    static constexpr size_t ChunkSize = 4096; // Events
+    static constexpr size_t MaxChunkCount = 64;
+    static constexpr size_t MaxThreadEventCount = ChunkSize * MaxChunkCount;
+
+    inline bool IsEnabled() const
+    {
+        return mIsEnabled.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * Discards the events recorded so far, and starts recording.
+     */
+    void Start();
+
+    /*
+     * Stops recording; the events recorded so far stay available for exporting.
+     */
+    void Stop();
+
+    /*
+     * Names the calling thread in exported traces; the name must be a string literal.
+     */
+    void SetThreadName(char const * name);
+
+    /*
+     * Returns the session the span began in - to be handed to EndSpan -, or zero
+     * when the span has not been recorded.
+     */
+    uint32_t BeginSpan(char const * name)
+    {
+        if (!IsEnabled())
+            return 0;
+
+        return RecordBeginSpan(name);
+    }
+
+    /*
+     * Ends a span; spans are ended even after recording has stopped, so that they
+     * stay balanced, though not when a new session has started meanwhile.
+     */
+    void EndSpan(
+        char const * name,
+        uint32_t session);
+
+    void RecordCounter(
+        char const * name,
+        double value)
+    {
+        if (!IsEnabled())
+            return;
+
+        RecordCounterValue(name, value);
+    }
+
+    void ExportChromeTrace(std::ostream & output);
+
+    void ExportChromeTrace(std::filesystem::path const & filePath);
+
+public:
+
+    static Tracer Instance;
+
+private:
+
+    Tracer();
+
+    struct ThreadBuffer
+    {
+        uint32_t const ThreadId;
+        std::atomic<char const *> ThreadName;
+
+        // Whether a live thread is recording into this buffer
+        std::atomic<bool> IsOwned;
+
+        // The session the events belong to
+        std::atomic<uint32_t> Session;
+
+        // Only the owner thread writes events, and it publishes them by bumping the count
+        std::array<std::unique_ptr<TraceEvent[]>, MaxChunkCount> Chunks;
+        std::atomic<size_t> EventCount;
+        std::atomic<size_t> DroppedEventCount;
+
+        // Owner thread only: the spans begun and not ended yet, each of which has an
+        // event reserved for its end
+        size_t OpenSpanCount;
+
+        explicit ThreadBuffer(uint32_t threadId)
+            : ThreadId(threadId)
+            , ThreadName(nullptr)
+            , IsOwned(true)
+            , Session(0)
+            , Chunks()
+            , EventCount(0)
+            , DroppedEventCount(0)
+            , OpenSpanCount(0)
+        {
+        }
+    };
+
+    // Gives the calling thread's buffer back when the thread exits
+    struct ThreadBufferOwner
+    {
+        ThreadBuffer * Buffer = nullptr;
+
+        ~ThreadBufferOwner();
+    };
+
+    static thread_local ThreadBufferOwner CurrentThreadBufferOwner;
+
+    ThreadBuffer & GetThreadBuffer();
+
+    uint32_t RecordBeginSpan(char const * name);
+
+    void RecordCounterValue(
+        char const * name,
+        double value);
+
+    bool Record(
+        ThreadBuffer & threadBuffer,
+        uint32_t session,
+        TraceEventType type,
+        char const * name,
+        double value);
+
+private:
+
+    std::chrono::steady_clock::time_point const mOrigin;
+
+    std::atomic<bool> mIsEnabled;
+    std::atomic<uint32_t> mCurrentSession;
+
+    // Guards the buffers, and serializes starting, stopping, and exporting
+    std::mutex mMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> mThreadBuffers;
+};
+
+/*
+ * Records a span over its own lifetime.
+ */
+class TraceSpan
+{
+public:
+
+    explicit TraceSpan(char const * name)
+        : mName(name)
+        , mSession(Tracer::Instance.BeginSpan(name))
+    {
+    }
+
+    ~TraceSpan()
+    {
+        if (mSession != 0)
+            Tracer::Instance.EndSpan(mName, mSession);
+    }
+
+    TraceSpan(TraceSpan const &) = delete;
+    TraceSpan & operator=(TraceSpan const &) = delete;
+
+private:
+
+    char const * const mName;
+    uint32_t const mSession;
+};
+
+//
+// Global aliases
+//
+
+inline void TraceCounter(
+    char const * name,
+    double value)
+{
+    Tracer::Instance.RecordCounter(name, value);
+}
@@ -15,6 +15,23 @@ void Triangles::Add(
     mIsDeletedBuffer.emplace_back(false);
 
     mEndpointsBuffer.emplace_back(pointAIndex, pointBIndex, pointCIndex);
+
+    mCoarseBlockIndexBuffer.emplace_back(NoneElementIndex);
+}
+
+void Triangles::AddCoarseBlock(std::array<ElementIndex, 8u> const & triangleIndices)
+{
+    ElementIndex const coarseBlockIndex = static_cast<ElementIndex>(mCoarseBlocks.size());
+
+    for (auto triangleIndex : triangleIndices)
+    {
+        assert(triangleIndex < mElementCount);
+        assert(NoneElementIndex == mCoarseBlockIndexBuffer[triangleIndex]);
+
+        mCoarseBlockIndexBuffer[triangleIndex] = coarseBlockIndex;
+    }
+
+    mCoarseBlocks.emplace_back(triangleIndices);
 }
 
 void Triangles::Destroy(ElementIndex triangleElementIndex)
@@ -30,11 +47,17 @@ void Triangles::Destroy(ElementIndex triangleElementIndex)
 
     // Flag ourselves as deleted
     mIsDeletedBuffer[triangleElementIndex] = true;
+
+    // Our coarse block - if any - is not whole anymore
+    if (NoneElementIndex != mCoarseBlockIndexBuffer[triangleElementIndex])
+    {
+        mCoarseBlocks[mCoarseBlockIndexBuffer[triangleElementIndex]].IsWhole = false;
+    }
 }
 
 void Triangles::UploadElements(
     int shipId,
-    RenderContext & renderContext,
+    IRenderBackend & renderContext,
     Points const & points) const
 {
     for (ElementIndex i : *this)
@@ -46,12 +69,141 @@ void Triangles::UploadElements(
 
             renderContext.UploadShipElementTriangle(
                 shipId,
+                i,
                 GetPointAIndex(i),
                 GetPointBIndex(i),
                 GetPointCIndex(i),
                 points.GetConnectedComponentId(GetPointAIndex(i)));
+
+            if (NoneElementIndex == mCoarseBlockIndexBuffer[i]
+                || !mCoarseBlocks[mCoarseBlockIndexBuffer[i]].IsWhole)
+            {
+                renderContext.UploadShipElementCoarseTriangle(
+                    shipId,
+                    i,
+                    GetPointAIndex(i),
+                    GetPointBIndex(i),
+                    GetPointCIndex(i),
+                    points.GetConnectedComponentId(GetPointAIndex(i)));
+            }
+        }
+    }
+
+    for (ElementIndex b = 0; b < mCoarseBlocks.size(); ++b)
+    {
+        if (mCoarseBlocks[b].IsWhole)
+        {
+            //
+            // The corners of the block are the top-left corner of the top-left cell,
+            // the top-right corner of the top-right cell, and so on
+            //
+
+            auto const & triangleIndices = mCoarseBlocks[b].TriangleIndices;
+
+            ElementIndex const topLeftPointIndex = GetPointAIndex(triangleIndices[0]);
+            ElementIndex const topRightPointIndex = GetPointBIndex(triangleIndices[2]);
+            ElementIndex const bottomLeftPointIndex = GetPointCIndex(triangleIndices[5]);
+            ElementIndex const bottomRightPointIndex = GetPointCIndex(triangleIndices[6]);
+
+            ConnectedComponentId const connectedComponentId = points.GetConnectedComponentId(topLeftPointIndex);
+
+            renderContext.UploadShipElementCoarseTriangle(
+                shipId,
+                GetCoarseTriangleIndex(b, 0),
+                topLeftPointIndex,
+                topRightPointIndex,
+                bottomRightPointIndex,
+                connectedComponentId);
+
+            renderContext.UploadShipElementCoarseTriangle(
+                shipId,
+                GetCoarseTriangleIndex(b, 1),
+                topLeftPointIndex,
+                bottomRightPointIndex,
+                bottomLeftPointIndex,
+                connectedComponentId);
+        }
+    }
+}
+
+void Triangles::UploadBrokenCoarseBlockElements(
+    int shipId,
+    IRenderBackend & renderContext,
+    Points const & points,
+    ElementIndex coarseBlockIndex) const
+{
+    assert(coarseBlockIndex < mCoarseBlocks.size());
+    assert(!mCoarseBlocks[coarseBlockIndex].IsWhole);
+
+    renderContext.RemoveShipElementCoarseTriangle(shipId, GetCoarseTriangleIndex(coarseBlockIndex, 0));
+    renderContext.RemoveShipElementCoarseTriangle(shipId, GetCoarseTriangleIndex(coarseBlockIndex, 1));
+
+    for (auto triangleIndex : mCoarseBlocks[coarseBlockIndex].TriangleIndices)
+    {
+        if (!mIsDeletedBuffer[triangleIndex])
+        {
+            renderContext.InsertShipElementCoarseTriangle(
+                shipId,
+                triangleIndex,
+                GetPointAIndex(triangleIndex),
+                GetPointBIndex(triangleIndex),
+                GetPointCIndex(triangleIndex),
+                points.GetConnectedComponentId(GetPointAIndex(triangleIndex)));
+        }
+    }
+}
+
+void Triangles::WriteSnapshot(SnapshotWriter & writer) const
+{
+    writer.WriteBuffer(mIsDeletedBuffer, mElementCount);
+    writer.WriteBuffer(mEndpointsBuffer, mElementCount);
+
+    writer.Write<uint32_t>(static_cast<uint32_t>(mCoarseBlocks.size()));
+    for (auto const & coarseBlock : mCoarseBlocks)
+    {
+        writer.Write(coarseBlock.TriangleIndices);
+        writer.Write<uint8_t>(coarseBlock.IsWhole ? 1 : 0);
+    }
+}
+
+void Triangles::ReadSnapshot(
+    SnapshotReader & reader,
+    ElementCount pointCount)
+{
+    reader.ReadBuffer(mIsDeletedBuffer, mElementCount);
+    reader.ReadBuffer(mEndpointsBuffer, mElementCount);
+
+    for (ElementIndex i = 0; i < mElementCount; ++i)
+    {
+        if (mEndpointsBuffer[i].PointAIndex >= pointCount
+            || mEndpointsBuffer[i].PointBIndex >= pointCount
+            || mEndpointsBuffer[i].PointCIndex >= pointCount)
+        {
+            throw GameException("Triangle endpoint out of range");
         }
     }
+
+    for (ElementIndex i = 0; i < mElementCount; ++i)
+    {
+        mCoarseBlockIndexBuffer.emplace_back(NoneElementIndex);
+    }
+
+    uint32_t const coarseBlockCount = reader.Read<uint32_t>();
+    for (uint32_t b = 0; b < coarseBlockCount; ++b)
+    {
+        auto const triangleIndices = reader.Read<std::array<ElementIndex, 8u>>();
+        for (auto triangleIndex : triangleIndices)
+        {
+            if (triangleIndex >= mElementCount)
+            {
+                throw GameException("Coarse block triangle out of range");
+            }
+        }
+
+        AddCoarseBlock(triangleIndices);
+
+        mCoarseBlocks.back().IsWhole = (0 != reader.Read<uint8_t>());
+    }
 }
 
 }
\ No newline at end of file
@@ -9,11 +9,14 @@
 #include "ElementContainer.h"
 #include "FixedSizeVector.h"
 #include "GameParameters.h"
+#include "IRenderBackend.h"
 #include "Material.h"
-#include "RenderContext.h"
+#include "Snapshot.h"
 
+#include <array>
 #include <cassert>
 #include <functional>
+#include <vector>
 
 namespace Physics
 {
@@ -45,6 +48,22 @@ private:
         {}
     };
 
+    /*
+     * A square of 2x2 cells that is drawn with two coarse triangles instead of its eight
+     * triangles when the ship is drawn with less detail, for as long as it's whole; see
+     * ShipBuilder::CoarseTriangleBlockInfo for the order of the triangles.
+     */
+    struct CoarseBlock
+    {
+        std::array<ElementIndex, 8u> TriangleIndices;
+        bool IsWhole;
+
+        CoarseBlock(std::array<ElementIndex, 8u> const & triangleIndices)
+            : TriangleIndices(triangleIndices)
+            , IsWhole(true)
+        {}
+    };
+
 
 public:
 
@@ -56,9 +75,12 @@ public:
         , mIsDeletedBuffer(elementCount)
         // Endpoints
         , mEndpointsBuffer(elementCount)        
+        // Coarse mesh
+        , mCoarseBlockIndexBuffer(elementCount)
         //////////////////////////////////
         // Container
         //////////////////////////////////
+        , mCoarseBlocks()
         , mDestroyHandler()
     {
     }
@@ -88,13 +110,50 @@ public:
         ElementIndex pointBIndex,
         ElementIndex pointCIndex);
 
+    /*
+     * Makes a coarse block out of the specified triangles, which must have been added already.
+     */
+    void AddCoarseBlock(std::array<ElementIndex, 8u> const & triangleIndices);
+
     void Destroy(ElementIndex triangleElementIndex);
 
+    /*
+     * Uploads the triangles, and the coarse triangles.
+     *
+     * The triangles that are not part of a whole coarse block are coarse triangles themselves,
+     * with their own index; the two coarse triangles of each whole coarse block come after them,
+     * at twice the index of the block after the last triangle.
+     */
     void UploadElements(
         int shipId,
-        RenderContext & renderContext,
+        IRenderBackend & renderContext,
         Points const & points) const;
 
+    /*
+     * Replaces the coarse triangles of a coarse block that is not whole anymore with
+     * the triangles of the block that are still there.
+     */
+    void UploadBrokenCoarseBlockElements(
+        int shipId,
+        IRenderBackend & renderContext,
+        Points const & points,
+        ElementIndex coarseBlockIndex) const;
+
+    /*
+     * Writes the state of all triangles to a snapshot.
+     */
+    void WriteSnapshot(SnapshotWriter & writer) const;
+
+    /*
+     * Reads the state of all triangles from a snapshot; only valid on a container that
+     * has just been constructed with the snapshot's number of triangles.
+     *
+     * Throws if an endpoint is not one of the specified number of points.
+     */
+    void ReadSnapshot(
+        SnapshotReader & reader,
+        ElementCount pointCount);
+
 public:
 
     //
@@ -133,8 +192,33 @@ public:
         return mEndpointsBuffer[triangleElementIndex].PointCIndex;
     }
 
+    //
+    // Coarse mesh
+    //
+
+    inline ElementIndex GetCoarseBlockIndex(ElementIndex triangleElementIndex) const
+    {
+        assert(triangleElementIndex < mElementCount);
+
+        return mCoarseBlockIndexBuffer[triangleElementIndex];
+    }
+
+    inline bool IsCoarseBlockWhole(ElementIndex coarseBlockIndex) const
+    {
+        assert(coarseBlockIndex < mCoarseBlocks.size());
+
+        return mCoarseBlocks[coarseBlockIndex].IsWhole;
+    }
+
 private:
 
+    inline ElementIndex GetCoarseTriangleIndex(
+        ElementIndex coarseBlockIndex,
+        ElementIndex coarseBlockTriangle) const
+    {
+        return mElementCount + 2 * coarseBlockIndex + coarseBlockTriangle;
+    }
+
 private:
 
     //////////////////////////////////////////////////////////
@@ -147,10 +231,15 @@ private:
     // Endpoints
     Buffer<Endpoints> mEndpointsBuffer;
 
+    // Coarse mesh - the index of the coarse block that the triangle is part of, if any
+    Buffer<ElementIndex> mCoarseBlockIndexBuffer;
+
     //////////////////////////////////////////////////////////
     // Container 
     //////////////////////////////////////////////////////////
 
+    std::vector<CoarseBlock> mCoarseBlocks;
+
     // The handler registered for triangle deletions
     DestroyHandler mDestroyHandler;
 };
@@ -0,0 +1,271 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-16
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "IAudioDevice.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+
+/*
+ * A fixed set of voices for one-shot sounds.
+ *
+ * All voices are made upfront, hence playing a sound never allocates. Each sound is
+ * identified by a dense key in [0, keyCount), which allows finding the last voice that
+ * played a sound in constant time.
+ *
+ * When all voices are busy, a new sound takes the voice of the lowest-priority sound -
+ * the oldest one among those with the same priority - provided that sound's priority
+ * is not higher than the new sound's; otherwise, the new sound is dropped.
+ */
+template<typename TSoundBuffer>
+class VoicePool
+{
+public:
+
+    enum class PlayOutcome
+    {
+        // The sound started on a free voice
+        Played,
+
+        // The sound started on the voice of another sound, which was stopped
+        PlayedOnStolenVoice,
+
+        // The same sound had started too recently, and it was made louder instead
+        Coalesced,
+
+        // All voices are playing more important sounds
+        Dropped
+    };
+
+    VoicePool(
+        IAudioDevice<TSoundBuffer> & audioDevice,
+        size_t voiceCount,
+        size_t keyCount,
+        std::chrono::steady_clock::duration minDeltaTimeSameSound)
+        : mVoices()
+        , mFreeVoices()
+        , mLastVoiceByKey(keyCount, NoVoice)
+        , mMinDeltaTimeSameSound(minDeltaTimeSameSound)
+        , mIsPaused(false)
+    {
+        assert(voiceCount > 0);
+
+        mVoices.reserve(voiceCount);
+        mFreeVoices.reserve(voiceCount);
+        for (size_t v = 0; v < voiceCount; ++v)
+        {
+            mVoices.emplace_back(audioDevice.MakeVoice());
+            mFreeVoices.push_back(voiceCount - 1 - v);
+        }
+    }
+
+    size_t GetVoiceCount() const
+    {
+        return mVoices.size();
+    }
+
+    /*
+     * The number of voices that have not been reclaimed yet; this includes
+     * voices whose sound has finished meanwhile.
+     */
+    size_t GetBusyVoiceCount() const
+    {
+        return mVoices.size() - mFreeVoices.size();
+    }
+
+    PlayOutcome Play(
+        size_t key,
+        TSoundBuffer const & soundBuffer,
+        float volume,
+        int priority,
+        std::chrono::steady_clock::time_point now)
+    {
+        assert(key < mLastVoiceByKey.size());
+
+        //
+        // Make sure the same sound hasn't started too recently;
+        // if it has, make it louder
+        //
+
+        size_t const lastVoice = mLastVoiceByKey[key];
+        if (NoVoice != lastVoice
+            && mVoices[lastVoice].IsBusy
+            && mVoices[lastVoice].Key == key
+            && now - mVoices[lastVoice].StartedTimestamp < mMinDeltaTimeSameSound)
+        {
+            auto & output = *(mVoices[lastVoice].Output);
+            output.SetVolume(std::min(100.0f, output.GetVolume() + volume));
+
+            return PlayOutcome::Coalesced;
+        }
+
+        //
+        // Find a voice
+        //
+
+        PlayOutcome outcome = PlayOutcome::Played;
+
+        if (mFreeVoices.empty())
+        {
+            ReclaimStoppedVoices();
+
+            if (mFreeVoices.empty())
+            {
+                if (!StealVoice(priority))
+                {
+                    return PlayOutcome::Dropped;
+                }
+
+                outcome = PlayOutcome::PlayedOnStolenVoice;
+            }
+        }
+
+        assert(!mFreeVoices.empty());
+        size_t const v = mFreeVoices.back();
+        mFreeVoices.pop_back();
+
+        //
+        // Play sound
+        //
+
+        Voice & voice = mVoices[v];
+
+        voice.IsBusy = true;
+        voice.Key = key;
+        voice.Priority = priority;
+        voice.StartedTimestamp = now;
+
+        voice.Output->Play(soundBuffer, volume);
+        if (mIsPaused)
+            voice.Output->Pause();
+
+        mLastVoiceByKey[key] = v;
+
+        return outcome;
+    }
+
+    void SetPaused(bool isPaused)
+    {
+        for (auto & voice : mVoices)
+        {
+            if (voice.IsBusy)
+            {
+                if (isPaused)
+                    voice.Output->Pause();
+                else
+                    voice.Output->Resume();
+            }
+        }
+
+        mIsPaused = isPaused;
+    }
+
+    void StopAll()
+    {
+        mFreeVoices.clear();
+
+        for (size_t v = mVoices.size(); v-- > 0; )
+        {
+            if (mVoices[v].IsBusy)
+            {
+                mVoices[v].Output->Stop();
+                mVoices[v].IsBusy = false;
+            }
+
+            mFreeVoices.push_back(v);
+        }
+
+        std::fill(mLastVoiceByKey.begin(), mLastVoiceByKey.end(), NoVoice);
+    }
+
+    /*
+     * Returns to the free list all voices whose sound has finished.
+     */
+    void ReclaimStoppedVoices()
+    {
+        for (size_t v = 0; v < mVoices.size(); ++v)
+        {
+            if (mVoices[v].IsBusy && mVoices[v].Output->IsStopped())
+            {
+                mVoices[v].IsBusy = false;
+                mFreeVoices.push_back(v);
+            }
+        }
+    }
+
+private:
+
+    bool StealVoice(int priority)
+    {
+        size_t victim = NoVoice;
+        for (size_t v = 0; v < mVoices.size(); ++v)
+        {
+            assert(mVoices[v].IsBusy);
+
+            if (NoVoice == victim
+                || mVoices[v].Priority < mVoices[victim].Priority
+                || (mVoices[v].Priority == mVoices[victim].Priority && mVoices[v].StartedTimestamp < mVoices[victim].StartedTimestamp))
+            {
+                victim = v;
+            }
+        }
+
+        assert(NoVoice != victim);
+
+        if (mVoices[victim].Priority > priority)
+        {
+            // Everything playing is more important
+            return false;
+        }
+
+        mVoices[victim].Output->Stop();
+        mVoices[victim].IsBusy = false;
+        mFreeVoices.push_back(victim);
+
+        return true;
+    }
+
+private:
+
+    static constexpr size_t NoVoice = std::numeric_limits<size_t>::max();
+
+    struct Voice
+    {
+        std::unique_ptr<IAudioVoice<TSoundBuffer>> Output;
+
+        bool IsBusy;
+        size_t Key;
+        int Priority;
+        std::chrono::steady_clock::time_point StartedTimestamp;
+
+        Voice(std::unique_ptr<IAudioVoice<TSoundBuffer>> output)
+            : Output(std::move(output))
+            , IsBusy(false)
+            , Key(NoVoice)
+            , Priority(0)
+            , StartedTimestamp()
+        {
+        }
+    };
+
+    std::vector<Voice> mVoices;
+
+    // Stack of the indices of the free voices
+    std::vector<size_t> mFreeVoices;
+
+    // The voice that played each key last, or NoVoice
+    std::vector<size_t> mLastVoiceByKey;
+
+    std::chrono::steady_clock::duration const mMinDeltaTimeSameSound;
+
+    bool mIsPaused;
+};
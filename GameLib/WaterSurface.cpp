@@ -9,6 +9,11 @@ namespace Physics {
 
 WaterSurface::WaterSurface()
     : mSamples(new float[SamplesCount + 1])
+    , mProfile{
+        { 0.0f, 0.0f, 0.0f },
+        { Frequency1, Frequency2, 0.0f },
+        { 0.0f, 0.0f, 0.0f },
+        0.0f }
 {
 }
 
@@ -20,10 +25,16 @@ void WaterSurface::Update(
     float x = 0;
     for (int64_t i = 0; i < SamplesCount + 1; i++, x += Dx)
     {
-        float const c1 = sinf(x * Frequency1 + currentTime) * 0.5f;
-        float const c2 = sinf(x * Frequency2 - currentTime * 1.1f) * 0.3f;
+        float const c1 = sinf(x * Frequency1 + currentTime * Speed1) * Amplitude1;
+        float const c2 = sinf(x * Frequency2 + currentTime * Speed2) * Amplitude2;
         mSamples[i] = (c1 + c2) * gameParameters.WaveHeight;
     }
+
+    // Phases are wrapped around, to keep them precise in single-precision shaders
+    mProfile.Amplitudes[0] = Amplitude1 * gameParameters.WaveHeight;
+    mProfile.Amplitudes[1] = Amplitude2 * gameParameters.WaveHeight;
+    mProfile.Phases[0] = fmodf(currentTime * Speed1, 2.0f * Pi<float>);
+    mProfile.Phases[1] = fmodf(currentTime * Speed2, 2.0f * Pi<float>);
 }
 
 }
\ No newline at end of file
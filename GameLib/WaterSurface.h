@@ -38,12 +38,28 @@ public:
             + (mSamples[index + 1] - mSamples[index]) * ((x / Dx) - absoluteSampleIndex);
     }
 
+    /*
+     * The exact profile that the samples are taken from.
+     */
+    SineWavesProfile const & GetProfile() const
+    {
+        return mProfile;
+    }
+
 private:
 
     // Frequencies of the wave components
     static constexpr float Frequency1 = 0.1f;
     static constexpr float Frequency2 = 0.3f;
 
+    // Amplitudes of the wave components, relative to the wave height
+    static constexpr float Amplitude1 = 0.5f;
+    static constexpr float Amplitude2 = 0.3f;
+
+    // Speed of the wave components
+    static constexpr float Speed1 = 1.0f;
+    static constexpr float Speed2 = -1.1f;
+
     // Period of the sum of the frequency components
     static constexpr float Period = 20.0f * Pi<float>;
 
@@ -57,6 +73,8 @@ private:
 
     // The samples
     std::unique_ptr<float[]> mSamples;    
+
+    SineWavesProfile mProfile;
 };
 
 }
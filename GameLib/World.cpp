@@ -9,6 +9,7 @@
 
 #include "GameRandomEngine.h"
 #include "ShipBuilder.h"
+#include "Trace.h"
 
 #include <algorithm>
 #include <cassert>
@@ -26,14 +27,17 @@ namespace Physics {
 //   W W      OOO    R     R  LLLLLLL  DDDD
 
 World::World(
-    std::shared_ptr<IGameEventHandler> gameEventHandler,
+    std::shared_ptr<GameEventDispatcher> gameEventHandler,
     GameParameters const & gameParameters)
     : mAllShips()
     , mAllClouds()
     , mWaterSurface()
     , mOceanFloor()
     , mCurrentTime(0.0f)
+    , mCurrentSimulationClockTime()
+    , mUseWallClock(gameParameters.UseWallClockForBombs)
     , mCurrentStepSequenceNumber(1u)
+    , mRandomEngine(GameRandomEngine::WorldStreamId)
     , mGameEventHandler(std::move(gameEventHandler))
 {
     // Initialize clouds
@@ -49,22 +53,36 @@ int World::AddShip(
     MaterialDatabase const & materials,
     GameParameters const & gameParameters)
 {
-    int shipId = static_cast<int>(mAllShips.size());
-
     auto newShip = ShipBuilder::Create(
-        shipId,
+        GetNextShipId(),
         *this,
         mGameEventHandler,
         shipDefinition,
         materials,
         gameParameters,
-        mCurrentStepSequenceNumber);
+        mCurrentStepSequenceNumber,
+        ProgressCallback());
+
+    return AddShip(std::move(newShip));
+}
+
+int World::AddShip(std::unique_ptr<Ship> ship)
+{
+    int shipId = static_cast<int>(mAllShips.size());
+    assert(static_cast<int>(ship->GetId()) == shipId);
 
-    mAllShips.push_back(std::move(newShip));
+    mAllShips.push_back(std::move(ship));
 
     return shipId;
 }
 
+Ship const & World::GetShip(int shipId) const
+{
+    assert(shipId >= 0 && shipId < static_cast<int>(mAllShips.size()));
+
+    return *(mAllShips[shipId]);
+}
+
 void World::DestroyAt(
     vec2 const & targetPos, 
     float radius)
@@ -201,8 +219,11 @@ ElementIndex World::GetNearestPointAt(
 
 void World::Update(GameParameters const & gameParameters)
 {
+    TraceSpan span("World::Update");
+
     // Update current time
     mCurrentTime += GameParameters::SimulationStepTimeDuration<float>;
+    mCurrentSimulationClockTime += SimulationClockStepDuration;
 
     // Generate a new step sequence number
     ++mCurrentStepSequenceNumber;
@@ -228,8 +249,10 @@ void World::Update(GameParameters const & gameParameters)
 
 void World::Render( 
     GameParameters const & gameParameters,
-    RenderContext & renderContext) const
+    IRenderBackend & renderContext) const
 {
+    TraceSpan span("World::Render");
+
     renderContext.RenderStart();
 
     // Upload land and water data
@@ -264,6 +287,56 @@ void World::Render(
     renderContext.RenderEnd();
 }
 
+void World::WriteSnapshot(SnapshotWriter & writer) const
+{
+    writer.Write(mCurrentTime);
+    writer.Write(mCurrentStepSequenceNumber);
+    mRandomEngine.WriteSnapshot(writer);
+
+    auto const now = GetCurrentClockTime();
+
+    writer.Write<uint32_t>(static_cast<uint32_t>(mAllShips.size()));
+    for (auto const & ship : mAllShips)
+    {
+        ship->WriteSnapshot(writer, now);
+    }
+}
+
+std::unique_ptr<World> World::ReadSnapshot(
+    SnapshotReader & reader,
+    std::shared_ptr<GameEventDispatcher> gameEventHandler,
+    MaterialDatabase const & materials,
+    GameParameters const & gameParameters)
+{
+    auto world = std::make_unique<World>(gameEventHandler, gameParameters);
+
+    world->mCurrentTime = reader.Read<float>();
+    world->mCurrentStepSequenceNumber = reader.Read<uint64_t>();
+    world->mRandomEngine.ReadSnapshot(reader);
+
+    // The water surface and the clouds are a function of the time
+    world->mWaterSurface.Update(world->mCurrentTime, gameParameters);
+    world->UpdateClouds(gameParameters);
+
+    auto const now = world->GetCurrentClockTime();
+
+    uint32_t const shipCount = reader.Read<uint32_t>();
+    for (uint32_t s = 0; s < shipCount; ++s)
+    {
+        world->AddShip(
+            Ship::ReadSnapshot(
+                reader,
+                world->GetNextShipId(),
+                *world,
+                gameEventHandler,
+                materials,
+                world->mCurrentStepSequenceNumber,
+                now));
+    }
+
+    return world;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////
 // Private Helpers
 ///////////////////////////////////////////////////////////////////////////////////
@@ -281,16 +354,16 @@ void World::UpdateClouds(GameParameters const & gameParameters)
         {
             mAllClouds.emplace_back(
                 new Cloud(
-                    GameRandomEngine::GetInstance().GenerateRandomNormalReal() * 100.0f,    // OffsetX
-                    GameRandomEngine::GetInstance().GenerateRandomNormalReal() * 0.01f,      // SpeedX1
-                    GameRandomEngine::GetInstance().GenerateRandomNormalReal() * 0.04f,     // AmpX
-                    GameRandomEngine::GetInstance().GenerateRandomNormalReal() * 0.01f,     // SpeedX2
-                    GameRandomEngine::GetInstance().GenerateRandomNormalReal() * 100.0f,    // OffsetY
-                    GameRandomEngine::GetInstance().GenerateRandomNormalReal() * 0.001f,    // AmpY
-                    GameRandomEngine::GetInstance().GenerateRandomNormalReal() * 0.005f,     // SpeedY
+                    mRandomEngine.GenerateRandomNormalReal() * 100.0f,    // OffsetX
+                    mRandomEngine.GenerateRandomNormalReal() * 0.01f,      // SpeedX1
+                    mRandomEngine.GenerateRandomNormalReal() * 0.04f,     // AmpX
+                    mRandomEngine.GenerateRandomNormalReal() * 0.01f,     // SpeedX2
+                    mRandomEngine.GenerateRandomNormalReal() * 100.0f,    // OffsetY
+                    mRandomEngine.GenerateRandomNormalReal() * 0.001f,    // AmpY
+                    mRandomEngine.GenerateRandomNormalReal() * 0.005f,     // SpeedY
                     0.2f + static_cast<float>(c) / static_cast<float>(c + 3), // OffsetScale - the earlier clouds are smaller
-                    GameRandomEngine::GetInstance().GenerateRandomNormalReal() * 0.05f,     // AmpScale
-                    GameRandomEngine::GetInstance().GenerateRandomNormalReal() * 0.005f));    // SpeedScale
+                    mRandomEngine.GenerateRandomNormalReal() * 0.05f,     // AmpScale
+                    mRandomEngine.GenerateRandomNormalReal() * 0.005f));    // SpeedScale
         }
     }
 
@@ -303,7 +376,7 @@ void World::UpdateClouds(GameParameters const & gameParameters)
     }
 }
 
-void World::RenderClouds(RenderContext & renderContext) const
+void World::RenderClouds(IRenderBackend & renderContext) const
 {
     renderContext.RenderCloudsStart(mAllClouds.size());
 
@@ -320,26 +393,12 @@ void World::RenderClouds(RenderContext & renderContext) const
 
 void World::UploadLandAndWater(
     GameParameters const & gameParameters,
-    RenderContext & renderContext) const
+    IRenderBackend & renderContext) const
 {
-    static constexpr size_t SlicesCount = 500;
-
-    float const visibleWorldWidth = renderContext.GetVisibleWorldWidth();
-    float const sliceWidth = visibleWorldWidth / static_cast<float>(SlicesCount);
-    float sliceX = renderContext.GetCameraWorldPosition().x - (visibleWorldWidth / 2.0f);
-
-    renderContext.UploadLandAndWaterStart(SlicesCount);    
-
-    for (size_t i = 0; i <= SlicesCount; ++i, sliceX += sliceWidth)
-    {
-        renderContext.UploadLandAndWater(
-            sliceX,
-            mOceanFloor.GetFloorHeightAt(sliceX),
-            mWaterSurface.GetWaterHeightAt(sliceX),
-            gameParameters.SeaDepth);
-    }
-
-    renderContext.UploadLandAndWaterEnd();
+    renderContext.UploadLandAndWater(
+        mOceanFloor.GetProfile(),
+        mWaterSurface.GetProfile(),
+        gameParameters.SeaDepth);
 }
 
 }
\ No newline at end of file
@@ -8,14 +8,18 @@
 #pragma once
 
 #include "AABB.h"
+#include "GameEventDispatcher.h"
 #include "GameParameters.h"
-#include "IGameEventHandler.h"
+#include "GameRandomEngine.h"
+#include "GameWallClock.h"
+#include "IRenderBackend.h"
 #include "MaterialDatabase.h"
 #include "Physics.h"
-#include "RenderContext.h"
 #include "ShipDefinition.h"
+#include "Snapshot.h"
 #include "Vectors.h"
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <set>
@@ -29,7 +33,7 @@ class World
 public:
 
 	World(
-        std::shared_ptr<IGameEventHandler> gameEventHandler,
+        std::shared_ptr<GameEventDispatcher> gameEventHandler,
         GameParameters const & gameParameters);
 
     int AddShip(
@@ -37,6 +41,45 @@ public:
         MaterialDatabase const & materials,
         GameParameters const & gameParameters);
 
+    /*
+     * Adds a ship that has been built elsewhere for this world, e.g. on a worker thread;
+     * the ship's ID must be the one returned by GetNextShipId().
+     */
+    int AddShip(std::unique_ptr<Ship> ship);
+
+    inline int GetNextShipId() const
+    {
+        return static_cast<int>(mAllShips.size());
+    }
+
+    Ship const & GetShip(int shipId) const;
+
+    inline uint64_t GetCurrentStepSequenceNumber() const
+    {
+        return mCurrentStepSequenceNumber;
+    }
+
+    /*
+     * The random engine for everything that happens in this world.
+     */
+    inline GameRandomEngine & GetRandomEngine()
+    {
+        return mRandomEngine;
+    }
+
+    /*
+     * The time that bombs are timed by. This is the simulation time - which advances by one
+     * step duration at each Update(), regardless of how long the step took for real - unless
+     * the world was created with the game wall clock.
+     */
+    inline GameWallClock::time_point GetCurrentClockTime() const
+    {
+        if (mUseWallClock)
+            return GameWallClock::GetInstance().Now();
+        else
+            return mCurrentSimulationClockTime;
+    }
+
     inline float GetWaterHeightAt(float x) const
     {
         return mWaterSurface.GetWaterHeightAt(x);
@@ -90,17 +133,32 @@ public:
 
 	void Render(		
         GameParameters const & gameParameters,
-		RenderContext & renderContext) const;
+		IRenderBackend & renderContext) const;
+
+    /*
+     * Writes the state of the world, including all of its ships, to a snapshot.
+     */
+    void WriteSnapshot(SnapshotWriter & writer) const;
+
+    /*
+     * Makes a world out of a snapshot. Clouds are not part of snapshots, and are
+     * generated anew.
+     */
+    static std::unique_ptr<World> ReadSnapshot(
+        SnapshotReader & reader,
+        std::shared_ptr<GameEventDispatcher> gameEventHandler,
+        MaterialDatabase const & materials,
+        GameParameters const & gameParameters);
 
 private:
 
     void UpdateClouds(GameParameters const & gameParameters);
 
-    void RenderClouds(RenderContext & renderContext) const;
+    void RenderClouds(IRenderBackend & renderContext) const;
 
 	void UploadLandAndWater(
 		GameParameters const & gameParameters,
-        RenderContext & renderContext) const;
+        IRenderBackend & renderContext) const;
 
 private:
 
@@ -113,12 +171,21 @@ private:
 	// The current time 
 	float mCurrentTime;
 
+    // The simulation time, as a time point of the game wall clock's type
+    static constexpr GameWallClock::duration SimulationClockStepDuration = std::chrono::round<GameWallClock::duration>(
+        std::chrono::duration<double>(GameParameters::SimulationStepTimeDuration<double>));
+    GameWallClock::time_point mCurrentSimulationClockTime;
+    bool const mUseWallClock;
+
     // The current step sequence number; used to avoid zero-ing out things.
     // Guaranteed to never be zero, but expected to rollover
     uint64_t mCurrentStepSequenceNumber;
 
+    // Our own random engine, so that the world does not depend on what else draws random numbers
+    GameRandomEngine mRandomEngine;
+
     // The game event handler
-    std::shared_ptr<IGameEventHandler> mGameEventHandler;
+    std::shared_ptr<GameEventDispatcher> mGameEventHandler;
 };
 
 }
@@ -1,6 +1,6 @@
 /*
 
-    OpenGL loader generated by glad 0.1.16a0 on Tue Feb 13 08:16:12 2018.
+    OpenGL loader generated by glad 0.1.16a0 on Sat Jul  7 10:12:41 2018.
 
     Language/Generator: C/C++
     Specification: gl
@@ -8,12 +8,14 @@
     Profile: core
     Extensions:
         GL_3DFX_texture_compression_FXT1,
+        GL_ARB_buffer_storage,
         GL_ARB_color_buffer_float,
         GL_ARB_depth_texture,
         GL_ARB_draw_buffers,
         GL_ARB_fragment_program,
         GL_ARB_fragment_shader,
         GL_ARB_half_float_pixel,
+        GL_ARB_map_buffer_range,
         GL_ARB_multisample,
         GL_ARB_multitexture,
         GL_ARB_occlusion_query,
@@ -23,6 +25,7 @@
         GL_ARB_shader_objects,
         GL_ARB_shading_language_100,
         GL_ARB_shadow,
+        GL_ARB_sync,
         GL_ARB_texture_border_clamp,
         GL_ARB_texture_compression,
         GL_ARB_texture_cube_map,
@@ -91,7 +94,7 @@
     Omit khrplatform: False
 
     Commandline:
-        --profile="core" --api="gl=2.1" --generator="c" --spec="gl" --extensions="GL_3DFX_texture_compression_FXT1,GL_ARB_color_buffer_float,GL_ARB_depth_texture,GL_ARB_draw_buffers,GL_ARB_fragment_program,GL_ARB_fragment_shader,GL_ARB_half_float_pixel,GL_ARB_multisample,GL_ARB_multitexture,GL_ARB_occlusion_query,GL_ARB_pixel_buffer_object,GL_ARB_point_parameters,GL_ARB_point_sprite,GL_ARB_shader_objects,GL_ARB_shading_language_100,GL_ARB_shadow,GL_ARB_texture_border_clamp,GL_ARB_texture_compression,GL_ARB_texture_cube_map,GL_ARB_texture_env_add,GL_ARB_texture_env_combine,GL_ARB_texture_env_crossbar,GL_ARB_texture_env_dot3,GL_ARB_texture_float,GL_ARB_texture_mirrored_repeat,GL_ARB_texture_non_power_of_two,GL_ARB_texture_rectangle,GL_ARB_transpose_matrix,GL_ARB_vertex_buffer_object,GL_ARB_vertex_program,GL_ARB_vertex_shader,GL_ARB_window_pos,GL_ATI_separate_stencil,GL_EXT_abgr,GL_EXT_bgra,GL_EXT_blend_color,GL_EXT_blend_equation_separate,GL_EXT_blend_func_separate,GL_EXT_blend_logic_op,GL_EXT_blend_minmax,GL_EXT_blend_subtract,GL_EXT_clip_volume_hint,GL_EXT_compiled_vertex_array,GL_EXT_copy_texture,GL_EXT_draw_range_elements,GL_EXT_fog_coord,GL_EXT_framebuffer_object,GL_EXT_multi_draw_arrays,GL_EXT_packed_pixels,GL_EXT_point_parameters,GL_EXT_polygon_offset,GL_EXT_rescale_normal,GL_EXT_secondary_color,GL_EXT_separate_specular_color,GL_EXT_shadow_funcs,GL_EXT_stencil_two_side,GL_EXT_stencil_wrap,GL_EXT_subtexture,GL_EXT_texture,GL_EXT_texture3D,GL_EXT_texture_compression_s3tc,GL_EXT_texture_env_add,GL_EXT_texture_env_combine,GL_EXT_texture_env_dot3,GL_EXT_texture_filter_anisotropic,GL_EXT_texture_lod_bias,GL_EXT_texture_object,GL_EXT_texture_sRGB,GL_EXT_vertex_array,GL_IBM_texture_mirrored_repeat,GL_NV_blend_square,GL_NV_point_sprite,GL_NV_texgen_reflection,GL_NV_texture_rectangle,GL_S3_s3tc,GL_SGIS_generate_mipmap,GL_SGIS_texture_edge_clamp,GL_SGIS_texture_lod,GL_SGIX_depth_texture"
+        --profile="core" --api="gl=2.1" --generator="c" --spec="gl" --extensions="GL_3DFX_texture_compression_FXT1,GL_ARB_buffer_storage,GL_ARB_color_buffer_float,GL_ARB_depth_texture,GL_ARB_draw_buffers,GL_ARB_fragment_program,GL_ARB_fragment_shader,GL_ARB_half_float_pixel,GL_ARB_map_buffer_range,GL_ARB_multisample,GL_ARB_multitexture,GL_ARB_occlusion_query,GL_ARB_pixel_buffer_object,GL_ARB_point_parameters,GL_ARB_point_sprite,GL_ARB_shader_objects,GL_ARB_shading_language_100,GL_ARB_shadow,GL_ARB_sync,GL_ARB_texture_border_clamp,GL_ARB_texture_compression,GL_ARB_texture_cube_map,GL_ARB_texture_env_add,GL_ARB_texture_env_combine,GL_ARB_texture_env_crossbar,GL_ARB_texture_env_dot3,GL_ARB_texture_float,GL_ARB_texture_mirrored_repeat,GL_ARB_texture_non_power_of_two,GL_ARB_texture_rectangle,GL_ARB_transpose_matrix,GL_ARB_vertex_buffer_object,GL_ARB_vertex_program,GL_ARB_vertex_shader,GL_ARB_window_pos,GL_ATI_separate_stencil,GL_EXT_abgr,GL_EXT_bgra,GL_EXT_blend_color,GL_EXT_blend_equation_separate,GL_EXT_blend_func_separate,GL_EXT_blend_logic_op,GL_EXT_blend_minmax,GL_EXT_blend_subtract,GL_EXT_clip_volume_hint,GL_EXT_compiled_vertex_array,GL_EXT_copy_texture,GL_EXT_draw_range_elements,GL_EXT_fog_coord,GL_EXT_framebuffer_object,GL_EXT_multi_draw_arrays,GL_EXT_packed_pixels,GL_EXT_point_parameters,GL_EXT_polygon_offset,GL_EXT_rescale_normal,GL_EXT_secondary_color,GL_EXT_separate_specular_color,GL_EXT_shadow_funcs,GL_EXT_stencil_two_side,GL_EXT_stencil_wrap,GL_EXT_subtexture,GL_EXT_texture,GL_EXT_texture3D,GL_EXT_texture_compression_s3tc,GL_EXT_texture_env_add,GL_EXT_texture_env_combine,GL_EXT_texture_env_dot3,GL_EXT_texture_filter_anisotropic,GL_EXT_texture_lod_bias,GL_EXT_texture_object,GL_EXT_texture_sRGB,GL_EXT_vertex_array,GL_IBM_texture_mirrored_repeat,GL_NV_blend_square,GL_NV_point_sprite,GL_NV_texgen_reflection,GL_NV_texture_rectangle,GL_S3_s3tc,GL_SGIS_generate_mipmap,GL_SGIS_texture_edge_clamp,GL_SGIS_texture_lod,GL_SGIX_depth_texture"
     Online:
         Too many extensions
 */
@@ -537,6 +540,9 @@ int GLAD_GL_EXT_texture_object;
 int GLAD_GL_EXT_vertex_array;
 int GLAD_GL_IBM_texture_mirrored_repeat;
 int GLAD_GL_ARB_window_pos;
+int GLAD_GL_ARB_buffer_storage;
+int GLAD_GL_ARB_map_buffer_range;
+int GLAD_GL_ARB_sync;
 int GLAD_GL_EXT_multi_draw_arrays;
 int GLAD_GL_EXT_compiled_vertex_array;
 int GLAD_GL_ARB_shadow;
@@ -717,6 +723,16 @@ PFNGLLOADTRANSPOSEMATRIXFARBPROC glad_glLoadTransposeMatrixfARB;
 PFNGLLOADTRANSPOSEMATRIXDARBPROC glad_glLoadTransposeMatrixdARB;
 PFNGLMULTTRANSPOSEMATRIXFARBPROC glad_glMultTransposeMatrixfARB;
 PFNGLMULTTRANSPOSEMATRIXDARBPROC glad_glMultTransposeMatrixdARB;
+PFNGLBUFFERSTORAGEPROC glad_glBufferStorage;
+PFNGLMAPBUFFERRANGEPROC glad_glMapBufferRange;
+PFNGLFLUSHMAPPEDBUFFERRANGEPROC glad_glFlushMappedBufferRange;
+PFNGLFENCESYNCPROC glad_glFenceSync;
+PFNGLISSYNCPROC glad_glIsSync;
+PFNGLDELETESYNCPROC glad_glDeleteSync;
+PFNGLCLIENTWAITSYNCPROC glad_glClientWaitSync;
+PFNGLWAITSYNCPROC glad_glWaitSync;
+PFNGLGETINTEGER64VPROC glad_glGetInteger64v;
+PFNGLGETSYNCIVPROC glad_glGetSynciv;
 PFNGLBINDBUFFERARBPROC glad_glBindBufferARB;
 PFNGLDELETEBUFFERSARBPROC glad_glDeleteBuffersARB;
 PFNGLGENBUFFERSARBPROC glad_glGenBuffersARB;
@@ -1095,6 +1111,10 @@ static void load_GL_VERSION_2_1(GLADloadproc load) {
 	glad_glUniformMatrix3x4fv = (PFNGLUNIFORMMATRIX3X4FVPROC)load("glUniformMatrix3x4fv");
 	glad_glUniformMatrix4x3fv = (PFNGLUNIFORMMATRIX4X3FVPROC)load("glUniformMatrix4x3fv");
 }
+static void load_GL_ARB_buffer_storage(GLADloadproc load) {
+	if(!GLAD_GL_ARB_buffer_storage) return;
+	glad_glBufferStorage = (PFNGLBUFFERSTORAGEPROC)load("glBufferStorage");
+}
 static void load_GL_ARB_color_buffer_float(GLADloadproc load) {
 	if(!GLAD_GL_ARB_color_buffer_float) return;
 	glad_glClampColorARB = (PFNGLCLAMPCOLORARBPROC)load("glClampColorARB");
@@ -1125,6 +1145,11 @@ static void load_GL_ARB_fragment_program(GLADloadproc load) {
 	glad_glGetProgramStringARB = (PFNGLGETPROGRAMSTRINGARBPROC)load("glGetProgramStringARB");
 	glad_glIsProgramARB = (PFNGLISPROGRAMARBPROC)load("glIsProgramARB");
 }
+static void load_GL_ARB_map_buffer_range(GLADloadproc load) {
+	if(!GLAD_GL_ARB_map_buffer_range) return;
+	glad_glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)load("glMapBufferRange");
+	glad_glFlushMappedBufferRange = (PFNGLFLUSHMAPPEDBUFFERRANGEPROC)load("glFlushMappedBufferRange");
+}
 static void load_GL_ARB_multisample(GLADloadproc load) {
 	if(!GLAD_GL_ARB_multisample) return;
 	glad_glSampleCoverageARB = (PFNGLSAMPLECOVERAGEARBPROC)load("glSampleCoverageARB");
@@ -1224,6 +1249,16 @@ static void load_GL_ARB_shader_objects(GLADloadproc load) {
 	glad_glGetUniformivARB = (PFNGLGETUNIFORMIVARBPROC)load("glGetUniformivARB");
 	glad_glGetShaderSourceARB = (PFNGLGETSHADERSOURCEARBPROC)load("glGetShaderSourceARB");
 }
+static void load_GL_ARB_sync(GLADloadproc load) {
+	if(!GLAD_GL_ARB_sync) return;
+	glad_glFenceSync = (PFNGLFENCESYNCPROC)load("glFenceSync");
+	glad_glIsSync = (PFNGLISSYNCPROC)load("glIsSync");
+	glad_glDeleteSync = (PFNGLDELETESYNCPROC)load("glDeleteSync");
+	glad_glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)load("glClientWaitSync");
+	glad_glWaitSync = (PFNGLWAITSYNCPROC)load("glWaitSync");
+	glad_glGetInteger64v = (PFNGLGETINTEGER64VPROC)load("glGetInteger64v");
+	glad_glGetSynciv = (PFNGLGETSYNCIVPROC)load("glGetSynciv");
+}
 static void load_GL_ARB_texture_compression(GLADloadproc load) {
 	if(!GLAD_GL_ARB_texture_compression) return;
 	glad_glCompressedTexImage3DARB = (PFNGLCOMPRESSEDTEXIMAGE3DARBPROC)load("glCompressedTexImage3DARB");
@@ -1531,12 +1566,14 @@ static void load_GL_NV_point_sprite(GLADloadproc load) {
 static int find_extensionsGL(void) {
 	if (!get_exts()) return 0;
 	GLAD_GL_3DFX_texture_compression_FXT1 = has_ext("GL_3DFX_texture_compression_FXT1");
+	GLAD_GL_ARB_buffer_storage = has_ext("GL_ARB_buffer_storage");
 	GLAD_GL_ARB_color_buffer_float = has_ext("GL_ARB_color_buffer_float");
 	GLAD_GL_ARB_depth_texture = has_ext("GL_ARB_depth_texture");
 	GLAD_GL_ARB_draw_buffers = has_ext("GL_ARB_draw_buffers");
 	GLAD_GL_ARB_fragment_program = has_ext("GL_ARB_fragment_program");
 	GLAD_GL_ARB_fragment_shader = has_ext("GL_ARB_fragment_shader");
 	GLAD_GL_ARB_half_float_pixel = has_ext("GL_ARB_half_float_pixel");
+	GLAD_GL_ARB_map_buffer_range = has_ext("GL_ARB_map_buffer_range");
 	GLAD_GL_ARB_multisample = has_ext("GL_ARB_multisample");
 	GLAD_GL_ARB_multitexture = has_ext("GL_ARB_multitexture");
 	GLAD_GL_ARB_occlusion_query = has_ext("GL_ARB_occlusion_query");
@@ -1546,6 +1583,7 @@ static int find_extensionsGL(void) {
 	GLAD_GL_ARB_shader_objects = has_ext("GL_ARB_shader_objects");
 	GLAD_GL_ARB_shading_language_100 = has_ext("GL_ARB_shading_language_100");
 	GLAD_GL_ARB_shadow = has_ext("GL_ARB_shadow");
+	GLAD_GL_ARB_sync = has_ext("GL_ARB_sync");
 	GLAD_GL_ARB_texture_border_clamp = has_ext("GL_ARB_texture_border_clamp");
 	GLAD_GL_ARB_texture_compression = has_ext("GL_ARB_texture_compression");
 	GLAD_GL_ARB_texture_cube_map = has_ext("GL_ARB_texture_cube_map");
@@ -1679,14 +1717,17 @@ int gladLoadGLLoader(GLADloadproc load) {
 	load_GL_VERSION_2_1(load);
 
 	if (!find_extensionsGL()) return 0;
+	load_GL_ARB_buffer_storage(load);
 	load_GL_ARB_color_buffer_float(load);
 	load_GL_ARB_draw_buffers(load);
 	load_GL_ARB_fragment_program(load);
+	load_GL_ARB_map_buffer_range(load);
 	load_GL_ARB_multisample(load);
 	load_GL_ARB_multitexture(load);
 	load_GL_ARB_occlusion_query(load);
 	load_GL_ARB_point_parameters(load);
 	load_GL_ARB_shader_objects(load);
+	load_GL_ARB_sync(load);
 	load_GL_ARB_texture_compression(load);
 	load_GL_ARB_transpose_matrix(load);
 	load_GL_ARB_vertex_buffer_object(load);
@@ -0,0 +1,318 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-15
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+
+//
+// Renders ships offscreen, in all render modes, and reports how long each render pass
+// took. The GL context is a surfaceless EGL one, hence this runs without a display -
+// and without a GPU, via Mesa's software rasterizer.
+//
+
+#include <GameLib/GameController.h>
+#include <GameLib/GameOpenGL.h>
+#include <GameLib/GameTypes.h>
+#include <GameLib/Log.h>
+#include <GameLib/RenderStatistics.h>
+#include <GameLib/ResourceLoader.h>
+#include <GameLib/Trace.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace /* anonymous */ {
+
+    struct Configuration
+    {
+        ShipRenderMode RenderMode;
+        char const * RenderModeName;
+        bool ShowStressedSprings;
+    };
+
+    Configuration const Configurations[] = {
+        { ShipRenderMode::Points, "Points", false },
+        { ShipRenderMode::Points, "Points", true },
+        { ShipRenderMode::Springs, "Springs", false },
+        { ShipRenderMode::Springs, "Springs", true },
+        { ShipRenderMode::Structure, "Structure", false },
+        { ShipRenderMode::Structure, "Structure", true },
+        { ShipRenderMode::Texture, "Texture", false },
+        { ShipRenderMode::Texture, "Texture", true }
+    };
+
+    // GL_DEPTH24_STENCIL8_EXT, from EXT_packed_depth_stencil - which our GLAD does not load
+    static constexpr GLenum DepthStencilFormat = 0x88F0;
+
+    /*
+     * An offscreen GL context, rendering into a framebuffer object.
+     */
+    class OffscreenContext
+    {
+    public:
+
+        OffscreenContext(
+            int width,
+            int height)
+        {
+            //
+            // Create context
+            //
+
+            mDisplay = eglGetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (EGL_NO_DISPLAY == mDisplay || !eglInitialize(mDisplay, nullptr, nullptr))
+            {
+                throw std::runtime_error("Cannot initialize the surfaceless EGL display");
+            }
+
+            if (!eglBindAPI(EGL_OPENGL_API))
+            {
+                throw std::runtime_error("Cannot bind the OpenGL API");
+            }
+
+            // We render with the compatibility profile, as the game does
+            mContext = eglCreateContext(mDisplay, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, nullptr);
+            if (EGL_NO_CONTEXT == mContext
+                || !eglMakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, mContext))
+            {
+                throw std::runtime_error("Cannot create the OpenGL context");
+            }
+
+            if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress)))
+            {
+                throw std::runtime_error("Failed to initialize GLAD");
+            }
+
+            //
+            // Create framebuffer, with a colour buffer and a depth-stencil buffer
+            //
+
+            if (!GLAD_GL_EXT_framebuffer_object)
+            {
+                throw std::runtime_error("The OpenGL implementation does not support framebuffer objects");
+            }
+
+            glGenFramebuffersEXT(1, &mFramebuffer);
+            glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, mFramebuffer);
+
+            glGenRenderbuffersEXT(2, mRenderbuffers);
+
+            glBindRenderbufferEXT(GL_RENDERBUFFER_EXT, mRenderbuffers[0]);
+            glRenderbufferStorageEXT(GL_RENDERBUFFER_EXT, GL_RGBA8, width, height);
+            glFramebufferRenderbufferEXT(GL_FRAMEBUFFER_EXT, GL_COLOR_ATTACHMENT0_EXT, GL_RENDERBUFFER_EXT, mRenderbuffers[0]);
+
+            glBindRenderbufferEXT(GL_RENDERBUFFER_EXT, mRenderbuffers[1]);
+            glRenderbufferStorageEXT(GL_RENDERBUFFER_EXT, DepthStencilFormat, width, height);
+            glFramebufferRenderbufferEXT(GL_FRAMEBUFFER_EXT, GL_DEPTH_ATTACHMENT_EXT, GL_RENDERBUFFER_EXT, mRenderbuffers[1]);
+            glFramebufferRenderbufferEXT(GL_FRAMEBUFFER_EXT, GL_STENCIL_ATTACHMENT_EXT, GL_RENDERBUFFER_EXT, mRenderbuffers[1]);
+
+            if (GL_FRAMEBUFFER_COMPLETE_EXT != glCheckFramebufferStatusEXT(GL_FRAMEBUFFER_EXT))
+            {
+                throw std::runtime_error("Cannot create the offscreen framebuffer");
+            }
+        }
+
+        ~OffscreenContext()
+        {
+            glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, 0);
+            glDeleteRenderbuffersEXT(2, mRenderbuffers);
+            glDeleteFramebuffersEXT(1, &mFramebuffer);
+
+            eglMakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            eglDestroyContext(mDisplay, mContext);
+            eglTerminate(mDisplay);
+        }
+
+        std::string GetRenderer() const
+        {
+            return std::string(reinterpret_cast<char const *>(glGetString(GL_RENDERER)));
+        }
+
+    private:
+
+        EGLDisplay mDisplay;
+        EGLContext mContext;
+        GLuint mFramebuffer;
+        GLuint mRenderbuffers[2];
+    };
+
+    float ToMillis(std::chrono::steady_clock::duration duration)
+    {
+        return std::chrono::duration<float, std::milli>(duration).count();
+    }
+
+    void PrintHeader()
+    {
+        std::cout
+            << std::left << std::setw(10) << "Mode"
+            << std::setw(8) << "Stress"
+            << std::right
+            << std::setw(10) << "Frame"
+            << std::setw(10) << "Clouds"
+            << std::setw(10) << "Land"
+            << std::setw(10) << "Water"
+            << std::setw(10) << "Points"
+            << std::setw(10) << "Springs"
+            << std::setw(10) << "Triangles"
+            << std::endl;
+    }
+
+    void PrintAverages(
+        Configuration const & configuration,
+        RenderStatistics const & totals,
+        int frames)
+    {
+        auto const average = [frames](std::chrono::steady_clock::duration duration)
+        {
+            return ToMillis(duration) / static_cast<float>(frames);
+        };
+
+        std::cout
+            << std::left << std::setw(10) << configuration.RenderModeName
+            << std::setw(8) << (configuration.ShowStressedSprings ? "On" : "Off")
+            << std::right << std::fixed << std::setprecision(3)
+            << std::setw(10) << average(totals.FrameDuration)
+            << std::setw(10) << average(totals.CloudsDuration)
+            << std::setw(10) << average(totals.LandDuration)
+            << std::setw(10) << average(totals.WaterDuration)
+            << std::setw(10) << average(totals.ShipPointsDuration)
+            << std::setw(10) << average(totals.ShipSpringsDuration)
+            << std::setw(10) << average(totals.ShipTrianglesDuration)
+            << std::endl;
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    int width = 1024;
+    int height = 768;
+    int warmupFrames = 10;
+    int frames = 100;
+    std::vector<std::filesystem::path> shipFilepaths;
+    std::filesystem::path traceFilepath;
+
+    for (int a = 1; a < argc; ++a)
+    {
+        std::string const arg(argv[a]);
+        if (arg == "--frames" && a + 1 < argc)
+            frames = std::atoi(argv[++a]);
+        else if (arg == "--warmup" && a + 1 < argc)
+            warmupFrames = std::atoi(argv[++a]);
+        else if (arg == "--width" && a + 1 < argc)
+            width = std::atoi(argv[++a]);
+        else if (arg == "--height" && a + 1 < argc)
+            height = std::atoi(argv[++a]);
+        else if (arg == "--trace" && a + 1 < argc)
+            traceFilepath = argv[++a];
+        else if (arg.rfind("--", 0) == 0)
+        {
+            std::cerr << "Usage: RenderBenchmark [--frames N] [--warmup N] [--width W] [--height H] [--trace <trace file>] [<ship file>...]" << std::endl;
+            return 1;
+        }
+        else
+            shipFilepaths.emplace_back(arg);
+    }
+
+    if (frames <= 0 || width <= 0 || height <= 0)
+    {
+        std::cerr << "Frames and canvas size must be positive" << std::endl;
+        return 1;
+    }
+
+    // Keep the game's own logging out of the report
+    Logger::Instance.SetLevel(LogLevel::None);
+
+    try
+    {
+        // Trace everything, from the creation of the game onwards
+        if (!traceFilepath.empty())
+        {
+            Tracer::Instance.SetThreadName("Main");
+            Tracer::Instance.Start();
+        }
+
+        OffscreenContext offscreenContext(width, height);
+
+        auto resourceLoader = std::make_shared<ResourceLoader>();
+
+        if (shipFilepaths.empty())
+        {
+            shipFilepaths.push_back(resourceLoader->GetDefaultShipDefinitionFilePath());
+        }
+
+        auto gameController = GameController::Create(
+            resourceLoader,
+            [](float, std::string const &) {});
+
+        gameController->SetCanvasSize(width, height);
+        gameController->SetSynchronousRenderStatistics(true);
+
+        std::cout << "Renderer: " << offscreenContext.GetRenderer() << std::endl;
+        std::cout << "Canvas: " << width << "x" << height << ", " << frames << " frames, average ms per frame" << std::endl;
+
+        for (auto const & shipFilepath : shipFilepaths)
+        {
+            std::cout << std::endl << shipFilepath.filename().string() << std::endl;
+
+            PrintHeader();
+
+            for (auto const & configuration : Configurations)
+            {
+                // Start each configuration from the same state, so that all configurations
+                // render the same frames
+                gameController->ResetAndLoadShip(shipFilepath);
+
+                gameController->SetShipRenderMode(configuration.RenderMode);
+                gameController->SetShowShipStress(configuration.ShowStressedSprings);
+
+                for (int f = 0; f < warmupFrames; ++f)
+                {
+                    gameController->DoStep();
+                    gameController->Render();
+                }
+
+                RenderStatistics totals;
+                for (int f = 0; f < frames; ++f)
+                {
+                    gameController->DoStep();
+                    gameController->Render();
+
+                    auto const & frameStatistics = gameController->GetLastFrameRenderStatistics();
+                    totals.FrameDuration += frameStatistics.FrameDuration;
+                    totals.CloudsDuration += frameStatistics.CloudsDuration;
+                    totals.LandDuration += frameStatistics.LandDuration;
+                    totals.WaterDuration += frameStatistics.WaterDuration;
+                    totals.ShipPointsDuration += frameStatistics.ShipPointsDuration;
+                    totals.ShipSpringsDuration += frameStatistics.ShipSpringsDuration;
+                    totals.ShipTrianglesDuration += frameStatistics.ShipTrianglesDuration;
+                }
+
+                PrintAverages(configuration, totals, frames);
+            }
+        }
+
+        if (!traceFilepath.empty())
+        {
+            Tracer::Instance.Stop();
+            Tracer::Instance.ExportChromeTrace(traceFilepath);
+        }
+    }
+    catch (std::exception const & ex)
+    {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-08
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+
+//
+// Replays an input recording against the world it was recorded with, without any
+// UI nor rendering, and reports how long the simulation took; optionally, it also saves
+// a trace of the replay.
+//
+
+#include <GameLib/GameEventDispatcher.h>
+#include <GameLib/InputRecording.h>
+#include <GameLib/ResourceLoader.h>
+#include <GameLib/Trace.h>
+
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+
+int main(int argc, char ** argv)
+{
+    if (argc != 2 && argc != 3)
+    {
+        std::cerr << "Usage: Replayer <recording file> [<trace file>]" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        if (argc == 3)
+        {
+            Tracer::Instance.SetThreadName("Main");
+            Tracer::Instance.Start();
+        }
+
+        ResourceLoader resourceLoader;
+        MaterialDatabase materials = resourceLoader.LoadMaterials();
+
+        auto gameEventDispatcher = std::make_shared<GameEventDispatcher>();
+
+        auto replayer = InputReplayer::Load(
+            argv[1],
+            gameEventDispatcher,
+            materials);
+
+        auto const startTime = std::chrono::steady_clock::now();
+
+        while (!replayer->IsAtEnd())
+        {
+            replayer->Step();
+
+            gameEventDispatcher->Flush();
+        }
+
+        auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+        std::cout << "Steps: " << replayer->GetStepCount() << std::endl;
+        std::cout << "Total: " << static_cast<float>(elapsed.count()) / 1000.0f << "ms" << std::endl;
+        if (replayer->GetStepCount() > 0)
+        {
+            std::cout << "Per step: " << static_cast<float>(elapsed.count()) / 1000.0f / static_cast<float>(replayer->GetStepCount()) << "ms" << std::endl;
+        }
+
+        if (argc == 3)
+        {
+            Tracer::Instance.Stop();
+            Tracer::Instance.ExportChromeTrace(std::filesystem::path(argv[2]));
+        }
+    }
+    catch (std::exception const & ex)
+    {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -54,8 +54,13 @@ void LoggingDialog::Open()
 	Logger::Instance.RegisterListener(
 		[this](std::string const & message)
 		{
-			assert(this->mTextCtrl != nullptr);
-			this->mTextCtrl->WriteText(message);
+			// Invoked on the logger's thread
+			this->CallAfter(
+				[this, message]()
+				{
+					assert(this->mTextCtrl != nullptr);
+					this->mTextCtrl->WriteText(message);
+				});
 		});
 
 	this->Show();
@@ -12,6 +12,8 @@
 
 #include "MainFrame.h"
 
+#include <GameLib/Trace.h>
+
 #include <wx/app.h>
 
 #ifdef FLOATING_POINT_CHECKS
@@ -41,6 +43,16 @@ bool MainApp::OnInit()
 	wxInitAllImageHandlers();
 
 
+    //
+    // Trace from the very start, if asked to; the trace is saved when tracing is stopped
+    //
+
+    for (int a = 1; a < argc; ++a)
+    {
+        if (argv[a] == "--trace")
+            Tracer::Instance.Start();
+    }
+
 
     //
     // Create frame and start
@@ -7,11 +7,13 @@
 ***************************************************************************************/
 #include "MainFrame.h"
 
+#include "SfmlAudioDevice.h"
 #include "SplashScreenDialog.h"
 #include "Version.h"
 
 #include <GameLib/GameException.h>
 #include <GameLib/Log.h>
+#include <GameLib/Trace.h>
 #include <GameLib/Utils.h>
 
 #include <wx/intl.h>
@@ -30,6 +32,10 @@ const long ID_MAIN_CANVAS = wxNewId();
 
 const long ID_LOAD_SHIP_MENUITEM = wxNewId();
 const long ID_RELOAD_LAST_SHIP_MENUITEM = wxNewId();
+const long ID_SAVE_SNAPSHOT_MENUITEM = wxNewId();
+const long ID_LOAD_SNAPSHOT_MENUITEM = wxNewId();
+const long ID_RECORD_INPUT_MENUITEM = wxNewId();
+const long ID_TRACE_MENUITEM = wxNewId();
 const long ID_QUIT_MENUITEM = wxNewId();
 
 const long ID_ZOOM_IN_MENUITEM = wxNewId();
@@ -78,6 +84,8 @@ MainFrame::MainFrame(wxApp * mainApp)
     , mStatsLastTimestampReal(std::chrono::steady_clock::time_point::min())
     , mStatsOriginTimestampGame(GameWallClock::time_point::min())
 {
+    Tracer::Instance.SetThreadName("Main");
+
     Create(
         nullptr, 
         wxID_ANY,
@@ -164,6 +172,22 @@ MainFrame::MainFrame(wxApp * mainApp)
     fileMenu->Append(reloadLastShipMenuItem);
     Connect(ID_RELOAD_LAST_SHIP_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnReloadLastShipMenuItemSelected);
 
+    wxMenuItem * saveSnapshotMenuItem = new wxMenuItem(fileMenu, ID_SAVE_SNAPSHOT_MENUITEM, _("Save Snapshot\tCtrl+Shift+S"), wxEmptyString, wxITEM_NORMAL);
+    fileMenu->Append(saveSnapshotMenuItem);
+    Connect(ID_SAVE_SNAPSHOT_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnSaveSnapshotMenuItemSelected);
+
+    wxMenuItem * loadSnapshotMenuItem = new wxMenuItem(fileMenu, ID_LOAD_SNAPSHOT_MENUITEM, _("Load Snapshot\tCtrl+Shift+O"), wxEmptyString, wxITEM_NORMAL);
+    fileMenu->Append(loadSnapshotMenuItem);
+    Connect(ID_LOAD_SNAPSHOT_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnLoadSnapshotMenuItemSelected);
+
+    wxMenuItem * recordInputMenuItem = new wxMenuItem(fileMenu, ID_RECORD_INPUT_MENUITEM, _("Start/Stop Recording\tCtrl+Shift+R"), _("Record the interactions with the world, for replaying them headless"), wxITEM_NORMAL);
+    fileMenu->Append(recordInputMenuItem);
+    Connect(ID_RECORD_INPUT_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnRecordInputMenuItemSelected);
+
+    wxMenuItem * traceMenuItem = new wxMenuItem(fileMenu, ID_TRACE_MENUITEM, _("Start/Stop Tracing\tCtrl+Shift+T"), _("Trace where time goes, for viewing in a trace viewer"), wxITEM_NORMAL);
+    fileMenu->Append(traceMenuItem);
+    Connect(ID_TRACE_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnTraceMenuItemSelected);
+
     wxMenuItem* quitMenuItem = new wxMenuItem(fileMenu, ID_QUIT_MENUITEM, _("Quit\tAlt-F4"), _("Quit the application"), wxITEM_NORMAL);
     fileMenu->Append(quitMenuItem);
     Connect(ID_QUIT_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnQuit);
@@ -286,6 +310,13 @@ MainFrame::MainFrame(wxApp * mainApp)
 
     SetMenuBar(mainMenuBar);
 
+
+    //
+    // Status bar
+    //
+
+    CreateStatusBar();
+
     //
     // Event ticker panel
     //
@@ -384,6 +415,8 @@ void MainFrame::OnPostInitializeTrigger(wxTimerEvent & /*event*/)
     {
         mSoundController = std::make_unique<SoundController>(
             mResourceLoader,
+            std::make_unique<SfmlAudioDevice>(),
+            std::make_unique<SoundCache>(mResourceLoader->GetSoundCacheDirectoryPath()),
             [&splash, this](float progress, std::string const & message)
             {
                 splash->UpdateProgress(0.5f + progress / 2.0f, message);
@@ -503,6 +536,19 @@ void MainFrame::OnMainFrameClose(wxCloseEvent & /*event*/)
     if (!!mLowFrequencyTimer)
         mLowFrequencyTimer->Stop();
 
+    // Save the recording in progress, if any
+    if (!!mGameController)
+    {
+        try
+        {
+            mGameController->StopRecording();
+        }
+        catch (std::exception const & ex)
+        {
+            LogMessage("Cannot save recording: ", ex.what());
+        }
+    }
+
     Destroy();
 }
 
@@ -691,7 +737,24 @@ void MainFrame::OnLoadShipMenuItemSelected(wxCommandEvent & /*event*/)
         assert(!!mGameController);
         try
         {
-            mGameController->ResetAndLoadShip(filename);
+            // Load the ship in the background, while the current world keeps running
+            mGameController->ResetAndLoadShipAsync(
+                filename,
+                [this](float progress, std::string const & message)
+                {
+                    // Invoked on the loader's thread
+                    this->CallAfter(
+                        [this, progress, message]()
+                        {
+                            // Ignore progress that arrives after the load has completed
+                            if (!!mGameController && mGameController->IsLoadingShip())
+                            {
+                                SetStatusText(wxString::Format("%s %d%%", message, static_cast<int>(100.0f * progress)));
+                            }
+                        });
+                });
+
+            SetStatusText(_("Loading ship..."));
         }
         catch (std::exception const & ex)
         { 
@@ -715,6 +778,128 @@ void MainFrame::OnReloadLastShipMenuItemSelected(wxCommandEvent & /*event*/)
     }
 }
 
+void MainFrame::OnSaveSnapshotMenuItemSelected(wxCommandEvent & /*event*/)
+{
+    wxFileDialog snapshotSaveDialog(
+        this,
+        L"Save Snapshot",
+        wxEmptyString,
+        wxEmptyString,
+        L"Snapshot files (*.sss)|*.sss",
+        wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+
+    if (snapshotSaveDialog.ShowModal() == wxID_OK)
+    {
+        std::string filename = snapshotSaveDialog.GetPath().ToStdString();
+
+        assert(!!mGameController);
+        try
+        {
+            mGameController->SaveSnapshot(filename);
+        }
+        catch (std::exception const & ex)
+        {
+            Die(ex.what());
+        }
+    }
+}
+
+void MainFrame::OnLoadSnapshotMenuItemSelected(wxCommandEvent & /*event*/)
+{
+    wxFileDialog snapshotOpenDialog(
+        this,
+        L"Load Snapshot",
+        wxEmptyString,
+        wxEmptyString,
+        L"Snapshot files (*.sss)|*.sss",
+        wxFD_OPEN | wxFD_FILE_MUST_EXIST);
+
+    if (snapshotOpenDialog.ShowModal() == wxID_OK)
+    {
+        std::string filename = snapshotOpenDialog.GetPath().ToStdString();
+
+        ResetState();
+
+        assert(!!mGameController);
+        try
+        {
+            mGameController->LoadSnapshot(filename);
+        }
+        catch (std::exception const & ex)
+        {
+            Die(ex.what());
+        }
+    }
+}
+
+void MainFrame::OnRecordInputMenuItemSelected(wxCommandEvent & /*event*/)
+{
+    assert(!!mGameController);
+
+    if (mGameController->IsRecording())
+    {
+        try
+        {
+            mGameController->StopRecording();
+        }
+        catch (std::exception const & ex)
+        {
+            Die(ex.what());
+        }
+    }
+    else
+    {
+        wxFileDialog recordingSaveDialog(
+            this,
+            L"Start Recording",
+            wxEmptyString,
+            wxEmptyString,
+            L"Recording files (*.ssr)|*.ssr",
+            wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+
+        if (recordingSaveDialog.ShowModal() == wxID_OK)
+        {
+            std::string filename = recordingSaveDialog.GetPath().ToStdString();
+
+            mGameController->StartRecording(filename);
+        }
+    }
+}
+
+void MainFrame::OnTraceMenuItemSelected(wxCommandEvent & /*event*/)
+{
+    if (!Tracer::Instance.IsEnabled())
+    {
+        Tracer::Instance.Start();
+    }
+    else
+    {
+        Tracer::Instance.Stop();
+
+        wxFileDialog traceSaveDialog(
+            this,
+            L"Save Trace",
+            wxEmptyString,
+            wxEmptyString,
+            L"Trace files (*.json)|*.json",
+            wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+
+        if (traceSaveDialog.ShowModal() == wxID_OK)
+        {
+            std::string filename = traceSaveDialog.GetPath().ToStdString();
+
+            try
+            {
+                Tracer::Instance.ExportChromeTrace(std::filesystem::path(filename));
+            }
+            catch (std::exception const & ex)
+            {
+                Die(ex.what());
+            }
+        }
+    }
+}
+
 void MainFrame::OnPauseMenuItemSelected(wxCommandEvent & /*event*/)
 {
     if (IsPaused())
@@ -915,6 +1100,13 @@ void MainFrame::SetFrameTitle()
         << "  FPS: " << std::fixed << std::setprecision(2) << totalFps << " (" << lastFps << ")"
         << " " << std::setw(2) << minutesGame << ":" << std::setw(2) << secondsGame;
 
+    if (!!mGameController)
+    {
+        auto const & renderStatistics = mGameController->GetLastFrameRenderStatistics();
+        ss << "  Upload: " << std::setprecision(3)
+            << std::chrono::duration<float, std::milli>(renderStatistics.PointUploadDuration).count() << "ms";
+    }
+
     if (!mCurrentShipNames.empty())
     {
         ss << " - "
@@ -961,8 +1153,16 @@ void MainFrame::RenderGame()
 {
     if (!!mGameController)
     {
-        // Render
-        mGameController->Render();
+        // Render - this is also where asynchronous ship loads complete
+        try
+        {
+            mGameController->Render();
+        }
+        catch (std::exception const & ex)
+        {
+            Die(ex.what());
+            return;
+        }
 
         // Flush all the draw operations and flip the back buffer onto the screen.  
         mMainGLCanvas->SwapBuffers();
@@ -113,6 +113,10 @@ private:
     void OnResetViewMenuItemSelected(wxCommandEvent& event);    
 	void OnLoadShipMenuItemSelected(wxCommandEvent& event);
 	void OnReloadLastShipMenuItemSelected(wxCommandEvent& event);
+    void OnSaveSnapshotMenuItemSelected(wxCommandEvent& event);
+    void OnLoadSnapshotMenuItemSelected(wxCommandEvent& event);
+    void OnRecordInputMenuItemSelected(wxCommandEvent& event);
+    void OnTraceMenuItemSelected(wxCommandEvent& event);
 	void OnSmashMenuItemSelected(wxCommandEvent& event);
     void OnSliceMenuItemSelected(wxCommandEvent& event);
 	void OnGrabMenuItemSelected(wxCommandEvent& event);
@@ -141,6 +145,9 @@ private:
         std::string const & name) override
     {
         mCurrentShipNames.push_back(name);
+
+        // Clear the progress of the load, if any
+        SetStatusText(wxEmptyString);
     }
 
     virtual void OnBombPlaced(
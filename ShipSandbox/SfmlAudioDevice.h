@@ -0,0 +1,78 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2018-07-16
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameLib/IAudioDevice.h>
+
+#include <SFML/Audio.hpp>
+
+#include <memory>
+
+/*
+ * The audio device that plays sounds via SFML.
+ */
+class SfmlAudioDevice : public IAudioDevice<sf::SoundBuffer>
+{
+public:
+
+    virtual std::unique_ptr<IAudioVoice<sf::SoundBuffer>> MakeVoice() override
+    {
+        return std::make_unique<SfmlAudioVoice>();
+    }
+
+private:
+
+    class SfmlAudioVoice : public IAudioVoice<sf::SoundBuffer>
+    {
+    public:
+
+        virtual void Play(
+            sf::SoundBuffer const & soundBuffer,
+            float volume) override
+        {
+            mSound.setBuffer(soundBuffer);
+            mSound.setVolume(volume);
+            mSound.play();
+        }
+
+        virtual void Stop() override
+        {
+            if (sf::Sound::Status::Stopped != mSound.getStatus())
+                mSound.stop();
+        }
+
+        virtual void Pause() override
+        {
+            if (sf::Sound::Status::Playing == mSound.getStatus())
+                mSound.pause();
+        }
+
+        virtual void Resume() override
+        {
+            if (sf::Sound::Status::Paused == mSound.getStatus())
+                mSound.play();
+        }
+
+        virtual bool IsStopped() const override
+        {
+            return sf::Sound::Status::Stopped == mSound.getStatus();
+        }
+
+        virtual float GetVolume() const override
+        {
+            return mSound.getVolume();
+        }
+
+        virtual void SetVolume(float volume) override
+        {
+            mSound.setVolume(volume);
+        }
+
+    private:
+
+        sf::Sound mSound;
+    };
+};
@@ -11,13 +11,70 @@
 #include <GameLib/Material.h>
 
 #include <cassert>
-#include <limits>
 #include <regex>
 
+namespace /* anonymous */ {
+
+    //
+    // Sound filename patterns
+    //
+
+    std::regex const SoundTypeRegex(R"(([^_]+)(?:_.+)?)");
+    std::regex const SawRegex(R"(([^_]+)(?:_(underwater))?)");
+    std::regex const MSURegex(R"(([^_]+)_([^_]+)_([^_]+)_(?:(underwater)_)?\d+)");
+    std::regex const URegex(R"(([^_]+)_(?:(underwater)_)?\d+)");
+
+    /*
+     * Runs on the decoding threads.
+     */
+    DecodedSound DecodeSound(
+        std::filesystem::path const & soundFilePath,
+        SoundCache const * soundCache)
+    {
+        std::optional<uint64_t> cacheKey;
+        if (nullptr != soundCache)
+        {
+            cacheKey = SoundCache::CalculateKey(soundFilePath);
+
+            std::optional<DecodedSound> cachedSound = soundCache->TryLoad(*cacheKey);
+            if (!!cachedSound)
+            {
+                return std::move(*cachedSound);
+            }
+        }
+
+        sf::InputSoundFile soundFile;
+        if (!soundFile.openFromFile(soundFilePath.string()))
+        {
+            throw GameException("Cannot open sound file \"" + soundFilePath.string() + "\"");
+        }
+
+        std::vector<int16_t> samples(static_cast<size_t>(soundFile.getSampleCount()));
+        samples.resize(static_cast<size_t>(soundFile.read(samples.data(), samples.size())));
+
+        DecodedSound decodedSound(
+            std::move(samples),
+            soundFile.getChannelCount(),
+            soundFile.getSampleRate());
+
+        if (!!cacheKey)
+        {
+            soundCache->Store(*cacheKey, decodedSound);
+        }
+
+        return decodedSound;
+    }
+}
+
 SoundController::SoundController(
     std::shared_ptr<ResourceLoader> resourceLoader,
+    std::unique_ptr<IAudioDevice<sf::SoundBuffer>> audioDevice,
+    std::unique_ptr<SoundCache> soundCache,
     ProgressCallback const & progressCallback)
     : mResourceLoader(std::move(resourceLoader))
+    , mAudioDevice(std::move(audioDevice))
+    , mSoundCache(std::move(soundCache))
+    , mDecodingThreadPool(TaskThreadPool::GetDefaultThreadCount())
     , mCurrentVolume(100.0f)
     // State
     , mBombsEmittingSlowFuseSounds()
@@ -25,7 +82,7 @@ SoundController::SoundController(
     // One-shot sounds
     , mMSUSoundBuffers()
     , mUSoundBuffers()
-    , mCurrentlyPlayingSounds()
+    , mOneShotVoices()
     // Continuous sounds
     , mSawAbovewaterSound()
     , mSawUnderwaterSound()
@@ -52,6 +109,12 @@ SoundController::SoundController(
     //
     // Initialize Sounds
     //
+    // Sounds are decoded on the decoding threads, frequent sounds first; a sound that
+    // is needed before its turn comes is decoded right away by whoever needs it
+    //
+
+    std::vector<std::shared_ptr<OnDemandTask<DecodedSound>>> frequentSoundDecodeTasks;
+    std::vector<std::shared_ptr<OnDemandTask<DecodedSound>>> rareSoundDecodeTasks;
 
     auto soundNames = mResourceLoader->GetSoundNames();
     for (size_t i = 0; i < soundNames.size(); ++i)
@@ -60,38 +123,45 @@ SoundController::SoundController(
 
         // Notify progress
         progressCallback(static_cast<float>(i + 1) / static_cast<float>(soundNames.size()), "Loading sounds...");
-        
-
-        //
-        // Load sound buffer
-        //
-
-        std::unique_ptr<sf::SoundBuffer> soundBuffer = std::make_unique<sf::SoundBuffer>();
-        if (!soundBuffer->loadFromFile(mResourceLoader->GetSoundFilepath(soundName).string()))
-        {
-            throw GameException("Cannot load sound \"" + soundName + "\"");
-        }
-
 
 
         //
         // Parse filename
-        //        
+        //
 
-        std::regex soundTypeRegex(R"(([^_]+)(?:_.+)?)");
         std::smatch soundTypeMatch;
-        if (!std::regex_match(soundName, soundTypeMatch, soundTypeRegex))
+        if (!std::regex_match(soundName, soundTypeMatch, SoundTypeRegex))
         {
             throw GameException("Sound filename \"" + soundName + "\" is not recognized");
         }
 
         assert(soundTypeMatch.size() == 1 + 1);
         SoundType soundType = StrToSoundType(soundTypeMatch[1].str());
+
+
+        //
+        // Prepare sound buffer
+        //
+
+        auto decodeTask = std::make_shared<OnDemandTask<DecodedSound>>(
+            [soundFilePath = mResourceLoader->GetSoundFilepath(soundName), soundCache = mSoundCache.get()]()
+            {
+                return DecodeSound(soundFilePath, soundCache);
+            });
+
+        if (IsFrequentSound(soundType))
+            frequentSoundDecodeTasks.push_back(decodeTask);
+        else
+            rareSoundDecodeTasks.push_back(decodeTask);
+
+        std::unique_ptr<LazySoundBuffer> soundBuffer = std::make_unique<LazySoundBuffer>(
+            soundName,
+            std::move(decodeTask));
+
         if (soundType == SoundType::Saw)
         {
-            std::regex sawRegex(R"(([^_]+)(?:_(underwater))?)");
             std::smatch uMatch;
-            if (!std::regex_match(soundName, uMatch, sawRegex))
+            if (!std::regex_match(soundName, uMatch, SawRegex))
             {
                 throw GameException("Saw sound filename \"" + soundName + "\" is not recognized");
             }
@@ -128,9 +198,8 @@ SoundController::SoundController(
             // MSU sound
             //
 
-            std::regex msuRegex(R"(([^_]+)_([^_]+)_([^_]+)_(?:(underwater)_)?\d+)");
             std::smatch msuMatch;
-            if (!std::regex_match(soundName, msuMatch, msuRegex))
+            if (!std::regex_match(soundName, msuMatch, MSURegex))
             {
                 throw GameException("MSU sound filename \"" + soundName + "\" is not recognized");
             }
@@ -169,9 +238,8 @@ SoundController::SoundController(
             // U sound
             //
 
-            std::regex uRegex(R"(([^_]+)_(?:(underwater)_)?\d+)");
             std::smatch uMatch;
-            if (!std::regex_match(soundName, uMatch, uRegex))
+            if (!std::regex_match(soundName, uMatch, URegex))
             {
                 throw GameException("U sound filename \"" + soundName + "\" is not recognized");
             }
@@ -199,6 +267,42 @@ SoundController::SoundController(
                 .SoundBuffers.emplace_back(std::move(soundBuffer));
         }
     }
+
+    // Start decoding
+    for (auto const & decodeTask : frequentSoundDecodeTasks)
+    {
+        OnDemandTask<DecodedSound>::Prefetch(decodeTask, mDecodingThreadPool);
+    }
+
+    for (auto const & decodeTask : rareSoundDecodeTasks)
+    {
+        OnDemandTask<DecodedSound>::Prefetch(decodeTask, mDecodingThreadPool);
+    }
+
+
+    //
+    // Initialize voices
+    //
+
+    size_t voiceKeyCount = 0;
+
+    for (auto & entry : mMSUSoundBuffers)
+    {
+        entry.second.FirstVoiceKey = voiceKeyCount;
+        voiceKeyCount += entry.second.SoundBuffers.size();
+    }
+
+    for (auto & entry : mUSoundBuffers)
+    {
+        entry.second.FirstVoiceKey = voiceKeyCount;
+        voiceKeyCount += entry.second.SoundBuffers.size();
+    }
+
+    mOneShotVoices = std::make_unique<VoicePool<sf::SoundBuffer>>(
+        *mAudioDevice,
+        MaxPlayingSounds,
+        voiceKeyCount,
+        MinDeltaTimeSound);
 }
 
 SoundController::~SoundController()
@@ -208,19 +312,7 @@ SoundController::~SoundController()
 
 void SoundController::SetPaused(bool isPaused)
 {
-    for (auto const & playingSound : mCurrentlyPlayingSounds)
-    {
-        if (isPaused)
-        {
-            if (sf::Sound::Status::Playing == playingSound.Sound->getStatus())
-                playingSound.Sound->pause();
-        }
-        else
-        {
-            if (sf::Sound::Status::Paused == playingSound.Sound->getStatus())
-                playingSound.Sound->play();
-        }
-    }
+    mOneShotVoices->SetPaused(isPaused);
 
     // We don't pause the continuous tool sounds
 
@@ -261,10 +353,10 @@ void SoundController::HighFrequencyUpdate()
 void SoundController::LowFrequencyUpdate()
 {
     //
-    // Scavenge stopped sounds
+    // Reclaim voices of stopped sounds
     //
 
-    ScavengeStoppedSounds();
+    mOneShotVoices->ReclaimStoppedVoices();
 }
 
 void SoundController::Reset()
@@ -273,16 +365,7 @@ void SoundController::Reset()
     // Stop and clear all sounds
     //
 
-    for (auto & playingSound : mCurrentlyPlayingSounds)
-    {
-        assert(!!playingSound.Sound);
-        if (sf::Sound::Status::Playing == playingSound.Sound->getStatus())
-        {
-            playingSound.Sound->stop();
-        }
-    }
-
-    mCurrentlyPlayingSounds.clear();
+    mOneShotVoices->StopAll();
 
     mSawAbovewaterSound.Stop();
     mSawUnderwaterSound.Stop();
@@ -663,148 +746,80 @@ void SoundController::ChooseAndPlaySound(
     MultipleSoundChoiceInfo & multipleSoundChoiceInfo,
     float volume)
 {
-    auto const now = std::chrono::steady_clock::now();
-
     //
     // Choose sound buffer
     //
 
-    sf::SoundBuffer * chosenSoundBuffer = nullptr;
+    size_t chosenSoundIndex;
 
     assert(!multipleSoundChoiceInfo.SoundBuffers.empty());
     if (1 == multipleSoundChoiceInfo.SoundBuffers.size())
     {
         // Nothing to choose
-        chosenSoundBuffer = multipleSoundChoiceInfo.SoundBuffers[0].get();
+        chosenSoundIndex = 0;
     }
     else
     {
         assert(multipleSoundChoiceInfo.SoundBuffers.size() >= 2);
 
         // Choose randomly, but avoid choosing the last-chosen sound again
-        size_t chosenSoundIndex = GameRandomEngine::GetInstance().ChooseNew(
+        chosenSoundIndex = GameRandomEngine::GetInstance().ChooseNew(
             multipleSoundChoiceInfo.SoundBuffers.size(),
             multipleSoundChoiceInfo.LastPlayedSoundIndex);
 
-        chosenSoundBuffer = multipleSoundChoiceInfo.SoundBuffers[chosenSoundIndex].get();
-
         multipleSoundChoiceInfo.LastPlayedSoundIndex = chosenSoundIndex;
     }
 
-    assert(nullptr != chosenSoundBuffer);
-
-    //
-    // Make sure there isn't already a sound with this sound buffer that started
-    // playing too recently;
-    // if there is, adjust its volume
-    //
-
-    for (auto const & currentlyPlayingSound : mCurrentlyPlayingSounds)
+    assert(!!multipleSoundChoiceInfo.SoundBuffers[chosenSoundIndex]);
+    sf::SoundBuffer const * chosenSoundBuffer = multipleSoundChoiceInfo.SoundBuffers[chosenSoundIndex]->Get();
+    if (nullptr == chosenSoundBuffer)
     {
-        assert(!!currentlyPlayingSound.Sound);
-        if (currentlyPlayingSound.Sound->getBuffer() == chosenSoundBuffer
-            && std::chrono::duration_cast<std::chrono::milliseconds>(now - currentlyPlayingSound.StartedTimestamp) < MinDeltaTimeSound)
-        {
-            currentlyPlayingSound.Sound->setVolume(
-                std::max(
-                    100.0f,
-                    currentlyPlayingSound.Sound->getVolume() + volume));
-
-            return;
-        }
-    }
-
-
-    //
-    // Make sure there's room for this sound
-    //
-
-    if (mCurrentlyPlayingSounds.size() >= MaxPlayingSounds)
-    {
-        ScavengeStoppedSounds();
-
-        if (mCurrentlyPlayingSounds.size() >= MaxPlayingSounds)
-        { 
-            // Need to stop sound that's been playing for the longest
-            ScavengeOldestSound(soundType);
-        }
+        // Couldn't load it
+        return;
     }
 
-    assert(mCurrentlyPlayingSounds.size() < MaxPlayingSounds);
-
-
-
     //
-    // Create and play sound
+    // Play sound
     //
 
-    std::unique_ptr<sf::Sound> sound = std::make_unique<sf::Sound>();
-    sound->setBuffer(*chosenSoundBuffer);
-
-    sound->setVolume(volume);
-    sound->play();    
-
-    mCurrentlyPlayingSounds.emplace_back(
-        soundType,
-        std::move(sound),
-        now);
+    mOneShotVoices->Play(
+        multipleSoundChoiceInfo.FirstVoiceKey + chosenSoundIndex,
+        *chosenSoundBuffer,
+        volume,
+        GetSoundPriority(soundType),
+        std::chrono::steady_clock::now());
 }
 
-void SoundController::ScavengeStoppedSounds()
+sf::SoundBuffer const * SoundController::LazySoundBuffer::Get()
 {
-    for (size_t i = 0; i < mCurrentlyPlayingSounds.size(); /*incremented in loop*/)
+    if (!mSoundBuffer && !!mDecodeTask)
     {
-        assert(!!mCurrentlyPlayingSounds[i].Sound);
-        if (sf::Sound::Status::Stopped == mCurrentlyPlayingSounds[i].Sound->getStatus())
-        {
-            // Scavenge
-            mCurrentlyPlayingSounds.erase(mCurrentlyPlayingSounds.begin() + i);
-        }
-        else
+        try
         {
-            ++i;
-        }
-    }
-}
-
-void SoundController::ScavengeOldestSound(SoundType soundType)
-{
-    assert(!mCurrentlyPlayingSounds.empty());
+            DecodedSound const & decodedSound = mDecodeTask->Get();
+
+            auto soundBuffer = std::make_unique<sf::SoundBuffer>();
+            if (!soundBuffer->loadFromSamples(
+                decodedSound.GetSamples(),
+                decodedSound.GetSampleCount(),
+                decodedSound.GetChannelCount(),
+                decodedSound.GetSampleRate()))
+            {
+                throw GameException("Cannot make sound buffer");
+            }
 
-    size_t iOldestSound = std::numeric_limits<size_t>::max();
-    auto oldestSoundStartTimestamp = std::chrono::steady_clock::time_point::max();
-    size_t iOldestSoundForType = std::numeric_limits<size_t>::max();
-    auto oldestSoundForTypeStartTimestamp = std::chrono::steady_clock::time_point::max();    
-    for (size_t i = 0; i < mCurrentlyPlayingSounds.size(); ++i)
-    {
-        if (mCurrentlyPlayingSounds[i].StartedTimestamp < oldestSoundStartTimestamp)
-        {
-            iOldestSound = i;
-            oldestSoundStartTimestamp = mCurrentlyPlayingSounds[i].StartedTimestamp;
+            mSoundBuffer = std::move(soundBuffer);
         }
-
-        if (mCurrentlyPlayingSounds[i].StartedTimestamp < oldestSoundForTypeStartTimestamp
-            && mCurrentlyPlayingSounds[i].Type == soundType)
+        catch (std::exception const & ex)
         {
-            iOldestSoundForType = i;
-            oldestSoundForTypeStartTimestamp = mCurrentlyPlayingSounds[i].StartedTimestamp;
+            LogMessage("Cannot load sound \"", mSoundName, "\": ", ex.what());
         }
-    }
 
-    size_t iStop;
-    if (oldestSoundForTypeStartTimestamp != std::chrono::steady_clock::time_point::max())
-    {
-        iStop = iOldestSoundForType;
-    }
-    else 
-    {
-        assert((oldestSoundStartTimestamp != std::chrono::steady_clock::time_point::max()));
-        iStop = iOldestSound;
+        // Either way, we're done with it
+        mDecodeTask.reset();
     }
 
-    assert(!!mCurrentlyPlayingSounds[iStop].Sound);
-    mCurrentlyPlayingSounds[iStop].Sound->stop();
-    mCurrentlyPlayingSounds.erase(mCurrentlyPlayingSounds.begin() + iStop);
+    return mSoundBuffer.get();
 }
 
 void SoundController::UpdateContinuousSound(
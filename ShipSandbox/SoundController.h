@@ -5,10 +5,14 @@
 ***************************************************************************************/
 #pragma once
 
+#include <GameLib/IAudioDevice.h>
 #include <GameLib/IGameEventHandler.h>
 #include <GameLib/ResourceLoader.h>
+#include <GameLib/SoundCache.h>
+#include <GameLib/TaskThreadPool.h>
 #include <GameLib/TupleKeys.h>
 #include <GameLib/Utils.h>
+#include <GameLib/VoicePool.h>
 
 #include <SFML/Audio.hpp>
 
@@ -24,6 +28,8 @@ public:
 
     SoundController(
         std::shared_ptr<ResourceLoader> resourceLoader,
+        std::unique_ptr<IAudioDevice<sf::SoundBuffer>> audioDevice,
+        std::unique_ptr<SoundCache> soundCache,
         ProgressCallback const & progressCallback);
 
 	virtual ~SoundController();
@@ -158,6 +164,49 @@ private:
             throw GameException("Unrecognized SoundType \"" + str + "\"");
     }
 
+    /*
+     * Sounds that are likely to be played soon after startup; these are decoded first.
+     */
+    static bool IsFrequentSound(SoundType soundType)
+    {
+        switch (soundType)
+        {
+            case SoundType::Break:
+            case SoundType::Destroy:
+            case SoundType::Draw:
+            case SoundType::Saw:
+            case SoundType::Stress:
+            case SoundType::Swirl:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    /*
+     * When we run out of voices, sounds with a higher priority take the voices
+     * of sounds with a lower priority.
+     */
+    static int GetSoundPriority(SoundType soundType)
+    {
+        switch (soundType)
+        {
+            case SoundType::Stress:
+                return 0;
+
+            case SoundType::Break:
+            case SoundType::Destroy:
+                return 1;
+
+            case SoundType::Explosion:
+                return 3;
+
+            default:
+                return 2;
+        }
+    }
+
     enum class SizeType : int
     {
         Min = 0,
@@ -185,31 +234,50 @@ private:
 
 private:
 
+    /*
+     * A sound buffer whose sound is decoded in the background, or on first use if it
+     * hasn't been decoded by then.
+     */
+    class LazySoundBuffer
+    {
+    public:
+
+        LazySoundBuffer(
+            std::string soundName,
+            std::shared_ptr<OnDemandTask<DecodedSound>> decodeTask)
+            : mSoundName(std::move(soundName))
+            , mDecodeTask(std::move(decodeTask))
+            , mSoundBuffer()
+        {
+        }
+
+        /*
+         * Returns nullptr if the sound cannot be loaded.
+         */
+        sf::SoundBuffer const * Get();
+
+    private:
+
+        std::string const mSoundName;
+
+        // Released once the buffer has been made
+        std::shared_ptr<OnDemandTask<DecodedSound>> mDecodeTask;
+
+        std::unique_ptr<sf::SoundBuffer> mSoundBuffer;
+    };
+
     struct MultipleSoundChoiceInfo
     {
-        std::vector<std::unique_ptr<sf::SoundBuffer>> SoundBuffers;
+        std::vector<std::unique_ptr<LazySoundBuffer>> SoundBuffers;
         size_t LastPlayedSoundIndex;
 
+        // The voice pool key of the first sound buffer; the others follow
+        size_t FirstVoiceKey;
+
         MultipleSoundChoiceInfo()
             : SoundBuffers()
             , LastPlayedSoundIndex(0u)
-        {
-        }
-    };
-
-    struct PlayingSound
-    {
-        SoundType Type;
-        std::unique_ptr<sf::Sound> Sound;
-        std::chrono::steady_clock::time_point StartedTimestamp;
-
-        PlayingSound(
-            SoundType type,
-            std::unique_ptr<sf::Sound> sound,
-            std::chrono::steady_clock::time_point startedTimestamp)
-            : Type(type)
-            , Sound(std::move(sound))
-            , StartedTimestamp(startedTimestamp)
+            , FirstVoiceKey(0u)
         {
         }
     };
@@ -219,23 +287,24 @@ private:
         SingleContinuousSound()
             : mSoundBuffer()
             , mSound()
+            , mVolume(100.0f)
             , mCurrentPauseState(false)
             , mDesiredPlayingState(false)
         {
         }
 
-        void Initialize(std::unique_ptr<sf::SoundBuffer> soundBuffer)
+        void Initialize(std::unique_ptr<LazySoundBuffer> soundBuffer)
         {
             assert(!mSoundBuffer && !mSound);
 
+            // The sound is made when first started, as that's when we need its buffer
             mSoundBuffer = std::move(soundBuffer);
-            mSound = std::make_unique<sf::Sound>();
-            mSound->setBuffer(*mSoundBuffer);
-            mSound->setLoop(true);
         }
 
         void SetVolume(float volume)
         {
+            mVolume = volume;
+
             if (!!mSound)
             {
                 mSound->setVolume(volume);
@@ -244,6 +313,18 @@ private:
 
         void Start()
         {
+            if (!mSound && !!mSoundBuffer)
+            {
+                sf::SoundBuffer const * soundBuffer = mSoundBuffer->Get();
+                if (nullptr != soundBuffer)
+                {
+                    mSound = std::make_unique<sf::Sound>();
+                    mSound->setBuffer(*soundBuffer);
+                    mSound->setLoop(true);
+                    mSound->setVolume(mVolume);
+                }
+            }
+
             if (!!mSound)
             {
                 if (!mCurrentPauseState
@@ -292,8 +373,9 @@ private:
         }
 
     private:
-        std::unique_ptr<sf::SoundBuffer> mSoundBuffer;
+        std::unique_ptr<LazySoundBuffer> mSoundBuffer;
         std::unique_ptr<sf::Sound> mSound;
+        float mVolume;
 
         // True/False if we are paused/not paused
         bool mCurrentPauseState;
@@ -323,10 +405,6 @@ private:
         MultipleSoundChoiceInfo & multipleSoundChoiceInfo,
         float volume);
 
-    void ScavengeStoppedSounds();
-
-    void ScavengeOldestSound(SoundType soundType);    
-
     void UpdateContinuousSound(
         size_t count, 
         SingleContinuousSound & sound);
@@ -335,6 +413,15 @@ private:
 
     std::shared_ptr<ResourceLoader> mResourceLoader;
 
+    std::unique_ptr<IAudioDevice<sf::SoundBuffer>> mAudioDevice;
+
+    // Optional
+    std::unique_ptr<SoundCache> mSoundCache;
+
+    // Decodes sounds in the background; declared after everything the decoding
+    // uses, as destroying the pool waits for the running decodes
+    TaskThreadPool mDecodingThreadPool;
+
     float mCurrentVolume;
 
 
@@ -362,7 +449,8 @@ private:
         std::tuple<SoundType, bool>,
         MultipleSoundChoiceInfo> mUSoundBuffers;
 
-    std::vector<PlayingSound> mCurrentlyPlayingSounds;
+    // Made once all sounds are loaded
+    std::unique_ptr<VoicePool<sf::SoundBuffer>> mOneShotVoices;
 
     //
     // Continuous sounds
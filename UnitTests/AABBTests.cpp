@@ -0,0 +1,50 @@
+#include <GameLib/AABB.h>
+
+#include "gtest/gtest.h"
+
+class AABBIntersectionTest : public testing::TestWithParam<std::tuple<vec2f, vec2f, vec2f, vec2f, bool>>
+{
+public:
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+INSTANTIATE_TEST_CASE_P(
+    TestCases,
+    AABBIntersectionTest,
+    ::testing::Values(
+        // Overlapping
+        std::make_tuple(vec2f{ 0.0f, 0.0f }, vec2f{ 2.0f, 2.0f }, vec2f{ 1.0f, 1.0f }, vec2f{ 3.0f, 3.0f }, true),
+
+        // Contained
+        std::make_tuple(vec2f{ 0.0f, 0.0f }, vec2f{ 4.0f, 4.0f }, vec2f{ 1.0f, 1.0f }, vec2f{ 2.0f, 2.0f }, true),
+
+        // Touching
+        std::make_tuple(vec2f{ 0.0f, 0.0f }, vec2f{ 2.0f, 2.0f }, vec2f{ 2.0f, 0.0f }, vec2f{ 3.0f, 2.0f }, true),
+
+        // Apart - 3
+        std::make_tuple(vec2f{ 0.0f, 0.0f }, vec2f{ 2.0f, 2.0f }, vec2f{ 3.0f, 0.0f }, vec2f{ 4.0f, 2.0f }, false),
+        std::make_tuple(vec2f{ 0.0f, 0.0f }, vec2f{ 2.0f, 2.0f }, vec2f{ 0.0f, -3.0f }, vec2f{ 2.0f, -1.0f }, false),
+        std::make_tuple(vec2f{ 0.0f, 0.0f }, vec2f{ 2.0f, 2.0f }, vec2f{ 1.0f, 3.0f }, vec2f{ 5.0f, 4.0f }, false)
+    ));
+
+TEST_P(AABBIntersectionTest, IntersectionTest)
+{
+    Geometry::AABB const a(std::get<0>(GetParam()), std::get<1>(GetParam()));
+    Geometry::AABB const b(std::get<2>(GetParam()), std::get<3>(GetParam()));
+
+    EXPECT_EQ(std::get<4>(GetParam()), a.intersects(b));
+    EXPECT_EQ(std::get<4>(GetParam()), b.intersects(a));
+}
+
+TEST(AABBTests, ExtendsToPoints)
+{
+    Geometry::AABB aabb(vec2f(1.0f, 1.0f), vec2f(1.0f, 1.0f));
+
+    aabb.extendTo(vec2f(-2.0f, 3.0f));
+    aabb.extendTo(vec2f(4.0f, -5.0f));
+    aabb.extendTo(vec2f(0.0f, 0.0f));
+
+    EXPECT_EQ(vec2f(-2.0f, -5.0f), aabb.bottomleft);
+    EXPECT_EQ(vec2f(4.0f, 3.0f), aabb.topright);
+}
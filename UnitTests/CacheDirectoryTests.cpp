@@ -0,0 +1,101 @@
+#include <GameLib/CacheDirectory.h>
+
+#include "CacheTestsFixture.h"
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#include "gtest/gtest.h"
+
+class CacheDirectoryTests : public CacheTestsFixture
+{
+};
+
+TEST_F(CacheDirectoryTests, HashKey_IsFnv1a)
+{
+    EXPECT_EQ(CacheDirectory::InitialKey, CacheDirectory::HashKey(CacheDirectory::InitialKey, "", 0));
+    EXPECT_EQ(0xaf63dc4c8601ec8cull, CacheDirectory::HashKey(CacheDirectory::InitialKey, "a", 1));
+}
+
+TEST_F(CacheDirectoryTests, HashFileStamp)
+{
+    auto const filePath = MakeFile("file.png", "abc");
+
+    uint64_t const key = CacheDirectory::HashFileStamp(CacheDirectory::InitialKey, filePath);
+    EXPECT_EQ(key, CacheDirectory::HashFileStamp(CacheDirectory::InitialKey, filePath));
+
+    // Name
+    auto const otherFilePath = MakeFile("other.png", "abc");
+    std::filesystem::last_write_time(otherFilePath, std::filesystem::last_write_time(filePath));
+    EXPECT_NE(key, CacheDirectory::HashFileStamp(CacheDirectory::InitialKey, otherFilePath));
+
+    // Size
+    MakeFile("file.png", "abcd");
+    EXPECT_NE(key, CacheDirectory::HashFileStamp(CacheDirectory::InitialKey, filePath));
+}
+
+TEST_F(CacheDirectoryTests, HashFileContent)
+{
+    auto const filePath1 = MakeFile("file1.png", "ab");
+    auto const filePath2 = MakeFile("file2.png", "c");
+
+    uint64_t const key = CacheDirectory::HashFileContent(
+        CacheDirectory::HashFileContent(CacheDirectory::InitialKey, filePath1),
+        filePath2);
+
+    // Content can't move across files
+    MakeFile("file1.png", "a");
+    MakeFile("file2.png", "bc");
+    EXPECT_NE(
+        key,
+        CacheDirectory::HashFileContent(
+            CacheDirectory::HashFileContent(CacheDirectory::InitialKey, filePath1),
+            filePath2));
+
+    // Content of the same size
+    MakeFile("file1.png", "ab");
+    MakeFile("file2.png", "d");
+    EXPECT_NE(
+        key,
+        CacheDirectory::HashFileContent(
+            CacheDirectory::HashFileContent(CacheDirectory::InitialKey, filePath1),
+            filePath2));
+}
+
+TEST_F(CacheDirectoryTests, GetEntryFilePath)
+{
+    CacheDirectory cacheDirectory(mCacheDirectoryPath, ".tst");
+
+    EXPECT_EQ(mCacheDirectoryPath / "000000000000002a.tst", cacheDirectory.GetEntryFilePath(42));
+}
+
+TEST_F(CacheDirectoryTests, MapEntryFile_Missing)
+{
+    CacheDirectory cacheDirectory(mCacheDirectoryPath, ".tst");
+
+    EXPECT_FALSE(!!cacheDirectory.MapEntryFile(42));
+}
+
+TEST_F(CacheDirectoryTests, WriteEntryFile)
+{
+    CacheDirectory cacheDirectory(mCacheDirectoryPath, ".tst");
+
+    uint32_t const header = 0x01020304;
+    std::string const body = "body";
+    cacheDirectory.WriteEntryFile(
+        42,
+        {
+            { &header, sizeof(header) },
+            { body.data(), body.size() }
+        });
+
+    auto mappedFile = cacheDirectory.MapEntryFile(42);
+    ASSERT_TRUE(!!mappedFile);
+    ASSERT_EQ(sizeof(header) + body.size(), mappedFile->GetSize());
+    EXPECT_EQ(0, std::memcmp(&header, mappedFile->GetData(), sizeof(header)));
+    EXPECT_EQ(0, std::memcmp(body.data(), mappedFile->GetData() + sizeof(header), body.size()));
+
+    // No temporary file left behind
+    EXPECT_FALSE(std::filesystem::exists(mCacheDirectoryPath / "000000000000002a.tst.tmp"));
+}
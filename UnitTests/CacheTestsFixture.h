@@ -0,0 +1,45 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+/*
+ * The fixture of the tests of the caches: each test runs with an empty cache directory
+ * of its own, which is removed afterwards.
+ */
+class CacheTestsFixture : public ::testing::Test
+{
+protected:
+
+    virtual void SetUp() override
+    {
+        mCacheDirectoryPath =
+            std::filesystem::temp_directory_path()
+            / ::testing::UnitTest::GetInstance()->current_test_info()->test_case_name();
+
+        std::filesystem::remove_all(mCacheDirectoryPath);
+    }
+
+    virtual void TearDown() override
+    {
+        std::filesystem::remove_all(mCacheDirectoryPath);
+    }
+
+    std::filesystem::path MakeFile(
+        std::string const & fileName,
+        std::string const & content) const
+    {
+        std::filesystem::create_directories(mCacheDirectoryPath);
+        auto const filePath = mCacheDirectoryPath / fileName;
+
+        std::ofstream file(filePath.string(), std::ios::out | std::ios::binary | std::ios::trunc);
+        file << content;
+
+        return filePath;
+    }
+
+    std::filesystem::path mCacheDirectoryPath;
+};
@@ -1,5 +1,7 @@
 #include <GameLib/GameEventDispatcher.h>
 
+#include <thread>
+
 #include "gmock/gmock.h"
 
 class _MockHandler : public IGameEventHandler
@@ -245,3 +247,57 @@ TEST(GameEventDispatcherTests, ClearsStateAtUpdate)
 
     Mock::VerifyAndClear(&handler);
 }
+
+TEST(GameEventDispatcherTests, Aggregates_OnBreak_AcrossThreads)
+{
+    MockHandler handler;
+
+    GameEventDispatcher dispatcher;
+    dispatcher.RegisterSink(&handler);
+
+    Material * pm1 = reinterpret_cast<Material *>(7);
+
+    EXPECT_CALL(handler, OnBreak(_, _, _)).Times(0);
+
+    dispatcher.OnBreak(pm1, false, 3);
+
+    std::thread thread(
+        [&dispatcher, pm1]()
+        {
+            dispatcher.OnBreak(pm1, false, 4);
+        });
+    thread.join();
+
+    Mock::VerifyAndClear(&handler);
+
+    EXPECT_CALL(handler, OnBreak(pm1, false, 7)).Times(1);
+
+    dispatcher.Flush();
+
+    Mock::VerifyAndClear(&handler);
+}
+
+TEST(GameEventDispatcherTests, Aggregates_OnStress_BeyondBufferCapacity)
+{
+    MockHandler handler;
+
+    GameEventDispatcher dispatcher;
+    dispatcher.RegisterSink(&handler);
+
+    Material * pm1 = reinterpret_cast<Material *>(7);
+    Material * pm2 = reinterpret_cast<Material *>(21);
+
+    // Alternate materials, so that no events get coalesced
+    for (int i = 0; i < 5000; ++i)
+    {
+        dispatcher.OnStress(pm1, false, 1);
+        dispatcher.OnStress(pm2, false, 2);
+    }
+
+    EXPECT_CALL(handler, OnStress(pm1, false, 5000)).Times(1);
+    EXPECT_CALL(handler, OnStress(pm2, false, 10000)).Times(1);
+
+    dispatcher.Flush();
+
+    Mock::VerifyAndClear(&handler);
+}
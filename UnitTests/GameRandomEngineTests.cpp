@@ -0,0 +1,76 @@
+#include <GameLib/GameRandomEngine.h>
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+TEST(GameRandomEngineTests, SameStreamIsRepeatable)
+{
+    GameRandomEngine engine1(GameRandomEngine::WorldStreamId);
+    GameRandomEngine engine2(GameRandomEngine::WorldStreamId);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(engine1.GenerateRandomInteger<int>(0, 1000), engine2.GenerateRandomInteger<int>(0, 1000));
+    }
+}
+
+TEST(GameRandomEngineTests, StreamsDiffer)
+{
+    GameRandomEngine engine1(GameRandomEngine::MainStreamId);
+    GameRandomEngine engine2(GameRandomEngine::WorldStreamId);
+
+    int sameCount = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+        if (engine1.GenerateRandomInteger<int>(0, 1000) == engine2.GenerateRandomInteger<int>(0, 1000))
+            ++sameCount;
+    }
+
+    EXPECT_LT(sameCount, 5);
+}
+
+TEST(GameRandomEngineTests, NormalRealRange)
+{
+    GameRandomEngine engine(GameRandomEngine::MainStreamId);
+
+    float sum = 0.0f;
+    for (int i = 0; i < 10000; ++i)
+    {
+        float const value = engine.GenerateRandomNormalReal();
+        EXPECT_GE(value, 0.0f);
+        EXPECT_LT(value, 1.0f);
+
+        sum += value;
+    }
+
+    EXPECT_NEAR(0.5f, sum / 10000.0f, 0.02f);
+}
+
+TEST(GameRandomEngineTests, Snapshot)
+{
+    GameRandomEngine engine(GameRandomEngine::WorldStreamId);
+    engine.GenerateRandomNormalReal();
+
+    SnapshotWriter writer;
+    engine.WriteSnapshot(writer);
+
+    GameRandomEngine restoredEngine(GameRandomEngine::MainStreamId);
+    SnapshotReader reader(writer.GetBuffer());
+    restoredEngine.ReadSnapshot(reader);
+
+    EXPECT_EQ(engine.GenerateRandomNormalReal(), restoredEngine.GenerateRandomNormalReal());
+}
+
+TEST(GameRandomEngineTests, ThreadInstancesDiffer)
+{
+    GameRandomEngine * otherThreadInstance = nullptr;
+    std::thread thread(
+        [&otherThreadInstance]()
+        {
+            otherThreadInstance = &GameRandomEngine::GetThreadInstance();
+        });
+    thread.join();
+
+    EXPECT_NE(otherThreadInstance, &GameRandomEngine::GetThreadInstance());
+}
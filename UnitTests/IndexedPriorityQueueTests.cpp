@@ -0,0 +1,125 @@
+#include <GameLib/IndexedPriorityQueue.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(IndexedPriorityQueueTests, Empty)
+{
+    IndexedPriorityQueue<float> queue(10);
+
+    EXPECT_EQ(0u, queue.size());
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.contains(3));
+}
+
+TEST(IndexedPriorityQueueTests, Push)
+{
+    IndexedPriorityQueue<float> queue(10);
+
+    queue.push(3, 1.0f);
+
+    EXPECT_EQ(1u, queue.size());
+    EXPECT_FALSE(queue.empty());
+    EXPECT_TRUE(queue.contains(3));
+    EXPECT_FALSE(queue.contains(4));
+    EXPECT_EQ(1.0f, queue.priority(3));
+}
+
+TEST(IndexedPriorityQueueTests, PopsInPriorityOrder)
+{
+    IndexedPriorityQueue<float> queue(10);
+
+    queue.push(0, 3.0f);
+    queue.push(1, 9.0f);
+    queue.push(2, -1.0f);
+    queue.push(3, 4.0f);
+    queue.push(4, 7.5f);
+
+    std::vector<size_t> popped;
+    while (!queue.empty())
+    {
+        popped.push_back(queue.top());
+        queue.pop();
+    }
+
+    EXPECT_EQ(std::vector<size_t>({ 1, 4, 3, 0, 2 }), popped);
+}
+
+TEST(IndexedPriorityQueueTests, BreaksTiesBySmallerIndex)
+{
+    IndexedPriorityQueue<float> queue(10);
+
+    queue.push(7, 2.0f);
+    queue.push(2, 2.0f);
+    queue.push(5, 2.0f);
+
+    EXPECT_EQ(2u, queue.top());
+    queue.pop();
+    EXPECT_EQ(5u, queue.top());
+    queue.pop();
+    EXPECT_EQ(7u, queue.top());
+}
+
+TEST(IndexedPriorityQueueTests, Update_Increase)
+{
+    IndexedPriorityQueue<float> queue(10);
+
+    queue.push(0, 3.0f);
+    queue.push(1, 9.0f);
+    queue.push(2, 1.0f);
+
+    queue.update(2, 10.0f);
+
+    EXPECT_EQ(2u, queue.top());
+    EXPECT_EQ(10.0f, queue.priority(2));
+}
+
+TEST(IndexedPriorityQueueTests, Update_Decrease)
+{
+    IndexedPriorityQueue<float> queue(10);
+
+    queue.push(0, 3.0f);
+    queue.push(1, 9.0f);
+    queue.push(2, 1.0f);
+
+    queue.update(1, 0.0f);
+
+    EXPECT_EQ(0u, queue.top());
+    queue.pop();
+    EXPECT_EQ(2u, queue.top());
+    queue.pop();
+    EXPECT_EQ(1u, queue.top());
+}
+
+TEST(IndexedPriorityQueueTests, Erase)
+{
+    IndexedPriorityQueue<float> queue(10);
+
+    queue.push(0, 3.0f);
+    queue.push(1, 9.0f);
+    queue.push(2, 1.0f);
+    queue.push(3, 5.0f);
+
+    queue.erase(3);
+
+    EXPECT_EQ(3u, queue.size());
+    EXPECT_FALSE(queue.contains(3));
+
+    queue.erase(1);
+
+    EXPECT_EQ(2u, queue.size());
+    EXPECT_EQ(0u, queue.top());
+}
+
+TEST(IndexedPriorityQueueTests, Erase_ThenPushAgain)
+{
+    IndexedPriorityQueue<float> queue(10);
+
+    queue.push(4, 3.0f);
+    queue.erase(4);
+    queue.push(4, 6.0f);
+
+    EXPECT_TRUE(queue.contains(4));
+    EXPECT_EQ(6.0f, queue.priority(4));
+}
@@ -0,0 +1,162 @@
+#include <GameLib/GameEventDispatcher.h>
+#include <GameLib/GameException.h>
+#include <GameLib/GameParameters.h>
+#include <GameLib/InputRecording.h>
+#include <GameLib/MaterialDatabase.h>
+#include <GameLib/Physics.h>
+
+#include "TestShips.h"
+
+#include <cstring>
+#include <filesystem>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+class InputRecordingTests : public ::testing::Test
+{
+    virtual void SetUp() override
+    {
+        mRecordingFilePath = std::filesystem::temp_directory_path() / "InputRecordingTests.ssr";
+
+        mMaterials = std::make_unique<MaterialDatabase>(MakeTestMaterialDatabase());
+    }
+
+    virtual void TearDown() override
+    {
+        std::filesystem::remove(mRecordingFilePath);
+    }
+
+protected:
+
+    std::filesystem::path mRecordingFilePath;
+    std::unique_ptr<MaterialDatabase> mMaterials;
+};
+
+TEST_F(InputRecordingTests, GameParameters_RoundTrip)
+{
+    GameParameters gameParameters;
+    gameParameters.StiffnessAdjustment = 0.5f;
+    gameParameters.TimerBombInterval = std::chrono::seconds(7);
+    gameParameters.NumberOfClouds = 3;
+    gameParameters.IsUltraViolentMode = true;
+
+    SnapshotWriter writer;
+    RecordedGameParameters::From(gameParameters).WriteSnapshot(writer);
+
+    SnapshotReader reader(writer.GetBuffer());
+    GameParameters restoredGameParameters;
+    RecordedGameParameters::ReadSnapshot(reader).ApplyTo(restoredGameParameters);
+
+    EXPECT_TRUE(reader.IsAtEnd());
+    EXPECT_EQ(0.5f, restoredGameParameters.StiffnessAdjustment);
+    EXPECT_EQ(std::chrono::seconds(7), restoredGameParameters.TimerBombInterval);
+    EXPECT_EQ(3u, restoredGameParameters.NumberOfClouds);
+    EXPECT_TRUE(restoredGameParameters.IsUltraViolentMode);
+}
+
+TEST_F(InputRecordingTests, Replay)
+{
+    auto gameEventDispatcher = std::make_shared<GameEventDispatcher>();
+    GameParameters gameParameters;
+    Physics::World world(gameEventDispatcher, gameParameters);
+    int const shipId = world.AddShip(
+        MakeTestShipDefinition(
+            {
+                "IIIIII",
+                "II..II",
+                "IIIIII"
+            },
+            vec2f(0.0f, 20.0f)),
+        *mMaterials,
+        gameParameters);
+
+    InputRecorder recorder(world, gameParameters);
+
+    recorder.RecordTogglePinAt(vec2f(-3.0f, 20.0f));
+    world.TogglePinAt(vec2f(-3.0f, 20.0f), gameParameters);
+    recorder.RecordToggleTimerBombAt(vec2f(-2.5f, 22.0f));
+    world.ToggleTimerBombAt(vec2f(-2.5f, 22.0f), gameParameters);
+    recorder.RecordToggleRCBombAt(vec2f(1.5f, 22.0f));
+    world.ToggleRCBombAt(vec2f(1.5f, 22.0f), gameParameters);
+    recorder.RecordStep(gameParameters);
+    world.Update(gameParameters);
+
+    recorder.RecordDestroyAt(vec2f(2.0f, 20.0f), 0.5f);
+    world.DestroyAt(vec2f(2.0f, 20.0f), 0.5f);
+    gameParameters.WaveHeight = 5.0f;
+    recorder.RecordStep(gameParameters);
+    world.Update(gameParameters);
+
+    recorder.RecordSawThrough(vec2f(-0.5f, 19.0f), vec2f(-0.5f, 23.0f));
+    world.SawThrough(vec2f(-0.5f, 19.0f), vec2f(-0.5f, 23.0f));
+    recorder.RecordDrawTo(vec2f(5.0f, 25.0f), 1000.0f);
+    world.DrawTo(vec2f(5.0f, 25.0f), 1000.0f);
+    recorder.RecordStep(gameParameters);
+    world.Update(gameParameters);
+
+    recorder.RecordSwirlAt(vec2f(0.0f, 21.0f), 1000.0f);
+    world.SwirlAt(vec2f(0.0f, 21.0f), 1000.0f);
+    recorder.RecordDetonateRCBombs();
+    world.DetonateRCBombs();
+    recorder.RecordStep(gameParameters);
+    world.Update(gameParameters);
+
+    for (int s = 0; s < 20; ++s)
+    {
+        recorder.RecordStep(gameParameters);
+        world.Update(gameParameters);
+    }
+
+    EXPECT_EQ(24u, recorder.GetStepCount());
+
+    recorder.SaveToFile(mRecordingFilePath);
+
+    auto replayer = InputReplayer::Load(mRecordingFilePath, gameEventDispatcher, *mMaterials);
+
+    EXPECT_EQ(24u, replayer->GetStepCount());
+
+    replayer->Step();
+    EXPECT_EQ(GameParameters().WaveHeight, replayer->GetGameParameters().WaveHeight);
+
+    replayer->Step();
+    EXPECT_EQ(5.0f, replayer->GetGameParameters().WaveHeight);
+
+    while (!replayer->IsAtEnd())
+    {
+        replayer->Step();
+    }
+
+    EXPECT_EQ(world.GetCurrentStepSequenceNumber(), replayer->GetWorld().GetCurrentStepSequenceNumber());
+
+    auto const & points = world.GetShip(shipId).GetPoints();
+    auto const & replayedPoints = replayer->GetWorld().GetShip(shipId).GetPoints();
+    ASSERT_EQ(points.GetElementCount(), replayedPoints.GetElementCount());
+
+    // The tools did something
+    size_t deletedPointCount = 0;
+    for (auto p : points)
+    {
+        if (points.IsDeleted(p))
+            ++deletedPointCount;
+    }
+
+    EXPECT_LT(0u, deletedPointCount);
+
+    for (auto p : points)
+    {
+        EXPECT_EQ(points.IsDeleted(p), replayedPoints.IsDeleted(p));
+        EXPECT_EQ(0, std::memcmp(&(points.GetPosition(p)), &(replayedPoints.GetPosition(p)), sizeof(vec2f)));
+    }
+}
+
+TEST_F(InputRecordingTests, NotARecording)
+{
+    SnapshotWriter writer;
+    writer.Write<uint32_t>(42);
+    writer.SaveToFile(mRecordingFilePath);
+
+    EXPECT_THROW(
+        InputReplayer::Load(mRecordingFilePath, std::make_shared<GameEventDispatcher>(), *mMaterials),
+        GameException);
+}
@@ -0,0 +1,107 @@
+#include <GameLib/Log.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+class LogTests : public ::testing::Test
+{
+protected:
+
+    void SetUp() override
+    {
+        Logger::Instance.Flush();
+
+        mIsListening = false;
+        Logger::Instance.RegisterListener(
+            [this](std::string const & message)
+            {
+                // The listener is first given all the messages stored so far
+                if (mIsListening)
+                    mMessages.push_back(message);
+            });
+
+        mIsListening = true;
+        mOriginalLevel = Logger::Instance.GetLevel();
+    }
+
+    void TearDown() override
+    {
+        Logger::Instance.SetLevel(mOriginalLevel);
+        Logger::Instance.UnregisterListener();
+    }
+
+    bool mIsListening;
+    std::vector<std::string> mMessages;
+    LogLevel mOriginalLevel;
+};
+
+TEST_F(LogTests, FormatsArguments)
+{
+    Logger::Instance.SetLevel(LogLevel::Info);
+
+    LogMessage("Text ", std::string("string "), 42, ' ', -7ll, ' ', 1.5f, ' ', 0.25, ' ', true);
+    Logger::Instance.Flush();
+
+    ASSERT_EQ(1u, mMessages.size());
+    EXPECT_EQ("Text string 42 -7 1.5 0.25 1\n", mMessages[0]);
+}
+
+TEST_F(LogTests, TruncatesLongMessages)
+{
+    Logger::Instance.SetLevel(LogLevel::Info);
+
+    LogMessage(std::string(2000, 'x'));
+    Logger::Instance.Flush();
+
+    ASSERT_EQ(1u, mMessages.size());
+    EXPECT_GT(mMessages[0].size(), 100u);
+    EXPECT_LT(mMessages[0].size(), 2000u);
+    EXPECT_EQ('\n', mMessages[0].back());
+}
+
+TEST_F(LogTests, HonorsLevel)
+{
+    Logger::Instance.SetLevel(LogLevel::Info);
+
+    LogDebug("Debug");
+    LogMessage("Info");
+    Logger::Instance.Flush();
+
+    ASSERT_EQ(1u, mMessages.size());
+    EXPECT_EQ("Info\n", mMessages[0]);
+
+    Logger::Instance.SetLevel(LogLevel::Debug);
+
+    LogDebug("Debug");
+    Logger::Instance.Flush();
+
+    ASSERT_EQ(2u, mMessages.size());
+    EXPECT_EQ("Debug\n", mMessages[1]);
+
+    Logger::Instance.SetLevel(LogLevel::None);
+
+    LogMessage("Info");
+    Logger::Instance.Flush();
+
+    EXPECT_EQ(2u, mMessages.size());
+}
+
+TEST_F(LogTests, KeepsOrder)
+{
+    Logger::Instance.SetLevel(LogLevel::Info);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        LogMessage("Message ", i);
+    }
+
+    Logger::Instance.Flush();
+
+    ASSERT_EQ(100u, mMessages.size());
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ("Message " + std::to_string(i) + "\n", mMessages[i]);
+    }
+}
@@ -0,0 +1,80 @@
+#include <GameLib/Material.h>
+#include <GameLib/MaterialDatabase.h>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace /* anonymous */ {
+
+    MaterialDatabase MakeMaterials()
+    {
+        std::vector<std::unique_ptr<Material const>> materials;
+        materials.emplace_back(new Material("Iron", 1.0f, 100.0f, 1.0f, { 0x80, 0x80, 0x80 }, { 0x80, 0x80, 0x80 }, true, false, std::nullopt, std::nullopt));
+        materials.emplace_back(new Material("Wood", 1.0f, 100.0f, 1.0f, { 0x80, 0x80, 0x81 }, { 0x80, 0x80, 0x81 }, false, false, std::nullopt, std::nullopt));
+        materials.emplace_back(new Material("Glass", 1.0f, 100.0f, 1.0f, { 0x20, 0x40, 0x60 }, { 0x20, 0x40, 0x60 }, false, false, std::nullopt, std::nullopt));
+        materials.emplace_back(new Material("Rope", 0.5f, 10.0f, 0.5f, { 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x00 }, false, true, std::nullopt, std::nullopt));
+
+        return MaterialDatabase::Create(std::move(materials));
+    }
+}
+
+TEST(MaterialDatabaseTests, Get)
+{
+    MaterialDatabase materials = MakeMaterials();
+
+    ASSERT_NE(nullptr, materials.Get({ 0x80, 0x80, 0x80 }));
+    EXPECT_EQ("Iron", materials.Get({ 0x80, 0x80, 0x80 })->Name);
+
+    ASSERT_NE(nullptr, materials.Get({ 0x80, 0x80, 0x81 }));
+    EXPECT_EQ("Wood", materials.Get({ 0x80, 0x80, 0x81 })->Name);
+
+    ASSERT_NE(nullptr, materials.Get({ 0x20, 0x40, 0x60 }));
+    EXPECT_EQ("Glass", materials.Get({ 0x20, 0x40, 0x60 })->Name);
+
+    EXPECT_EQ(&(materials.GetRopeMaterial()), materials.Get({ 0x00, 0x00, 0x00 }));
+}
+
+TEST(MaterialDatabaseTests, Get_Unknown)
+{
+    MaterialDatabase materials = MakeMaterials();
+
+    EXPECT_EQ(nullptr, materials.Get({ 0xFF, 0xFF, 0xFF }));
+    EXPECT_EQ(nullptr, materials.Get({ 0x80, 0x80, 0x82 }));
+    EXPECT_EQ(nullptr, materials.Get({ 0x20, 0x41, 0x60 }));
+    EXPECT_EQ(nullptr, materials.Get({ 0x00, 0x00, 0x01 }));
+}
+
+TEST(MaterialDatabaseTests, GetRow)
+{
+    MaterialDatabase materials = MakeMaterials();
+
+    std::array<unsigned char, 5 * 3> const row = {
+        0xFF, 0xFF, 0xFF,
+        0x80, 0x80, 0x80,
+        0x20, 0x40, 0x60,
+        0xFF, 0xFF, 0xFE,
+        0x00, 0x00, 0x00 };
+
+    std::array<Material const *, 5> rowMaterials;
+    materials.GetRow(row.data(), rowMaterials.size(), rowMaterials.data());
+
+    EXPECT_EQ(nullptr, rowMaterials[0]);
+    EXPECT_EQ(materials.Get({ 0x80, 0x80, 0x80 }), rowMaterials[1]);
+    EXPECT_EQ(materials.Get({ 0x20, 0x40, 0x60 }), rowMaterials[2]);
+    EXPECT_EQ(nullptr, rowMaterials[3]);
+    EXPECT_EQ(&(materials.GetRopeMaterial()), rowMaterials[4]);
+}
+
+TEST(MaterialDatabaseTests, SurvivesMove)
+{
+    MaterialDatabase materials = MakeMaterials();
+    Material const * iron = materials.Get({ 0x80, 0x80, 0x80 });
+
+    MaterialDatabase movedMaterials(std::move(materials));
+
+    EXPECT_EQ(iron, movedMaterials.Get({ 0x80, 0x80, 0x80 }));
+}
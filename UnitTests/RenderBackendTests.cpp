@@ -0,0 +1,146 @@
+#include <GameLib/GameEventDispatcher.h>
+#include <GameLib/GameParameters.h>
+#include <GameLib/Material.h>
+#include <GameLib/MaterialDatabase.h>
+#include <GameLib/NullRenderBackend.h>
+#include <GameLib/Physics.h>
+#include <GameLib/RecordingRenderBackend.h>
+#include <GameLib/ShipDefinition.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+class RenderBackendTests : public ::testing::Test
+{
+    virtual void SetUp() override
+    {
+        std::vector<std::unique_ptr<Material const>> materials;
+        materials.emplace_back(new Material("Iron", 1.0f, 100.0f, 1.0f, { 0x80, 0x80, 0x80 }, { 0x80, 0x80, 0x80 }, false, false, std::nullopt, std::nullopt));
+        materials.emplace_back(new Material("Rope", 0.5f, 10.0f, 0.5f, { 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x00 }, false, true, std::nullopt, std::nullopt));
+        mMaterials = std::make_unique<MaterialDatabase>(MaterialDatabase::Create(std::move(materials)));
+
+        mWorld = std::make_unique<Physics::World>(
+            std::make_shared<GameEventDispatcher>(),
+            mGameParameters);
+
+        mWorld->AddShip(
+            MakeShipDefinition(),
+            *mMaterials,
+            mGameParameters);
+    }
+
+protected:
+
+    // A solid ShipSize X ShipSize ship
+    static constexpr int ShipSize = 8;
+    static constexpr size_t ShipPointCount = ShipSize * ShipSize;
+    static constexpr size_t ShipSpringCount = 2 * ShipSize * (ShipSize - 1) + 2 * (ShipSize - 1) * (ShipSize - 1);
+    static constexpr size_t ShipTriangleCount = 2 * (ShipSize - 1) * (ShipSize - 1);
+
+    static ShipDefinition MakeShipDefinition()
+    {
+        std::unique_ptr<unsigned char[]> data(new unsigned char[ShipPointCount * 3]);
+        for (size_t p = 0; p < ShipPointCount * 3; ++p)
+        {
+            data[p] = 0x80;
+        }
+
+        return ShipDefinition(
+            ImageData(ShipSize, ShipSize, std::unique_ptr<unsigned char const[]>(std::move(data))),
+            std::nullopt,
+            "Test",
+            vec2f(0.0f, 0.0f));
+    }
+
+    GameParameters mGameParameters;
+    std::unique_ptr<MaterialDatabase> mMaterials;
+    std::unique_ptr<Physics::World> mWorld;
+};
+
+TEST_F(RenderBackendTests, Null_RendersWorld)
+{
+    NullRenderBackend renderBackend;
+
+    mWorld->Render(mGameParameters, renderBackend);
+    mWorld->Update(mGameParameters);
+    mWorld->Render(mGameParameters, renderBackend);
+}
+
+TEST_F(RenderBackendTests, Recording_FirstFrameUploadsAllElements)
+{
+    RecordingRenderBackend renderBackend;
+
+    mWorld->Render(mGameParameters, renderBackend);
+
+    auto const & uploads = renderBackend.GetRecordedUploads();
+
+    EXPECT_EQ(1u, renderBackend.GetFrameCount());
+    EXPECT_EQ(1u, renderBackend.GetRenderedShipCount());
+
+    EXPECT_EQ(1u, uploads.LandAndWater.Calls);
+
+    EXPECT_EQ(1u, uploads.ShipPointImmutableGraphicalAttributes.Calls);
+    EXPECT_EQ(ShipPointCount, uploads.ShipPointImmutableGraphicalAttributes.Elements);
+
+    EXPECT_EQ(1u, uploads.ShipPoints.Calls);
+    EXPECT_EQ(ShipPointCount, uploads.ShipPoints.Elements);
+
+    EXPECT_EQ(ShipPointCount, uploads.ShipElementPoints.Elements);
+    EXPECT_EQ(ShipSpringCount, uploads.ShipElementSprings.Elements);
+    EXPECT_EQ(0u, uploads.ShipElementRopes.Elements);
+    EXPECT_EQ(ShipTriangleCount, uploads.ShipElementTriangles.Elements);
+    EXPECT_EQ(0u, uploads.RemovedShipElements.Elements);
+
+    EXPECT_EQ(ShipSpringCount * 2 * sizeof(int), uploads.ShipElementSprings.Bytes);
+    EXPECT_EQ(ShipTriangleCount * 3 * sizeof(int), uploads.ShipElementTriangles.Bytes);
+}
+
+TEST_F(RenderBackendTests, Recording_SecondFrameOnlyUploadsPoints)
+{
+    RecordingRenderBackend renderBackend;
+
+    mWorld->Render(mGameParameters, renderBackend);
+    mWorld->Update(mGameParameters);
+
+    renderBackend.Reset();
+
+    mWorld->Render(mGameParameters, renderBackend);
+
+    auto const & uploads = renderBackend.GetRecordedUploads();
+
+    EXPECT_EQ(1u, renderBackend.GetFrameCount());
+
+    EXPECT_EQ(0u, uploads.ShipPointImmutableGraphicalAttributes.Calls);
+    EXPECT_EQ(ShipPointCount, uploads.ShipPoints.Elements);
+
+    EXPECT_EQ(0u, uploads.ShipElementPoints.Calls);
+    EXPECT_EQ(0u, uploads.ShipElementSprings.Calls);
+    EXPECT_EQ(0u, uploads.ShipElementTriangles.Calls);
+    EXPECT_EQ(0u, uploads.ShipElementCoarseTriangles.Calls);
+    EXPECT_EQ(0u, uploads.RemovedShipElements.Calls);
+}
+
+TEST_F(RenderBackendTests, Recording_DestroyRemovesElements)
+{
+    RecordingRenderBackend renderBackend;
+
+    mWorld->Render(mGameParameters, renderBackend);
+
+    renderBackend.Reset();
+
+    // Destroy the bottom-left corner of the ship, which doesn't split it
+    mWorld->DestroyAt(vec2f(-static_cast<float>(ShipSize / 2), 0.0f), 0.5f);
+
+    mWorld->Render(mGameParameters, renderBackend);
+
+    auto const & uploads = renderBackend.GetRecordedUploads();
+
+    EXPECT_LT(0u, uploads.RemovedShipElements.Elements);
+
+    EXPECT_EQ(0u, uploads.ShipElementPoints.Calls);
+    EXPECT_EQ(0u, uploads.ShipElementSprings.Calls);
+    EXPECT_EQ(0u, uploads.ShipElementTriangles.Calls);
+}
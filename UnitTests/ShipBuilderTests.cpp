@@ -0,0 +1,157 @@
+#include <GameLib/ShipBuilder.h>
+
+#include "TestShips.h"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <set>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+namespace /* anonymous */ {
+
+    using Position = std::pair<float, float>;
+
+    Position ToPosition(vec2f const & v)
+    {
+        return Position(v.x, v.y);
+    }
+
+    std::set<std::pair<Position, Position>> GetSprings(ShipBuilder::CompiledShip const & compiledShip)
+    {
+        std::set<std::pair<Position, Position>> springs;
+        for (auto const & springInfo : compiledShip.SpringInfos)
+        {
+            Position const a = ToPosition(compiledShip.PointInfos[springInfo.PointAIndex].Position);
+            Position const b = ToPosition(compiledShip.PointInfos[springInfo.PointBIndex].Position);
+            springs.emplace(std::min(a, b), std::max(a, b));
+        }
+
+        return springs;
+    }
+
+    // Triangles keep their winding, starting from their smallest vertex
+    std::set<std::array<Position, 3u>> GetTriangles(ShipBuilder::CompiledShip const & compiledShip)
+    {
+        std::set<std::array<Position, 3u>> triangles;
+        for (auto const & triangleInfo : compiledShip.TriangleInfos)
+        {
+            std::array<Position, 3u> triangle = {
+                ToPosition(compiledShip.PointInfos[triangleInfo.PointAIndex].Position),
+                ToPosition(compiledShip.PointInfos[triangleInfo.PointBIndex].Position),
+                ToPosition(compiledShip.PointInfos[triangleInfo.PointCIndex].Position) };
+
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+            triangles.insert(triangle);
+        }
+
+        return triangles;
+    }
+}
+
+TEST(ShipBuilderTests, Compile_Topology)
+{
+    MaterialDatabase const materials = MakeTestMaterialDatabase();
+
+    ShipDefinition const shipDefinition = MakeTestShipDefinition(
+        {
+            "II.1",
+            "I.I.",
+            "III1"
+        },
+        vec2f(0.0f, 0.0f),
+        true);
+
+    auto const compiledShip = ShipBuilder::Compile(shipDefinition, materials, ProgressCallback());
+
+    EXPECT_EQ(4, compiledShip.StructureSize.Width);
+    EXPECT_EQ(3, compiledShip.StructureSize.Height);
+
+    //
+    // Points
+    //
+
+    Material const * const iron = materials.Get(TestShipStructuralColour);
+    Material const * const rope = &(materials.GetRopeMaterial());
+
+    // Position -> (material, is leaking)
+    std::map<Position, std::pair<Material const *, bool>> points;
+    for (auto const & pointInfo : compiledShip.PointInfos)
+    {
+        EXPECT_TRUE(points.emplace(ToPosition(pointInfo.Position), std::make_pair(pointInfo.Mtl, pointInfo.IsLeaking)).second);
+    }
+
+    std::map<Position, std::pair<Material const *, bool>> const expectedPoints = {
+        { { -2.0f, 0.0f }, { iron, false } },
+        { { -1.0f, 0.0f }, { iron, false } },
+        { { 0.0f, 0.0f }, { iron, false } },
+        { { 1.0f, 0.0f }, { rope, true } },
+        { { -2.0f, 1.0f }, { iron, false } },
+        { { 0.0f, 1.0f }, { iron, false } },
+        { { 1.0f, 1.0f }, { rope, false } },
+        { { -2.0f, 2.0f }, { iron, false } },
+        { { -1.0f, 2.0f }, { iron, false } },
+        { { 1.0f, 2.0f }, { rope, true } }
+    };
+
+    EXPECT_EQ(expectedPoints, points);
+
+    // The points of the structure map the texture onto it
+    for (auto const & pointInfo : compiledShip.PointInfos)
+    {
+        if (pointInfo.Position != vec2f(1.0f, 1.0f))
+        {
+            EXPECT_EQ(
+                vec2f((pointInfo.Position.x + 2.0f) / 4.0f, pointInfo.Position.y / 3.0f),
+                pointInfo.TextureCoordinates);
+        }
+    }
+
+    //
+    // Springs: between each pair of neighbouring points, and along the rope
+    //
+
+    std::set<std::pair<Position, Position>> const expectedSprings = {
+        { { -2.0f, 0.0f }, { -1.0f, 0.0f } },
+        { { -1.0f, 0.0f }, { 0.0f, 0.0f } },
+        { { 0.0f, 0.0f }, { 1.0f, 0.0f } },
+        { { -2.0f, 2.0f }, { -1.0f, 2.0f } },
+
+        { { -2.0f, 0.0f }, { -2.0f, 1.0f } },
+        { { -2.0f, 1.0f }, { -2.0f, 2.0f } },
+        { { 0.0f, 0.0f }, { 0.0f, 1.0f } },
+
+        { { -1.0f, 0.0f }, { 0.0f, 1.0f } },
+        { { -2.0f, 1.0f }, { -1.0f, 2.0f } },
+        { { 0.0f, 1.0f }, { 1.0f, 2.0f } },
+
+        { { -2.0f, 1.0f }, { -1.0f, 0.0f } },
+        { { 0.0f, 1.0f }, { 1.0f, 0.0f } },
+        { { -1.0f, 2.0f }, { 0.0f, 1.0f } },
+
+        { { 1.0f, 0.0f }, { 1.0f, 1.0f } },
+        { { 1.0f, 1.0f }, { 1.0f, 2.0f } }
+    };
+
+    EXPECT_EQ(expectedSprings.size(), compiledShip.SpringInfos.size());
+    EXPECT_EQ(expectedSprings, GetSprings(compiledShip));
+
+    //
+    // Triangles: none across the holes
+    //
+
+    std::set<std::array<Position, 3u>> const expectedTriangles = {
+        { { { -2.0f, 0.0f }, { -2.0f, 1.0f }, { -1.0f, 0.0f } } },
+        { { { 0.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 0.0f } } },
+        { { { -1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, 0.0f } } },
+        { { { -2.0f, 1.0f }, { -2.0f, 2.0f }, { -1.0f, 2.0f } } }
+    };
+
+    EXPECT_EQ(expectedTriangles.size(), compiledShip.TriangleInfos.size());
+    EXPECT_EQ(expectedTriangles, GetTriangles(compiledShip));
+
+    // No square of 2x2 cells is fully tessellated
+    EXPECT_TRUE(compiledShip.CoarseTriangleBlockInfos.empty());
+}
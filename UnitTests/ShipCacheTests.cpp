@@ -0,0 +1,161 @@
+#include <GameLib/Material.h>
+#include <GameLib/MaterialDatabase.h>
+#include <GameLib/ShipCache.h>
+
+#include "CacheTestsFixture.h"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+class ShipCacheTests : public CacheTestsFixture
+{
+    virtual void SetUp() override
+    {
+        CacheTestsFixture::SetUp();
+
+        std::vector<std::unique_ptr<Material const>> materials;
+        materials.emplace_back(new Material("Iron", 1.0f, 100.0f, 1.0f, { 0x80, 0x80, 0x80 }, { 0x80, 0x80, 0x80 }, true, false, std::nullopt, std::nullopt));
+        materials.emplace_back(new Material("Rope", 0.5f, 10.0f, 0.5f, { 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x00 }, false, true, std::nullopt, std::nullopt));
+        mMaterials = std::make_unique<MaterialDatabase>(MaterialDatabase::Create(std::move(materials)));
+    }
+
+protected:
+
+    ShipBuilder::CompiledShip MakeCompiledShip() const
+    {
+        std::vector<ShipBuilder::PointInfo> pointInfos;
+        pointInfos.emplace_back(vec2f(0.0f, 0.0f), vec2f(0.0f, 0.0f), mMaterials->Get({ 0x80, 0x80, 0x80 }));
+        pointInfos.emplace_back(vec2f(1.0f, 0.0f), vec2f(0.5f, 0.0f), mMaterials->Get({ 0x80, 0x80, 0x80 }));
+        pointInfos.emplace_back(vec2f(0.0f, 1.0f), vec2f(0.0f, 0.5f), &(mMaterials->GetRopeMaterial()));
+        pointInfos.back().IsLeaking = true;
+
+        std::vector<ShipBuilder::SpringInfo> springInfos;
+        springInfos.emplace_back(0, 1);
+        springInfos.emplace_back(1, 2);
+        springInfos.emplace_back(2, 0);
+        springInfos.back().IsCoarse = true;
+
+        std::vector<ShipBuilder::TriangleInfo> triangleInfos;
+        triangleInfos.emplace_back(0, 1, 2);
+
+        std::vector<ShipBuilder::CoarseTriangleBlockInfo> coarseTriangleBlockInfos;
+        coarseTriangleBlockInfos.emplace_back(std::array<ElementIndex, 8u>{ 0, 0, 0, 0, 0, 0, 0, 0 });
+
+        return ShipBuilder::CompiledShip(
+            ImageSize(2, 2),
+            std::move(pointInfos),
+            std::move(springInfos),
+            std::move(triangleInfos),
+            std::move(coarseTriangleBlockInfos));
+    }
+
+    std::unique_ptr<MaterialDatabase> mMaterials;
+};
+
+TEST_F(ShipCacheTests, RoundTrip)
+{
+    ShipCache cache(mCacheDirectoryPath);
+
+    std::unique_ptr<unsigned char[]> textureData(new unsigned char[2 * 1 * 4]{ 1, 2, 3, 4, 5, 6, 7, 8 });
+    std::optional<ImageData> textureImage;
+    textureImage.emplace(2, 1, std::unique_ptr<unsigned char const[]>(std::move(textureData)));
+
+    cache.Store(42, MakeCompiledShip(), textureImage, "Test Ship");
+
+    auto entry = cache.TryLoad(42, *mMaterials);
+    ASSERT_TRUE(!!entry);
+
+    EXPECT_EQ(2, entry->CompiledShip.StructureSize.Width);
+    EXPECT_EQ(2, entry->CompiledShip.StructureSize.Height);
+
+    ASSERT_EQ(3u, entry->CompiledShip.PointInfos.size());
+    EXPECT_EQ(vec2f(1.0f, 0.0f), entry->CompiledShip.PointInfos[1].Position);
+    EXPECT_EQ(vec2f(0.0f, 0.5f), entry->CompiledShip.PointInfos[2].TextureCoordinates);
+    EXPECT_EQ(mMaterials->Get({ 0x80, 0x80, 0x80 }), entry->CompiledShip.PointInfos[0].Mtl);
+    EXPECT_EQ(&(mMaterials->GetRopeMaterial()), entry->CompiledShip.PointInfos[2].Mtl);
+    EXPECT_FALSE(entry->CompiledShip.PointInfos[0].IsLeaking);
+    EXPECT_TRUE(entry->CompiledShip.PointInfos[2].IsLeaking);
+
+    ASSERT_EQ(3u, entry->CompiledShip.SpringInfos.size());
+    EXPECT_EQ(1u, entry->CompiledShip.SpringInfos[1].PointAIndex);
+    EXPECT_EQ(2u, entry->CompiledShip.SpringInfos[1].PointBIndex);
+    EXPECT_FALSE(entry->CompiledShip.SpringInfos[1].IsCoarse);
+    EXPECT_TRUE(entry->CompiledShip.SpringInfos[2].IsCoarse);
+
+    ASSERT_EQ(1u, entry->CompiledShip.TriangleInfos.size());
+    EXPECT_EQ(2u, entry->CompiledShip.TriangleInfos[0].PointCIndex);
+
+    ASSERT_EQ(1u, entry->CompiledShip.CoarseTriangleBlockInfos.size());
+    EXPECT_EQ(0u, entry->CompiledShip.CoarseTriangleBlockInfos[0].TriangleIndices[7]);
+
+    ASSERT_TRUE(!!entry->TextureImage);
+    EXPECT_EQ(2, entry->TextureImage->Size.Width);
+    EXPECT_EQ(1, entry->TextureImage->Size.Height);
+    EXPECT_EQ(8, entry->TextureImage->Data[7]);
+
+    EXPECT_EQ("Test Ship", entry->ShipName);
+}
+
+TEST_F(ShipCacheTests, RoundTrip_NoTexture)
+{
+    ShipCache cache(mCacheDirectoryPath);
+
+    cache.Store(42, MakeCompiledShip(), std::nullopt, "");
+
+    auto entry = cache.TryLoad(42, *mMaterials);
+    ASSERT_TRUE(!!entry);
+
+    EXPECT_FALSE(!!entry->TextureImage);
+    EXPECT_EQ("", entry->ShipName);
+}
+
+TEST_F(ShipCacheTests, TruncatedEntryIsIgnored)
+{
+    ShipCache cache(mCacheDirectoryPath);
+
+    cache.Store(42, MakeCompiledShip(), std::nullopt, "Test Ship");
+
+    auto const entryFilePath = mCacheDirectoryPath / "000000000000002a.shc";
+    ASSERT_TRUE(std::filesystem::exists(entryFilePath));
+    std::filesystem::resize_file(entryFilePath, std::filesystem::file_size(entryFilePath) - 1);
+
+    EXPECT_FALSE(!!cache.TryLoad(42, *mMaterials));
+}
+
+TEST_F(ShipCacheTests, InvalidSpringFlagIsIgnored)
+{
+    ShipCache cache(mCacheDirectoryPath);
+
+    cache.Store(42, MakeCompiledShip(), std::nullopt, "");
+    ASSERT_TRUE(!!cache.TryLoad(42, *mMaterials));
+
+    // The coarse flag of the first spring comes after the header (64 bytes) and the
+    // padded sections of the 2 materials (8), the empty name (0), the 3 positions (24),
+    // the 3 texture coordinates (24), the 3 material indices (16), the 3 leaking flags (8),
+    // and the 3 spring endpoint pairs (24)
+    static constexpr std::streamoff IsCoarseOffset = 64 + 8 + 0 + 24 + 24 + 16 + 8 + 24;
+
+    {
+        std::fstream file((mCacheDirectoryPath / "000000000000002a.shc").string(), std::ios::in | std::ios::out | std::ios::binary);
+        ASSERT_TRUE(file.is_open());
+
+        // Make sure we're patching the flag
+        file.seekg(IsCoarseOffset);
+        char flags[3];
+        file.read(flags, sizeof(flags));
+        ASSERT_EQ(0, flags[0]);
+        ASSERT_EQ(0, flags[1]);
+        ASSERT_EQ(1, flags[2]);
+
+        file.seekp(IsCoarseOffset);
+        file.put(2);
+    }
+
+    EXPECT_FALSE(!!cache.TryLoad(42, *mMaterials));
+}
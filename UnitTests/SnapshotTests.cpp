@@ -0,0 +1,143 @@
+#include <GameLib/Buffer.h>
+#include <GameLib/GameEventDispatcher.h>
+#include <GameLib/GameException.h>
+#include <GameLib/GameParameters.h>
+#include <GameLib/Physics.h>
+#include <GameLib/Snapshot.h>
+#include <GameLib/Vectors.h>
+
+#include "TestShips.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(SnapshotTests, Values)
+{
+    SnapshotWriter writer;
+    writer.Write<uint32_t>(42);
+    writer.Write(vec2f(1.0f, 2.0f));
+    writer.Write(std::string("Test"));
+    writer.WriteOptional(std::optional<float>(3.0f));
+    writer.WriteOptional(std::optional<float>());
+
+    SnapshotReader reader(writer.GetBuffer());
+    EXPECT_EQ(42u, reader.Read<uint32_t>());
+    EXPECT_EQ(vec2f(1.0f, 2.0f), reader.Read<vec2f>());
+    EXPECT_EQ("Test", reader.ReadString());
+
+    auto const optional1 = reader.ReadOptional<float>();
+    ASSERT_TRUE(!!optional1);
+    EXPECT_EQ(3.0f, *optional1);
+    EXPECT_FALSE(!!reader.ReadOptional<float>());
+
+    EXPECT_TRUE(reader.IsAtEnd());
+}
+
+TEST(SnapshotTests, Buffers)
+{
+    Buffer<vec2f> buffer(3);
+    buffer.emplace_back(1.0f, 2.0f);
+    buffer.emplace_back(3.0f, 4.0f);
+    buffer.emplace_back(5.0f, 6.0f);
+
+    SnapshotWriter writer;
+    writer.WriteBuffer(buffer, 3);
+
+    SnapshotReader reader(writer.GetBuffer());
+    Buffer<vec2f> restoredBuffer(3);
+    reader.ReadBuffer(restoredBuffer, 3);
+
+    EXPECT_EQ(vec2f(1.0f, 2.0f), restoredBuffer[0]);
+    EXPECT_EQ(vec2f(3.0f, 4.0f), restoredBuffer[1]);
+    EXPECT_EQ(vec2f(5.0f, 6.0f), restoredBuffer[2]);
+
+    EXPECT_TRUE(reader.IsAtEnd());
+}
+
+TEST(SnapshotTests, Buffers_TooManyElements)
+{
+    Buffer<float> buffer(2);
+    buffer.emplace_back(1.0f);
+    buffer.emplace_back(2.0f);
+
+    SnapshotWriter writer;
+    writer.WriteBuffer(buffer, 2);
+
+    SnapshotReader reader(writer.GetBuffer());
+    Buffer<float> restoredBuffer(1);
+    EXPECT_THROW(reader.ReadBuffer(restoredBuffer, 2), std::runtime_error);
+}
+
+TEST(SnapshotTests, UnexpectedEnd)
+{
+    SnapshotWriter writer;
+    writer.Write<uint16_t>(42);
+
+    SnapshotReader reader(writer.GetBuffer());
+    EXPECT_THROW(reader.Read<uint32_t>(), GameException);
+}
+
+TEST(SnapshotTests, World_RoundTrip)
+{
+    auto gameEventDispatcher = std::make_shared<GameEventDispatcher>();
+    GameParameters gameParameters;
+    MaterialDatabase const materials = MakeTestMaterialDatabase();
+
+    Physics::World world(gameEventDispatcher, gameParameters);
+    int const shipId = world.AddShip(
+        MakeTestShipDefinition(
+            {
+                "IIII",
+                "IIII",
+                "IIII"
+            },
+            vec2f(0.0f, 20.0f)),
+        materials,
+        gameParameters);
+
+    world.TogglePinAt(vec2f(-2.0f, 20.0f), gameParameters);
+    world.TogglePinAt(vec2f(1.0f, 20.0f), gameParameters);
+    world.ToggleTimerBombAt(vec2f(-0.5f, 22.0f), gameParameters);
+
+    for (int s = 0; s < 10; ++s)
+    {
+        world.Update(gameParameters);
+    }
+
+    SnapshotWriter writer;
+    world.WriteSnapshot(writer);
+
+    SnapshotReader reader(writer.GetBuffer());
+    auto restoredWorld = Physics::World::ReadSnapshot(reader, gameEventDispatcher, materials, gameParameters);
+    EXPECT_TRUE(reader.IsAtEnd());
+
+    for (int s = 0; s < 10; ++s)
+    {
+        world.Update(gameParameters);
+        restoredWorld->Update(gameParameters);
+    }
+
+    // Positions
+    auto const & points = world.GetShip(shipId).GetPoints();
+    auto const & restoredPoints = restoredWorld->GetShip(shipId).GetPoints();
+    ASSERT_EQ(points.GetElementCount(), restoredPoints.GetElementCount());
+    for (auto p : points)
+    {
+        EXPECT_EQ(points.GetPosition(p), restoredPoints.GetPosition(p));
+    }
+
+    // The pinned points have not moved
+    EXPECT_EQ(vec2f(-2.0f, 20.0f), restoredPoints.GetPosition(restoredWorld->GetNearestPointAt(vec2f(-2.0f, 20.0f), 0.1f)));
+    EXPECT_EQ(vec2f(1.0f, 20.0f), restoredPoints.GetPosition(restoredWorld->GetNearestPointAt(vec2f(1.0f, 20.0f), 0.1f)));
+
+    // Everything else, including the state of the bomb
+    SnapshotWriter worldWriter;
+    world.WriteSnapshot(worldWriter);
+    SnapshotWriter restoredWorldWriter;
+    restoredWorld->WriteSnapshot(restoredWorldWriter);
+    EXPECT_EQ(worldWriter.GetBuffer(), restoredWorldWriter.GetBuffer());
+}
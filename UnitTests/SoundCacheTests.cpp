@@ -0,0 +1,60 @@
+#include <GameLib/SoundCache.h>
+
+#include "CacheTestsFixture.h"
+
+#include <filesystem>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+class SoundCacheTests : public CacheTestsFixture
+{
+};
+
+TEST_F(SoundCacheTests, RoundTrip)
+{
+    SoundCache cache(mCacheDirectoryPath);
+
+    cache.Store(42, DecodedSound(std::vector<int16_t>{ 1, -2, 3, -4, 5, -32768 }, 2, 44100));
+
+    auto decodedSound = cache.TryLoad(42);
+    ASSERT_TRUE(!!decodedSound);
+
+    EXPECT_EQ(2u, decodedSound->GetChannelCount());
+    EXPECT_EQ(44100u, decodedSound->GetSampleRate());
+    ASSERT_EQ(6u, decodedSound->GetSampleCount());
+    EXPECT_EQ(-2, decodedSound->GetSamples()[1]);
+    EXPECT_EQ(-32768, decodedSound->GetSamples()[5]);
+
+    // Samples stay put when the sound moves
+    int16_t const * const samples = decodedSound->GetSamples();
+    DecodedSound movedSound(std::move(*decodedSound));
+    EXPECT_EQ(samples, movedSound.GetSamples());
+    EXPECT_EQ(5, movedSound.GetSamples()[4]);
+}
+
+TEST_F(SoundCacheTests, RoundTrip_Empty)
+{
+    SoundCache cache(mCacheDirectoryPath);
+
+    cache.Store(42, DecodedSound(std::vector<int16_t>(), 1, 22050));
+
+    auto decodedSound = cache.TryLoad(42);
+    ASSERT_TRUE(!!decodedSound);
+
+    EXPECT_EQ(0u, decodedSound->GetSampleCount());
+    EXPECT_EQ(22050u, decodedSound->GetSampleRate());
+}
+
+TEST_F(SoundCacheTests, TruncatedEntryIsIgnored)
+{
+    SoundCache cache(mCacheDirectoryPath);
+
+    cache.Store(42, DecodedSound(std::vector<int16_t>{ 1, 2, 3 }, 1, 44100));
+
+    auto const entryFilePath = mCacheDirectoryPath / "000000000000002a.sds";
+    ASSERT_TRUE(std::filesystem::exists(entryFilePath));
+    std::filesystem::resize_file(entryFilePath, std::filesystem::file_size(entryFilePath) - 1);
+
+    EXPECT_FALSE(!!cache.TryLoad(42));
+}
@@ -0,0 +1,102 @@
+#include <GameLib/TaskThreadPool.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+TEST(TaskThreadPoolTests, RunsAllTasks)
+{
+    TaskThreadPool pool(3);
+
+    EXPECT_EQ(3u, pool.GetThreadCount());
+
+    std::atomic<int> sum(0);
+    for (int i = 1; i <= 100; ++i)
+    {
+        pool.Submit([&sum, i]() { sum += i; });
+    }
+
+    pool.WaitIdle();
+
+    EXPECT_EQ(5050, sum.load());
+}
+
+TEST(TaskThreadPoolTests, SurvivesThrowingTasks)
+{
+    TaskThreadPool pool(1);
+
+    std::atomic<int> count(0);
+    pool.Submit([]() { throw std::runtime_error("Test"); });
+    pool.Submit([&count]() { ++count; });
+
+    pool.WaitIdle();
+
+    EXPECT_EQ(1, count.load());
+}
+
+TEST(TaskThreadPoolTests, DefaultThreadCountIsPositive)
+{
+    EXPECT_LE(1u, TaskThreadPool::GetDefaultThreadCount());
+}
+
+TEST(TaskThreadPoolTests, OnDemandTask_RunsOnCallerWhenNotPrefetched)
+{
+    int runCount = 0;
+    OnDemandTask<int> task(
+        [&runCount]()
+        {
+            ++runCount;
+            return 42;
+        });
+
+    EXPECT_FALSE(task.IsDone());
+
+    EXPECT_EQ(42, task.Get());
+    EXPECT_EQ(42, task.Get());
+
+    EXPECT_TRUE(task.IsDone());
+    EXPECT_EQ(1, runCount);
+}
+
+TEST(TaskThreadPoolTests, OnDemandTask_RunsOnceWhenPrefetched)
+{
+    std::atomic<int> runCount(0);
+    std::thread::id runThreadId;
+
+    auto task = std::make_shared<OnDemandTask<int>>(
+        [&runCount, &runThreadId]()
+        {
+            ++runCount;
+            runThreadId = std::this_thread::get_id();
+            return 42;
+        });
+
+    {
+        TaskThreadPool pool(1);
+
+        OnDemandTask<int>::Prefetch(task, pool);
+
+        pool.WaitIdle();
+
+        EXPECT_TRUE(task->IsDone());
+        EXPECT_NE(std::this_thread::get_id(), runThreadId);
+    }
+
+    EXPECT_EQ(42, task->Get());
+    EXPECT_EQ(1, runCount.load());
+}
+
+TEST(TaskThreadPoolTests, OnDemandTask_RethrowsOnGet)
+{
+    OnDemandTask<int> task(
+        []() -> int
+        {
+            throw std::runtime_error("Test");
+        });
+
+    EXPECT_THROW(task.Get(), std::runtime_error);
+    EXPECT_THROW(task.Get(), std::runtime_error);
+}
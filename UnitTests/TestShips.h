@@ -0,0 +1,91 @@
+#pragma once
+
+#include <GameLib/Material.h>
+#include <GameLib/MaterialDatabase.h>
+#include <GameLib/ShipDefinition.h>
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/*
+ * Helpers for building small ships for the tests.
+ */
+
+// The structural colour of the material our test ships are made of
+static constexpr std::array<uint8_t, 3u> TestShipStructuralColour = { 0x80, 0x80, 0x80 };
+
+/*
+ * Makes the materials of our test ships; the iron is strong enough for a pinned ship
+ * to hold a bomb.
+ */
+inline MaterialDatabase MakeTestMaterialDatabase()
+{
+    std::vector<std::unique_ptr<Material const>> materials;
+    materials.emplace_back(new Material("Iron", 1000.0f, 100.0f, 1.0f, TestShipStructuralColour, TestShipStructuralColour, true, false, std::nullopt, std::nullopt));
+    materials.emplace_back(new Material("Rope", 0.5f, 10.0f, 0.5f, { 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x00 }, false, true, std::nullopt, std::nullopt));
+
+    return MaterialDatabase::Create(std::move(materials));
+}
+
+/*
+ * Makes a ship out of a picture of its structure, top row first: 'I' is iron, '.' is
+ * empty, and each digit is one of the two endpoints of the rope of that number.
+ *
+ * The texture, if requested, is a plain image of the size of the structure.
+ */
+inline ShipDefinition MakeTestShipDefinition(
+    std::vector<std::string> const & rows,
+    vec2f const & offset,
+    bool withTexture = false)
+{
+    assert(!rows.empty());
+
+    int const width = static_cast<int>(rows[0].size());
+    int const height = static_cast<int>(rows.size());
+
+    std::unique_ptr<unsigned char[]> structureData(new unsigned char[static_cast<size_t>(width * height) * 3]);
+    for (int y = 0; y < height; ++y)
+    {
+        assert(static_cast<int>(rows[y].size()) == width);
+
+        for (int x = 0; x < width; ++x)
+        {
+            std::array<uint8_t, 3u> rgbColour;
+            char const c = rows[y][x];
+            if ('I' == c)
+                rgbColour = TestShipStructuralColour;
+            else if (c >= '1' && c <= '9')
+                rgbColour = { 0x00, 0x00, static_cast<uint8_t>(c - '0') };
+            else
+                rgbColour = { 0xff, 0xff, 0xff };
+
+            for (int component = 0; component < 3; ++component)
+            {
+                structureData[(x + y * width) * 3 + component] = rgbColour[component];
+            }
+        }
+    }
+
+    std::optional<ImageData> textureImage;
+    if (withTexture)
+    {
+        std::unique_ptr<unsigned char[]> textureData(new unsigned char[static_cast<size_t>(width * height) * 4]);
+        for (int p = 0; p < width * height * 4; ++p)
+        {
+            textureData[p] = 0x40;
+        }
+
+        textureImage.emplace(width, height, std::unique_ptr<unsigned char const[]>(std::move(textureData)));
+    }
+
+    return ShipDefinition(
+        ImageData(width, height, std::unique_ptr<unsigned char const[]>(std::move(structureData))),
+        std::move(textureImage),
+        "Test",
+        offset);
+}
@@ -0,0 +1,146 @@
+#include <GameLib/DecodedTexture.h>
+#include <GameLib/TextureCache.h>
+
+#include "CacheTestsFixture.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+    ImageData MakeImage(
+        int width,
+        int height,
+        unsigned char const * pixels)
+    {
+        size_t const size = static_cast<size_t>(width * height * 4);
+        std::unique_ptr<unsigned char[]> data(new unsigned char[size]);
+        std::memcpy(data.get(), pixels, size);
+
+        return ImageData(width, height, std::move(data));
+    }
+}
+
+TEST(DecodedTextureTests, FromImage_WithoutMipmaps)
+{
+    unsigned char const pixels[] = { 1, 2, 3, 4,   5, 6, 7, 8 };
+
+    DecodedTexture texture = DecodedTexture::FromImage(MakeImage(2, 1, pixels), false);
+
+    ASSERT_EQ(1u, texture.GetLevelCount());
+    EXPECT_EQ(2, texture.GetSize().Width);
+    EXPECT_EQ(1, texture.GetSize().Height);
+    EXPECT_EQ(7, texture.GetLevelData(0)[6]);
+}
+
+TEST(DecodedTextureTests, FromImage_WithMipmaps)
+{
+    unsigned char const pixels[] = {
+        0, 10, 20, 255,     4, 10, 20, 255,     8, 0, 0, 0,     8, 0, 0, 0,
+        8, 10, 20, 255,     12, 10, 20, 255,    8, 0, 0, 0,     8, 0, 0, 0 };
+
+    DecodedTexture texture = DecodedTexture::FromImage(MakeImage(4, 2, pixels), true);
+
+    ASSERT_EQ(3u, texture.GetLevelCount());
+    EXPECT_EQ(DecodedTexture::CalculateMipmapLevelCount(ImageSize(4, 2)), texture.GetLevelCount());
+
+    EXPECT_EQ(2, texture.GetLevelSize(1).Width);
+    EXPECT_EQ(1, texture.GetLevelSize(1).Height);
+    EXPECT_EQ(1, texture.GetLevelSize(2).Width);
+    EXPECT_EQ(1, texture.GetLevelSize(2).Height);
+
+    // Box filter
+    EXPECT_EQ(6, texture.GetLevelData(1)[0]);
+    EXPECT_EQ(10, texture.GetLevelData(1)[1]);
+    EXPECT_EQ(255, texture.GetLevelData(1)[3]);
+    EXPECT_EQ(8, texture.GetLevelData(1)[4]);
+    EXPECT_EQ(0, texture.GetLevelData(1)[7]);
+    EXPECT_EQ(7, texture.GetLevelData(2)[0]);
+    EXPECT_EQ(127, texture.GetLevelData(2)[3]);
+}
+
+TEST(DecodedTextureTests, CalculateDataSize)
+{
+    EXPECT_EQ(4u * 2u * 4u, DecodedTexture::CalculateDataSize(ImageSize(4, 2), 1));
+    EXPECT_EQ((8u + 2u + 1u) * 4u, DecodedTexture::CalculateDataSize(ImageSize(4, 2), 3));
+}
+
+class TextureCacheTests : public CacheTestsFixture
+{
+protected:
+
+    /*
+     * Overwrites the level count in the header of an entry file, which comes after
+     * the magic, the format version, the key, and the size.
+     */
+    void PatchLevelCount(
+        uint64_t key,
+        uint32_t levelCount) const
+    {
+        static constexpr std::streamoff LevelCountOffset = 24;
+
+        auto const entryFilePath = CacheDirectory(mCacheDirectoryPath, ".sdt").GetEntryFilePath(key);
+        std::fstream file(entryFilePath.string(), std::ios::in | std::ios::out | std::ios::binary);
+        ASSERT_TRUE(file.is_open());
+        file.seekp(LevelCountOffset);
+        file.write(reinterpret_cast<char const *>(&levelCount), sizeof(levelCount));
+    }
+};
+
+TEST_F(TextureCacheTests, RoundTrip_WithMipmaps)
+{
+    TextureCache cache(mCacheDirectoryPath);
+
+    unsigned char const pixels[] = {
+        0, 0, 0, 0,     4, 4, 4, 4,
+        8, 8, 8, 8,     12, 12, 12, 12 };
+    DecodedTexture const original = DecodedTexture::FromImage(MakeImage(2, 2, pixels), true);
+    cache.Store(42, original);
+
+    auto texture = cache.TryLoad(42);
+    ASSERT_TRUE(!!texture);
+
+    ASSERT_EQ(2u, texture->GetLevelCount());
+    EXPECT_EQ(1, texture->GetLevelSize(1).Width);
+    EXPECT_EQ(1, texture->GetLevelSize(1).Height);
+    EXPECT_EQ(0, std::memcmp(pixels, texture->GetLevelData(0), sizeof(pixels)));
+    EXPECT_EQ(6, texture->GetLevelData(1)[0]);
+
+    // Levels stay put when the texture moves
+    unsigned char const * const levelData = texture->GetLevelData(1);
+    DecodedTexture movedTexture(std::move(*texture));
+    EXPECT_EQ(levelData, movedTexture.GetLevelData(1));
+}
+
+TEST_F(TextureCacheTests, InvalidLevelCountIsIgnored)
+{
+    TextureCache cache(mCacheDirectoryPath);
+
+    unsigned char const pixels[] = { 1, 2, 3, 4,   5, 6, 7, 8 };
+    cache.Store(42, DecodedTexture::FromImage(MakeImage(2, 1, pixels), true));
+    ASSERT_TRUE(!!cache.TryLoad(42));
+
+    // No levels
+    PatchLevelCount(42, 0);
+    EXPECT_FALSE(!!cache.TryLoad(42));
+
+    // More levels than a 2x1 texture may have
+    PatchLevelCount(42, 3);
+    EXPECT_FALSE(!!cache.TryLoad(42));
+
+    // Fewer levels than the entry has
+    PatchLevelCount(42, 1);
+    EXPECT_FALSE(!!cache.TryLoad(42));
+}
+
+TEST_F(TextureCacheTests, KeyDependsOnMipmaps)
+{
+    auto const filePath = MakeFile("texture.png", "abc");
+
+    EXPECT_NE(TextureCache::CalculateKey(filePath, false), TextureCache::CalculateKey(filePath, true));
+}
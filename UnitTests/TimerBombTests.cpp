@@ -0,0 +1,119 @@
+#include <GameLib/GameEventDispatcher.h>
+#include <GameLib/GameParameters.h>
+#include <GameLib/GameWallClock.h>
+#include <GameLib/Physics.h>
+
+#include "TestShips.h"
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+class TimerBombTests : public ::testing::Test
+{
+protected:
+
+    class ExplosionCounter final : public IGameEventHandler
+    {
+    public:
+
+        virtual void OnBombExplosion(
+            bool /*isUnderwater*/,
+            unsigned int size) override
+        {
+            ExplosionCount += size;
+        }
+
+        unsigned int ExplosionCount = 0;
+    };
+
+    virtual void SetUp() override
+    {
+        mGameEventDispatcher = std::make_shared<GameEventDispatcher>();
+        mGameEventDispatcher->RegisterSink(&mExplosionCounter);
+    }
+
+    // Places a timer bomb on a ship that is pinned well above the water
+    std::unique_ptr<Physics::World> MakeWorldWithTimerBomb(GameParameters const & gameParameters)
+    {
+        auto world = std::make_unique<Physics::World>(mGameEventDispatcher, gameParameters);
+        world->AddShip(
+            MakeTestShipDefinition(
+                {
+                    "IIII",
+                    "IIII",
+                    "IIII"
+                },
+                vec2f(0.0f, 20.0f)),
+            mMaterials,
+            gameParameters);
+
+        world->TogglePinAt(vec2f(-2.0f, 20.0f), gameParameters);
+        world->TogglePinAt(vec2f(1.0f, 20.0f), gameParameters);
+        world->ToggleTimerBombAt(vec2f(-0.5f, 22.0f), gameParameters);
+
+        return world;
+    }
+
+    unsigned int Update(
+        Physics::World & world,
+        GameParameters const & gameParameters)
+    {
+        world.Update(gameParameters);
+        mGameEventDispatcher->Flush();
+
+        return mExplosionCounter.ExplosionCount;
+    }
+
+    MaterialDatabase const mMaterials = MakeTestMaterialDatabase();
+    ExplosionCounter mExplosionCounter;
+    std::shared_ptr<GameEventDispatcher> mGameEventDispatcher;
+};
+
+TEST_F(TimerBombTests, ExplodesAfterTimerBombIntervalOfSimulationTime)
+{
+    GameParameters gameParameters;
+    gameParameters.TimerBombInterval = std::chrono::seconds(4);
+
+    auto world = MakeWorldWithTimerBomb(gameParameters);
+
+    long const stepCount = std::lround(
+        std::chrono::duration<double>(gameParameters.TimerBombInterval).count()
+        / GameParameters::SimulationStepTimeDuration<double>);
+
+    // Steps take no time at all, yet the bomb goes off at its time
+    for (long s = 0; s < stepCount; ++s)
+    {
+        ASSERT_EQ(0u, Update(*world, gameParameters)) << "at step " << s;
+    }
+
+    EXPECT_EQ(1u, Update(*world, gameParameters));
+}
+
+TEST_F(TimerBombTests, UseWallClockForBombs)
+{
+    GameParameters gameParameters;
+    gameParameters.TimerBombInterval = std::chrono::seconds(4);
+    gameParameters.UseWallClockForBombs = true;
+
+    auto world = MakeWorldWithTimerBomb(gameParameters);
+
+    long const stepCount = std::lround(
+        std::chrono::duration<double>(gameParameters.TimerBombInterval).count()
+        / GameParameters::SimulationStepTimeDuration<double>);
+
+    // With the wall clock stopped, the bomb never goes off, regardless of the steps
+    GameWallClock::GetInstance().Pause();
+
+    unsigned int explosionCount = 0;
+    for (long s = 0; s < 2 * stepCount; ++s)
+    {
+        explosionCount = Update(*world, gameParameters);
+    }
+
+    GameWallClock::GetInstance().Resume();
+
+    EXPECT_EQ(0u, explosionCount);
+}
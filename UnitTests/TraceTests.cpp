@@ -0,0 +1,234 @@
+#include <GameLib/Trace.h>
+
+#include <picojson/picojson.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+class TraceTests : public ::testing::Test
+{
+protected:
+
+    void TearDown() override
+    {
+        Tracer::Instance.Stop();
+    }
+
+    picojson::object Export()
+    {
+        std::stringstream ss;
+        Tracer::Instance.ExportChromeTrace(ss);
+
+        picojson::value root;
+        std::string const error = picojson::parse(root, ss.str());
+        EXPECT_TRUE(error.empty()) << error;
+        EXPECT_TRUE(root.is<picojson::object>());
+
+        return root.get<picojson::object>();
+    }
+
+    // All but the metadata
+    picojson::array ExportEvents()
+    {
+        auto root = Export();
+
+        picojson::array events;
+        for (auto const & event : root["traceEvents"].get<picojson::array>())
+        {
+            if (event.get("ph").get<std::string>() != "M")
+                events.push_back(event);
+        }
+
+        return events;
+    }
+
+    static std::string const & Phase(picojson::value const & event)
+    {
+        return event.get("ph").get<std::string>();
+    }
+
+    static std::string const & Name(picojson::value const & event)
+    {
+        return event.get("name").get<std::string>();
+    }
+};
+
+TEST_F(TraceTests, NothingIsRecordedWhenStopped)
+{
+    Tracer::Instance.Start();
+    Tracer::Instance.Stop();
+
+    {
+        TraceSpan span("A");
+        TraceCounter("B", 1.0);
+    }
+
+    EXPECT_TRUE(ExportEvents().empty());
+}
+
+TEST_F(TraceTests, SpansAndCounters)
+{
+    Tracer::Instance.Start();
+
+    {
+        TraceSpan outerSpan("Outer");
+
+        {
+            TraceSpan innerSpan("Inner");
+        }
+
+        TraceCounter("Count", 42.0);
+    }
+
+    Tracer::Instance.Stop();
+
+    auto const events = ExportEvents();
+    ASSERT_EQ(5u, events.size());
+
+    EXPECT_EQ("B", Phase(events[0]));
+    EXPECT_EQ("Outer", Name(events[0]));
+    EXPECT_EQ("B", Phase(events[1]));
+    EXPECT_EQ("Inner", Name(events[1]));
+    EXPECT_EQ("E", Phase(events[2]));
+    EXPECT_EQ("Inner", Name(events[2]));
+    EXPECT_EQ("C", Phase(events[3]));
+    EXPECT_EQ("Count", Name(events[3]));
+    EXPECT_EQ(42.0, events[3].get("args").get("value").get<double>());
+    EXPECT_EQ("E", Phase(events[4]));
+    EXPECT_EQ("Outer", Name(events[4]));
+
+    for (size_t e = 1; e < events.size(); ++e)
+    {
+        EXPECT_LE(events[e - 1].get("ts").get<double>(), events[e].get("ts").get<double>());
+        EXPECT_EQ(events[0].get("tid").get<double>(), events[e].get("tid").get<double>());
+    }
+}
+
+TEST_F(TraceTests, StartDiscardsPreviousSession)
+{
+    Tracer::Instance.Start();
+
+    {
+        TraceSpan span("First");
+    }
+
+    Tracer::Instance.Start();
+
+    {
+        TraceSpan span("Second");
+    }
+
+    Tracer::Instance.Stop();
+
+    auto const events = ExportEvents();
+    ASSERT_EQ(2u, events.size());
+    EXPECT_EQ("Second", Name(events[0]));
+    EXPECT_EQ("Second", Name(events[1]));
+}
+
+TEST_F(TraceTests, SpanEndedAfterStopIsRecorded)
+{
+    Tracer::Instance.Start();
+
+    {
+        TraceSpan span("A");
+
+        Tracer::Instance.Stop();
+    }
+
+    auto const events = ExportEvents();
+    ASSERT_EQ(2u, events.size());
+    EXPECT_EQ("B", Phase(events[0]));
+    EXPECT_EQ("E", Phase(events[1]));
+}
+
+TEST_F(TraceTests, SpanEndedAfterRestartIsDiscarded)
+{
+    Tracer::Instance.Start();
+
+    {
+        TraceSpan span("A");
+
+        Tracer::Instance.Start();
+    }
+
+    Tracer::Instance.Stop();
+
+    EXPECT_TRUE(ExportEvents().empty());
+}
+
+TEST_F(TraceTests, ThreadsAreRecordedSeparately)
+{
+    Tracer::Instance.Start();
+
+    std::thread worker(
+        []()
+        {
+            Tracer::Instance.SetThreadName("Worker");
+
+            TraceSpan span("Work");
+        });
+
+    worker.join();
+
+    {
+        TraceSpan span("Main");
+    }
+
+    Tracer::Instance.Stop();
+
+    auto root = Export();
+
+    double workerThreadId = -1.0;
+    double mainThreadId = -1.0;
+    bool isWorkerNamed = false;
+    for (auto const & event : root["traceEvents"].get<picojson::array>())
+    {
+        if (Phase(event) == "M")
+        {
+            if (event.get("args").get("name").get<std::string>() == "Worker")
+                isWorkerNamed = true;
+        }
+        else if (Name(event) == "Work")
+        {
+            workerThreadId = event.get("tid").get<double>();
+        }
+        else if (Name(event) == "Main")
+        {
+            mainThreadId = event.get("tid").get<double>();
+        }
+    }
+
+    EXPECT_TRUE(isWorkerNamed);
+    EXPECT_GT(workerThreadId, 0.0);
+    EXPECT_GT(mainThreadId, 0.0);
+    EXPECT_NE(workerThreadId, mainThreadId);
+}
+
+TEST_F(TraceTests, FullBufferDropsEventsButKeepsSpansBalanced)
+{
+    Tracer::Instance.Start();
+
+    {
+        TraceSpan span("Outer");
+
+        for (size_t i = 0; i < Tracer::MaxThreadEventCount; ++i)
+        {
+            TraceCounter("Counter", static_cast<double>(i));
+        }
+    }
+
+    Tracer::Instance.Stop();
+
+    auto root = Export();
+
+    EXPECT_EQ("2", root["otherData"].get("droppedEventCount").get<std::string>());
+
+    auto const & events = root["traceEvents"].get<picojson::array>();
+    ASSERT_EQ(1u + Tracer::MaxThreadEventCount, events.size()); // Including the thread name
+    EXPECT_EQ("E", Phase(events.back()));
+    EXPECT_EQ("Outer", Name(events.back()));
+}
@@ -0,0 +1,240 @@
+#include <GameLib/NullAudioDevice.h>
+#include <GameLib/VoicePool.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace /* anonymous */ {
+
+    struct TestSoundBuffer
+    {
+        int Id;
+    };
+
+    struct TestVoiceState
+    {
+        TestSoundBuffer const * SoundBuffer;
+        float Volume;
+        bool IsStopped;
+        bool IsPaused;
+    };
+
+    /*
+     * A device whose voices expose their state to the test.
+     */
+    class TestAudioDevice : public IAudioDevice<TestSoundBuffer>
+    {
+    public:
+
+        std::vector<std::shared_ptr<TestVoiceState>> Voices;
+
+        virtual std::unique_ptr<IAudioVoice<TestSoundBuffer>> MakeVoice() override
+        {
+            Voices.emplace_back(new TestVoiceState{ nullptr, 0.0f, true, false });
+            return std::make_unique<TestAudioVoice>(Voices.back());
+        }
+
+    private:
+
+        class TestAudioVoice : public IAudioVoice<TestSoundBuffer>
+        {
+        public:
+
+            TestAudioVoice(std::shared_ptr<TestVoiceState> state)
+                : mState(std::move(state))
+            {}
+
+            virtual void Play(TestSoundBuffer const & soundBuffer, float volume) override
+            {
+                mState->SoundBuffer = &soundBuffer;
+                mState->Volume = volume;
+                mState->IsStopped = false;
+                mState->IsPaused = false;
+            }
+
+            virtual void Stop() override { mState->IsStopped = true; }
+            virtual void Pause() override { mState->IsPaused = true; }
+            virtual void Resume() override { mState->IsPaused = false; }
+            virtual bool IsStopped() const override { return mState->IsStopped; }
+            virtual float GetVolume() const override { return mState->Volume; }
+            virtual void SetVolume(float volume) override { mState->Volume = volume; }
+
+        private:
+
+            std::shared_ptr<TestVoiceState> mState;
+        };
+    };
+
+    using Outcome = VoicePool<TestSoundBuffer>::PlayOutcome;
+
+    std::chrono::milliseconds constexpr MinDeltaTime{ 100 };
+
+    TestSoundBuffer const Buffers[4] = { { 0 }, { 1 }, { 2 }, { 3 } };
+}
+
+TEST(VoicePoolTests, MakesAllVoicesUpfront)
+{
+    TestAudioDevice device;
+    VoicePool<TestSoundBuffer> pool(device, 3, 4, MinDeltaTime);
+
+    EXPECT_EQ(3u, device.Voices.size());
+    EXPECT_EQ(3u, pool.GetVoiceCount());
+    EXPECT_EQ(0u, pool.GetBusyVoiceCount());
+}
+
+TEST(VoicePoolTests, PlaysOnFreeVoices)
+{
+    TestAudioDevice device;
+    VoicePool<TestSoundBuffer> pool(device, 3, 4, MinDeltaTime);
+
+    auto const t0 = std::chrono::steady_clock::time_point();
+
+    EXPECT_EQ(Outcome::Played, pool.Play(0, Buffers[0], 40.0f, 0, t0));
+    EXPECT_EQ(Outcome::Played, pool.Play(1, Buffers[1], 50.0f, 0, t0));
+
+    EXPECT_EQ(2u, pool.GetBusyVoiceCount());
+
+    EXPECT_EQ(&(Buffers[0]), device.Voices[0]->SoundBuffer);
+    EXPECT_EQ(40.0f, device.Voices[0]->Volume);
+    EXPECT_EQ(&(Buffers[1]), device.Voices[1]->SoundBuffer);
+    EXPECT_EQ(50.0f, device.Voices[1]->Volume);
+    EXPECT_TRUE(device.Voices[2]->IsStopped);
+}
+
+TEST(VoicePoolTests, CoalescesSameSoundWithinMinDeltaTime)
+{
+    TestAudioDevice device;
+    VoicePool<TestSoundBuffer> pool(device, 3, 4, MinDeltaTime);
+
+    auto const t0 = std::chrono::steady_clock::time_point();
+
+    EXPECT_EQ(Outcome::Played, pool.Play(0, Buffers[0], 40.0f, 0, t0));
+    EXPECT_EQ(Outcome::Coalesced, pool.Play(0, Buffers[0], 40.0f, 0, t0 + std::chrono::milliseconds(50)));
+
+    EXPECT_EQ(1u, pool.GetBusyVoiceCount());
+    EXPECT_EQ(80.0f, device.Voices[0]->Volume);
+
+    // Capped
+    EXPECT_EQ(Outcome::Coalesced, pool.Play(0, Buffers[0], 40.0f, 0, t0 + std::chrono::milliseconds(60)));
+    EXPECT_EQ(100.0f, device.Voices[0]->Volume);
+
+    // Too late
+    EXPECT_EQ(Outcome::Played, pool.Play(0, Buffers[0], 40.0f, 0, t0 + MinDeltaTime));
+    EXPECT_EQ(2u, pool.GetBusyVoiceCount());
+}
+
+TEST(VoicePoolTests, ReclaimsStoppedVoices)
+{
+    TestAudioDevice device;
+    VoicePool<TestSoundBuffer> pool(device, 2, 4, MinDeltaTime);
+
+    auto const t0 = std::chrono::steady_clock::time_point();
+
+    pool.Play(0, Buffers[0], 100.0f, 0, t0);
+    pool.Play(1, Buffers[1], 100.0f, 0, t0);
+
+    // The first sound finishes
+    device.Voices[0]->IsStopped = true;
+
+    EXPECT_EQ(Outcome::Played, pool.Play(2, Buffers[2], 100.0f, 0, t0));
+    EXPECT_EQ(&(Buffers[2]), device.Voices[0]->SoundBuffer);
+    EXPECT_FALSE(device.Voices[1]->IsStopped);
+}
+
+TEST(VoicePoolTests, StealsOldestVoiceOfLowestPriority)
+{
+    TestAudioDevice device;
+    VoicePool<TestSoundBuffer> pool(device, 3, 4, MinDeltaTime);
+
+    auto const t0 = std::chrono::steady_clock::time_point();
+
+    pool.Play(0, Buffers[0], 100.0f, 1, t0);
+    pool.Play(1, Buffers[1], 100.0f, 0, t0 + std::chrono::milliseconds(1));
+    pool.Play(2, Buffers[2], 100.0f, 0, t0 + std::chrono::milliseconds(2));
+
+    EXPECT_EQ(Outcome::PlayedOnStolenVoice, pool.Play(3, Buffers[3], 100.0f, 0, t0 + std::chrono::milliseconds(3)));
+
+    EXPECT_EQ(3u, pool.GetBusyVoiceCount());
+    EXPECT_EQ(&(Buffers[0]), device.Voices[0]->SoundBuffer);
+    EXPECT_EQ(&(Buffers[3]), device.Voices[1]->SoundBuffer);
+    EXPECT_EQ(&(Buffers[2]), device.Voices[2]->SoundBuffer);
+}
+
+TEST(VoicePoolTests, DropsSoundWhenAllVoicesAreMoreImportant)
+{
+    TestAudioDevice device;
+    VoicePool<TestSoundBuffer> pool(device, 2, 4, MinDeltaTime);
+
+    auto const t0 = std::chrono::steady_clock::time_point();
+
+    pool.Play(0, Buffers[0], 100.0f, 2, t0);
+    pool.Play(1, Buffers[1], 100.0f, 2, t0);
+
+    EXPECT_EQ(Outcome::Dropped, pool.Play(2, Buffers[2], 100.0f, 1, t0));
+
+    EXPECT_EQ(&(Buffers[0]), device.Voices[0]->SoundBuffer);
+    EXPECT_EQ(&(Buffers[1]), device.Voices[1]->SoundBuffer);
+    EXPECT_FALSE(device.Voices[0]->IsStopped);
+    EXPECT_FALSE(device.Voices[1]->IsStopped);
+}
+
+TEST(VoicePoolTests, PausesAndResumesBusyVoices)
+{
+    TestAudioDevice device;
+    VoicePool<TestSoundBuffer> pool(device, 2, 4, MinDeltaTime);
+
+    auto const t0 = std::chrono::steady_clock::time_point();
+
+    pool.Play(0, Buffers[0], 100.0f, 0, t0);
+
+    pool.SetPaused(true);
+
+    EXPECT_TRUE(device.Voices[0]->IsPaused);
+    EXPECT_FALSE(device.Voices[1]->IsPaused);
+
+    // Sounds started while paused start paused
+    pool.Play(1, Buffers[1], 100.0f, 0, t0);
+    EXPECT_TRUE(device.Voices[1]->IsPaused);
+
+    pool.SetPaused(false);
+
+    EXPECT_FALSE(device.Voices[0]->IsPaused);
+    EXPECT_FALSE(device.Voices[1]->IsPaused);
+}
+
+TEST(VoicePoolTests, StopAllFreesAllVoices)
+{
+    TestAudioDevice device;
+    VoicePool<TestSoundBuffer> pool(device, 2, 4, MinDeltaTime);
+
+    auto const t0 = std::chrono::steady_clock::time_point();
+
+    pool.Play(0, Buffers[0], 100.0f, 0, t0);
+    pool.Play(1, Buffers[1], 100.0f, 0, t0);
+
+    pool.StopAll();
+
+    EXPECT_EQ(0u, pool.GetBusyVoiceCount());
+    EXPECT_TRUE(device.Voices[0]->IsStopped);
+    EXPECT_TRUE(device.Voices[1]->IsStopped);
+
+    // Not coalesced with the stopped sound
+    EXPECT_EQ(Outcome::Played, pool.Play(0, Buffers[0], 100.0f, 0, t0));
+}
+
+TEST(VoicePoolTests, NullDevice_StealsWhenFull)
+{
+    NullAudioDevice<TestSoundBuffer> device;
+    VoicePool<TestSoundBuffer> pool(device, 2, 4, MinDeltaTime);
+
+    auto const t0 = std::chrono::steady_clock::time_point();
+
+    EXPECT_EQ(Outcome::Played, pool.Play(0, Buffers[0], 100.0f, 0, t0));
+    EXPECT_EQ(Outcome::Played, pool.Play(1, Buffers[1], 100.0f, 0, t0));
+    EXPECT_EQ(Outcome::PlayedOnStolenVoice, pool.Play(2, Buffers[2], 100.0f, 0, t0));
+
+    EXPECT_EQ(2u, pool.GetBusyVoiceCount());
+}